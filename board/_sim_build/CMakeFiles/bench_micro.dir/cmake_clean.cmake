@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_micro.dir/bench/alloc_counter.cpp.o"
+  "CMakeFiles/bench_micro.dir/bench/alloc_counter.cpp.o.d"
+  "CMakeFiles/bench_micro.dir/bench/bench_micro.cpp.o"
+  "CMakeFiles/bench_micro.dir/bench/bench_micro.cpp.o.d"
+  "bench_micro"
+  "bench_micro.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_micro.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
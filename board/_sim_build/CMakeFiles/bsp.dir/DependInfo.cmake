@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/board/src/bsp/adafruit_tm117.cpp" "CMakeFiles/bsp.dir/src/bsp/adafruit_tm117.cpp.o" "gcc" "CMakeFiles/bsp.dir/src/bsp/adafruit_tm117.cpp.o.d"
+  "/root/repo/board/src/bsp/adafruit_ultimate_gps_pa1616d.cpp" "CMakeFiles/bsp.dir/src/bsp/adafruit_ultimate_gps_pa1616d.cpp.o" "gcc" "CMakeFiles/bsp.dir/src/bsp/adafruit_ultimate_gps_pa1616d.cpp.o.d"
+  "/root/repo/board/src/bsp/flight_replay.cpp" "CMakeFiles/bsp.dir/src/bsp/flight_replay.cpp.o" "gcc" "CMakeFiles/bsp.dir/src/bsp/flight_replay.cpp.o.d"
+  "/root/repo/board/src/bsp/fmcw_fft_parser.cpp" "CMakeFiles/bsp.dir/src/bsp/fmcw_fft_parser.cpp.o" "gcc" "CMakeFiles/bsp.dir/src/bsp/fmcw_fft_parser.cpp.o.d"
+  "/root/repo/board/src/bsp/gps_position_hint.cpp" "CMakeFiles/bsp.dir/src/bsp/gps_position_hint.cpp.o" "gcc" "CMakeFiles/bsp.dir/src/bsp/gps_position_hint.cpp.o.d"
+  "/root/repo/board/src/bsp/nmea_parser.cpp" "CMakeFiles/bsp.dir/src/bsp/nmea_parser.cpp.o" "gcc" "CMakeFiles/bsp.dir/src/bsp/nmea_parser.cpp.o.d"
+  "/root/repo/board/src/bsp/ops_fmcw.cpp" "CMakeFiles/bsp.dir/src/bsp/ops_fmcw.cpp.o" "gcc" "CMakeFiles/bsp.dir/src/bsp/ops_fmcw.cpp.o.d"
+  "/root/repo/board/src/bsp/radar_command_sequencer.cpp" "CMakeFiles/bsp.dir/src/bsp/radar_command_sequencer.cpp.o" "gcc" "CMakeFiles/bsp.dir/src/bsp/radar_command_sequencer.cpp.o.d"
+  "/root/repo/board/src/bsp/serial_line_reader.cpp" "CMakeFiles/bsp.dir/src/bsp/serial_line_reader.cpp.o" "gcc" "CMakeFiles/bsp.dir/src/bsp/serial_line_reader.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,27 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bsp.dir/src/bsp/adafruit_tm117.cpp.o"
+  "CMakeFiles/bsp.dir/src/bsp/adafruit_tm117.cpp.o.d"
+  "CMakeFiles/bsp.dir/src/bsp/adafruit_ultimate_gps_pa1616d.cpp.o"
+  "CMakeFiles/bsp.dir/src/bsp/adafruit_ultimate_gps_pa1616d.cpp.o.d"
+  "CMakeFiles/bsp.dir/src/bsp/flight_replay.cpp.o"
+  "CMakeFiles/bsp.dir/src/bsp/flight_replay.cpp.o.d"
+  "CMakeFiles/bsp.dir/src/bsp/fmcw_fft_parser.cpp.o"
+  "CMakeFiles/bsp.dir/src/bsp/fmcw_fft_parser.cpp.o.d"
+  "CMakeFiles/bsp.dir/src/bsp/gps_position_hint.cpp.o"
+  "CMakeFiles/bsp.dir/src/bsp/gps_position_hint.cpp.o.d"
+  "CMakeFiles/bsp.dir/src/bsp/nmea_parser.cpp.o"
+  "CMakeFiles/bsp.dir/src/bsp/nmea_parser.cpp.o.d"
+  "CMakeFiles/bsp.dir/src/bsp/ops_fmcw.cpp.o"
+  "CMakeFiles/bsp.dir/src/bsp/ops_fmcw.cpp.o.d"
+  "CMakeFiles/bsp.dir/src/bsp/radar_command_sequencer.cpp.o"
+  "CMakeFiles/bsp.dir/src/bsp/radar_command_sequencer.cpp.o.d"
+  "CMakeFiles/bsp.dir/src/bsp/serial_line_reader.cpp.o"
+  "CMakeFiles/bsp.dir/src/bsp/serial_line_reader.cpp.o.d"
+  "libbsp.a"
+  "libbsp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bsp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
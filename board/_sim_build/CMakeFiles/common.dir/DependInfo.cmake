@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/board/src/common/async_writer.c" "CMakeFiles/common.dir/src/common/async_writer.c.o" "gcc" "CMakeFiles/common.dir/src/common/async_writer.c.o.d"
+  "/root/repo/board/src/common/clock.c" "CMakeFiles/common.dir/src/common/clock.c.o" "gcc" "CMakeFiles/common.dir/src/common/clock.c.o.d"
+  "/root/repo/board/src/common/event_loop.c" "CMakeFiles/common.dir/src/common/event_loop.c.o" "gcc" "CMakeFiles/common.dir/src/common/event_loop.c.o.d"
+  "/root/repo/board/src/common/logging.c" "CMakeFiles/common.dir/src/common/logging.c.o" "gcc" "CMakeFiles/common.dir/src/common/logging.c.o.d"
+  "/root/repo/board/src/common/rt_profile.c" "CMakeFiles/common.dir/src/common/rt_profile.c.o" "gcc" "CMakeFiles/common.dir/src/common/rt_profile.c.o.d"
+  "/root/repo/board/src/common/trace.c" "CMakeFiles/common.dir/src/common/trace.c.o" "gcc" "CMakeFiles/common.dir/src/common/trace.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/common.dir/src/common/async_writer.c.o"
+  "CMakeFiles/common.dir/src/common/async_writer.c.o.d"
+  "CMakeFiles/common.dir/src/common/clock.c.o"
+  "CMakeFiles/common.dir/src/common/clock.c.o.d"
+  "CMakeFiles/common.dir/src/common/event_loop.c.o"
+  "CMakeFiles/common.dir/src/common/event_loop.c.o.d"
+  "CMakeFiles/common.dir/src/common/logging.c.o"
+  "CMakeFiles/common.dir/src/common/logging.c.o.d"
+  "CMakeFiles/common.dir/src/common/rt_profile.c.o"
+  "CMakeFiles/common.dir/src/common/rt_profile.c.o.d"
+  "CMakeFiles/common.dir/src/common/trace.c.o"
+  "CMakeFiles/common.dir/src/common/trace.c.o.d"
+  "libcommon.a"
+  "libcommon.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/common.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
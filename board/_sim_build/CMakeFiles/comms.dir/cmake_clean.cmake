@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/comms.dir/src/comms/telemetry.cpp.o"
+  "CMakeFiles/comms.dir/src/comms/telemetry.cpp.o.d"
+  "libcomms.a"
+  "libcomms.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/comms.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/board/src/dsp/ice_thickness.cpp" "CMakeFiles/dsp.dir/src/dsp/ice_thickness.cpp.o" "gcc" "CMakeFiles/dsp.dir/src/dsp/ice_thickness.cpp.o.d"
+  "/root/repo/board/src/dsp/radar_fft.cpp" "CMakeFiles/dsp.dir/src/dsp/radar_fft.cpp.o" "gcc" "CMakeFiles/dsp.dir/src/dsp/radar_fft.cpp.o.d"
+  "/root/repo/board/src/dsp/spectrum_stack.cpp" "CMakeFiles/dsp.dir/src/dsp/spectrum_stack.cpp.o" "gcc" "CMakeFiles/dsp.dir/src/dsp/spectrum_stack.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dsp.dir/src/dsp/ice_thickness.cpp.o"
+  "CMakeFiles/dsp.dir/src/dsp/ice_thickness.cpp.o.d"
+  "CMakeFiles/dsp.dir/src/dsp/radar_fft.cpp.o"
+  "CMakeFiles/dsp.dir/src/dsp/radar_fft.cpp.o.d"
+  "CMakeFiles/dsp.dir/src/dsp/spectrum_stack.cpp.o"
+  "CMakeFiles/dsp.dir/src/dsp/spectrum_stack.cpp.o.d"
+  "libdsp.a"
+  "libdsp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dsp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/board/src/nav/coverage_grid.cpp" "CMakeFiles/nav.dir/src/nav/coverage_grid.cpp.o" "gcc" "CMakeFiles/nav.dir/src/nav/coverage_grid.cpp.o.d"
+  "/root/repo/board/src/nav/motion_estimator.cpp" "CMakeFiles/nav.dir/src/nav/motion_estimator.cpp.o" "gcc" "CMakeFiles/nav.dir/src/nav/motion_estimator.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
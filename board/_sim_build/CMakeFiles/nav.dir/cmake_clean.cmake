@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nav.dir/src/nav/coverage_grid.cpp.o"
+  "CMakeFiles/nav.dir/src/nav/coverage_grid.cpp.o.d"
+  "CMakeFiles/nav.dir/src/nav/motion_estimator.cpp.o"
+  "CMakeFiles/nav.dir/src/nav/motion_estimator.cpp.o.d"
+  "libnav.a"
+  "libnav.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nav.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/snow_angel_ingest.dir/tools/ingest/ingest.cpp.o"
+  "CMakeFiles/snow_angel_ingest.dir/tools/ingest/ingest.cpp.o.d"
+  "snow_angel_ingest"
+  "snow_angel_ingest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/snow_angel_ingest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
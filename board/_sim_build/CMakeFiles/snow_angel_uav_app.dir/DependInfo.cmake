@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/board/src/app/board_fsm.cpp" "CMakeFiles/snow_angel_uav_app.dir/src/app/board_fsm.cpp.o" "gcc" "CMakeFiles/snow_angel_uav_app.dir/src/app/board_fsm.cpp.o.d"
+  "/root/repo/board/src/app/main.cpp" "CMakeFiles/snow_angel_uav_app.dir/src/app/main.cpp.o" "gcc" "CMakeFiles/snow_angel_uav_app.dir/src/app/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/board/_sim_build/CMakeFiles/bsp.dir/DependInfo.cmake"
+  "/root/repo/board/_sim_build/CMakeFiles/dsp.dir/DependInfo.cmake"
+  "/root/repo/board/_sim_build/CMakeFiles/nav.dir/DependInfo.cmake"
+  "/root/repo/board/_sim_build/CMakeFiles/storage.dir/DependInfo.cmake"
+  "/root/repo/board/_sim_build/CMakeFiles/comms.dir/DependInfo.cmake"
+  "/root/repo/board/_sim_build/CMakeFiles/common.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/snow_angel_uav_app.dir/src/app/board_fsm.cpp.o"
+  "CMakeFiles/snow_angel_uav_app.dir/src/app/board_fsm.cpp.o.d"
+  "CMakeFiles/snow_angel_uav_app.dir/src/app/main.cpp.o"
+  "CMakeFiles/snow_angel_uav_app.dir/src/app/main.cpp.o.d"
+  "snow_angel_uav_app"
+  "snow_angel_uav_app.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/snow_angel_uav_app.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/board/src/storage/flight_csv.cpp" "CMakeFiles/storage.dir/src/storage/flight_csv.cpp.o" "gcc" "CMakeFiles/storage.dir/src/storage/flight_csv.cpp.o.d"
+  "/root/repo/board/src/storage/flight_log.cpp" "CMakeFiles/storage.dir/src/storage/flight_log.cpp.o" "gcc" "CMakeFiles/storage.dir/src/storage/flight_log.cpp.o.d"
+  "/root/repo/board/src/storage/spectrum_codec.cpp" "CMakeFiles/storage.dir/src/storage/spectrum_codec.cpp.o" "gcc" "CMakeFiles/storage.dir/src/storage/spectrum_codec.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/board/_sim_build/CMakeFiles/bsp.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/storage.dir/src/storage/flight_csv.cpp.o"
+  "CMakeFiles/storage.dir/src/storage/flight_csv.cpp.o.d"
+  "CMakeFiles/storage.dir/src/storage/flight_log.cpp.o"
+  "CMakeFiles/storage.dir/src/storage/flight_log.cpp.o.d"
+  "CMakeFiles/storage.dir/src/storage/spectrum_codec.cpp.o"
+  "CMakeFiles/storage.dir/src/storage/spectrum_codec.cpp.o.d"
+  "libstorage.a"
+  "libstorage.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/storage.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
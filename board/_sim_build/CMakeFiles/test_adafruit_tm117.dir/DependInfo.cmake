@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/board/unittest/test_adafruit_tm117.cpp" "CMakeFiles/test_adafruit_tm117.dir/unittest/test_adafruit_tm117.cpp.o" "gcc" "CMakeFiles/test_adafruit_tm117.dir/unittest/test_adafruit_tm117.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/board/_sim_build/CMakeFiles/bsp.dir/DependInfo.cmake"
+  "/root/repo/board/_sim_build/CMakeFiles/dsp.dir/DependInfo.cmake"
+  "/root/repo/board/_sim_build/CMakeFiles/nav.dir/DependInfo.cmake"
+  "/root/repo/board/_sim_build/CMakeFiles/storage.dir/DependInfo.cmake"
+  "/root/repo/board/_sim_build/CMakeFiles/comms.dir/DependInfo.cmake"
+  "/root/repo/board/_sim_build/CMakeFiles/common.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_adafruit_tm117.dir/unittest/test_adafruit_tm117.cpp.o"
+  "CMakeFiles/test_adafruit_tm117.dir/unittest/test_adafruit_tm117.cpp.o.d"
+  "test_adafruit_tm117"
+  "test_adafruit_tm117.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_adafruit_tm117.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
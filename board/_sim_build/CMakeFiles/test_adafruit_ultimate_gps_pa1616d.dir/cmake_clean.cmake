@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_adafruit_ultimate_gps_pa1616d.dir/unittest/test_adafruit_ultimate_gps_pa1616d.cpp.o"
+  "CMakeFiles/test_adafruit_ultimate_gps_pa1616d.dir/unittest/test_adafruit_ultimate_gps_pa1616d.cpp.o.d"
+  "test_adafruit_ultimate_gps_pa1616d"
+  "test_adafruit_ultimate_gps_pa1616d.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_adafruit_ultimate_gps_pa1616d.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_async_writer.dir/unittest/test_async_writer.cpp.o"
+  "CMakeFiles/test_async_writer.dir/unittest/test_async_writer.cpp.o.d"
+  "test_async_writer"
+  "test_async_writer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_async_writer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_coverage_grid.dir/unittest/test_coverage_grid.cpp.o"
+  "CMakeFiles/test_coverage_grid.dir/unittest/test_coverage_grid.cpp.o.d"
+  "test_coverage_grid"
+  "test_coverage_grid.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_coverage_grid.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_flight_csv.dir/unittest/test_flight_csv.cpp.o"
+  "CMakeFiles/test_flight_csv.dir/unittest/test_flight_csv.cpp.o.d"
+  "test_flight_csv"
+  "test_flight_csv.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_flight_csv.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_flight_log.dir/unittest/test_flight_log.cpp.o"
+  "CMakeFiles/test_flight_log.dir/unittest/test_flight_log.cpp.o.d"
+  "test_flight_log"
+  "test_flight_log.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_flight_log.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_flight_replay.dir/unittest/test_flight_replay.cpp.o"
+  "CMakeFiles/test_flight_replay.dir/unittest/test_flight_replay.cpp.o.d"
+  "test_flight_replay"
+  "test_flight_replay.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_flight_replay.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
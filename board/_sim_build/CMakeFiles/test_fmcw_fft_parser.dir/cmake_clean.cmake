@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_fmcw_fft_parser.dir/unittest/test_fmcw_fft_parser.cpp.o"
+  "CMakeFiles/test_fmcw_fft_parser.dir/unittest/test_fmcw_fft_parser.cpp.o.d"
+  "test_fmcw_fft_parser"
+  "test_fmcw_fft_parser.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_fmcw_fft_parser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_gps_position_hint.dir/unittest/test_gps_position_hint.cpp.o"
+  "CMakeFiles/test_gps_position_hint.dir/unittest/test_gps_position_hint.cpp.o.d"
+  "test_gps_position_hint"
+  "test_gps_position_hint.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_gps_position_hint.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
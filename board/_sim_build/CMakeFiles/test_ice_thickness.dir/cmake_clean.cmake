@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_ice_thickness.dir/unittest/test_ice_thickness.cpp.o"
+  "CMakeFiles/test_ice_thickness.dir/unittest/test_ice_thickness.cpp.o.d"
+  "test_ice_thickness"
+  "test_ice_thickness.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_ice_thickness.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_motion_estimator.dir/unittest/test_motion_estimator.cpp.o"
+  "CMakeFiles/test_motion_estimator.dir/unittest/test_motion_estimator.cpp.o.d"
+  "test_motion_estimator"
+  "test_motion_estimator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_motion_estimator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_nmea_parser.dir/unittest/test_nmea_parser.cpp.o"
+  "CMakeFiles/test_nmea_parser.dir/unittest/test_nmea_parser.cpp.o.d"
+  "test_nmea_parser"
+  "test_nmea_parser.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_nmea_parser.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
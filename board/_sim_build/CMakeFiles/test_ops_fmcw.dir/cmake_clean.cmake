@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_ops_fmcw.dir/unittest/test_ops_fmcw.cpp.o"
+  "CMakeFiles/test_ops_fmcw.dir/unittest/test_ops_fmcw.cpp.o.d"
+  "test_ops_fmcw"
+  "test_ops_fmcw.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_ops_fmcw.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_radar_command_sequencer.dir/unittest/test_radar_command_sequencer.cpp.o"
+  "CMakeFiles/test_radar_command_sequencer.dir/unittest/test_radar_command_sequencer.cpp.o.d"
+  "test_radar_command_sequencer"
+  "test_radar_command_sequencer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_radar_command_sequencer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
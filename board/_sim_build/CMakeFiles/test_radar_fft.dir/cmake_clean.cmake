@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_radar_fft.dir/unittest/test_radar_fft.cpp.o"
+  "CMakeFiles/test_radar_fft.dir/unittest/test_radar_fft.cpp.o.d"
+  "test_radar_fft"
+  "test_radar_fft.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_radar_fft.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
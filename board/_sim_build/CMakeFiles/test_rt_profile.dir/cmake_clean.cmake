@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_rt_profile.dir/unittest/test_rt_profile.cpp.o"
+  "CMakeFiles/test_rt_profile.dir/unittest/test_rt_profile.cpp.o.d"
+  "test_rt_profile"
+  "test_rt_profile.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_rt_profile.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
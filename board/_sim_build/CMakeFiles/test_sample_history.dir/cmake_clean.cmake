@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sample_history.dir/unittest/test_sample_history.cpp.o"
+  "CMakeFiles/test_sample_history.dir/unittest/test_sample_history.cpp.o.d"
+  "test_sample_history"
+  "test_sample_history.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sample_history.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
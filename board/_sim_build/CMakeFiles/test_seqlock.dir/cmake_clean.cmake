@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_seqlock.dir/unittest/test_seqlock.cpp.o"
+  "CMakeFiles/test_seqlock.dir/unittest/test_seqlock.cpp.o.d"
+  "test_seqlock"
+  "test_seqlock.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_seqlock.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
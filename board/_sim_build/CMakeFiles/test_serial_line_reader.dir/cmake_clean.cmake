@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_serial_line_reader.dir/unittest/test_serial_line_reader.cpp.o"
+  "CMakeFiles/test_serial_line_reader.dir/unittest/test_serial_line_reader.cpp.o.d"
+  "test_serial_line_reader"
+  "test_serial_line_reader.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_serial_line_reader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
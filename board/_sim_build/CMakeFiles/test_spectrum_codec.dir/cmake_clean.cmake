@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_spectrum_codec.dir/unittest/test_spectrum_codec.cpp.o"
+  "CMakeFiles/test_spectrum_codec.dir/unittest/test_spectrum_codec.cpp.o.d"
+  "test_spectrum_codec"
+  "test_spectrum_codec.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_spectrum_codec.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_spectrum_stack.dir/unittest/test_spectrum_stack.cpp.o"
+  "CMakeFiles/test_spectrum_stack.dir/unittest/test_spectrum_stack.cpp.o.d"
+  "test_spectrum_stack"
+  "test_spectrum_stack.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_spectrum_stack.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,60 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/board
+# Build directory: /root/repo/board/_sim_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test_adafruit_tm117 "/root/repo/board/_sim_build/test_adafruit_tm117")
+set_tests_properties(test_adafruit_tm117 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_adafruit_ultimate_gps_pa1616d "/root/repo/board/_sim_build/test_adafruit_ultimate_gps_pa1616d")
+set_tests_properties(test_adafruit_ultimate_gps_pa1616d PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_async_writer "/root/repo/board/_sim_build/test_async_writer")
+set_tests_properties(test_async_writer PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_coverage_grid "/root/repo/board/_sim_build/test_coverage_grid")
+set_tests_properties(test_coverage_grid PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_event_loop "/root/repo/board/_sim_build/test_event_loop")
+set_tests_properties(test_event_loop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_flight_csv "/root/repo/board/_sim_build/test_flight_csv")
+set_tests_properties(test_flight_csv PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_flight_log "/root/repo/board/_sim_build/test_flight_log")
+set_tests_properties(test_flight_log PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_flight_replay "/root/repo/board/_sim_build/test_flight_replay")
+set_tests_properties(test_flight_replay PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_fmcw_fft_parser "/root/repo/board/_sim_build/test_fmcw_fft_parser")
+set_tests_properties(test_fmcw_fft_parser PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_frame_pool "/root/repo/board/_sim_build/test_frame_pool")
+set_tests_properties(test_frame_pool PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_gps_position_hint "/root/repo/board/_sim_build/test_gps_position_hint")
+set_tests_properties(test_gps_position_hint PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_ice_thickness "/root/repo/board/_sim_build/test_ice_thickness")
+set_tests_properties(test_ice_thickness PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_logging "/root/repo/board/_sim_build/test_logging")
+set_tests_properties(test_logging PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_motion_estimator "/root/repo/board/_sim_build/test_motion_estimator")
+set_tests_properties(test_motion_estimator PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_nmea_parser "/root/repo/board/_sim_build/test_nmea_parser")
+set_tests_properties(test_nmea_parser PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_ops_fmcw "/root/repo/board/_sim_build/test_ops_fmcw")
+set_tests_properties(test_ops_fmcw PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_radar_command_sequencer "/root/repo/board/_sim_build/test_radar_command_sequencer")
+set_tests_properties(test_radar_command_sequencer PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_radar_fft "/root/repo/board/_sim_build/test_radar_fft")
+set_tests_properties(test_radar_fft PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_rt_profile "/root/repo/board/_sim_build/test_rt_profile")
+set_tests_properties(test_rt_profile PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_sample_history "/root/repo/board/_sim_build/test_sample_history")
+set_tests_properties(test_sample_history PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_seqlock "/root/repo/board/_sim_build/test_seqlock")
+set_tests_properties(test_seqlock PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_serial_line_reader "/root/repo/board/_sim_build/test_serial_line_reader")
+set_tests_properties(test_serial_line_reader PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_spectrum_codec "/root/repo/board/_sim_build/test_spectrum_codec")
+set_tests_properties(test_spectrum_codec PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_spectrum_stack "/root/repo/board/_sim_build/test_spectrum_stack")
+set_tests_properties(test_spectrum_stack PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_spsc_queue "/root/repo/board/_sim_build/test_spsc_queue")
+set_tests_properties(test_spsc_queue PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_telemetry "/root/repo/board/_sim_build/test_telemetry")
+set_tests_properties(test_telemetry PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
+add_test(test_trace "/root/repo/board/_sim_build/test_trace")
+set_tests_properties(test_trace PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/board/CMakeLists.txt;143;add_test;/root/repo/board/CMakeLists.txt;0;")
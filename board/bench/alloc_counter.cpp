@@ -0,0 +1,61 @@
+/**
+ * Name: alloc_counter.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the heap allocation counters described in alloc_counter.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "alloc_counter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> allocations(0);
+static std::atomic<uint64_t> allocated_bytes(0);
+
+void *operator new(size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+	void *ptr = malloc(size ? size : 1);
+	if (ptr == nullptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void *operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+alloc_count_t alloc_counter_read()
+{
+	alloc_count_t count;
+	count.allocations = allocations.load(std::memory_order_relaxed);
+	count.bytes = allocated_bytes.load(std::memory_order_relaxed);
+	return count;
+}
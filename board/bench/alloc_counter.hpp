@@ -0,0 +1,29 @@
+/**
+ * Name: alloc_counter.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes the heap allocation counters of the benchmarks. Linking alloc_counter.cpp
+ * replaces the global operator new, so every C++ allocation in the process is counted.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+typedef struct alloc_count
+{
+	uint64_t allocations;
+	uint64_t bytes;
+} alloc_count_t;
+
+/**
+ * @return The allocations made so far, subtract two of these to count a section of code.
+ */
+alloc_count_t alloc_counter_read();
+
+#endif // #ifndef ALLOC_COUNTER_H
@@ -0,0 +1,442 @@
+/**
+ * Name: bench_micro.cpp
+ * Author: Hubert Dang
+ *
+ * Microbenchmarks of the hot parsers and DSP kernels on fixed corpora: the radar frame in
+ * sim/, the pretty printed radar frame in scripts/radar_data.json and a 10 Hz NMEA epoch.
+ * Each benchmark is calibrated to run for at least BENCH_MIN_RUN_NSEC, the fastest of
+ * BENCH_REPEATS runs is reported. Results are printed as one JSON document, to compare runs
+ * over time and between x86 dev boxes and the Pi.
+ *
+ * Usage: ./bench_micro [name filter]
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "alloc_counter.hpp"
+#include "bsp/fmcw_radar_sensor.hpp"
+#include "bsp/nmea_parser.hpp"
+#include "common/clock.h"
+#include "dsp/ice_thickness.hpp"
+#include "dsp/spectrum_stack.hpp"
+#include "nav/motion_estimator.hpp"
+#include "storage/flight_log.hpp"
+#include "storage/spectrum_codec.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <sys/utsname.h>
+
+#define BENCH_MIN_RUN_NSEC 50000000ULL // 50 ms
+#define BENCH_REPEATS 5
+#define BENCH_STACK_FRAMES 20 // a stop's worth
+#define BENCH_TRACK_FIXES 600 // a minute of 10 Hz fixes
+
+#define SIM_FFT_PATH BENCH_CORPUS_DIR "/sim/radar_ice_fft_data.sim"
+#define RADAR_JSON_PATH BENCH_CORPUS_DIR "/scripts/radar_data.json"
+
+/* Keeps the compiler from optimizing away a result nothing reads. */
+template <typename T>
+static inline void keep(const T &value)
+{
+	asm volatile("" : : "r"(&value) : "memory");
+}
+
+/* Fixed inputs, built once before anything is measured */
+struct corpus
+{
+	std::string sim_fft;       // the comma separated magnitudes of a frame
+	std::string pretty_fft;    // the same for radar_data.json, with its newlines and indents
+	std::string json_line;     // radar_data.json as the radar streams it, one line
+	std::string nmea_epoch[4]; // RMC, VTG, GGA and GSA of one fix
+	fmcw_fft_frame_t frames[BENCH_STACK_FRAMES];
+	const fmcw_fft_frame_t *frame_ptrs[BENCH_STACK_FRAMES];
+	double track[BENCH_TRACK_FIXES][2]; // latitude, longitude
+	flight_log_record_t record;
+	uint8_t delta[SPECTRUM_CODEC_MAX_SIZE(FMCW_RADAR_FFT_SIZE)];    // frames[1] against frames[0]
+	uint8_t keyframe[SPECTRUM_CODEC_MAX_SIZE(FMCW_RADAR_FFT_SIZE)]; // frames[1] on its own
+	size_t delta_size;
+	size_t keyframe_size;
+
+	// input sizes, for reporting throughput
+	size_t sim_fft_bytes;
+	size_t pretty_fft_bytes;
+	size_t json_line_bytes;
+	size_t gga_bytes;
+	size_t epoch_bytes;
+};
+
+static corpus data;
+
+typedef void (*bench_fn)(size_t iterations);
+
+struct bench_case
+{
+	const char *name;
+	bench_fn run;
+	const size_t *bytes_per_op; // input bytes, nullptr if throughput does not make sense
+};
+
+//------------------------------ Benchmarks -------------------------------
+static void bench_fft_extract(size_t iterations)
+{
+	std::string_view fft;
+	for (size_t i = 0; i < iterations; i++)
+	{
+		fmcw_radar_extract_fft(data.json_line, &fft);
+		keep(fft);
+	}
+}
+
+static void bench_fft_parse_bins(size_t iterations)
+{
+	uint16_t bins[FMCW_RADAR_FFT_SIZE];
+	for (size_t i = 0; i < iterations; i++)
+	{
+		int n = fmcw_radar_parse_fft_bins(data.sim_fft.data(), data.sim_fft.size(), bins,
+		                                  FMCW_RADAR_FFT_SIZE);
+		keep(n);
+		keep(bins);
+	}
+}
+
+static void bench_fft_parse_pretty(size_t iterations)
+{
+	uint16_t bins[FMCW_RADAR_FFT_SIZE];
+	for (size_t i = 0; i < iterations; i++)
+	{
+		int n = fmcw_radar_parse_fft_bins(data.pretty_fft.data(), data.pretty_fft.size(), bins,
+		                                  FMCW_RADAR_FFT_SIZE);
+		keep(n);
+		keep(bins);
+	}
+}
+
+static void bench_fft_line_to_frame(size_t iterations)
+{
+	fmcw_fft_frame_t frame;
+	for (size_t i = 0; i < iterations; i++)
+	{
+		std::string_view fft;
+		fmcw_radar_extract_fft(data.json_line, &fft);
+		int n = fmcw_radar_parse_fft_bins(fft.data(), fft.size(), frame.bins, FMCW_RADAR_FFT_SIZE);
+		frame.num_bins = static_cast<uint16_t>(n);
+		keep(frame);
+	}
+}
+
+static void bench_nmea_tokenize(size_t iterations)
+{
+	nmea_fields_t fields;
+	for (size_t i = 0; i < iterations; i++)
+	{
+		int8_t rc = nmea_tokenize(data.nmea_epoch[2], &fields);
+		keep(rc);
+		keep(fields);
+	}
+}
+
+static void bench_nmea_parse_epoch(size_t iterations)
+{
+	nmea_fix_t fix = {};
+	for (size_t i = 0; i < iterations; i++)
+	{
+		for (const std::string &sentence : data.nmea_epoch)
+			keep(nmea_parse_sentence(sentence, &fix));
+		keep(fix);
+	}
+}
+
+static void bench_enu_project(size_t iterations)
+{
+	enu_origin_t origin;
+	enu_origin_init(&origin, data.track[0][0], data.track[0][1]);
+	for (size_t i = 0; i < iterations; i++)
+	{
+		const double *fix = data.track[i % BENCH_TRACK_FIXES];
+		double east_m, north_m;
+		enu_project(&origin, fix[0], fix[1], &east_m, &north_m);
+		keep(east_m);
+		keep(north_m);
+	}
+}
+
+static void bench_motion_update(size_t iterations)
+{
+	// the board's MOTION_CONFIG
+	static const motion_estimator_config_t config = {0.4,    0.05,   0.7,    1.5,
+	                                                 500000, 300000, 1000000};
+	motion_estimator_t estimator;
+	motion_estimator_init(&estimator, &config);
+	for (size_t i = 0; i < iterations; i++)
+	{
+		const double *fix = data.track[i % BENCH_TRACK_FIXES];
+		keep(motion_estimator_update(&estimator, fix[0], fix[1], i * 100000ULL));
+	}
+}
+
+static void bench_flight_log_make_record(size_t iterations)
+{
+	flight_log_record_t record;
+	for (size_t i = 0; i < iterations; i++)
+	{
+		flight_log_make_record(45.3848, -75.7047, -12.4, &data.frames[0], &record);
+		record.crc = flight_log_crc32(&record, offsetof(flight_log_record_t, crc));
+		keep(record);
+	}
+}
+
+static void bench_flight_log_record_valid(size_t iterations)
+{
+	for (size_t i = 0; i < iterations; i++)
+		keep(flight_log_record_valid(&data.record));
+}
+
+static void bench_spectrum_encode(size_t iterations)
+{
+	static uint8_t out[SPECTRUM_CODEC_MAX_SIZE(FMCW_RADAR_FFT_SIZE)];
+	for (size_t i = 0; i < iterations; i++)
+	{
+		keep(spectrum_encode(data.frames[1].bins, data.frames[0].bins, FMCW_RADAR_FFT_SIZE, out,
+		                     sizeof(out)));
+		keep(out);
+	}
+}
+
+static void bench_spectrum_decode(size_t iterations)
+{
+	static uint16_t bins[FMCW_RADAR_FFT_SIZE];
+	for (size_t i = 0; i < iterations; i++)
+	{
+		keep(spectrum_decode(data.delta, data.delta_size, data.frames[0].bins,
+		                     FMCW_RADAR_FFT_SIZE, bins));
+		keep(bins);
+	}
+}
+
+static void bench_spectrum_decode_keyframe(size_t iterations)
+{
+	static uint16_t bins[FMCW_RADAR_FFT_SIZE];
+	for (size_t i = 0; i < iterations; i++)
+	{
+		keep(spectrum_decode(data.keyframe, data.keyframe_size, nullptr, FMCW_RADAR_FFT_SIZE,
+		                     bins));
+		keep(bins);
+	}
+}
+
+static void bench_spectrum_stack(size_t iterations)
+{
+	static spectrum_stack_result_t result;
+	for (size_t i = 0; i < iterations; i++)
+	{
+		spectrum_stack(data.frame_ptrs, BENCH_STACK_FRAMES, &result);
+		keep(result);
+	}
+}
+
+static void bench_ice_thickness_estimate(size_t iterations)
+{
+	ice_thickness_estimate_t estimate;
+	for (size_t i = 0; i < iterations; i++)
+	{
+		ice_thickness_estimate(data.frames[0].bins, FMCW_RADAR_FFT_SIZE, &estimate);
+		keep(estimate);
+	}
+}
+
+static const size_t RECORD_BYTES = sizeof(flight_log_record_t);
+static const size_t FRAME_BYTES = sizeof(uint16_t) * FMCW_RADAR_FFT_SIZE;
+static const size_t STACK_BYTES = BENCH_STACK_FRAMES * FRAME_BYTES;
+
+static const bench_case BENCHMARKS[] = {
+    {"fft_extract", bench_fft_extract, &data.json_line_bytes},
+    {"fft_parse_bins", bench_fft_parse_bins, &data.sim_fft_bytes},
+    {"fft_parse_pretty", bench_fft_parse_pretty, &data.pretty_fft_bytes},
+    {"fft_line_to_frame", bench_fft_line_to_frame, &data.json_line_bytes},
+    {"nmea_tokenize_gga", bench_nmea_tokenize, &data.gga_bytes},
+    {"nmea_parse_epoch", bench_nmea_parse_epoch, &data.epoch_bytes},
+    {"enu_project", bench_enu_project, nullptr},
+    {"motion_estimator_update", bench_motion_update, nullptr},
+    {"flight_log_make_record", bench_flight_log_make_record, &RECORD_BYTES},
+    {"flight_log_record_valid", bench_flight_log_record_valid, &RECORD_BYTES},
+    {"spectrum_encode", bench_spectrum_encode, &FRAME_BYTES},
+    {"spectrum_decode", bench_spectrum_decode, &FRAME_BYTES},
+    {"spectrum_decode_keyframe", bench_spectrum_decode_keyframe, &FRAME_BYTES},
+    {"spectrum_stack_20", bench_spectrum_stack, &STACK_BYTES},
+    {"ice_thickness_estimate", bench_ice_thickness_estimate, &FRAME_BYTES},
+};
+
+//------------------------------ Corpus -------------------------------
+static bool read_file(const char *path, std::string *contents)
+{
+	std::ifstream file(path);
+	if (!file.is_open())
+	{
+		fprintf(stderr, "Failed to open corpus %s\n", path);
+		return false;
+	}
+	contents->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return true;
+}
+
+static std::string nmea_sentence(const char *body)
+{
+	char checksum[4];
+	snprintf(checksum, sizeof(checksum), "*%02X", nmea_checksum(body));
+	return std::string("$") + body + checksum;
+}
+
+static bool load_corpus()
+{
+	std::string pretty;
+	if (!read_file(SIM_FFT_PATH, &data.sim_fft) || !read_file(RADAR_JSON_PATH, &pretty))
+		return false;
+	while (!data.sim_fft.empty() && (data.sim_fft.back() == '\n' || data.sim_fft.back() == '\r'))
+		data.sim_fft.pop_back();
+
+	size_t open = pretty.find('[');
+	size_t close = pretty.find(']', open);
+	if (open == std::string::npos || close == std::string::npos)
+		return false;
+	data.pretty_fft = pretty.substr(open + 1, close - open - 1);
+
+	data.json_line = "{\"FFT\":[";
+	for (char ch : data.pretty_fft)
+	{
+		if (ch != ' ' && ch != '\n' && ch != '\r' && ch != '\t')
+			data.json_line += ch;
+	}
+	data.json_line += "]}";
+
+	data.nmea_epoch[0] =
+	    nmea_sentence("GNRMC,150000.000,A,4523.0880,N,07542.2819,W,0.45,83.20,201125,,,A");
+	data.nmea_epoch[1] = nmea_sentence("GNVTG,83.20,T,,M,0.45,N,0.83,K,A");
+	data.nmea_epoch[2] =
+	    nmea_sentence("GNGGA,150000.000,4523.0880,N,07542.2819,W,1,10,0.90,97.1,M,-34.2,M,,");
+	data.nmea_epoch[3] = nmea_sentence("GNGSA,A,3,10,16,18,20,26,27,,,,,,,1.52,0.90,1.22");
+
+	// the sim frame with a deterministic ripple, so the stack has something to average
+	uint16_t bins[FMCW_RADAR_FFT_SIZE];
+	if (fmcw_radar_parse_fft_bins(data.sim_fft.data(), data.sim_fft.size(), bins,
+	                              FMCW_RADAR_FFT_SIZE) != FMCW_RADAR_FFT_SIZE)
+		return false;
+	for (int f = 0; f < BENCH_STACK_FRAMES; f++)
+	{
+		fmcw_fft_frame_t &frame = data.frames[f];
+		frame = {};
+		frame.sequence = f;
+		frame.num_bins = FMCW_RADAR_FFT_SIZE;
+		for (int b = 0; b < FMCW_RADAR_FFT_SIZE; b++)
+			frame.bins[b] = static_cast<uint16_t>(bins[b] + (b * 7 + f * 13) % 23);
+		data.frame_ptrs[f] = &frame;
+	}
+
+	// a drone flying north at 4 m/s
+	for (int i = 0; i < BENCH_TRACK_FIXES; i++)
+	{
+		data.track[i][0] = 45.3848 + i * 0.4 / 111132.954;
+		data.track[i][1] = -75.7047;
+	}
+
+	flight_log_make_record(45.3848, -75.7047, -12.4, &data.frames[0], &data.record);
+	data.record.crc = flight_log_crc32(&data.record, offsetof(flight_log_record_t, crc));
+
+	data.delta_size = spectrum_encode(data.frames[1].bins, data.frames[0].bins,
+	                                  FMCW_RADAR_FFT_SIZE, data.delta, sizeof(data.delta));
+	data.keyframe_size = spectrum_encode(data.frames[1].bins, nullptr, FMCW_RADAR_FFT_SIZE,
+	                                     data.keyframe, sizeof(data.keyframe));
+
+	data.sim_fft_bytes = data.sim_fft.size();
+	data.pretty_fft_bytes = data.pretty_fft.size();
+	data.json_line_bytes = data.json_line.size();
+	data.gga_bytes = data.nmea_epoch[2].size();
+	data.epoch_bytes = 0;
+	for (const std::string &sentence : data.nmea_epoch)
+		data.epoch_bytes += sentence.size();
+	return true;
+}
+
+//------------------------------ Harness -------------------------------
+static uint64_t time_run(bench_fn run, size_t iterations)
+{
+	uint64_t start_nsec = clock_monotonic_nsec();
+	run(iterations);
+	return clock_monotonic_nsec() - start_nsec;
+}
+
+static void run_case(const bench_case &bench, bool first)
+{
+	// double the iterations until one run is long enough to time
+	size_t iterations = 1;
+	bench.run(iterations); // warm the caches
+	while (time_run(bench.run, iterations) < BENCH_MIN_RUN_NSEC && iterations < (1ULL << 40))
+		iterations *= 2;
+
+	uint64_t best_nsec = UINT64_MAX;
+	alloc_count_t before = alloc_counter_read();
+	for (int r = 0; r < BENCH_REPEATS; r++)
+	{
+		uint64_t nsec = time_run(bench.run, iterations);
+		if (nsec < best_nsec)
+			best_nsec = nsec;
+	}
+	alloc_count_t after = alloc_counter_read();
+
+	double ops = static_cast<double>(iterations) * BENCH_REPEATS;
+	double ns_per_op = static_cast<double>(best_nsec) / iterations;
+	printf("%s\n    {\"name\": \"%s\", \"iterations\": %zu, \"ns_per_op\": %.2f, "
+	       "\"allocs_per_op\": %.3f, \"bytes_allocated_per_op\": %.1f",
+	       first ? "" : ",", bench.name, iterations, ns_per_op,
+	       (after.allocations - before.allocations) / ops, (after.bytes - before.bytes) / ops);
+	if (bench.bytes_per_op != nullptr)
+		printf(", \"bytes_per_op\": %zu, \"mb_per_sec\": %.1f", *bench.bytes_per_op,
+		       *bench.bytes_per_op * 1e3 / ns_per_op);
+	printf("}");
+	fflush(stdout);
+}
+
+int main(int argc, char **argv)
+{
+	const char *filter = argc > 1 ? argv[1] : nullptr;
+
+	if (!load_corpus())
+		return 1;
+
+	struct utsname host;
+	uname(&host);
+#if defined(__clang__)
+	const char *compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+	const char *compiler = "gcc " __VERSION__;
+#else
+	const char *compiler = "unknown";
+#endif
+#ifdef __OPTIMIZE__
+	bool optimized = true;
+#else
+	bool optimized = false;
+#endif
+
+	printf("{\n  \"machine\": \"%s\",\n  \"kernel\": \"%s\",\n  \"compiler\": \"%s\",\n"
+	       "  \"optimized\": %s,\n  \"timestamp_usec\": %llu,\n  \"benchmarks\": [",
+	       host.machine, host.release, compiler, optimized ? "true" : "false",
+	       (unsigned long long)clock_realtime_usec());
+
+	bool first = true;
+	for (const bench_case &bench : BENCHMARKS)
+	{
+		if (filter != nullptr && strstr(bench.name, filter) == nullptr)
+			continue;
+
+		run_case(bench, first);
+		first = false;
+	}
+	printf("\n  ]\n}\n");
+	return 0;
+}
@@ -0,0 +1,248 @@
+/**
+ * Name: bench_pipeline.cpp
+ * Author: Hubert Dang
+ *
+ * Throughput benchmark of the radar pipeline. A flight replay is fed through the simulation
+ * drivers' real parse paths and every radar frame is joined with the nearest GPS fix and
+ * temperature, persisted to a flight log and estimated, like the board does while profiling
+ * a stop. Reports frames/sec, the latency of each traced stage and heap allocations.
+ *
+ * Usage: ./bench_pipeline <replay> [speed]
+ *        speed 0 (the default) replays as fast as the pipeline keeps up, 1 is real time.
+ *        See scripts/make_flight_replay.py for making a replay.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "alloc_counter.hpp"
+#include "bsp/flight_replay.hpp"
+#include "bsp/fmcw_radar_sensor.hpp"
+#include "bsp/gps.hpp"
+#include "bsp/temperature_sensor.hpp"
+#include "common/clock.h"
+#include "common/common.h"
+#include "common/event_loop.h"
+#include "common/sample_history.hpp"
+#include "common/trace.h"
+#include "dsp/ice_thickness.hpp"
+#include "dsp/spectrum_stack.hpp"
+#include "storage/flight_log.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BENCH_FRAMES_PER_STACK 20 // a stop's worth, MAX_RADAR_READS_PER_STOP in the FSM
+#define BENCH_IDLE_TIMEOUT_MS 1000 // the replay is over once nothing arrives for this long
+
+struct bench_state
+{
+	TEMPERATURE_SENSOR *temp_sensor;
+	FMCW_RADAR_SENSOR *radar;
+	GPS *gps;
+	FLIGHT_LOG_WRITER log;
+
+	SAMPLE_HISTORY<gps_data_t, 32> gps_history;
+	temp_sensor_data_t temperature;
+	fmcw_frame_handle_t frames[BENCH_FRAMES_PER_STACK];
+	const fmcw_fft_frame_t *stack_frames[BENCH_FRAMES_PER_STACK];
+	size_t num_stacked;
+
+	uint64_t frames_processed;
+	uint64_t estimates;
+	uint64_t stacks;
+	uint64_t errors;
+};
+
+static void on_gps_fix(void *ctx)
+{
+	bench_state *bench = static_cast<bench_state *>(ctx);
+	gps_data_t fixes[8];
+	int num_fixes;
+
+	event_fd_drain(bench->gps->gps_fix_event_fd());
+	do
+	{
+		num_fixes = bench->gps->gps_read_fixes(fixes, 8);
+		for (int i = 0; i < num_fixes; i++)
+			bench->gps_history.push(fixes[i].timestamp_usec, fixes[i]);
+	} while (num_fixes == 8);
+}
+
+static void process_frame(bench_state *bench, const fmcw_fft_frame_t &frame);
+
+static void on_radar_frame(void *ctx)
+{
+	bench_state *bench = static_cast<bench_state *>(ctx);
+	TRACE_SCOPE(TRACE_FSM_RADAR_FRAME);
+
+	event_fd_drain(bench->radar->fmcw_radar_sensor_frame_event_fd());
+	int num_frames = bench->radar->fmcw_radar_sensor_try_acquire_fft_frames(
+	    &bench->frames[bench->num_stacked], BENCH_FRAMES_PER_STACK - bench->num_stacked);
+	if (num_frames < 0)
+	{
+		bench->errors++;
+		return;
+	}
+
+	// keeps the previous sample until the sensor finishes its next conversion
+	if (bench->temp_sensor->temperature_sensor_try_read_samples(&bench->temperature, 1) < 0)
+		bench->errors++;
+
+	for (int i = 0; i < num_frames; i++)
+		process_frame(bench, *bench->frames[bench->num_stacked]);
+}
+
+static void process_frame(bench_state *bench, const fmcw_fft_frame_t &frame)
+{
+	gps_data_t fix = {};
+	bench->gps_history.nearest(frame.monotonic_usec, &fix);
+
+	{
+		TRACE_SCOPE(TRACE_PERSIST_RECORD);
+		flight_log_record_t record;
+		flight_log_make_record(fix.latitude, fix.longitude, bench->temperature.temperature,
+		                       &frame, &record);
+		if (bench->log.append(&record) != SUCCESS)
+			bench->errors++;
+	}
+
+	ice_thickness_estimate_t estimate;
+	uint64_t estimate_start_nsec = clock_monotonic_nsec();
+	if (ice_thickness_estimate(&frame, &estimate) == SUCCESS)
+		bench->estimates++;
+	trace_record(TRACE_ICE_ESTIMATE, clock_monotonic_nsec() - estimate_start_nsec);
+
+	bench->stack_frames[bench->num_stacked++] = &frame;
+	bench->frames_processed++;
+	if (bench->num_stacked == BENCH_FRAMES_PER_STACK)
+	{
+		TRACE_SCOPE(TRACE_FSM_FINISH_STOP);
+		spectrum_stack_result_t stack;
+		if (spectrum_stack(bench->stack_frames, bench->num_stacked, &stack) == SUCCESS &&
+		    ice_thickness_estimate(stack.mean, FMCW_RADAR_FFT_SIZE, &estimate) == SUCCESS)
+			bench->stacks++;
+		for (fmcw_frame_handle_t &stacked : bench->frames)
+			stacked.reset();
+		bench->num_stacked = 0;
+	}
+}
+
+static void print_stage(enum trace_point point)
+{
+	struct trace_stats stats;
+	trace_get_stats(point, &stats);
+	if (stats.count == 0)
+		return;
+
+	printf("  %-17s %8llu %10.1f %10.1f %10.1f %10.1f\n", trace_point_name(point),
+	       (unsigned long long)stats.count, stats.p50_nsec / 1e3, stats.p99_nsec / 1e3,
+	       stats.max_nsec / 1e3, stats.mean_nsec / 1e3);
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		printf("Usage: %s <replay> [speed]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	double speed = argc > 2 ? strtod(argv[2], nullptr) : 0.0;
+
+	// the drivers pick up the started replay from flight_replay_active()
+	FLIGHT_REPLAY *replay = FLIGHT_REPLAY::get_instance();
+	if (replay->open(argv[1]) != SUCCESS)
+		return EXIT_FAILURE;
+
+	static bench_state bench = {};
+	char log_path[] = "/tmp/bench_pipeline_XXXXXX";
+	int log_fd = mkstemp(log_path);
+	if (log_fd < 0)
+		return EXIT_FAILURE;
+	close(log_fd);
+	unlink(log_path); // the writer creates it
+	if (bench.log.open(log_path, 0, FLIGHT_LOG_PACKED) != SUCCESS)
+		return EXIT_FAILURE;
+
+	bench.temp_sensor = instantiate_temperature_sensor();
+	bench.radar = instantiate_fmcw_radar_sensor();
+	bench.gps = instantiate_gps();
+	if (replay->start(speed) != SUCCESS ||
+	    bench.temp_sensor->temperature_sensor_init() != SUCCESS ||
+	    bench.radar->fmcw_radar_sensor_init() != SUCCESS || bench.gps->gps_init() != SUCCESS)
+	{
+		printf("Failed to start the replay and drivers\n");
+		return EXIT_FAILURE;
+	}
+
+	struct event_loop *loop = event_loop_create();
+	if (loop == nullptr ||
+	    event_loop_add_fd(loop, bench.gps->gps_fix_event_fd(), on_gps_fix, &bench) != 0 ||
+	    event_loop_add_fd(loop, bench.radar->fmcw_radar_sensor_frame_event_fd(), on_radar_frame,
+	                      &bench) != 0)
+		return EXIT_FAILURE;
+
+	bench.radar->fmcw_radar_sensor_start_tx_signal();
+	bench.radar->fmcw_radar_sensor_start_streaming();
+
+	uint64_t start_usec = clock_monotonic_usec();
+	alloc_count_t start_allocations = alloc_counter_read();
+	uint64_t last_event_usec = start_usec;
+	while (true)
+	{
+		int rc = event_loop_run_once(loop, BENCH_IDLE_TIMEOUT_MS);
+		if (rc < 0)
+			break;
+		if (rc > 0)
+			last_event_usec = clock_monotonic_usec();
+		else if (replay->finished())
+			break;
+		trace_collect(); // keep the trace rings from overflowing
+	}
+	uint64_t elapsed_usec = last_event_usec - start_usec;
+	uint64_t loop_allocations = alloc_counter_read().allocations - start_allocations.allocations;
+
+	bench.radar->fmcw_radar_sensor_stop_streaming();
+	bench.radar->fmcw_radar_sensor_stop_tx_signal();
+	bench.log.close();
+	struct stat log_stat = {};
+	stat(log_path, &log_stat);
+	unlink(log_path);
+	trace_collect();
+
+	flight_replay_stats_t replay_stats;
+	replay->get_stats(&replay_stats);
+	double elapsed_sec = elapsed_usec / 1e6;
+
+	printf("Replayed %llu radar lines (%llu dropped), %llu NMEA sentences, %llu temperatures "
+	       "in %.3f s\n",
+	       (unsigned long long)replay_stats.radar_lines,
+	       (unsigned long long)replay_stats.radar_lines_dropped,
+	       (unsigned long long)replay_stats.gps_sentences,
+	       (unsigned long long)replay_stats.temperature_samples, elapsed_sec);
+	printf("Processed %llu frames, %.1f frames/sec: %llu estimates, %llu stacks, %llu errors\n",
+	       (unsigned long long)bench.frames_processed,
+	       elapsed_sec > 0 ? bench.frames_processed / elapsed_sec : 0.0,
+	       (unsigned long long)bench.estimates, (unsigned long long)bench.stacks,
+	       (unsigned long long)bench.errors);
+	uint64_t log_bytes = log_stat.st_size > 0 ? log_stat.st_size - sizeof(flight_log_header_t) : 0;
+	uint64_t unpacked_bytes = bench.frames_processed * sizeof(flight_log_record_t);
+	printf("Packed flight log: %llu bytes, %.1f per frame (%.1fx smaller than unpacked)\n",
+	       (unsigned long long)log_bytes,
+	       bench.frames_processed ? (double)log_bytes / bench.frames_processed : 0.0,
+	       log_bytes ? (double)unpacked_bytes / log_bytes : 0.0);
+	printf("Heap allocations while streaming: %llu (%.2f per frame)\n",
+	       (unsigned long long)loop_allocations,
+	       bench.frames_processed ? (double)loop_allocations / bench.frames_processed : 0.0);
+
+	printf("  %-17s %8s %10s %10s %10s %10s\n", "stage (usec)", "count", "p50", "p99", "max",
+	       "mean");
+	for (int point = 0; point < TRACE_NUM_POINTS; point++)
+		print_stage((enum trace_point)point);
+
+	event_loop_destroy(loop);
+	replay->stop(); // the GPS ingest thread still reads its pipe until the process exits
+	return bench.frames_processed > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
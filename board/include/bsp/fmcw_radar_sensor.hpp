@@ -13,10 +13,14 @@
 #ifndef FMCW_RADAR_SENSOR_H
 #define FMCW_RADAR_SENSOR_H
 
+#include "common/frame_pool.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <string_view>
 
 //----------------------------------------------------------------
 #define FMCW_RADAR_FFT_SIZE 512   // FFT is 1024 but 512 point symmetrical along y=0
+#define FMCW_RADAR_ZOOM_SIZE 256  // zoomed spectrum points of frames computed on board
 
 typedef struct fmcw_waveform_data
 {
@@ -27,6 +31,42 @@ typedef struct fmcw_waveform_data
 	uint8_t raw_data[FMCW_RADAR_MAX_DATA_SIZE];
 } fmcw_waveform_data_t;
 
+// Parsed form of one FFT line. Consumers should prefer this over the ASCII raw_data
+// since it is a third of the size and never needs to be reparsed.
+typedef struct fmcw_fft_frame
+{
+	uint64_t timestamp_usec; // capture time, microseconds since the Unix epoch
+	uint64_t monotonic_usec; // capture time on the monotonic clock, for joining with other sensors
+	uint32_t sequence;       // increments by one for every frame read from the sensor
+	uint16_t num_bins;       // number of valid entries in bins
+	uint16_t bins[FMCW_RADAR_FFT_SIZE]; // magnitudes rounded to the nearest integer
+
+	// Finer spectrum over the ice range gate, only frames computed on board from the radar's
+	// ADC samples have one
+	uint16_t num_zoom_bins; // 0 without a zoomed spectrum
+	float zoom_start_m;     // range of zoom_bins[0]
+	float zoom_step_m;      // range between neighbouring zoom bins
+	uint16_t zoom_bins[FMCW_RADAR_ZOOM_SIZE];
+} fmcw_fft_frame_t;
+
+/* Streamed frames live in a pool the driver allocates once, and are handed out as shared
+   handles instead of copies. The pool covers a full stream queue, the frames the application
+   holds on to (a stop's worth) and the frame being captured. */
+#define FMCW_RADAR_FRAME_POOL_SIZE 64
+#define FMCW_RADAR_MAX_HELD_FRAMES 24
+typedef FRAME_POOL<fmcw_fft_frame_t, FMCW_RADAR_FRAME_POOL_SIZE> fmcw_frame_pool_t;
+typedef fmcw_frame_pool_t::HANDLE fmcw_frame_handle_t;
+
+// What the frame stream lost since streaming last started
+typedef struct fmcw_stream_stats
+{
+	uint32_t frames;             // frames queued for the application
+	uint32_t dropped_frames;     // captured, but the stream queue or the frame pool was full
+	uint32_t missed_frames;      // did not arrive in time or arrived damaged
+	uint32_t serial_overruns;    // times the serial driver lost bytes, 0 if it does not count
+	uint32_t max_frame_gap_usec; // longest time between two captured frames
+} fmcw_stream_stats_t;
+
 //----------------------------------------------------------------
 
 class FMCW_RADAR_SENSOR
@@ -41,8 +81,38 @@ public:
 	virtual int8_t fmcw_radar_sensor_init() = 0;
 	virtual int8_t fmcw_radar_sensor_start_tx_signal() = 0;
 	virtual int8_t fmcw_radar_sensor_read_rx_signal(fmcw_waveform_data_t *data) = 0;
+	virtual int8_t fmcw_radar_sensor_read_fft_frame(fmcw_fft_frame_t *frame) = 0;
 	virtual int8_t fmcw_radar_sensor_stop_tx_signal() = 0;
 
+	// Batch reads: fill frames with up to max_frames frames, oldest first, and return how many
+	// (-X on failure). read_fft_frames() waits for at least one, while streaming it then takes
+	// whatever else is queued, otherwise it reads max_frames frames back to back.
+	// try_read_fft_frames() never waits and only returns frames that were already streamed.
+	virtual int fmcw_radar_sensor_read_fft_frames(fmcw_fft_frame_t *frames,
+	                                              size_t max_frames) = 0;
+	virtual int fmcw_radar_sensor_try_read_fft_frames(fmcw_fft_frame_t *frames,
+	                                                  size_t max_frames) = 0;
+
+	// Like try_read_fft_frames() without the copies: takes handles to the streamed frames
+	// themselves. Each frame goes back to the driver once its last handle is reset, holding
+	// on to more than FMCW_RADAR_MAX_HELD_FRAMES starves the stream and frames get dropped.
+	virtual int fmcw_radar_sensor_try_acquire_fft_frames(fmcw_frame_handle_t *frames,
+	                                                     size_t max_frames) = 0;
+
+	// Streaming mode: frames are captured continuously in the background and
+	// fmcw_radar_sensor_read_fft_frame() hands them out in order. Frames are buffered up to the
+	// capacity of the stream queue and the frame pool, frames captured while either is full are
+	// dropped. get_stream_stats() counts them, and any the line lost, since it last started.
+	virtual int8_t fmcw_radar_sensor_start_streaming() = 0;
+	virtual int8_t fmcw_radar_sensor_stop_streaming() = 0;
+	virtual void fmcw_radar_sensor_get_stream_stats(fmcw_stream_stats_t *stats) = 0;
+
+	// Readable while streamed frames are waiting, so an event loop can wait on it. Drain it
+	// with event_fd_drain() before taking every waiting frame with
+	// fmcw_radar_sensor_try_read_fft_frames(). A frame queued in between makes it readable
+	// again.
+	virtual int fmcw_radar_sensor_frame_event_fd() = 0;
+
 	virtual ~FMCW_RADAR_SENSOR() {}
 	// do not declare anything as private or protected
 };
@@ -51,4 +121,49 @@ public:
 
 FMCW_RADAR_SENSOR *instantiate_fmcw_radar_sensor();
 
+/**
+ * Parses a comma separated list of FFT magnitudes (the contents of the radar's JSON
+ * "FFT" array) into integer bins. Does not allocate and only makes a single pass over text.
+ * @param text The ASCII magnitudes, e.g. "0.0,61.0,263.0,..."
+ * @param len The number of characters in text
+ * @param bins The array to store the parsed magnitudes in
+ * @param max_bins The capacity of bins
+ *
+ * @return The number of bins parsed on success, -X on failure with failure code.
+ */
+int fmcw_radar_parse_fft_bins(const char *text, size_t len, uint16_t *bins, size_t max_bins);
+
+/**
+ * Finds the contents of the "FFT" array in one JSON line from the radar, e.g.
+ * {"FFT":[0.0,61.0,...]} gives "0.0,61.0,...". Does not allocate.
+ * @param line One line from the radar
+ * @param fft_data The view to point at the magnitudes, a view into line
+ *
+ * @return 0 on success, -1 if the line is not FFT data.
+ */
+int8_t fmcw_radar_extract_fft(std::string_view line, std::string_view *fft_data);
+
+/**
+ * Parses a comma separated list of the radar's raw ADC samples (the contents of its JSON "I"
+ * or "Q" array). Does not allocate and only makes a single pass over text.
+ * @param text The ASCII samples, e.g. "2048,2311,2290,..."
+ * @param len The number of characters in text
+ * @param samples The array to store the parsed samples in
+ * @param max_samples The capacity of samples
+ *
+ * @return The number of samples parsed on success, -X on failure with failure code.
+ */
+int fmcw_radar_parse_adc_samples(const char *text, size_t len, float *samples, size_t max_samples);
+
+/**
+ * Finds the contents of the "I" or "Q" array in one JSON line from the radar, which streams a
+ * chirp's samples as an {"I":[...]} line followed by a {"Q":[...]} line. Does not allocate.
+ * @param line One line from the radar
+ * @param channel 'I' or 'Q'
+ * @param samples The view to point at the samples, a view into line
+ *
+ * @return 0 on success, -1 if the line is not that channel's samples.
+ */
+int8_t fmcw_radar_extract_adc(std::string_view line, char channel, std::string_view *samples);
+
 #endif // #ifndef FMCW_RADAR_SENSOR_H
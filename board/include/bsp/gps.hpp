@@ -13,12 +13,20 @@
 #ifndef GPS_H 
 #define GPS_H 
 
+#include <cstddef>
 #include <cstdint>
 
 typedef struct gps_data
 {
 	double latitude;
 	double longitude;
+	double speed_mps;    // speed over ground
+	double course_deg;   // true course over ground, meaningless when not moving
+	double hdop;         // horizontal dilution of precision, lower is better
+	uint8_t fix_quality; // 1 GPS, 2 DGPS, ...; gps_read only returns valid fixes
+	uint8_t num_satellites;
+	uint64_t timestamp_usec; // monotonic time the fix was received, see clock_monotonic_usec()
+	uint32_t sequence;       // counts fixes, so a caller can tell a new fix from a repeated one
 } gps_data_t;
 
 class GPS
@@ -31,7 +39,20 @@ public:
 
 	// Pure virtual functions enforce child class implementations
 	virtual int8_t gps_init() = 0;
-	virtual int8_t gps_read(gps_data_t *data) = 0;
+	virtual int8_t gps_read(gps_data_t *data) = 0; // latest fix, never blocks
+
+	// Every fix published since the last call, oldest first, up to max_fixes. Returns how many
+	// (-X on failure) and never blocks. Fixes older than the driver keeps are skipped, a
+	// gap in their sequence numbers shows how many. There is only one such reader.
+	virtual int gps_read_fixes(gps_data_t *fixes, size_t max_fixes) = 0;
+
+	// Readable once a new fix has been published since it was last drained with
+	// event_fd_drain(), so an event loop can wait for fixes instead of polling gps_read().
+	virtual int gps_fix_event_fd() = 0;
+
+	// Caches the latest fix so the next boot finds the satellites sooner. Writes and syncs a
+	// small file, call it on a slow timer from a thread that may block, not per fix.
+	virtual int8_t gps_save_position_hint() = 0;
 
 	virtual ~GPS() {}
 	// do not declare anything as private or protected
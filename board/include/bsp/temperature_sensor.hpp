@@ -14,11 +14,13 @@
 #ifndef TEMP_SENSOR_H
 #define TEMP_SENSOR_H
 
+#include <cstddef>
 #include <cstdint>
 //----------------------------------------------------------------
 typedef struct temp_sensor_data
 {
-	double temperature; // in celcius to 2 decimal precision
+	double temperature;      // in celcius to 2 decimal precision
+	uint64_t timestamp_usec; // monotonic time the sample was read, see clock_monotonic_usec()
 } temp_sensor_data_t;
 
 //----------------------------------------------------------------
@@ -35,6 +37,14 @@ public:
 	virtual int8_t temperature_sensor_init() = 0;
 	virtual int8_t temperature_sensor_read(temp_sensor_data_t *data) = 0;
 
+	// Batch reads: fill samples with up to max_samples new samples, one per conversion, and
+	// return how many (-X on failure). read_samples() waits for each conversion,
+	// try_read_samples() only returns a conversion that is already done.
+	virtual int temperature_sensor_read_samples(temp_sensor_data_t *samples,
+	                                            size_t max_samples) = 0;
+	virtual int temperature_sensor_try_read_samples(temp_sensor_data_t *samples,
+	                                                size_t max_samples) = 0;
+
 	virtual ~TEMPERATURE_SENSOR() {}
 	// do not declare anything as private or protected
 };
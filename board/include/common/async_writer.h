@@ -0,0 +1,83 @@
+/**
+ *
+ * Name: async_writer.h
+ * Author: Hubert Dang
+ *
+ * This file describes a background writer that keeps storage I/O off the sensor loop.
+ * Producers copy bytes into a preallocated double buffer and return immediately; a single
+ * thread writes the buffer out in large chunks and fsyncs according to a policy.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef ASYNC_WRITER_H
+#define ASYNC_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+struct async_writer_config
+{
+	size_t buffer_size;          /* bytes per half of the double buffer */
+	unsigned flush_interval_ms;  /* longest data waits in memory before it is written */
+	unsigned fsync_interval_ms;  /* longest written data waits for an fsync, 0 = on request */
+};
+
+struct async_writer_stats
+{
+	uint64_t bytes_written;
+	uint64_t bytes_dropped; /* producer found the buffer full */
+	uint32_t write_errors;
+	uint32_t fsyncs;
+};
+
+struct async_writer;
+
+/**
+ * async_writer_create - start a writer thread for a file
+ *
+ * @param fd The open file to append to. The writer takes ownership and closes it.
+ * @param config The buffer size and flush/fsync policy
+ *
+ * @return The writer on success, NULL on failure
+ */
+struct async_writer *async_writer_create(int fd, const struct async_writer_config *config);
+
+/**
+ * async_writer_write - queue bytes for writing
+ *
+ * Never blocks on storage. If the buffer is full the bytes are dropped and counted.
+ *
+ * @return 0 on success, negative number if the data was dropped
+ */
+int async_writer_write(struct async_writer *writer, const void *data, size_t len);
+
+/**
+ * async_writer_sync - ask for everything queued so far to be written and fsynced
+ *
+ * Does not wait for the fsync to happen. Use this on events like a state change.
+ */
+void async_writer_sync(struct async_writer *writer);
+
+/**
+ * async_writer_get_stats - get a snapshot of the writer's counters
+ */
+void async_writer_get_stats(struct async_writer *writer, struct async_writer_stats *stats);
+
+/**
+ * async_writer_destroy - write and fsync everything queued, then stop the thread
+ */
+void async_writer_destroy(struct async_writer *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASYNC_WRITER_H */
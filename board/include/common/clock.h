@@ -0,0 +1,54 @@
+/**
+ *
+ * Name: clock.h
+ * Author: Hubert Dang
+ *
+ * This file provides the timestamp helpers shared by the board software.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * clock_realtime_usec - get the wall clock time
+ *
+ * Use this to timestamp captured data that gets persisted or joined with other sensors.
+ *
+ * @return Microseconds since the Unix epoch
+ */
+uint64_t clock_realtime_usec();
+
+/**
+ * clock_monotonic_usec - get the monotonic clock time
+ *
+ * Use this for measuring intervals and deadlines. It never jumps when the wall clock is set.
+ *
+ * @return Microseconds since an arbitrary, fixed point in the past
+ */
+uint64_t clock_monotonic_usec();
+
+/**
+ * clock_monotonic_nsec - get the monotonic clock time in nanoseconds
+ *
+ * Use this for timing short sections of code, see common/trace.h.
+ *
+ * @return Nanoseconds since the same point as clock_monotonic_usec()
+ */
+uint64_t clock_monotonic_nsec();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLOCK_H */
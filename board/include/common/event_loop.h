@@ -0,0 +1,111 @@
+/**
+ *
+ * Name: event_loop.h
+ * Author: Hubert Dang
+ *
+ * This file describes a single threaded event loop built on epoll. File descriptors, timers
+ * (timerfd) and cross thread notifications (eventfd) are registered with a callback, and the
+ * loop sleeps until one of them is ready instead of polling.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define EVENT_LOOP_MAX_SOURCES 16
+
+typedef void (*event_loop_callback)(void *ctx);
+
+struct event_loop;
+
+/**
+ * event_loop_create - create an empty event loop
+ *
+ * @return The loop on success, NULL on failure
+ */
+struct event_loop *event_loop_create();
+
+/**
+ * event_loop_add_fd - call callback whenever fd is readable
+ *
+ * The callback must consume what made fd readable, the loop is level triggered. The loop does
+ * not take ownership of fd.
+ *
+ * @return 0 on success, negative number on failure
+ */
+int event_loop_add_fd(struct event_loop *loop, int fd, event_loop_callback callback, void *ctx);
+
+/**
+ * event_loop_remove_fd - stop watching fd. Safe to call from any callback.
+ */
+void event_loop_remove_fd(struct event_loop *loop, int fd);
+
+/**
+ * event_loop_add_timer - create a disarmed timer, see event_loop_arm_timer
+ *
+ * @return The timer's file descriptor on success, negative number on failure
+ */
+int event_loop_add_timer(struct event_loop *loop, event_loop_callback callback, void *ctx);
+
+/**
+ * event_loop_arm_timer - fire once after delay_usec, then every period_usec if it is not 0
+ *
+ * A delay of 0 disarms the timer. Rearming replaces any pending expiry.
+ *
+ * @return 0 on success, negative number on failure
+ */
+int event_loop_arm_timer(struct event_loop *loop, int timer, uint64_t delay_usec,
+                         uint64_t period_usec);
+
+/**
+ * event_loop_remove_timer - disarm, unregister and close a timer
+ */
+void event_loop_remove_timer(struct event_loop *loop, int timer);
+
+/**
+ * event_loop_run - dispatch callbacks until event_loop_stop is called
+ *
+ * @return 0 once stopped, negative number if waiting for events failed
+ */
+int event_loop_run(struct event_loop *loop);
+
+/**
+ * event_loop_run_once - dispatch whatever becomes ready within timeout_ms (-1 waits forever)
+ *
+ * @return The number of callbacks run, negative number on failure
+ */
+int event_loop_run_once(struct event_loop *loop, int timeout_ms);
+
+void event_loop_stop(struct event_loop *loop);
+
+/**
+ * event_loop_destroy - close the timers and free the loop, registered fds are left open
+ */
+void event_loop_destroy(struct event_loop *loop);
+
+/**
+ * event_fd_* - eventfd helpers for a thread to wake an event loop
+ *
+ * A semaphore eventfd stays readable once per signal, for handing over one item per wakeup.
+ * Otherwise one drain consumes every signal, for "something changed" notifications.
+ */
+int event_fd_create(bool semaphore);
+void event_fd_signal(int fd);
+uint64_t event_fd_drain(int fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_LOOP_H */
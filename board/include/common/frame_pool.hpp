@@ -0,0 +1,164 @@
+/**
+ *
+ * Name: frame_pool.hpp
+ * Author: Hubert Dang
+ *
+ * This file implements a fixed-capacity pool of frames handed out through reference counted
+ * handles. A driver fills a frame once and every stage after it (estimation, stacking,
+ * storage) shares the same slot through its own handle. The slot goes back to the pool when
+ * the last handle lets go, so nothing is copied or allocated between capture and storage.
+ *
+ * Acquiring and releasing are lock-free and may happen on any thread. A frame must not be
+ * written once it has been handed to another thread.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template <typename T, size_t CAPACITY> class FRAME_POOL
+{
+	static_assert(CAPACITY >= 1, "FRAME_POOL needs at least one slot");
+
+public:
+	// Shares one slot of the pool. Copies add a reference, the slot is freed when the last
+	// copy is destroyed or reset. An empty handle refers to no slot.
+	class HANDLE
+	{
+	public:
+		HANDLE() : pool(nullptr), slot(0) {}
+
+		HANDLE(const HANDLE &other) : pool(other.pool), slot(other.slot)
+		{
+			if (pool != nullptr)
+				pool->retain(slot);
+		}
+
+		HANDLE(HANDLE &&other) noexcept : pool(other.pool), slot(other.slot)
+		{
+			other.pool = nullptr;
+		}
+
+		// by value, so assigning from a temporary moves and from anything else copies
+		HANDLE &operator=(HANDLE other) noexcept
+		{
+			FRAME_POOL *p = pool;
+			size_t s = slot;
+			pool = other.pool;
+			slot = other.slot;
+			other.pool = p;
+			other.slot = s;
+			return *this;
+		}
+
+		~HANDLE() { reset(); }
+
+		/**
+		 * Drops this handle's reference, freeing the slot if it was the last one.
+		 */
+		void reset()
+		{
+			if (pool != nullptr)
+				pool->release(slot);
+			pool = nullptr;
+		}
+
+		T *get() const { return pool != nullptr ? &pool->slots[slot] : nullptr; }
+		T &operator*() const { return pool->slots[slot]; }
+		T *operator->() const { return &pool->slots[slot]; }
+		explicit operator bool() const { return pool != nullptr; }
+
+		// number of handles sharing the slot, 0 for an empty handle
+		uint32_t use_count() const
+		{
+			return pool != nullptr ? pool->refs[slot].load(std::memory_order_relaxed) : 0;
+		}
+
+	private:
+		friend class FRAME_POOL;
+		HANDLE(FRAME_POOL *pool, size_t slot) : pool(pool), slot(slot) {}
+
+		FRAME_POOL *pool;
+		size_t slot;
+	};
+
+	FRAME_POOL()
+	{
+		for (size_t w = 0; w < NUM_WORDS; w++)
+		{
+			size_t bits = CAPACITY - w * 64 < 64 ? CAPACITY - w * 64 : 64;
+			free_slots[w].store(bits == 64 ? ~0ULL : (1ULL << bits) - 1,
+			                    std::memory_order_relaxed);
+		}
+		for (size_t i = 0; i < CAPACITY; i++)
+			refs[i].store(0, std::memory_order_relaxed);
+	}
+
+	// FRAME_POOL should not be cloneable.
+	FRAME_POOL(FRAME_POOL &other) = delete;
+
+	// FRAME_POOL should not be assignable.
+	void operator=(const FRAME_POOL &) = delete;
+
+	/**
+	 * Takes a free slot. Its frame still holds whatever the last user left in it.
+	 *
+	 * @return A handle to the slot, or an empty handle if every slot is in use.
+	 */
+	HANDLE acquire()
+	{
+		for (size_t w = 0; w < NUM_WORDS; w++)
+		{
+			uint64_t bits = free_slots[w].load(std::memory_order_relaxed);
+			while (bits != 0)
+			{
+				uint64_t bit = bits & -bits; // lowest free slot
+				if (free_slots[w].compare_exchange_weak(bits, bits & ~bit,
+				                                        std::memory_order_acquire,
+				                                        std::memory_order_relaxed))
+				{
+					size_t slot = w * 64 + __builtin_ctzll(bit);
+					refs[slot].store(1, std::memory_order_relaxed);
+					return HANDLE(this, slot);
+				}
+			}
+		}
+		return HANDLE();
+	}
+
+	// number of free slots, a snapshot when other threads acquire or release
+	size_t available() const
+	{
+		size_t count = 0;
+		for (size_t w = 0; w < NUM_WORDS; w++)
+			count += __builtin_popcountll(free_slots[w].load(std::memory_order_relaxed));
+		return count;
+	}
+
+	static constexpr size_t capacity() { return CAPACITY; }
+
+private:
+	void retain(size_t slot) { refs[slot].fetch_add(1, std::memory_order_relaxed); }
+
+	void release(size_t slot)
+	{
+		// the last user's writes to the frame happen before the next acquire() of the slot
+		if (refs[slot].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			free_slots[slot / 64].fetch_or(1ULL << (slot % 64), std::memory_order_release);
+	}
+
+	static constexpr size_t NUM_WORDS = (CAPACITY + 63) / 64;
+
+	std::atomic<uint64_t> free_slots[NUM_WORDS]; // a set bit is a free slot
+	std::atomic<uint32_t> refs[CAPACITY];
+	T slots[CAPACITY];
+};
+
+#endif // #ifndef FRAME_POOL_H
@@ -18,9 +18,17 @@ extern "C"
 {
 #endif
 
-#define LOG_INFO_ENABLE 1
-#define LOG_WARN_ENABLE 1
-#define LOG_ERROR_ENABLE 1
+/* Levels that are not enabled compile out of every call site, override with e.g.
+   -DLOG_INFO_ENABLE=0 */
+#ifndef LOG_INFO_ENABLE
+	#define LOG_INFO_ENABLE 1
+#endif
+#ifndef LOG_WARN_ENABLE
+	#define LOG_WARN_ENABLE 1
+#endif
+#ifndef LOG_ERROR_ENABLE
+	#define LOG_ERROR_ENABLE 1
+#endif
 
 enum log_level
 {
@@ -45,16 +53,38 @@ int logging_init();
  */
 void logging_cleanup();
 
+/**
+ * logging_sync - make sure every log written so far reaches storage
+ *
+ * Logs are written in the background. Call this on important events, like a state change.
+ */
+void logging_sync();
+
+#define LOG_LEVEL_ENABLED(level) \
+	((level) == LOG_INFO   ? LOG_INFO_ENABLE \
+	 : (level) == LOG_WARN ? LOG_WARN_ENABLE \
+	                       : LOG_ERROR_ENABLE)
+
 /**
  * logging_write - write a log
  *
  * @param log_level The level/type of log
- * @param msg The log message
+ * @param msg The log message, must be a string literal
  * @param ... Arguments corresponding to the format specifier in msg
  *
- * Logging should be initialized before calling this function.
+ * Logging should be initialized before calling this function. Only the format's address and
+ * the raw arguments are queued (strings are copied), the text is formatted in the background.
+ * Messages are dropped, and counted in the log, if the queue is full.
  */
-void logging_write(enum log_level level, const char *msg, ...);
+#define logging_write(level, ...) \
+	do \
+	{ \
+		if (LOG_LEVEL_ENABLED(level)) \
+			logging_emit(level, __VA_ARGS__); \
+	} while (0)
+
+void logging_emit(enum log_level level, const char *msg, ...)
+    __attribute__((format(printf, 2, 3)));
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,114 @@
+/**
+ *
+ * Name: rt_profile.h
+ * Author: Hubert Dang
+ *
+ * This file describes the real-time profile for the acquisition threads. It bounds how late
+ * the radar and GPS readers can run, so frames are not lost to scheduler jitter or page
+ * faults at 1152000 baud:
+ *
+ *     - all memory is locked (mlockall), so nothing page faults after startup
+ *     - the radar reader runs alone on one core, which should be taken away from the
+ *       scheduler with isolcpus= on the kernel command line; every other thread of the
+ *       process, including those started before the profile was applied, stays off it
+ *     - the radar reader, GPS reader and FSM run with SCHED_FIFO priorities, in that order,
+ *       and background threads (flight log and telemetry writers) under the normal
+ *       scheduler
+ *     - serial ports are switched to low latency, which makes USB serial drivers hand over
+ *       every byte as it arrives instead of batching them
+ *
+ * The profile is off by default. -DRT_PROFILE=ON turns it on by default, and the environment
+ * overrides the build at run time:
+ *
+ *     SNOW_ANGEL_RT=0|1           off or on
+ *     SNOW_ANGEL_RT_RADAR_CPU=n   the radar reader's core, -1 leaves it unpinned
+ *
+ * Every step that fails (e.g. without CAP_SYS_NICE or CAP_IPC_LOCK) is logged and skipped,
+ * the board runs without it.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef RT_PROFILE_H
+#define RT_PROFILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifndef RT_PROFILE_RADAR_CPU
+#define RT_PROFILE_RADAR_CPU 3 /* last core of the Pi's four */
+#endif
+
+enum rt_thread_role
+{
+	RT_THREAD_RADAR,      /* radar stream reader */
+	RT_THREAD_GPS,        /* GPS sentence reader */
+	RT_THREAD_FSM,        /* main thread, consumes the readers' frames and fixes */
+	RT_THREAD_BACKGROUND, /* writers that may lag, e.g. logging and telemetry */
+	RT_THREAD_ROLES
+};
+
+struct rt_profile
+{
+	bool enabled;
+	bool lock_memory;
+	bool low_latency_serial;
+	int radar_cpu;                 /* -1 leaves the radar reader unpinned */
+	int priority[RT_THREAD_ROLES]; /* SCHED_FIFO priority, 0 for the normal scheduler */
+};
+
+/**
+ * rt_profile_load - fill in the profile the build selects, overridden by the environment
+ */
+void rt_profile_load(struct rt_profile *profile);
+
+/**
+ * rt_profile_apply - apply a profile to the process, call from the main thread early on
+ *
+ * Locks memory, moves the process' other threads off the radar reader's core and the calling
+ * thread into RT_THREAD_FSM. Threads created afterwards start with its core set and priority
+ * until they call rt_profile_enter. Nothing is done if the profile is not enabled.
+ *
+ * @return 0 on success, negative number with the number of steps that failed
+ */
+int rt_profile_apply(const struct rt_profile *profile);
+
+/**
+ * rt_profile_enter - move the calling thread into role under the applied profile
+ *
+ * Call at the start of a thread. Does nothing if no profile was applied.
+ *
+ * @return 0 on success, negative number on failure
+ */
+int rt_profile_enter(enum rt_thread_role role);
+
+/**
+ * rt_profile_serial_low_latency - switch a serial port to low latency under the applied profile
+ *
+ * Does nothing if no profile was applied or it leaves serial ports alone.
+ *
+ * @return 0 on success, negative number if the driver does not support it
+ */
+int rt_profile_serial_low_latency(int fd);
+
+/**
+ * rt_profile_serial_overruns - get how many times a serial port's driver lost bytes
+ *
+ * Counts hardware FIFO and driver buffer overruns since the port was opened.
+ *
+ * @return 0 on success, negative number if the driver does not count them
+ */
+int rt_profile_serial_overruns(int fd, uint32_t *overruns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RT_PROFILE_H */
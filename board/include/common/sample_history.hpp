@@ -0,0 +1,109 @@
+/**
+ *
+ * Name: sample_history.hpp
+ * Author: Hubert Dang
+ *
+ * This file implements a fixed size history of time tagged sensor samples. Sensors that are
+ * sampled on their own schedule push into one, and a consumer joins its own measurement with
+ * the sample taken nearest in time to it.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef SAMPLE_HISTORY_H
+#define SAMPLE_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+
+template <typename T, size_t N> class SAMPLE_HISTORY
+{
+	static_assert(N > 0, "SAMPLE_HISTORY needs room for at least one sample");
+
+public:
+	SAMPLE_HISTORY() : head(0), count(0) {}
+
+	/**
+	 * Records a sample, overwriting the oldest one once the history is full. Samples must be
+	 * pushed in timestamp order.
+	 * @param timestamp_usec When the sample was taken
+	 * @param value The sample
+	 */
+	void push(uint64_t timestamp_usec, const T &value)
+	{
+		samples[head].timestamp_usec = timestamp_usec;
+		samples[head].value = value;
+		head = (head + 1) % N;
+		if (count < N)
+			count++;
+	}
+
+	/**
+	 * Finds the sample taken nearest in time to timestamp_usec.
+	 * @param timestamp_usec The time to join against
+	 * @param value Pointer to store the sample in
+	 * @param skew_usec Optional pointer to store how far apart the two times are
+	 *
+	 * @return false if the history is empty.
+	 */
+	bool nearest(uint64_t timestamp_usec, T *value, uint64_t *skew_usec = nullptr) const
+	{
+		if (count == 0)
+			return false;
+
+		// Walk back from the newest sample, the distance only grows once we pass the target
+		size_t best = newest(0);
+		uint64_t best_skew = distance(samples[best].timestamp_usec, timestamp_usec);
+		for (size_t age = 1; age < count; age++)
+		{
+			size_t slot = newest(age);
+			uint64_t skew = distance(samples[slot].timestamp_usec, timestamp_usec);
+			if (skew > best_skew)
+				break;
+			best = slot;
+			best_skew = skew;
+		}
+
+		*value = samples[best].value;
+		if (skew_usec)
+			*skew_usec = best_skew;
+		return true;
+	}
+
+	void clear()
+	{
+		head = 0;
+		count = 0;
+	}
+
+	size_t size() const
+	{
+		return count;
+	}
+
+private:
+	size_t newest(size_t age) const
+	{
+		return (head + N - 1 - age) % N;
+	}
+
+	static uint64_t distance(uint64_t a, uint64_t b)
+	{
+		return a > b ? a - b : b - a;
+	}
+
+private:
+	struct sample
+	{
+		uint64_t timestamp_usec;
+		T value;
+	};
+
+	sample samples[N];
+	size_t head;  // slot the next sample goes in
+	size_t count; // valid samples, at most N
+};
+
+#endif // #ifndef SAMPLE_HISTORY_H
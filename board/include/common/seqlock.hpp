@@ -0,0 +1,91 @@
+/**
+ *
+ * Name: seqlock.hpp
+ * Author: Hubert Dang
+ *
+ * This file implements a single writer sequence lock used to publish the latest value a
+ * driver's reader thread produced. Readers never block the writer and always get a consistent
+ * copy; they retry if a write happened while they were copying.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template <typename T> class SEQLOCK
+{
+	static_assert(std::is_trivially_copyable<T>::value, "SEQLOCK values are copied bytewise");
+
+public:
+	SEQLOCK() : sequence(0)
+	{
+		for (size_t i = 0; i < NUM_WORDS; i++)
+			words[i].store(0, std::memory_order_relaxed);
+	}
+
+	// SEQLOCK should not be cloneable.
+	SEQLOCK(SEQLOCK &other) = delete;
+
+	// SEQLOCK should not be assignable.
+	void operator=(const SEQLOCK &) = delete;
+
+	/**
+	 * Publishes a new value. Only the writer thread may call this.
+	 * @param value The value to copy in.
+	 */
+	void store(const T &value)
+	{
+		uint64_t staged[NUM_WORDS] = {};
+		memcpy(staged, &value, sizeof(T));
+
+		uint32_t s = sequence.load(std::memory_order_relaxed);
+		sequence.store(s + 1, std::memory_order_relaxed); // odd: write in progress
+		std::atomic_thread_fence(std::memory_order_release);
+		for (size_t i = 0; i < NUM_WORDS; i++)
+			words[i].store(staged[i], std::memory_order_relaxed);
+		sequence.store(s + 2, std::memory_order_release);
+	}
+
+	/**
+	 * Copies out the latest value. Any thread may call this.
+	 * @param value Pointer to store the value in.
+	 *
+	 * @return false if nothing has been published yet.
+	 */
+	bool load(T *value) const
+	{
+		uint64_t staged[NUM_WORDS];
+		uint32_t before, after;
+
+		do
+		{
+			before = sequence.load(std::memory_order_acquire);
+			for (size_t i = 0; i < NUM_WORDS; i++)
+				staged[i] = words[i].load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			after = sequence.load(std::memory_order_relaxed);
+		} while ((before & 1) || before != after);
+
+		if (before == 0)
+			return false;
+
+		memcpy(value, staged, sizeof(T));
+		return true;
+	}
+
+private:
+	static constexpr size_t NUM_WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+	std::atomic<uint32_t> sequence; // even when stable, bumped by 2 per store
+	std::atomic<uint64_t> words[NUM_WORDS];
+};
+
+#endif // #ifndef SEQLOCK_H
@@ -0,0 +1,137 @@
+/**
+ *
+ * Name: spsc_queue.hpp
+ * Author: Karran Dhillon
+ *
+ * This file implements a bounded, lock-free single producer single consumer queue used to
+ * hand data from a driver's reader thread to the application.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Keeps the producer and consumer indices on separate cache lines
+#define SPSC_QUEUE_CACHE_LINE_SIZE 64
+
+template <typename T, size_t CAPACITY> class SPSC_QUEUE
+{
+	static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+	              "SPSC_QUEUE capacity must be a power of two");
+
+public:
+	SPSC_QUEUE() : head(0), tail(0) {}
+
+	// SPSC_QUEUE should not be cloneable.
+	SPSC_QUEUE(SPSC_QUEUE &other) = delete;
+
+	// SPSC_QUEUE should not be assignable.
+	void operator=(const SPSC_QUEUE &) = delete;
+
+	/**
+	 * Adds an item to the back of the queue. Only the producer thread may call this.
+	 * @param item The item to copy into the queue.
+	 *
+	 * @return true on success, false if the queue is full.
+	 */
+	bool push(const T &item)
+	{
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) == CAPACITY)
+			return false;
+
+		slots[t & (CAPACITY - 1)] = item;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Moves an item to the back of the queue. Only the producer thread may call this.
+	 * @param item The item to move into the queue, left as is if the queue is full.
+	 *
+	 * @return true on success, false if the queue is full.
+	 */
+	bool push(T &&item)
+	{
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) == CAPACITY)
+			return false;
+
+		slots[t & (CAPACITY - 1)] = std::move(item);
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Removes the item at the front of the queue. Only the consumer thread may call this.
+	 * @param item Pointer to store the item in.
+	 *
+	 * @return true on success, false if the queue is empty.
+	 */
+	bool pop(T *item)
+	{
+		size_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire))
+			return false;
+
+		*item = std::move(slots[h & (CAPACITY - 1)]);
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Removes up to max_items items from the front of the queue at once, with a single
+	 * update of the consumer index. Only the consumer thread may call this.
+	 * @param items Where to store the items, oldest first.
+	 * @param max_items The capacity of items.
+	 *
+	 * @return The number of items removed, 0 if the queue is empty.
+	 */
+	size_t pop_many(T *items, size_t max_items)
+	{
+		size_t h = head.load(std::memory_order_relaxed);
+		size_t available = tail.load(std::memory_order_acquire) - h;
+		size_t count = available < max_items ? available : max_items;
+
+		for (size_t i = 0; i < count; i++)
+			items[i] = std::move(slots[(h + i) & (CAPACITY - 1)]);
+		head.store(h + count, std::memory_order_release);
+		return count;
+	}
+
+	/**
+	 * Drops every queued item. Only the consumer thread may call this.
+	 */
+	void clear()
+	{
+		size_t h = head.load(std::memory_order_relaxed);
+		size_t t = tail.load(std::memory_order_acquire);
+		// items that own something, like a FRAME_POOL handle, give it up now
+		if (!std::is_trivially_destructible<T>::value)
+		{
+			for (; h != t; h++)
+				slots[h & (CAPACITY - 1)] = T();
+		}
+		head.store(t, std::memory_order_release);
+	}
+
+	size_t size() const
+	{
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+	}
+
+private:
+	alignas(SPSC_QUEUE_CACHE_LINE_SIZE) std::atomic<size_t> head; // next slot to pop
+	alignas(SPSC_QUEUE_CACHE_LINE_SIZE) std::atomic<size_t> tail; // next slot to push
+	T slots[CAPACITY];
+};
+
+#endif // #ifndef SPSC_QUEUE_H
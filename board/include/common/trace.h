@@ -0,0 +1,119 @@
+/**
+ *
+ * Name: trace.h
+ * Author: Hubert Dang
+ *
+ * This file describes the latency tracing used to see where time goes on the board. Sections
+ * of code are timed on the monotonic clock and recorded into a lock free ring owned by the
+ * calling thread. trace_collect() folds every thread's ring into per trace point histograms,
+ * which trace_log_summary() reports as p50/p99/max at the end of a flight.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "common/clock.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define TRACE_MAX_THREADS 8  /* threads that can record at the same time */
+#define TRACE_RING_SIZE 1024 /* events per thread between collections, a power of two */
+
+enum trace_point
+{
+	TRACE_RADAR_SERIAL_READ, /* stream thread waiting for and reading one line */
+	TRACE_RADAR_PARSE,       /* parsing one FFT line, or one chirp's ADC lines, into a frame */
+	TRACE_RADAR_FFT,         /* on-board FFT and zoom of one chirp's ADC samples */
+	TRACE_RADAR_READ_FRAME,  /* fmcw_radar_sensor_read_fft_frame */
+	TRACE_GPS_PARSE,         /* ingest thread handling one NMEA sentence */
+	TRACE_GPS_READ,          /* gps_read */
+	TRACE_TEMPERATURE_READ,  /* temperature_sensor_read */
+	TRACE_PERSIST_RECORD,    /* appending one record to the flight log */
+	TRACE_ICE_ESTIMATE,      /* ice thickness estimate of one frame */
+	TRACE_FSM_GPS_FIX,       /* board FSM handling a GPS fix */
+	TRACE_FSM_STABILIZED,    /* board FSM starting the radar */
+	TRACE_FSM_RADAR_FRAME,   /* board FSM handling a radar frame */
+	TRACE_FSM_FINISH_STOP,   /* board FSM stopping the radar and reporting the stop */
+	TRACE_NUM_POINTS,
+};
+
+struct trace_stats
+{
+	uint64_t count;   /* events collected */
+	uint64_t dropped; /* events lost to a full ring */
+	uint32_t p50_nsec;
+	uint32_t p99_nsec;
+	uint32_t max_nsec;
+	uint32_t mean_nsec;
+};
+
+/**
+ * trace_record - record that one section of code took duration_nsec
+ *
+ * Lock free and allocation free, safe to call from any thread. Durations are saturated at
+ * about 4.3 seconds.
+ */
+void trace_record(enum trace_point point, uint64_t duration_nsec);
+
+/**
+ * trace_collect - fold every thread's recorded events into the histograms
+ *
+ * Call this often enough that no thread records more than TRACE_RING_SIZE events between calls.
+ */
+void trace_collect();
+
+/**
+ * trace_get_stats - summarize the collected events of one trace point
+ *
+ * Percentiles are accurate to 1/8th of the value.
+ *
+ * @return 0 on success, negative number if point is not a trace point
+ */
+int trace_get_stats(enum trace_point point, struct trace_stats *stats);
+
+/**
+ * trace_log_summary - collect and log the statistics of every trace point that fired
+ */
+void trace_log_summary();
+
+const char *trace_point_name(enum trace_point point);
+
+#ifdef __cplusplus
+}
+
+/* Times the rest of the enclosing scope, e.g. TRACE_SCOPE(TRACE_GPS_READ); */
+class TRACE_SCOPE_TIMER
+{
+public:
+	explicit TRACE_SCOPE_TIMER(enum trace_point point)
+	    : point(point), start_nsec(clock_monotonic_nsec())
+	{
+	}
+
+	~TRACE_SCOPE_TIMER()
+	{
+		trace_record(point, clock_monotonic_nsec() - start_nsec);
+	}
+
+	TRACE_SCOPE_TIMER(TRACE_SCOPE_TIMER &other) = delete;
+	void operator=(const TRACE_SCOPE_TIMER &) = delete;
+
+private:
+	enum trace_point point;
+	uint64_t start_nsec;
+};
+
+#define TRACE_SCOPE_NAME(line) trace_scope_##line
+#define TRACE_SCOPE_LINE(point, line) TRACE_SCOPE_TIMER TRACE_SCOPE_NAME(line)(point)
+#define TRACE_SCOPE(point) TRACE_SCOPE_LINE(point, __LINE__)
+#endif
+
+#endif /* TRACE_H */
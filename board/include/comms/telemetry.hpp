@@ -0,0 +1,135 @@
+/**
+ *
+ * Name: telemetry.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes the telemetry downlink that sends each stop's result to the ground
+ * station while the drone is still flying. scripts/telemetry_listen.py receives it.
+ *
+ * The FSM publishes a report at the end of every stop and returns right away. A sender
+ * thread sends every report it has not sent yet in one UDP datagram. Reports wait in a
+ * bounded ring, and if the link falls behind the oldest unsent ones are overwritten. The
+ * newest result is what the operator needs to re-fly a bad spot.
+ *
+ * Datagram layout (little endian):
+ *     telemetry_header_t, then num_reports telemetry_stop_report_t, oldest first. A gap in
+ *     datagram numbers is a lost datagram. A gap in report sequence numbers is a report
+ *     that was overwritten or lost.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "common/seqlock.hpp"
+#include <atomic>
+#include <cstdint>
+#include <netinet/in.h>
+#include <thread>
+
+//----------------------------------------------------------------
+#define TELEMETRY_MAGIC 0x4C544153u // "SATL"
+#define TELEMETRY_VERSION 2 // 2 split the stacked estimate from the mean
+#define TELEMETRY_DEFAULT_PORT 14650
+
+#define TELEMETRY_QUEUE_DEPTH 16              // unsent reports kept, minutes of stops
+#define TELEMETRY_MAX_REPORTS_PER_DATAGRAM 16 // 1040 bytes, well under any link's MTU
+
+#define TELEMETRY_STOP_CONVERGED 0x1    // the stop ended before its read cap
+#define TELEMETRY_STOP_HAS_ESTIMATE 0x2 // the stacked frames gave stacked_thickness_m
+
+typedef struct telemetry_header
+{
+	uint32_t magic; // TELEMETRY_MAGIC
+	uint16_t version;
+	uint16_t num_reports;
+	uint32_t datagram;        // increments by one for every datagram sent
+	uint32_t dropped_reports; // reports overwritten before they were sent, so far
+} telemetry_header_t;
+
+typedef struct telemetry_stop_report
+{
+	uint32_t sequence; // set by publish(), increments by one for every report from 1
+	uint16_t flags;    // TELEMETRY_STOP_CONVERGED, TELEMETRY_STOP_HAS_ESTIMATE
+	uint16_t num_reads;
+	uint64_t timestamp_usec; // end of the stop, microseconds since the Unix epoch
+	double latitude;
+	double longitude;
+	float temperature;         // celcius
+	float thickness_m;         // mean of the frames' estimates
+	float half_width_m;        // 95% confidence half-width of that mean, the stop's quality
+	float snr_db;              // peak SNR of the stacked spectrum
+	uint16_t num_estimates;    // reads that produced a thickness
+	uint16_t cell_stops;       // stops in this stop's coverage grid cell, this one included
+	float cell_uncertainty_m;  // of the cell's thickness, 0 if the stop is not in the grid
+	float stacked_thickness_m; // estimate from the stacked frames, less noisy but without a CI
+	uint32_t reserved;         // always 0
+} telemetry_stop_report_t;
+
+static_assert(sizeof(telemetry_header_t) == 16, "telemetry header layout changed");
+static_assert(sizeof(telemetry_stop_report_t) == 64, "telemetry report layout changed");
+
+#define TELEMETRY_MAX_DATAGRAM_SIZE                                                               \
+	(sizeof(telemetry_header_t) +                                                                \
+	 TELEMETRY_MAX_REPORTS_PER_DATAGRAM * sizeof(telemetry_stop_report_t))
+
+typedef struct telemetry_stats
+{
+	uint32_t published;
+	uint32_t sent;
+	uint32_t dropped; // overwritten before they were sent
+	uint32_t datagrams;
+	uint32_t send_errors; // datagrams the socket refused, their reports are not resent
+} telemetry_stats_t;
+
+//----------------------------------------------------------------
+
+class TELEMETRY_PUBLISHER
+{
+public:
+	TELEMETRY_PUBLISHER();
+
+	// TELEMETRY_PUBLISHER owns its socket, it should not be cloneable.
+	TELEMETRY_PUBLISHER(TELEMETRY_PUBLISHER &other) = delete;
+
+	// TELEMETRY_PUBLISHER should not be assignable.
+	void operator=(const TELEMETRY_PUBLISHER &) = delete;
+
+	int8_t open(const char *address, uint16_t port = TELEMETRY_DEFAULT_PORT);
+	int8_t publish(const telemetry_stop_report_t *report);
+	void get_stats(telemetry_stats_t *stats) const;
+	void close();
+	bool is_open() const;
+
+	~TELEMETRY_PUBLISHER();
+
+private:
+	void send_loop();
+	void send_pending();
+
+private:
+	int sock;
+	struct sockaddr_in destination;
+	int wake_fd; // signalled after every published report and on close()
+	std::thread sender;
+	std::atomic<bool> running;
+
+	// report n lives in slot n % TELEMETRY_QUEUE_DEPTH, the publisher only ever overwrites
+	SEQLOCK<telemetry_stop_report_t> reports[TELEMETRY_QUEUE_DEPTH];
+	std::atomic<uint32_t> published; // sequence of the newest report
+
+	// only touched by the sender thread
+	uint32_t last_sent; // sequence of the newest report sent or dropped
+	uint32_t datagram;
+	uint8_t buffer[TELEMETRY_MAX_DATAGRAM_SIZE];
+
+	std::atomic<uint32_t> sent;
+	std::atomic<uint32_t> dropped;
+	std::atomic<uint32_t> datagrams;
+	std::atomic<uint32_t> send_errors;
+};
+
+#endif // #ifndef TELEMETRY_H
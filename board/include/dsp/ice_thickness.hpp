@@ -0,0 +1,86 @@
+/**
+ *
+ * Name: ice_thickness.hpp
+ * Author: Karran Dhillon
+ *
+ * This file describes the on-board ice thickness estimator. It finds the ice surface and
+ * ice bottom reflections in an FFT frame and converts the distance between them to meters.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef ICE_THICKNESS_H
+#define ICE_THICKNESS_H
+
+#include "bsp/fmcw_radar_sensor.hpp"
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------
+typedef struct ice_peak
+{
+	float bin;        // interpolated FFT bin of the reflection
+	float range_m;    // distance from the radar to the reflection
+	float magnitude;  // interpolated height of the peak
+	float prominence; // height of the peak above the surrounding spectrum
+} ice_peak_t;
+
+typedef struct ice_thickness_estimate
+{
+	ice_peak_t surface; // closest reflection, the top of the ice
+	ice_peak_t bottom;  // second closest reflection, the ice/water interface
+	float thickness_m;
+	uint8_t num_peaks; // number of peaks found in the range gate, before keeping the first two
+} ice_thickness_estimate_t;
+
+//----------------------------------------------------------------
+
+/**
+ * Estimates the ice thickness from one FFT spectrum. Mirrors the offline processing in
+ * scripts/ops_serial.py: the two closest prominent peaks between 0.1 m and 1 m are the
+ * surface and the bottom of the ice.
+ * @param bins The FFT magnitudes, one per range bin
+ * @param num_bins The number of entries in bins
+ * @param estimate Pointer to store the estimate in
+ *
+ * @return 0 on success, -1 on invalid arguments, -2 if fewer than two peaks were found.
+ */
+int8_t ice_thickness_estimate(const uint16_t *bins, size_t num_bins,
+                              ice_thickness_estimate_t *estimate);
+int8_t ice_thickness_estimate(const float *bins, size_t num_bins,
+                              ice_thickness_estimate_t *estimate);
+
+/**
+ * Estimates the ice thickness from a zoomed spectrum, see radar_fft.hpp. Same as
+ * ice_thickness_estimate() on a finer range axis, the bins of the returned peaks are zoom bins.
+ * @param bins The zoomed magnitudes
+ * @param num_bins The number of entries in bins
+ * @param start_m The range of bins[0], no further than the start of the range gate
+ * @param step_m The range between neighbouring bins
+ * @param estimate Pointer to store the estimate in
+ *
+ * @return 0 on success, -1 on invalid arguments, -2 if fewer than two peaks were found.
+ */
+int8_t ice_thickness_estimate_zoom(const uint16_t *bins, size_t num_bins, float start_m,
+                                   float step_m, ice_thickness_estimate_t *estimate);
+
+/**
+ * Estimates the ice thickness from a frame, from its zoomed spectrum when it has one.
+ * @param frame The frame
+ * @param estimate Pointer to store the estimate in
+ *
+ * @return 0 on success, -1 on invalid arguments, -2 if fewer than two peaks were found.
+ */
+int8_t ice_thickness_estimate(const fmcw_fft_frame_t *frame, ice_thickness_estimate_t *estimate);
+
+/**
+ * Converts a (fractional) FFT bin to the distance from the radar.
+ * @param bin The FFT bin
+ *
+ * @return The range in meters.
+ */
+float ice_thickness_bin_to_range_m(float bin);
+
+#endif // #ifndef ICE_THICKNESS_H
@@ -0,0 +1,99 @@
+/**
+ *
+ * Name: radar_fft.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes the on-board FFT engine for the radar's raw ADC samples. One chirp of
+ * I/Q samples is windowed and transformed into the same zero-padded spectrum the radar's own
+ * FFT output has, and a chirp-Z (zoom) transform evaluates the spectrum on a much finer grid
+ * over just the range gate the ice is in. Twiddles, bit reversal and the window are computed
+ * at compile time for the chirp length the radar is configured with.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef RADAR_FFT_H
+#define RADAR_FFT_H
+
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------
+#define RADAR_FFT_CHIRP_SAMPLES 128 // I/Q samples per chirp, the radar's S( setting
+#define RADAR_FFT_SIZE 1024         // zero-padded like the radar's x8 setting
+#define RADAR_FFT_BINS (RADAR_FFT_SIZE / 2) // positive frequencies, FMCW_RADAR_FFT_SIZE
+
+#define RADAR_ZOOM_MAX_POINTS 256
+#define RADAR_ZOOM_CONV_SIZE 512 // circular convolution length, >= chirp + points - 1
+
+typedef struct radar_complex
+{
+	float re;
+	float im;
+} radar_complex_t;
+
+// Chirp-Z transform over [start_m, start_m + (num_points - 1) * step_m] with Bluestein's
+// algorithm, see radar_zoom_plan_init(). Build it once and reuse it for every chirp.
+typedef struct radar_zoom_plan
+{
+	float start_m;
+	float step_m;
+	uint16_t num_points;
+	radar_complex_t premultiply[RADAR_FFT_CHIRP_SAMPLES]; // window * A^-n * W^(n^2 / 2)
+	radar_complex_t chirp_filter[RADAR_ZOOM_CONV_SIZE];   // FFT of W^(-m^2 / 2), scaled
+} radar_zoom_plan_t;
+
+//----------------------------------------------------------------
+
+/**
+ * Computes the magnitude spectrum of one chirp: the mean is removed from each channel, a Hann
+ * window applied and the 1024 point FFT of the zero-padded samples taken, the same as the
+ * offline processing in scripts/ops_serial.py. Magnitudes are in ADC counts of the beat
+ * tone's amplitude. The zero padding is never transformed, the padded FFT is computed as
+ * RADAR_FFT_SIZE / RADAR_FFT_CHIRP_SAMPLES interleaved FFTs of the chirp length.
+ * @param i The in-phase samples
+ * @param q The quadrature samples
+ * @param num_samples The number of samples, RADAR_FFT_CHIRP_SAMPLES
+ * @param magnitude Where to store RADAR_FFT_BINS magnitudes, bin k is k * fs / 1024 Hz
+ *
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int8_t radar_fft_spectrum(const float *i, const float *q, size_t num_samples, float *magnitude);
+
+/**
+ * Plans a chirp-Z transform that evaluates the chirp's spectrum at evenly spaced ranges.
+ * @param plan The plan to fill in
+ * @param start_m The range of the first point
+ * @param end_m The range of the last point
+ * @param num_points The number of points, between 2 and RADAR_ZOOM_MAX_POINTS
+ *
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int8_t radar_zoom_plan_init(radar_zoom_plan_t *plan, float start_m, float end_m,
+                            size_t num_points);
+
+/**
+ * Evaluates the magnitude spectrum of one chirp at the plan's ranges, scaled and windowed
+ * like radar_fft_spectrum() so the two can be compared.
+ * @param plan The plan from radar_zoom_plan_init()
+ * @param i The in-phase samples
+ * @param q The quadrature samples
+ * @param num_samples The number of samples, RADAR_FFT_CHIRP_SAMPLES
+ * @param magnitude Where to store plan->num_points magnitudes
+ *
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int8_t radar_zoom_spectrum(const radar_zoom_plan_t *plan, const float *i, const float *q,
+                           size_t num_samples, float *magnitude);
+
+/**
+ * Converts a beat frequency to the distance from the radar.
+ * @param hz The beat frequency
+ *
+ * @return The range in meters.
+ */
+double radar_fft_hz_to_range_m(double hz);
+
+#endif // #ifndef RADAR_FFT_H
@@ -0,0 +1,46 @@
+/**
+ *
+ * Name: spectrum_stack.hpp
+ * Author: Karran Dhillon
+ *
+ * This file describes the stacking stage that combines the FFT frames captured during one
+ * stop into a single, cleaner spectrum.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef SPECTRUM_STACK_H
+#define SPECTRUM_STACK_H
+
+#include "bsp/fmcw_radar_sensor.hpp"
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------
+#define SPECTRUM_STACK_MAX_FRAMES 64
+
+typedef struct spectrum_stack_result
+{
+	uint16_t num_frames;                // number of frames that were stacked
+	float mean[FMCW_RADAR_FFT_SIZE];    // element-wise mean of the frames
+	float median[FMCW_RADAR_FFT_SIZE];  // element-wise median of the frames
+	float noise_floor;                  // median magnitude of the mean spectrum
+	float peak_snr_db;                  // strongest bin of the mean spectrum over the noise floor
+} spectrum_stack_result_t;
+
+//----------------------------------------------------------------
+
+/**
+ * Stacks FFT frames bin by bin. Uses NEON on ARM and plain C++ everywhere else.
+ * @param frames The frames to stack, all with FMCW_RADAR_FFT_SIZE bins
+ * @param num_frames The number of frames, between 1 and SPECTRUM_STACK_MAX_FRAMES
+ * @param result Pointer to store the stacked spectrum and its statistics in
+ *
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int8_t spectrum_stack(const fmcw_fft_frame_t *const *frames, size_t num_frames,
+                      spectrum_stack_result_t *result);
+
+#endif // #ifndef SPECTRUM_STACK_H
@@ -0,0 +1,111 @@
+/**
+ *
+ * Name: coverage_grid.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes the coverage grid that remembers where the flight has measured the ice.
+ * Stops are binned into square cells of a flat local east/north plane centered on the first
+ * stop, and each cell keeps running statistics (Welford's algorithm) of the thicknesses
+ * measured in it. Occupied cells live in a fixed open addressing hash table, so adding a stop
+ * and looking up a cell take constant time and nothing is allocated during the flight.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef COVERAGE_GRID_H
+#define COVERAGE_GRID_H
+
+#include "nav/motion_estimator.hpp"
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------
+#define COVERAGE_GRID_CAPACITY 1024 // slots, a power of two
+#define COVERAGE_GRID_MAX_CELLS (COVERAGE_GRID_CAPACITY * 3 / 4) // keeps probe sequences short
+
+typedef struct coverage_cell
+{
+	int32_t east_index; // cell column, floor(east_m / cell_size_m)
+	int32_t north_index;
+	uint32_t num_stops; // 0 marks an empty slot
+
+	// mean position of the cell's stops in the local plane
+	double east_m;
+	double north_m;
+
+	// thickness statistics over the cell's stops
+	double mean_m;
+	double m2;                // sum of squared differences from the mean
+	double best_half_width_m; // narrowest confidence half-width of any one stop in the cell
+} coverage_cell_t;
+
+typedef struct coverage_grid
+{
+	double cell_size_m;
+	enu_origin_t origin; // first stop of the flight
+	bool has_origin;
+	size_t num_cells;
+	coverage_cell_t cells[COVERAGE_GRID_CAPACITY];
+} coverage_grid_t;
+
+//----------------------------------------------------------------
+
+void coverage_grid_init(coverage_grid_t *grid, double cell_size_m);
+
+/**
+ * Adds one stop's thickness to the cell it is in.
+ * @param grid The grid
+ * @param latitude The stop's latitude in degrees
+ * @param longitude The stop's longitude in degrees
+ * @param thickness_m The stop's thickness estimate
+ * @param half_width_m The confidence half-width of that estimate
+ *
+ * @return The stop's cell, or nullptr if the stop is in a new cell and COVERAGE_GRID_MAX_CELLS
+ *         are in use already.
+ */
+const coverage_cell_t *coverage_grid_add_stop(coverage_grid_t *grid, double latitude,
+                                              double longitude, double thickness_m,
+                                              double half_width_m);
+
+/**
+ * @return The cell a position is in, or nullptr if no stop was made in it yet.
+ */
+const coverage_cell_t *coverage_grid_cell_at(const coverage_grid_t *grid, double latitude,
+                                             double longitude);
+
+/**
+ * Finds the covered cell whose stops are closest to a position. Looks at every cell within
+ * max_distance_m, so it takes (2 * max_distance_m / cell_size_m + 3)^2 lookups at most.
+ * @param grid The grid
+ * @param latitude The position's latitude in degrees
+ * @param longitude The position's longitude in degrees
+ * @param max_distance_m How far to look
+ * @param distance_m Pointer to store the distance to the cell's mean stop position in
+ *
+ * @return The nearest cell, or nullptr if there is none within max_distance_m.
+ */
+const coverage_cell_t *coverage_grid_nearest(const coverage_grid_t *grid, double latitude,
+                                             double longitude, double max_distance_m,
+                                             double *distance_m);
+
+/**
+ * How uncertain a cell's thickness is: the standard deviation of its stops' thicknesses, but
+ * no less than the narrowest confidence half-width of a single stop in it.
+ */
+double coverage_cell_uncertainty_m(const coverage_cell_t *cell);
+
+/**
+ * Lists the cells with the most uncertain thickness, most uncertain first. Scans the whole
+ * table, so it is meant for the end of a stop rather than every frame.
+ * @param grid The grid
+ * @param cells Array to store the cells in
+ * @param max_cells The capacity of cells
+ *
+ * @return The number of cells stored.
+ */
+size_t coverage_grid_most_uncertain(const coverage_grid_t *grid, const coverage_cell_t **cells,
+                                    size_t max_cells);
+
+#endif // #ifndef COVERAGE_GRID_H
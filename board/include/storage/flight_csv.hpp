@@ -0,0 +1,63 @@
+/**
+ *
+ * Name: flight_csv.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes the parser for the flight CSV the webapp ingests, the output of
+ * scripts/flight_log_to_csv.py. One row per radar frame:
+ *
+ *     YYYY-MM-DD HH:MM:SS,latitude,longitude,temperature,bin0,bin1,...,bin511
+ *
+ * Rows are parsed in place, so a file can be mapped into memory and split between threads at
+ * any row boundary.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef FLIGHT_CSV_H
+#define FLIGHT_CSV_H
+
+#include "bsp/fmcw_radar_sensor.hpp"
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------
+#define FLIGHT_CSV_TIMESTAMP_SIZE 19 // "YYYY-MM-DD HH:MM:SS"
+
+typedef struct flight_csv_row
+{
+	char timestamp[FLIGHT_CSV_TIMESTAMP_SIZE + 1]; // local time as written, null terminated
+	double latitude;
+	double longitude;
+	float temperature;
+	uint16_t bins[FMCW_RADAR_FFT_SIZE];
+} flight_csv_row_t;
+
+//----------------------------------------------------------------
+
+/**
+ * Parses one row of a flight CSV.
+ * @param line The row, without its newline. A trailing carriage return is ignored.
+ * @param len The number of characters in line
+ * @param row Pointer to store the parsed row in
+ *
+ * @return 0 on success, -1 on invalid arguments, -2 on a malformed timestamp, -3 on a
+ *         malformed position or temperature, -4 if the row does not hold FMCW_RADAR_FFT_SIZE
+ *         valid bins.
+ */
+int8_t flight_csv_parse_row(const char *line, size_t len, flight_csv_row_t *row);
+
+/**
+ * Finds where the first row starting at or after an offset begins, to split a file between
+ * threads.
+ * @param text The file's contents
+ * @param len The number of characters in text
+ * @param offset Where to start looking
+ *
+ * @return The offset of the row, len if no row starts at or after offset.
+ */
+size_t flight_csv_row_start(const char *text, size_t len, size_t offset);
+
+#endif // #ifndef FLIGHT_CSV_H
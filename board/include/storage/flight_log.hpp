@@ -0,0 +1,203 @@
+/**
+ *
+ * Name: flight_log.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes the binary flight log that stores the raw measurements of a flight.
+ * scripts/flight_log_to_csv.py converts it to the CSV the webapp expects.
+ *
+ * File layout (little endian):
+ *     flight_log_header_t, then flight_log_record_t back to back. A frame computed on board
+ *     also has a zoomed spectrum over the ice range gate, which a record carries after the
+ *     bins; num_zoom_bins is 0 in the records of other frames. An append log grows with
+ *     every record. A ring log is preallocated to ring_capacity records when it is created and
+ *     record n lives in slot n % ring_capacity, so the oldest records are overwritten once the
+ *     ring is full.
+ *
+ *     A packed log (FLIGHT_LOG_PACKED in the header's flags) stores the bins with the codec in
+ *     spectrum_codec.hpp instead, so its records vary in size: flight_log_packed_record_t,
+ *     the encoded bins, the encoded zoom bins, a CRC-32 of all of them and zero padding to a
+ *     multiple of 8 bytes. Most records' bins are encoded against the record before them, a
+ *     keyframe stands on its own and starts each run of FLIGHT_LOG_KEYFRAME_INTERVAL records.
+ *     The zoom bins are always encoded on their own, the zoom moves with the ice. A packed
+ *     ring log has ring_capacity bytes for records. A record that does not fit before the end
+ *     of the ring goes at its start and the rest of the end is zeroed, and write_offset counts
+ *     every byte ever used including those. The oldest records are found by looking for the
+ *     first intact record after the write cursor.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef FLIGHT_LOG_H
+#define FLIGHT_LOG_H
+
+#include "bsp/fmcw_radar_sensor.hpp"
+#include "common/async_writer.h"
+#include "storage/spectrum_codec.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+//----------------------------------------------------------------
+#define FLIGHT_LOG_MAGIC "SAUVLOG" // 7 characters plus the terminator fills magic[8]
+#define FLIGHT_LOG_VERSION 2 // 2 added the zoomed spectrum
+
+#define FLIGHT_LOG_PACKED 0x1 // header flag, records are encoded with spectrum_codec.hpp
+
+typedef struct flight_log_header
+{
+	char magic[8];
+	uint16_t version;
+	uint16_t header_size; // sizeof(flight_log_header_t)
+	uint16_t record_size; // sizeof(flight_log_record_t), 0 in a packed log
+	uint16_t num_bins;    // FFT bins per record
+	uint64_t created_usec;
+	uint32_t ring_capacity; // records in a ring log (bytes if packed), 0 for an append log
+	uint32_t flags;         // FLIGHT_LOG_PACKED
+	uint64_t write_count;   // ring logs only: records ever written, the write cursor
+	uint64_t write_offset;  // packed ring logs only: bytes ever used, the write cursor
+	uint16_t num_zoom_bins; // capacity for zoom bins of an unpacked record
+	uint8_t reserved[14];
+} flight_log_header_t;
+
+typedef struct flight_log_record
+{
+	uint64_t timestamp_usec; // radar frame capture time, microseconds since the Unix epoch
+	double latitude;
+	double longitude;
+	float temperature; // celcius
+	uint32_t sequence; // radar frame sequence number
+	uint16_t num_bins;
+	uint16_t flags; // reserved, always 0
+	uint16_t bins[FMCW_RADAR_FFT_SIZE];
+	uint16_t num_zoom_bins; // 0 without a zoomed spectrum
+	uint16_t zoom_reserved; // always 0
+	float zoom_start_m;     // range of zoom_bins[0]
+	float zoom_step_m;      // range between neighbouring zoom bins
+	uint16_t zoom_bins[FMCW_RADAR_ZOOM_SIZE];
+	uint32_t reserved; // always 0, keeps the CRC at the very end of the record
+	uint32_t crc;      // CRC-32 (same as zlib.crc32) of every byte before it
+} flight_log_record_t;
+
+#define FLIGHT_LOG_PACKED_SYNC 0x52565541u // "AUVR", marks the start of a packed record
+#define FLIGHT_LOG_RECORD_KEYFRAME 0x1    // packed record flag, bins do not need the last record
+#define FLIGHT_LOG_KEYFRAME_INTERVAL 20   // a stop's worth of frames
+
+typedef struct flight_log_packed_record
+{
+	uint32_t sync;         // FLIGHT_LOG_PACKED_SYNC
+	uint16_t payload_size; // bytes of encoded bins and zoom bins that follow
+	uint16_t flags;        // FLIGHT_LOG_RECORD_KEYFRAME
+	uint64_t offset;       // bytes of records before this one, write_offset in a ring log
+	uint64_t timestamp_usec;
+	double latitude;
+	double longitude;
+	float temperature;
+	uint32_t sequence; // radar frame sequence number
+	uint16_t num_bins;
+	uint16_t num_zoom_bins;
+	uint32_t index; // records written to the log before this one, a delta needs index - 1
+	float zoom_start_m;
+	float zoom_step_m;
+} flight_log_packed_record_t;
+
+#define FLIGHT_LOG_PACKED_ALIGN 8
+#define FLIGHT_LOG_PACKED_MAX_PAYLOAD                                                             \
+	(SPECTRUM_CODEC_MAX_SIZE(FMCW_RADAR_FFT_SIZE) + SPECTRUM_CODEC_MAX_SIZE(FMCW_RADAR_ZOOM_SIZE))
+#define FLIGHT_LOG_PACKED_MAX_SIZE                                                                \
+	((sizeof(flight_log_packed_record_t) + FLIGHT_LOG_PACKED_MAX_PAYLOAD + sizeof(uint32_t) +     \
+	  FLIGHT_LOG_PACKED_ALIGN - 1) /                                                              \
+	 FLIGHT_LOG_PACKED_ALIGN * FLIGHT_LOG_PACKED_ALIGN)
+
+static_assert(sizeof(flight_log_header_t) == 64, "flight log header layout changed");
+static_assert(sizeof(flight_log_record_t) ==
+                  56 + 2 * FMCW_RADAR_FFT_SIZE + 2 * FMCW_RADAR_ZOOM_SIZE,
+              "flight log record layout changed");
+static_assert(sizeof(flight_log_packed_record_t) == 64, "packed flight log record layout changed");
+
+//----------------------------------------------------------------
+// Append log: records reach the file within FLIGHT_LOG_FLUSH_INTERVAL_MS and the SD card within
+// FLIGHT_LOG_FSYNC_INTERVAL_MS, or right away on sync()
+#define FLIGHT_LOG_BUFFER_SIZE (256 * 1024) // about 8 s of radar frames per half buffer
+#define FLIGHT_LOG_FLUSH_INTERVAL_MS 200
+#define FLIGHT_LOG_FSYNC_INTERVAL_MS 1000
+
+class FLIGHT_LOG_WRITER
+{
+public:
+	FLIGHT_LOG_WRITER();
+
+	// FLIGHT_LOG_WRITER owns its file, it should not be cloneable.
+	FLIGHT_LOG_WRITER(FLIGHT_LOG_WRITER &other) = delete;
+
+	// FLIGHT_LOG_WRITER should not be assignable.
+	void operator=(const FLIGHT_LOG_WRITER &) = delete;
+
+	int8_t open(const char *path, uint32_t ring_capacity = 0, uint32_t flags = 0);
+	int8_t append(flight_log_record_t *record);
+	void sync();
+	void close();
+	bool is_open() const;
+
+	~FLIGHT_LOG_WRITER();
+
+private:
+	int8_t start_writer();
+	int8_t open_ring(const char *path, uint32_t ring_capacity, uint32_t flags, off_t file_size);
+	void recover_ring();
+	int8_t recover_packed(off_t file_size);
+	void recover_packed_ring();
+	size_t pack(const flight_log_record_t *record, uint64_t index);
+	void seal(size_t size, uint64_t offset);
+	int8_t append_packed(const flight_log_record_t *record);
+
+private:
+	int fd;
+	struct async_writer *writer; // append log: records are written and fsynced off the sensor loop
+
+	// ring log: the whole file is mapped and records are copied straight into it
+	size_t map_size;
+	flight_log_header_t *ring_header; // start of the mapping
+	flight_log_record_t *ring_records;
+	uint8_t *ring_bytes; // packed ring log, in place of ring_records
+
+	// packed log: the last record's bins, which the next record is encoded against
+	bool packed;
+	bool have_reference;
+	uint16_t reference_num_bins;
+	uint32_t since_keyframe;
+	uint64_t write_offset; // append log: bytes of records in the file
+	uint64_t record_count; // append log: records in the file
+	uint16_t reference[FMCW_RADAR_FFT_SIZE];
+	uint8_t packed_record[FLIGHT_LOG_PACKED_MAX_SIZE];
+};
+
+//----------------------------------------------------------------
+
+/**
+ * Fills in a record from one set of sensor readings. The CRC is computed when appending.
+ */
+void flight_log_make_record(double latitude, double longitude, double temperature,
+                            const fmcw_fft_frame_t *frame, flight_log_record_t *record);
+
+bool flight_log_header_valid(const flight_log_header_t *header);
+bool flight_log_record_valid(const flight_log_record_t *record);
+
+/**
+ * Checks for an intact packed record at the start of some bytes.
+ * @param data The bytes
+ * @param len The number of bytes available
+ * @param offset The offset the record should have been written at
+ *
+ * @return The size of the record including its padding, 0 if there is no intact record.
+ */
+size_t flight_log_packed_record_size(const uint8_t *data, size_t len, uint64_t offset);
+
+/**
+ * CRC-32 with the zlib/PNG polynomial, so Python can check records with zlib.crc32().
+ */
+uint32_t flight_log_crc32(const void *data, size_t len);
+
+#endif // #ifndef FLIGHT_LOG_H
@@ -0,0 +1,65 @@
+/**
+ *
+ * Name: spectrum_codec.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes the lossless codec for the FFT bins stored in packed flight logs. Each
+ * bin is stored as its difference from a reference: the same bin of the previous frame, or
+ * for a keyframe the bin before it in the same frame. Differences are zigzag encoded so small
+ * negative ones stay small, and bit-packed in blocks of SPECTRUM_CODEC_BLOCK_BINS with the
+ * width of the block's largest difference in front.
+ *
+ * Encoded layout, one block after another:
+ *     uint8_t width (0 to 17), then the block's bins * width bits, least significant first,
+ *     padded to a whole byte. A width of 0 means every bin equals its reference.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef SPECTRUM_CODEC_H
+#define SPECTRUM_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------
+#define SPECTRUM_CODEC_BLOCK_BINS 16
+#define SPECTRUM_CODEC_MAX_WIDTH 17 // zigzag of a difference between two uint16_t
+
+// Largest encoding of num_bins bins, when every block needs the full width
+#define SPECTRUM_CODEC_MAX_SIZE(num_bins)                                                         \
+	((((num_bins) + SPECTRUM_CODEC_BLOCK_BINS - 1) / SPECTRUM_CODEC_BLOCK_BINS) *                \
+	 (1 + (SPECTRUM_CODEC_BLOCK_BINS * SPECTRUM_CODEC_MAX_WIDTH + 7) / 8))
+
+//----------------------------------------------------------------
+
+/**
+ * Encodes a frame's bins.
+ * @param bins The bins to encode
+ * @param reference The previous frame's bins, or nullptr to encode a keyframe
+ * @param num_bins The number of bins in both
+ * @param out Where to store the encoding
+ * @param out_size The capacity of out, SPECTRUM_CODEC_MAX_SIZE(num_bins) always fits
+ *
+ * @return The number of bytes stored, -1 on invalid arguments, -2 if out is too small.
+ */
+int spectrum_encode(const uint16_t *bins, const uint16_t *reference, size_t num_bins, uint8_t *out,
+                    size_t out_size);
+
+/**
+ * Decodes a frame's bins.
+ * @param data The encoding
+ * @param len The length of data
+ * @param reference The bins of the frame it was encoded against, or nullptr for a keyframe
+ * @param num_bins The number of bins to decode
+ * @param bins Where to store the bins
+ *
+ * @return The number of bytes of data used, -1 on invalid arguments, -2 if data is cut short
+ *         or does not decode to valid bins.
+ */
+int spectrum_decode(const uint8_t *data, size_t len, const uint16_t *reference, size_t num_bins,
+                    uint16_t *bins);
+
+#endif // #ifndef SPECTRUM_CODEC_H
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+"""
+Name: flight_log_to_csv.py
+Author: Hubert Dang
+
+Converts a binary flight log (snow_angel_uav_raw_YYYYMMDD_HHMMSS.bin) written by the board
+into the CSV the webapp expects:
+
+    YYYY-MM-DD HH:MM:SS,latitude,longitude,temperature,bin0,bin1,...,bin511
+
+The layout must match include/storage/flight_log.hpp and the bins of packed logs are decoded
+like src/storage/spectrum_codec.cpp. Append logs and ring logs, packed or not, are supported;
+ring logs are read oldest record first. Records with a bad CRC and a trailing partial record
+(e.g. from a crash) are skipped, and so are packed records encoded against one of those.
+
+Frames the board computed itself also have a zoomed spectrum over the ice range gate. With a
+third argument those are written to their own CSV, one line per frame that has one:
+
+    YYYY-MM-DD HH:MM:SS,zoom_start_m,zoom_step_m,zoom_bin0,zoom_bin1,...
+
+Usage: ./flight_log_to_csv.py snow_angel_uav_raw_YYYYMMDD_HHMMSS.bin [output.csv [zoom.csv]]
+
+Date: November 2025
+
+Copyright 2025 SnowAngel-UAV
+"""
+
+import struct
+import sys
+import zlib
+from datetime import datetime
+
+MAGIC = b"SAUVLOG\0"
+VERSION = 2
+
+HEADER = struct.Struct("<8sHHHHQIIQQH14x")
+RECORD_PREFIX = struct.Struct("<QddfIHH")  # fields before the bins
+RECORD_ZOOM = struct.Struct("<HHff")  # fields between the bins and the zoom bins
+RECORD_RESERVED = struct.Struct("<I")  # between the zoom bins and the CRC
+CRC = struct.Struct("<I")
+
+PACKED = 0x1  # header flag
+PACKED_SYNC = 0x52565541
+PACKED_RECORD = struct.Struct("<IHHQQddfIHHIff")  # flight_log_packed_record_t
+PACKED_KEYFRAME = 0x1
+PACKED_ALIGN = 8
+CODEC_BLOCK_BINS = 16
+CODEC_MAX_WIDTH = 17
+
+
+def decode_bins(payload, reference, num_bins):
+    """(bins, bytes used) of encoded bins, reference is the previous record's bins or None for
+    a keyframe."""
+    bins = []
+    pos = 0
+    previous = 0
+    for start in range(0, num_bins, CODEC_BLOCK_BINS):
+        count = min(CODEC_BLOCK_BINS, num_bins - start)
+        width = payload[pos]
+        size = (count * width + 7) // 8
+        pos += 1
+        if width > CODEC_MAX_WIDTH or pos + size > len(payload):
+            raise ValueError("corrupt packed bins")
+        if width == 0 and reference is not None:
+            bins.extend(reference[start:start + count])
+            continue
+
+        # the whole block as one integer, each bin is the next width bits
+        block = int.from_bytes(payload[pos:pos + size], "little")
+        pos += size
+        mask = (1 << width) - 1
+        for k in range(count):
+            zigzag = block & mask
+            block >>= width
+            base = reference[start + k] if reference is not None else previous
+            previous = base + ((zigzag >> 1) ^ -(zigzag & 1))
+            bins.append(previous)
+    if any(b < 0 or b > 0xFFFF for b in bins):
+        raise ValueError("corrupt packed bins")
+    return bins, pos
+
+
+def packed_record_at(data, pos, end, offset):
+    """(size, fields, payload) of the intact packed record written at offset that starts at
+    data[pos] and ends before data[end], or None."""
+    if pos + PACKED_RECORD.size > end:
+        return None
+    fields = PACKED_RECORD.unpack_from(data, pos)
+    sync, payload_size, _, record_offset = fields[:4]
+    if sync != PACKED_SYNC or record_offset != offset:
+        return None
+
+    crc_at = pos + PACKED_RECORD.size + payload_size
+    size = -(-(crc_at + CRC.size - pos) // PACKED_ALIGN) * PACKED_ALIGN
+    if pos + size > end:
+        return None
+    (crc,) = CRC.unpack_from(data, crc_at)
+    if zlib.crc32(data[pos:crc_at]) != crc:
+        return None
+    return size, fields, data[pos + PACKED_RECORD.size:crc_at]
+
+
+def read_packed_records(path, data, header_size, ring_capacity, write_offset):
+    """Yield (timestamp_usec, lat, lon, temperature, bins, zoom) for every decodable packed
+    record, zoom is (start_m, step_m, bins) or None."""
+    if ring_capacity:
+        if len(data) != header_size + ring_capacity:
+            raise ValueError(f"{path} is not the size its ring capacity says")
+        offset = max(0, write_offset - ring_capacity)
+        end_offset = write_offset
+        end = len(data)
+    else:
+        offset = 0
+        end_offset = len(data) - header_size
+        end = len(data)
+
+    reference = None
+    last_index = None
+    found = False
+    damaged = 0
+    undecodable = 0
+
+    while offset < end_offset:
+        pos = header_size + (offset % ring_capacity if ring_capacity else offset)
+        record = packed_record_at(data, pos, end, offset)
+        if record is None:
+            # the zeroed end of a ring, or a damaged record: look for the next one
+            if (found or not ring_capacity) and any(data[pos:pos + PACKED_ALIGN]):
+                damaged += PACKED_ALIGN
+            offset += PACKED_ALIGN
+            continue
+
+        size, fields, payload = record
+        offset += size
+        found = True
+        (_, _, flags, _, timestamp_usec, lat, lon, temperature, _, num_bins, num_zoom_bins, index,
+         zoom_start_m, zoom_step_m) = fields
+        try:
+            if flags & PACKED_KEYFRAME:
+                bins, used = decode_bins(payload, None, num_bins)
+            elif reference is not None and index == (last_index + 1) & 0xFFFFFFFF and \
+                    len(reference) == num_bins:
+                bins, used = decode_bins(payload, reference, num_bins)
+            else:
+                raise ValueError("the record it was encoded against is gone")
+        except ValueError:
+            undecodable += 1
+            reference = None
+            continue
+
+        reference, last_index = bins, index
+        zoom = None
+        if num_zoom_bins:
+            try:
+                zoom_bins, _ = decode_bins(payload[used:], None, num_zoom_bins)
+                zoom = (zoom_start_m, zoom_step_m, zoom_bins)
+            except ValueError:
+                undecodable += 1
+        yield timestamp_usec, lat, lon, temperature, bins, zoom
+
+    if damaged:
+        print(f"[WARNING] Skipped {damaged} bytes of damaged records", file=sys.stderr)
+    if undecodable:
+        print(f"[WARNING] Skipped {undecodable} records encoded against a missing record",
+              file=sys.stderr)
+
+
+def read_records(path):
+    """Yield (timestamp_usec, lat, lon, temperature, bins, zoom) for every intact record, zoom
+    is (start_m, step_m, bins) or None."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if len(data) < HEADER.size:
+        raise ValueError(f"{path} is too small to be a flight log")
+
+    (magic, version, header_size, record_size, num_bins, _, ring_capacity, flags, write_count,
+     write_offset, num_zoom_bins) = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION or header_size != HEADER.size:
+        raise ValueError(f"{path} is not a version {VERSION} flight log")
+    if flags & PACKED:
+        yield from read_packed_records(path, data, header_size, ring_capacity, write_offset)
+        return
+    zoom_at = RECORD_PREFIX.size + 2 * num_bins
+    if record_size != zoom_at + RECORD_ZOOM.size + 2 * num_zoom_bins + RECORD_RESERVED.size + \
+            CRC.size:
+        raise ValueError(f"{path} has an unexpected record size {record_size}")
+
+    bins_format = struct.Struct(f"<{num_bins}H")
+    zoom_format = struct.Struct(f"<{num_zoom_bins}H")
+    skipped = 0
+
+    if ring_capacity:
+        if len(data) != header_size + ring_capacity * record_size:
+            raise ValueError(f"{path} is not the size its ring capacity says")
+        first = max(0, write_count - ring_capacity)
+        offsets = [header_size + (n % ring_capacity) * record_size for n in range(first, write_count)]
+        end = len(data)
+    else:
+        count = (len(data) - header_size) // record_size
+        offsets = [header_size + n * record_size for n in range(count)]
+        end = header_size + count * record_size
+
+    for offset in offsets:
+        record = data[offset:offset + record_size]
+
+        (crc,) = CRC.unpack_from(record, record_size - CRC.size)
+        if zlib.crc32(record[:-CRC.size]) != crc:
+            skipped += 1
+            continue
+
+        timestamp_usec, lat, lon, temperature, _, record_bins, _ = RECORD_PREFIX.unpack_from(record)
+        bins = bins_format.unpack_from(record, RECORD_PREFIX.size)[:record_bins]
+        record_zoom_bins, _, zoom_start_m, zoom_step_m = RECORD_ZOOM.unpack_from(record, zoom_at)
+        zoom = None
+        if record_zoom_bins:
+            zoom_bins = zoom_format.unpack_from(record, zoom_at + RECORD_ZOOM.size)
+            zoom = (zoom_start_m, zoom_step_m, zoom_bins[:record_zoom_bins])
+        yield timestamp_usec, lat, lon, temperature, bins, zoom
+
+    if end != len(data):
+        print(f"[WARNING] Ignoring {len(data) - end} bytes of a truncated record", file=sys.stderr)
+    if skipped:
+        print(f"[WARNING] Skipped {skipped} records with a bad CRC", file=sys.stderr)
+
+
+def main():
+    if len(sys.argv) not in (2, 3, 4):
+        print(__doc__)
+        sys.exit(1)
+
+    out = open(sys.argv[2], "w") if len(sys.argv) >= 3 else sys.stdout
+    zoom_out = open(sys.argv[3], "w") if len(sys.argv) == 4 else None
+    count = 0
+    zoom_count = 0
+    for timestamp_usec, lat, lon, temperature, bins, zoom in read_records(sys.argv[1]):
+        when = datetime.fromtimestamp(timestamp_usec / 1e6).strftime("%Y-%m-%d %H:%M:%S")
+        out.write(f"{when},{lat:.6f},{lon:.6f},{temperature:.2f},{','.join(map(str, bins))}\n")
+        count += 1
+        if zoom is not None and zoom_out is not None:
+            start_m, step_m, zoom_bins = zoom
+            zoom_out.write(f"{when},{start_m:.4f},{step_m:.6f},{','.join(map(str, zoom_bins))}\n")
+            zoom_count += 1
+
+    if out is not sys.stdout:
+        out.close()
+    if zoom_out is not None:
+        zoom_out.close()
+        print(f"[INFO] Wrote {zoom_count} zoomed spectra", file=sys.stderr)
+    print(f"[INFO] Converted {count} records", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
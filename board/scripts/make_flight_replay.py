@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""
+Name: make_flight_replay.py
+Author: Hubert Dang
+
+Writes a flight replay for the RADAR_SIMULATION drivers (see src/bsp/flight_replay.hpp): a
+drone that hovers, then flies a line of survey stops over the test site. The radar streams
+the FFT of sim/radar_ice_fft_data.sim with a little noise at 20 Hz, the GPS sends RMC and GGA
+at 10 Hz and the temperature is sampled at 4 Hz, one event per line:
+
+    <usec since start> R {"FFT":[...]}
+    <usec since start> G $GNGGA,...*hh
+    <usec since start> T -12.43
+
+With --adc the radar streams raw chirps instead, for a RADAR_ADC_CAPTURE build: an
+{"I":[...]} and a {"Q":[...]} line of 128 samples each with reflections from the ice surface
+and bottom (see src/dsp/radar_fft.hpp).
+
+Usage: ./make_flight_replay.py [--stops N] [--seed N] [--adc] [output.replay]
+       SNOW_ANGEL_REPLAY=output.replay ./snow_angel_uav_app
+       ./bench_pipeline output.replay
+
+Date: November 2025
+
+Copyright 2025 SnowAngel-UAV
+"""
+
+import argparse
+import math
+import os
+import random
+import sys
+from datetime import datetime, timedelta, timezone
+
+SIM_FFT_PATH = os.path.join(os.path.dirname(__file__), "..", "sim", "radar_ice_fft_data.sim")
+
+START_LATITUDE = 45.3848
+START_LONGITUDE = -75.7047
+METERS_PER_DEG_LAT = 111132.954
+
+RADAR_PERIOD_USEC = 50000
+GPS_PERIOD_USEC = 100000
+TEMPERATURE_PERIOD_USEC = 250000
+
+HOVER_SEC = 3.0
+STOP_SEC = 6.0  # long enough to settle and profile a stop
+LEG_METERS = 20.0
+FLY_SPEED_MPS = 4.0
+POSITION_NOISE_M = 0.05
+BIN_NOISE = 0.02  # relative
+
+# raw chirps, the radar configuration in src/bsp/ops_fmcw.hpp
+CHIRP_SAMPLES = 128
+SAMPLE_RATE_HZ = 80e3
+CHIRP_SLOPE_HZ_PER_S = 990e6 / 1.6e-3
+ADC_MID_SCALE = 2048
+ADC_NOISE = 3.0  # counts
+# (range m, amplitude) of the ice surface and bottom, 35 cm apart: 128 windowed samples
+# cannot tell reflections much closer than that apart
+REFLECTIONS = [(0.40, 600.0), (0.75, 250.0)]
+
+
+def nmea(body):
+    checksum = 0
+    for ch in body.encode("ascii"):
+        checksum ^= ch
+    return f"${body}*{checksum:02X}"
+
+
+def nmea_coordinate(degrees, digits, positive, negative):
+    hemisphere = positive if degrees >= 0 else negative
+    degrees = abs(degrees)
+    whole = int(degrees)
+    minutes = (degrees - whole) * 60
+    return f"{whole:0{digits}d}{minutes:07.4f}", hemisphere
+
+
+def adc_chirp(rng):
+    """I and Q lines of one chirp, every reflection at a random phase."""
+    meters_per_hz = 3e8 / (2 * CHIRP_SLOPE_HZ_PER_S)
+    tones = [(2 * math.pi * (r / meters_per_hz) / SAMPLE_RATE_HZ, a, rng.uniform(0, 2 * math.pi))
+             for r, a in REFLECTIONS]
+    i_samples, q_samples = [], []
+    for n in range(CHIRP_SAMPLES):
+        re = ADC_MID_SCALE + rng.gauss(0, ADC_NOISE)
+        im = ADC_MID_SCALE + rng.gauss(0, ADC_NOISE)
+        for omega, amplitude, phase in tones:
+            re += amplitude * math.cos(omega * n + phase)
+            im += amplitude * math.sin(omega * n + phase)
+        i_samples.append(str(round(re)))
+        q_samples.append(str(round(im)))
+    return '{"I":[' + ",".join(i_samples) + ']}', '{"Q":[' + ",".join(q_samples) + ']}'
+
+
+def flight_plan(stops):
+    """List of (duration_sec, speed_mps) segments, flying north between stops."""
+    plan = [(HOVER_SEC, 0.0)]
+    for _ in range(stops):
+        plan.append((LEG_METERS / FLY_SPEED_MPS, FLY_SPEED_MPS))
+        plan.append((STOP_SEC, 0.0))
+    plan.append((LEG_METERS / FLY_SPEED_MPS, FLY_SPEED_MPS))
+    return plan
+
+
+def position_at(plan, t_sec):
+    """(north_m, speed_mps) of the drone t_sec into the flight."""
+    north = 0.0
+    for duration, speed in plan:
+        if t_sec < duration:
+            return north + speed * t_sec, speed
+        north += speed * duration
+        t_sec -= duration
+    return north, 0.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("output", nargs="?", help="replay file, stdout if not given")
+    parser.add_argument("--stops", type=int, default=3)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--adc", action="store_true", help="stream raw chirps instead of FFTs")
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    with open(SIM_FFT_PATH) as f:
+        bins = [float(v) for v in f.read().strip().split(",")]
+
+    plan = flight_plan(args.stops)
+    duration_usec = int(sum(d for d, _ in plan) * 1e6)
+    start_time = datetime(2025, 11, 20, 15, 0, tzinfo=timezone.utc)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    out.write(f"# {args.stops} stop flight, {duration_usec / 1e6:.1f} s, see "
+              "scripts/make_flight_replay.py\n")
+
+    for t_usec in range(0, duration_usec, RADAR_PERIOD_USEC // 5):  # 10 ms ticks
+        if t_usec % GPS_PERIOD_USEC == 0:
+            north, speed = position_at(plan, t_usec / 1e6)
+            north += rng.gauss(0, POSITION_NOISE_M)
+            east = rng.gauss(0, POSITION_NOISE_M)
+            meters_per_deg_lon = METERS_PER_DEG_LAT * math.cos(math.radians(START_LATITUDE))
+            lat, ns = nmea_coordinate(START_LATITUDE + north / METERS_PER_DEG_LAT, 2, "N", "S")
+            lon, ew = nmea_coordinate(START_LONGITUDE + east / meters_per_deg_lon, 3, "E", "W")
+            now = start_time + timedelta(microseconds=t_usec)
+            hms = now.strftime("%H%M%S.") + f"{now.microsecond // 1000:03d}"
+            knots = speed / 0.514444
+            # the module sends RMC before GGA each epoch
+            out.write(f"{t_usec} G " + nmea(f"GNRMC,{hms},A,{lat},{ns},{lon},{ew},{knots:.2f},"
+                                              f"0.00,{now.strftime('%d%m%y')},,,A") + "\n")
+            out.write(f"{t_usec} G " + nmea(f"GNGGA,{hms},{lat},{ns},{lon},{ew},1,10,0.90,97.1,"
+                                              "M,-34.2,M,,") + "\n")
+
+        if t_usec % TEMPERATURE_PERIOD_USEC == 0:
+            celcius = -12.4 + 0.3 * math.sin(t_usec / 20e6) + rng.gauss(0, 0.01)
+            out.write(f"{t_usec} T {celcius:.3f}\n")
+
+        if t_usec % RADAR_PERIOD_USEC == 0 and args.adc:
+            for line in adc_chirp(rng):
+                out.write(f"{t_usec} R {line}\n")
+        elif t_usec % RADAR_PERIOD_USEC == 0:
+            noisy = (max(0.0, v * (1 + rng.gauss(0, BIN_NOISE))) for v in bins)
+            out.write(f"{t_usec} R " + '{"FFT":[' + ",".join(f"{v:.1f}" for v in noisy) +
+                      "]}\n")
+
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
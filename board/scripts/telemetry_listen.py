@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+Name: telemetry_listen.py
+Author: Hubert Dang
+
+Receives the stop reports the board broadcasts during a flight and prints one CSV line per
+stop as it arrives:
+
+    YYYY-MM-DD HH:MM:SS,stop,latitude,longitude,temperature,thickness_cm,half_width_cm,
+    snr_db,reads,estimates,status,cell_stops,cell_uncertainty_cm,stacked_thickness_cm
+
+thickness_cm is the mean of the frames' estimates and half_width_cm its 95% confidence
+half-width. stacked_thickness_cm is the estimate from the stop's stacked frames, empty when
+they gave none. status is "converged" or "read cap".
+
+The layout must match include/comms/telemetry.hpp. Lost or overwritten reports are reported
+on stderr, from the gaps in datagram and report numbers.
+
+Usage: ./telemetry_listen.py [port] [output.csv]
+
+Date: November 2025
+
+Copyright 2025 SnowAngel-UAV
+"""
+
+import socket
+import struct
+import sys
+from datetime import datetime
+
+MAGIC = 0x4C544153
+VERSION = 2
+DEFAULT_PORT = 14650
+
+HEADER = struct.Struct("<IHHII")  # telemetry_header_t
+REPORT = struct.Struct("<IHHQddffffHHff4x")  # telemetry_stop_report_t
+
+CONVERGED = 0x1
+HAS_ESTIMATE = 0x2
+
+
+def parse_datagram(data):
+    """Returns the header fields and the reports of one datagram, None if it is not ours."""
+    if len(data) < HEADER.size:
+        return None
+    magic, version, num_reports, datagram, dropped = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION or len(data) != HEADER.size + num_reports * REPORT.size:
+        return None
+    reports = [REPORT.unpack_from(data, HEADER.size + i * REPORT.size) for i in range(num_reports)]
+    return datagram, dropped, reports
+
+
+def main():
+    if len(sys.argv) > 3:
+        print(__doc__)
+        sys.exit(1)
+
+    port = int(sys.argv[1]) if len(sys.argv) > 1 else DEFAULT_PORT
+    out = open(sys.argv[2], "a") if len(sys.argv) == 3 else sys.stdout
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.bind(("", port))
+    print(f"[INFO] Listening for stop reports on UDP port {port}", file=sys.stderr)
+
+    last_datagram = last_sequence = None
+    try:
+        while True:
+            parsed = parse_datagram(sock.recv(65536))
+            if parsed is None:
+                continue
+            datagram, dropped, reports = parsed
+            if last_datagram is not None and datagram != last_datagram + 1:
+                print(f"[WARN] {datagram - last_datagram - 1} datagrams lost", file=sys.stderr)
+            last_datagram = datagram
+
+            for (sequence, flags, reads, timestamp_usec, lat, lon, temperature, thickness_m,
+                 half_width_m, snr_db, estimates, cell_stops, cell_uncertainty_m,
+                 stacked_thickness_m) in reports:
+                if last_sequence is not None and sequence != last_sequence + 1:
+                    print(f"[WARN] stops {last_sequence + 1} to {sequence - 1} missing "
+                          f"({dropped} dropped on board so far)", file=sys.stderr)
+                last_sequence = sequence
+
+                when = datetime.fromtimestamp(timestamp_usec / 1e6).strftime("%Y-%m-%d %H:%M:%S")
+                status = "converged" if flags & CONVERGED else "read cap"
+                stacked = f"{stacked_thickness_m * 100:.2f}" if flags & HAS_ESTIMATE else ""
+                out.write(f"{when},{sequence},{lat:.6f},{lon:.6f},{temperature:.2f},"
+                          f"{thickness_m * 100:.2f},{half_width_m * 100:.2f},{snr_db:.1f},"
+                          f"{reads},{estimates},{status},{cell_stops},"
+                          f"{cell_uncertainty_m * 100:.2f},{stacked}\n")
+                out.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if out is not sys.stdout:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()
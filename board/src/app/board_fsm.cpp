@@ -15,47 +15,180 @@
 #include "bsp/fmcw_radar_sensor.hpp"
 #include "bsp/gps.hpp"
 #include "bsp/temperature_sensor.hpp"
+#include "common/clock.h"
 #include "common/common.h"
+#include "common/event_loop.h"
+#include "common/sample_history.hpp"
+#include "common/trace.h"
 #include "common/logging.h"
+#include "comms/telemetry.hpp"
+#include "dsp/ice_thickness.hpp"
+#include "dsp/spectrum_stack.hpp"
+#include "nav/coverage_grid.hpp"
+#include "nav/motion_estimator.hpp"
+#include "storage/flight_log.hpp"
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
-#include <fstream>
-#include <iomanip>
-#include <iostream>
-#include <sstream>
-#include <unistd.h>
-
-constexpr const char *RAW_DATA_CSV = "./snow_angel_uav_raw.csv";
-
-constexpr int GPS_POLL_RATE_USEC = 1000000;
-
-constexpr double STOPPED_THRESHOLD_METERS = 2.0;
-constexpr double FLYING_THRESHOLD_METERS = 3.0;
-constexpr double STATIONARY_THRESHOLD_METERS = 5.0;
+#include <thread>
+
+/* One preallocated ring log per flight, named after the time the board started. See
+   scripts/flight_log_to_csv.py. The log is packed, the frames of a stop compress well
+   against each other, so the same 64 MB that held 55 minutes of radar frames at 20 Hz
+   unpacked holds a few hours. Later frames overwrite the oldest. */
+constexpr const char *RAW_DATA_LOG_FORMAT = "./snow_angel_uav_raw_%Y%m%d_%H%M%S.bin";
+constexpr uint32_t RAW_DATA_LOG_RING_BYTES = 64 * 1024 * 1024;
+
+/* Each stop's result is broadcast to the ground station as it finishes, see
+   scripts/telemetry_listen.py. The simulation sends it to the local machine instead. */
+#ifdef RADAR_SIMULATION
+constexpr const char *TELEMETRY_ADDRESS = "127.0.0.1";
+#else
+constexpr const char *TELEMETRY_ADDRESS = "255.255.255.255";
+#endif
+
+/* The drone is stationary once its filtered speed has stayed below 0.7 m/s for 0.5 s, and
+   flying once it has stayed above 1.5 m/s for 0.3 s. The gap between the thresholds keeps a
+   hovering drone drifting around 1 m/s from flip-flopping. */
+constexpr motion_estimator_config_t MOTION_CONFIG = {
+    0.4,     /* alpha */
+    0.05,    /* beta */
+    0.7,     /* stationary_speed_mps */
+    1.5,     /* moving_speed_mps */
+    500000,  /* stationary_hold_usec */
+    300000,  /* moving_hold_usec */
+    1000000, /* max_gap_usec, e.g. while the radar profiles a stop */
+};
 
 constexpr int STABLIZATION_TIME_USEC = 2000000;
 
+/* The sensors come up in parallel, so startup takes as long as the radar's configuration
+   (about 1.3 s) instead of the sum of all three. The GPS keeps searching for satellites in
+   the background: a cold start usually takes 180 s, a hot start from the cached position
+   hint a few seconds. The board faults if there is still no fix after this long. */
+constexpr uint64_t GPS_FIRST_FIX_TIMEOUT_USEC = 240000000;
+
+/* From the first fix on, the latest fix is cached for the next boot's hot start this often.
+   The save syncs a file, so it runs here and not on the GPS reader's thread, which must keep
+   up with the module. */
+constexpr uint64_t GPS_HINT_SAVE_PERIOD_USEC = 60000000;
+
+/* While profiling, the temperature is polled on a timer, ice surface temperature changes far
+   slower than this. Each radar frame is joined with the GPS fix and temperature sample taken
+   nearest to its capture time, the histories cover a few seconds of either. */
+constexpr int TEMPERATURE_POLL_PERIOD_USEC = 250000;
+constexpr size_t TEMPERATURE_HISTORY_SIZE = 16;
+constexpr size_t GPS_HISTORY_SIZE = 32;
+constexpr size_t GPS_FIXES_PER_READ = 8;
+
+/* The radar streams about 20 frames per second, a stop fails if it goes quiet this long. */
+constexpr int RADAR_FRAME_TIMEOUT_USEC = 2000000;
+
+/* Latency traces are folded into histograms this often, well before any thread's trace ring
+   fills up. The histograms are summarized in the log at cleanup. */
+constexpr int TRACE_COLLECT_PERIOD_USEC = 1000000;
+
+/* Adaptive dwell: a stop ends once the 95% confidence interval of the mean thickness is
+   within +/- DWELL_TOLERANCE_METERS, or after MAX_RADAR_READS_PER_STOP reads. A stop in a
+   cell of the coverage grid that earlier stops already pinned down to DWELL_TOLERANCE_METERS
+   is only a quick check, it ends after MIN_RADAR_READS_PER_STOP reads. */
+constexpr int MIN_RADAR_READS_PER_STOP = 5;
+constexpr int MAX_RADAR_READS_PER_STOP = 20;
+static_assert(MAX_RADAR_READS_PER_STOP <= FMCW_RADAR_MAX_HELD_FRAMES,
+              "a stop holds on to every frame it reads");
+constexpr double DWELL_CONFIDENCE_Z = 1.96;
+constexpr double DWELL_TOLERANCE_METERS = 0.005;
+
+/* Stops are binned into cells this size, about the spread of GPS fixes while hovering. The
+   nearest covered cell is looked up within COVERAGE_SEARCH_METERS of a new stop, and the log
+   lists the COVERAGE_REPORT_CELLS most uncertain cells at the end of the flight. */
+constexpr double COVERAGE_CELL_SIZE_METERS = 5.0;
+constexpr double COVERAGE_SEARCH_METERS = 50.0;
+constexpr size_t COVERAGE_REPORT_CELLS = 5;
+
+/* Running thickness statistics for the current stop (Welford's algorithm) */
+struct dwell_controller
+{
+	int max_reads;     /* read cap of this stop */
+	int num_reads;     /* every radar read, including ones without an estimate */
+	int num_estimates; /* reads that produced a thickness estimate */
+	double mean_m;
+	double m2; /* sum of squared differences from the mean */
+};
+
+enum stop_phase
+{
+	STOP_PHASE_SETTLING,  /* waiting out STABLIZATION_TIME_USEC */
+	STOP_PHASE_PROFILING, /* radar is streaming frames */
+	STOP_PHASE_DONE,      /* waiting for the drone to fly on */
+};
+
 TEMPERATURE_SENSOR *temp_sensor = nullptr;
 FMCW_RADAR_SENSOR *fmcw_radar_sensor = nullptr;
 GPS *gps = nullptr;
 
-std::ofstream raw_data_csv;
+FLIGHT_LOG_WRITER raw_data_log;
+TELEMETRY_PUBLISHER telemetry;
+motion_estimator_t motion; /* its local plane is centered on the first fix of the flight */
+coverage_grid_t coverage;  /* every stop of the flight, by where it was made */
+fmcw_stream_stats_t stream_totals; /* what the radar stream lost over the flight */
+
+/* The IDLE, FLYING and STATIONARY states are driven by sensor events: the GPS and radar wake
+   the loop through eventfds, the stabilization wait and temperature polling are timerfds.
+   Callbacks update fsm_state, board_fsm_process() returns it after each batch of events. */
+struct event_loop *loop = nullptr;
+int stabilization_timer = -1;
+int temperature_timer = -1;
+int radar_watchdog_timer = -1;
+int trace_timer = -1;
+int gps_first_fix_timer = -1;
+int gps_hint_timer = -1;
+enum board_state fsm_state = BOARD_STATE_INIT;
+uint64_t init_start_usec;
+bool has_first_fix = false;
+
+SAMPLE_HISTORY<gps_data_t, GPS_HISTORY_SIZE> gps_history;
+SAMPLE_HISTORY<temp_sensor_data_t, TEMPERATURE_HISTORY_SIZE> temperature_history;
+
+enum stop_phase stop_phase;
+/* The stop's frames are the driver's own, shared through handles until the stop is done */
+fmcw_frame_handle_t fft_frames[MAX_RADAR_READS_PER_STOP];
+const fmcw_fft_frame_t *stop_frames[MAX_RADAR_READS_PER_STOP];
+struct dwell_controller dwell;
 
 enum board_state board_fsm_init();
-enum board_state board_fsm_idle();
-enum board_state board_fsm_flying();
-enum board_state board_fsm_stationary();
+enum board_state board_fsm_run_events();
 enum board_state board_fsm_fault();
 enum board_state board_fsm_cleanup();
 
-int8_t wait_until_stationary();
-int8_t wait_until_flying();
-
-void persist_to_csv(double lat, double lon, double tmp, char *waveform);
-double haversine(double lat1, double lon1, double lat2, double lon2);
+int8_t register_event_sources();
+void on_gps_fix(void *ctx);
+void handle_gps_fix(const gps_data_t *fix);
+void on_stabilized(void *ctx);
+void on_temperature_poll(void *ctx);
+void on_radar_frame(void *ctx);
+void handle_radar_frame(const fmcw_fft_frame_t *fft_frame);
+void on_radar_timeout(void *ctx);
+void on_trace_collect(void *ctx);
+void on_gps_first_fix_timeout(void *ctx);
+void on_gps_hint_save(void *ctx);
+int8_t init_sensors();
+int8_t sample_temperature();
+void finish_stop();
+void log_stream_stats();
+void release_stop_frames();
+int stop_read_cap();
+
+void dwell_controller_reset(struct dwell_controller *dwell, int max_reads);
+void dwell_controller_update(struct dwell_controller *dwell,
+                             const ice_thickness_estimate_t *estimate);
+bool dwell_controller_done(const struct dwell_controller *dwell);
+double dwell_controller_half_width(const struct dwell_controller *dwell);
+
+int8_t persist_record(double lat, double lon, double tmp, const fmcw_fft_frame_t *frame);
 
 /**
  * Process a board state. Note that the next state is not always a different state.
@@ -71,11 +204,9 @@ enum board_state board_fsm_process(enum board_state state)
 	case BOARD_STATE_INIT:
 		return board_fsm_init();
 	case BOARD_STATE_IDLE:
-		return board_fsm_idle();
 	case BOARD_STATE_FLYING:
-		return board_fsm_flying();
 	case BOARD_STATE_STATIONARY:
-		return board_fsm_stationary();
+		return board_fsm_run_events();
 	case BOARD_STATE_FAULT:
 		return board_fsm_fault();
 	case BOARD_STATE_CLEANUP:
@@ -89,234 +220,568 @@ enum board_state board_fsm_init()
 {
 	int rc;
 
-	temp_sensor = instantiate_temperature_sensor();
-	if ((rc = temp_sensor->temperature_sensor_init()) != SUCCESS)
-	{
-		logging_write(LOG_ERROR, "Temperature sensor init failed! (err %d)", rc);
+	init_start_usec = clock_monotonic_usec();
+	if (init_sensors() != SUCCESS)
 		return BOARD_STATE_FAULT;
-	}
 
-	fmcw_radar_sensor = instantiate_fmcw_radar_sensor();
-	if ((rc = fmcw_radar_sensor->fmcw_radar_sensor_init()) != SUCCESS)
-	{
-		logging_write(LOG_ERROR, "FMCW radar sensor init failed! (err %d)", rc);
-		return BOARD_STATE_FAULT;
-	}
+	char raw_data_log_path[64];
+	time_t now = time(NULL);
+	strftime(raw_data_log_path, sizeof(raw_data_log_path), RAW_DATA_LOG_FORMAT, localtime(&now));
 
-	gps = instantiate_gps();
-	if ((rc = gps->gps_init()) != SUCCESS)
+	motion_estimator_init(&motion, &MOTION_CONFIG);
+	coverage_grid_init(&coverage, COVERAGE_CELL_SIZE_METERS);
+
+	rc = raw_data_log.open(raw_data_log_path, RAW_DATA_LOG_RING_BYTES, FLIGHT_LOG_PACKED);
+	if (rc != SUCCESS)
 	{
-		logging_write(LOG_ERROR, "GPS module init failed! (err %d)", rc);
+		logging_write(LOG_ERROR, "Failed to open %s (err %d)", raw_data_log_path, rc);
 		return BOARD_STATE_FAULT;
 	}
 
-	raw_data_csv.open(RAW_DATA_CSV, std::ios::app);
-	if (!raw_data_csv.is_open())
+	// the flight's results are on the SD card either way, the downlink is a bonus
+	if ((rc = telemetry.open(TELEMETRY_ADDRESS)) != SUCCESS)
+		logging_write(LOG_WARN, "Telemetry downlink unavailable (err %d)", rc);
+
+	if ((rc = register_event_sources()) != SUCCESS)
 	{
-		logging_write(LOG_ERROR, "Failed to open %s", RAW_DATA_CSV);
+		logging_write(LOG_ERROR, "Event loop setup failed! (err %d)", rc);
 		return BOARD_STATE_FAULT;
 	}
 
-	return BOARD_STATE_IDLE;
+	fsm_state = BOARD_STATE_IDLE;
+	return fsm_state;
 }
 
 /**
- * Wait until the drone becomes stationary. GPS is noisy, so we require several consecutive
- * stationary readings before we can confidently say the drone is stationary.
+ * Bring up the temperature sensor, the radar and the GPS at the same time.
+ *
+ * @return 0 on success, negative number if any of them failed.
+ */
+int8_t init_sensors()
+{
+	temp_sensor = instantiate_temperature_sensor();
+	fmcw_radar_sensor = instantiate_fmcw_radar_sensor();
+	gps = instantiate_gps();
+
+	int8_t temp_rc = SUCCESS, radar_rc = SUCCESS, gps_rc = SUCCESS;
+	std::thread temp_thread([&temp_rc] { temp_rc = temp_sensor->temperature_sensor_init(); });
+	std::thread radar_thread(
+	    [&radar_rc] { radar_rc = fmcw_radar_sensor->fmcw_radar_sensor_init(); });
+	gps_rc = gps->gps_init();
+	temp_thread.join();
+	radar_thread.join();
+
+	if (temp_rc != SUCCESS)
+		logging_write(LOG_ERROR, "Temperature sensor init failed! (err %d)", temp_rc);
+	if (radar_rc != SUCCESS)
+		logging_write(LOG_ERROR, "FMCW radar sensor init failed! (err %d)", radar_rc);
+	if (gps_rc != SUCCESS)
+		logging_write(LOG_ERROR, "GPS module init failed! (err %d)", gps_rc);
+	if (temp_rc != SUCCESS || radar_rc != SUCCESS || gps_rc != SUCCESS)
+		return -1;
+
+	logging_write(LOG_INFO, "Sensors up after %.2f s",
+	              (clock_monotonic_usec() - init_start_usec) / 1e6);
+	return SUCCESS;
+}
+
+/**
+ * Register the sensors and timers the flight states react to.
  *
  * @return 0 on success, negative number otherwise.
  */
-int8_t wait_until_stationary()
+int8_t register_event_sources()
 {
-	constexpr uint8_t STATIONARY_READS_REQUIRED = 3;
+	loop = event_loop_create();
+	if (loop == nullptr)
+		return -1;
+
+	if (event_loop_add_fd(loop, gps->gps_fix_event_fd(), on_gps_fix, nullptr) != 0)
+		return -2;
+
+	if (event_loop_add_fd(loop, fmcw_radar_sensor->fmcw_radar_sensor_frame_event_fd(),
+	                      on_radar_frame, nullptr) != 0)
+		return -3;
+
+	stabilization_timer = event_loop_add_timer(loop, on_stabilized, nullptr);
+	temperature_timer = event_loop_add_timer(loop, on_temperature_poll, nullptr);
+	radar_watchdog_timer = event_loop_add_timer(loop, on_radar_timeout, nullptr);
+	trace_timer = event_loop_add_timer(loop, on_trace_collect, nullptr);
+	gps_first_fix_timer = event_loop_add_timer(loop, on_gps_first_fix_timeout, nullptr);
+	gps_hint_timer = event_loop_add_timer(loop, on_gps_hint_save, nullptr);
+	if (stabilization_timer < 0 || temperature_timer < 0 || radar_watchdog_timer < 0 ||
+	    trace_timer < 0 || gps_first_fix_timer < 0 || gps_hint_timer < 0)
+		return -4;
+
+	if (event_loop_arm_timer(loop, trace_timer, TRACE_COLLECT_PERIOD_USEC,
+	                         TRACE_COLLECT_PERIOD_USEC) != 0)
+		return -5;
+
+	if (event_loop_arm_timer(loop, gps_first_fix_timer, GPS_FIRST_FIX_TIMEOUT_USEC, 0) != 0)
+		return -6;
 
-	uint8_t rc = 0;
-	uint8_t num_stationary_reads = 0;
-	double distance_moved_meters = 0.0;
-	gps_data_t previous_gps_data{};
-	gps_data_t current_gps_data{};
+	return SUCCESS;
+}
 
-	/* Get initial coordinates */
-	if ((rc = gps->gps_read(&previous_gps_data)) != SUCCESS)
+/**
+ * Sleep until a sensor or timer needs attention and run its callback.
+ *
+ * @return The state the callbacks left the board in.
+ */
+enum board_state board_fsm_run_events()
+{
+	if (event_loop_run_once(loop, -1) < 0)
 	{
-		logging_write(LOG_ERROR, "GPS read failed! (err %d)", rc);
-		return rc;
+		logging_write(LOG_ERROR, "Waiting for sensor events failed!");
+		return BOARD_STATE_FAULT;
 	}
 
-	/* Poll GPS to check if we've stopped flying */
-	while (true)
-	{
-		usleep(GPS_POLL_RATE_USEC);
+	return fsm_state;
+}
+
+/**
+ * Feed every new GPS fix to the motion estimator. GPS is noisy, so the filtered speed has to
+ * stay low (or high) for a while before we can confidently say the drone stopped (or is
+ * flying).
+ */
+void on_gps_fix(void *ctx)
+{
+	(void)ctx;
+	TRACE_SCOPE(TRACE_FSM_GPS_FIX);
+	gps_data_t fixes[GPS_FIXES_PER_READ];
+	int num_fixes;
 
-		if ((rc = gps->gps_read(&current_gps_data)) != SUCCESS)
+	event_fd_drain(gps->gps_fix_event_fd());
+	do
+	{
+		// a wakeup can be late by several fixes while the loop is busy with a frame
+		if ((num_fixes = gps->gps_read_fixes(fixes, GPS_FIXES_PER_READ)) < 0)
 		{
-			logging_write(LOG_ERROR, "GPS read failed! (err %d)", rc);
-			return rc;
+			logging_write(LOG_ERROR, "GPS read failed! (err %d)", num_fixes);
+			fsm_state = BOARD_STATE_FAULT;
+			return;
 		}
 
-		distance_moved_meters = haversine(previous_gps_data.latitude, previous_gps_data.longitude,
-		                                  current_gps_data.latitude, current_gps_data.longitude);
-		previous_gps_data = current_gps_data;
+		for (int i = 0; i < num_fixes; i++)
+			handle_gps_fix(&fixes[i]);
+	} while (num_fixes == static_cast<int>(GPS_FIXES_PER_READ));
+}
 
-		logging_write(LOG_INFO, "distance_moved_meters = %f", distance_moved_meters);
+/**
+ * Record one fix and move between IDLE, FLYING and STATIONARY when the motion state changes.
+ */
+void handle_gps_fix(const gps_data_t *fix)
+{
+	if (!has_first_fix)
+	{
+		has_first_fix = true;
+		event_loop_arm_timer(loop, gps_first_fix_timer, 0, 0);
+		logging_write(LOG_INFO, "GPS: first fix after %.1f s, %u satellites",
+		              (fix->timestamp_usec - init_start_usec) / 1e6, fix->num_satellites);
+		on_gps_hint_save(nullptr);
+		event_loop_arm_timer(loop, gps_hint_timer, GPS_HINT_SAVE_PERIOD_USEC,
+		                     GPS_HINT_SAVE_PERIOD_USEC);
+	}
 
-		if (distance_moved_meters < FLYING_THRESHOLD_METERS)
-		{
-			num_stationary_reads++;
-		}
-		else
-		{
-			num_stationary_reads = 0; // Reset because we started moving again
-			logging_write(LOG_INFO, "Reset count");
-		}
+	gps_history.push(fix->timestamp_usec, *fix);
+	enum motion_state motion_state =
+	    motion_estimator_update(&motion, fix->latitude, fix->longitude, fix->timestamp_usec);
 
-		if (num_stationary_reads == STATIONARY_READS_REQUIRED)
-		{
-			break; // Drone is stationary
-		}
+	bool stopped = fsm_state == BOARD_STATE_FLYING && motion_state == MOTION_STATE_STATIONARY;
+	bool flying = motion_state == MOTION_STATE_MOVING &&
+	              (fsm_state == BOARD_STATE_IDLE ||
+	               (fsm_state == BOARD_STATE_STATIONARY && stop_phase == STOP_PHASE_DONE));
+	if (!stopped && !flying)
+		return;
+
+	logging_write(LOG_INFO, "%s at %.2f m/s", stopped ? "Stopped" : "Flying",
+	              motion_estimator_speed_mps(&motion));
+
+	if (flying)
+	{
+		fsm_state = BOARD_STATE_FLYING;
+		return;
 	}
 
-	return SUCCESS;
+	// Extra time to let the drone settle before transmitting radar
+	fsm_state = BOARD_STATE_STATIONARY;
+	stop_phase = STOP_PHASE_SETTLING;
+	event_loop_arm_timer(loop, stabilization_timer, STABLIZATION_TIME_USEC, 0);
 }
 
 /**
- * Wait until the drone starts flying. GPS is noisy, so we require several consecutive
- * flying readings before we can confidently say the drone is flying.
+ * Append one radar frame, with the position and temperature it was captured at, to the raw
+ * data log.
  *
  * @return 0 on success, negative number otherwise.
  */
-int8_t wait_until_flying()
+int8_t persist_record(double lat, double lon, double tmp, const fmcw_fft_frame_t *frame)
 {
-	constexpr uint8_t FLYING_READS_REQUIRED = 3;
+	TRACE_SCOPE(TRACE_PERSIST_RECORD);
 
-	uint8_t rc = 0;
-	double distance_moved_meters = 0.0;
-	uint8_t num_flying_reads = 0;
-	gps_data_t initial_gps_data{};
-	gps_data_t current_gps_data{};
+	flight_log_record_t record;
+	flight_log_make_record(lat, lon, tmp, frame, &record);
+	return raw_data_log.append(&record);
+}
 
-	/* Get initial coordinates */
-	if ((rc = gps->gps_read(&initial_gps_data)) != SUCCESS)
-	{
-		logging_write(LOG_ERROR, "GPS read failed! (err %d)", rc);
-		return rc;
-	}
+void dwell_controller_reset(struct dwell_controller *dwell, int max_reads)
+{
+	*dwell = {};
+	dwell->max_reads = max_reads;
+}
 
-	/* Poll GPS to check if we're far away enough from our initial location */
-	while (true)
-	{
-		usleep(GPS_POLL_RATE_USEC);
+/**
+ * Record the outcome of one radar read.
+ *
+ * @param dwell The controller for the current stop
+ * @param estimate The frame's thickness estimate, or nullptr if the frame did not produce one
+ */
+void dwell_controller_update(struct dwell_controller *dwell,
+                             const ice_thickness_estimate_t *estimate)
+{
+	dwell->num_reads++;
+	if (estimate == nullptr)
+		return;
+
+	dwell->num_estimates++;
+	double delta = estimate->thickness_m - dwell->mean_m;
+	dwell->mean_m += delta / dwell->num_estimates;
+	dwell->m2 += delta * (estimate->thickness_m - dwell->mean_m);
+}
 
-		if ((rc = gps->gps_read(&current_gps_data)) != SUCCESS)
-		{
-			logging_write(LOG_ERROR, "GPS read failed! (err %d)", rc);
-			return rc;
-		}
+/**
+ * Half width of the confidence interval around the mean thickness.
+ *
+ * @return The half width in meters, or infinity with fewer than two estimates.
+ */
+double dwell_controller_half_width(const struct dwell_controller *dwell)
+{
+	if (dwell->num_estimates < 2)
+		return INFINITY;
 
-		distance_moved_meters = haversine(initial_gps_data.latitude, initial_gps_data.longitude,
-		                                  current_gps_data.latitude, current_gps_data.longitude);
-		logging_write(LOG_INFO, "distance_moved_meters = %f", distance_moved_meters);
+	double variance = dwell->m2 / (dwell->num_estimates - 1);
+	return DWELL_CONFIDENCE_Z * std::sqrt(variance / dwell->num_estimates);
+}
 
-		if (distance_moved_meters >= STATIONARY_THRESHOLD_METERS)
-		{
-			num_flying_reads++;
-		}
-		else
-		{
-			num_flying_reads = 0; // reset as we stopped moving
-		}
+/**
+ * Decide whether the stop has enough radar reads.
+ *
+ * @return true once the thickness estimate has converged or the read cap is hit.
+ */
+bool dwell_controller_done(const struct dwell_controller *dwell)
+{
+	if (dwell->num_reads >= dwell->max_reads)
+		return true;
 
-		if (num_flying_reads == FLYING_READS_REQUIRED)
-		{
-			break; // drone is flying
-		}
+	return dwell->num_estimates >= MIN_RADAR_READS_PER_STOP &&
+	       dwell_controller_half_width(dwell) <= DWELL_TOLERANCE_METERS;
+}
+
+/**
+ * Look the stop up in the coverage grid. A cell earlier stops already pinned down only needs
+ * a quick check, anywhere else gets the full dwell.
+ *
+ * @return The number of radar reads the stop may take.
+ */
+int stop_read_cap()
+{
+	gps_data_t fix = {};
+	if (!gps_history.nearest(clock_monotonic_usec(), &fix))
+		return MAX_RADAR_READS_PER_STOP;
+
+	double distance_m;
+	const coverage_cell_t *cell = coverage_grid_cell_at(&coverage, fix.latitude, fix.longitude);
+	if (cell != nullptr && coverage_cell_uncertainty_m(cell) <= DWELL_TOLERANCE_METERS)
+	{
+		logging_write(LOG_INFO, "Stop in a covered cell: %.2f cm from %u stops, quick check",
+		              cell->mean_m * 100, cell->num_stops);
+		return MIN_RADAR_READS_PER_STOP;
 	}
 
-	return SUCCESS;
+	if (cell != nullptr)
+	{
+		logging_write(LOG_INFO, "Stop in an uncertain cell: %.2f +/- %.2f cm from %u stops",
+		              cell->mean_m * 100, coverage_cell_uncertainty_m(cell) * 100,
+		              cell->num_stops);
+	}
+	else if ((cell = coverage_grid_nearest(&coverage, fix.latitude, fix.longitude,
+	                                       COVERAGE_SEARCH_METERS, &distance_m)) != nullptr)
+	{
+		logging_write(LOG_INFO, "Stop in a new cell, %.1f m from the nearest covered one",
+		              distance_m);
+	}
+	return MAX_RADAR_READS_PER_STOP;
 }
 
-enum board_state board_fsm_idle()
+/**
+ * The drone has settled, start profiling ice thickness.
+ */
+void on_stabilized(void *ctx)
 {
-	if (wait_until_flying() != SUCCESS)
+	(void)ctx;
+	TRACE_SCOPE(TRACE_FSM_STABILIZED);
+	int8_t rc;
+
+	// every frame of the stop has a temperature sample to join with
+	temperature_history.clear();
+	if (sample_temperature() != SUCCESS)
+		return;
+
+	// the radar watchdog catches a sensor that acts on the commands without acknowledging them
+	if ((rc = fmcw_radar_sensor->fmcw_radar_sensor_start_tx_signal()) != SUCCESS)
+		logging_write(LOG_WARN, "FMCW radar did not acknowledge transmitting (err %d)", rc);
+	if ((rc = fmcw_radar_sensor->fmcw_radar_sensor_start_streaming()) != SUCCESS)
 	{
-		return BOARD_STATE_FAULT;
+		logging_write(LOG_ERROR, "FMCW radar sensor streaming failed! (err %d)", rc);
+		fsm_state = BOARD_STATE_FAULT;
+		return;
 	}
 
-	return BOARD_STATE_FLYING;
+	dwell_controller_reset(&dwell, stop_read_cap());
+	stop_phase = STOP_PHASE_PROFILING;
+	event_loop_arm_timer(loop, temperature_timer, TEMPERATURE_POLL_PERIOD_USEC,
+	                     TEMPERATURE_POLL_PERIOD_USEC);
+	event_loop_arm_timer(loop, radar_watchdog_timer, RADAR_FRAME_TIMEOUT_USEC, 0);
 }
 
-enum board_state board_fsm_flying()
+void on_temperature_poll(void *ctx)
 {
-	if (wait_until_stationary() != SUCCESS)
+	(void)ctx;
+	sample_temperature();
+}
+
+/**
+ * Read the temperature into the history radar frames are joined with.
+ *
+ * @return 0 on success, negative number otherwise (the board faults).
+ */
+int8_t sample_temperature()
+{
+	int8_t rc;
+	temp_sensor_data_t sample;
+
+	if ((rc = temp_sensor->temperature_sensor_read(&sample)) != SUCCESS)
 	{
-		return BOARD_STATE_FAULT;
+		logging_write(LOG_ERROR, "Temperature sensor read failed! (err %d)", rc);
+		fsm_state = BOARD_STATE_FAULT;
+		return rc;
 	}
 
-	return BOARD_STATE_STATIONARY;
+	temperature_history.push(sample.timestamp_usec, sample);
+	return SUCCESS;
 }
 
-void persist_to_csv(double lat, double lon, double tmp, char *waveform)
+void on_trace_collect(void *ctx)
 {
-	constexpr double GPS_DATA_PRECISION = 6; // Number of decimal places
-	constexpr double TMP_DATA_PRECISION = 2; // Number of decimal places
-
-	auto now = std::time(nullptr);
-	auto tm = *std::localtime(&now);
-
-	std::ostringstream csv_line;
-	csv_line << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << "," << std::fixed
-	         << std::setprecision(GPS_DATA_PRECISION) << lat << "," << lon << ","
-	         << std::setprecision(TMP_DATA_PRECISION) << tmp << "," << std::string(waveform);
-	raw_data_csv << csv_line.str() << "\n";
-	raw_data_csv.flush();
+	(void)ctx;
+	trace_collect();
 }
 
-enum board_state board_fsm_stationary()
+void on_gps_first_fix_timeout(void *ctx)
 {
-	constexpr int NUM_RADAR_READS_PER_STOP = 20;
+	(void)ctx;
+	logging_write(LOG_ERROR, "GPS module found no fix in %llu s!",
+	              (unsigned long long)(GPS_FIRST_FIX_TIMEOUT_USEC / 1000000));
+	fsm_state = BOARD_STATE_FAULT;
+}
 
-	usleep(STABLIZATION_TIME_USEC); // Extra time to let the drone settle before transmitting radar
+void on_gps_hint_save(void *ctx)
+{
+	(void)ctx;
+	if (gps->gps_save_position_hint() != 0)
+		logging_write(LOG_WARN, "GPS: failed to save the position hint");
+}
 
-	fmcw_radar_sensor->fmcw_radar_sensor_start_tx_signal();
+void on_radar_timeout(void *ctx)
+{
+	(void)ctx;
+	logging_write(LOG_ERROR, "FMCW radar sensor sent no frame for %d ms!",
+	              RADAR_FRAME_TIMEOUT_USEC / 1000);
+	fsm_state = BOARD_STATE_FAULT;
+}
 
-	gps_data_t gps_data;
-	temp_sensor_data_t tmp_data;
-	fmcw_waveform_data_t waveform_data;
+/**
+ * Take every radar frame queued since the last wakeup and handle them in capture order.
+ */
+void on_radar_frame(void *ctx)
+{
+	(void)ctx;
+	TRACE_SCOPE(TRACE_FSM_RADAR_FRAME);
 
+	event_fd_drain(fmcw_radar_sensor->fmcw_radar_sensor_frame_event_fd());
+	if (stop_phase != STOP_PHASE_PROFILING)
+		return;
+
+	// frames pile up while a slow SD card write holds the loop, the stop may need fewer
+	int num_frames = fmcw_radar_sensor->fmcw_radar_sensor_try_acquire_fft_frames(
+	    &fft_frames[dwell.num_reads], MAX_RADAR_READS_PER_STOP - dwell.num_reads);
+	if (num_frames < 0)
+	{
+		logging_write(LOG_ERROR, "FMCW radar sensor read failed! (err %d)", num_frames);
+		fsm_state = BOARD_STATE_FAULT;
+		return;
+	}
+	if (num_frames == 0)
+		return;
+	event_loop_arm_timer(loop, radar_watchdog_timer, RADAR_FRAME_TIMEOUT_USEC, 0);
+
+	for (int i = 0; i < num_frames && stop_phase == STOP_PHASE_PROFILING; i++)
+		handle_radar_frame(fft_frames[dwell.num_reads].get());
+}
+
+/**
+ * Log, estimate and account for one streamed radar frame.
+ */
+void handle_radar_frame(const fmcw_fft_frame_t *fft_frame)
+{
 	int8_t rc;
 
-	/* Profile ice thickness */
-	if ((rc = gps->gps_read(&gps_data)) != SUCCESS)
+	/* Both histories were filled before profiling started, so there is always a sample to
+	   join with. A fix after the capture may still be in flight, then the one before it is
+	   the nearest we have. */
+	gps_data_t fix = {};
+	temp_sensor_data_t temperature = {};
+	gps_history.nearest(fft_frame->monotonic_usec, &fix);
+	temperature_history.nearest(fft_frame->monotonic_usec, &temperature);
+
+	if ((rc = persist_record(fix.latitude, fix.longitude, temperature.temperature, fft_frame)) !=
+	    SUCCESS)
 	{
-		logging_write(LOG_ERROR, "GPS read failed! (err %d)", rc);
-		return BOARD_STATE_FAULT;
+		logging_write(LOG_ERROR, "Failed to write raw data record! (err %d)", rc);
 	}
+	stop_frames[dwell.num_reads] = fft_frame;
 
-	for (int read_count = 0; read_count < NUM_RADAR_READS_PER_STOP; read_count++)
+	ice_thickness_estimate_t estimate = {}; // num_peaks is logged even if the estimate fails early
+	uint64_t estimate_start_nsec = clock_monotonic_nsec();
+	rc = ice_thickness_estimate(fft_frame, &estimate); // zoomed when captured in ADC mode
+	trace_record(TRACE_ICE_ESTIMATE, clock_monotonic_nsec() - estimate_start_nsec);
+	if (rc == SUCCESS)
 	{
-		if ((rc = temp_sensor->temperature_sensor_read(&tmp_data)) != SUCCESS)
+		logging_write(LOG_INFO, "Frame %u: surface %.3f m, bottom %.3f m, thickness %.2f cm",
+		              fft_frame->sequence, estimate.surface.range_m, estimate.bottom.range_m,
+		              estimate.thickness_m * 100);
+		dwell_controller_update(&dwell, &estimate);
+	}
+	else
+	{
+		logging_write(LOG_WARN, "Frame %u: found %u peaks, need 2 for a thickness estimate",
+		              fft_frame->sequence, estimate.num_peaks);
+		dwell_controller_update(&dwell, nullptr);
+	}
+
+	if (dwell_controller_done(&dwell))
+		finish_stop();
+}
+
+/**
+ * Log what the radar stream lost during the stop and add it to the flight's totals.
+ */
+void log_stream_stats()
+{
+	fmcw_stream_stats_t stats;
+	fmcw_radar_sensor->fmcw_radar_sensor_get_stream_stats(&stats);
+	stream_totals.frames += stats.frames;
+	stream_totals.dropped_frames += stats.dropped_frames;
+	stream_totals.missed_frames += stats.missed_frames;
+	stream_totals.serial_overruns += stats.serial_overruns;
+	stream_totals.max_frame_gap_usec =
+	    std::max(stream_totals.max_frame_gap_usec, stats.max_frame_gap_usec);
+
+	bool lossy = stats.dropped_frames + stats.missed_frames + stats.serial_overruns > 0;
+	logging_write(lossy ? LOG_WARN : LOG_INFO, "Radar stream: %u frames, %u dropped, %u missed, "
+	              "%u serial overruns, longest gap %.1f ms", stats.frames, stats.dropped_frames,
+	              stats.missed_frames, stats.serial_overruns, stats.max_frame_gap_usec / 1000.0);
+}
+
+/**
+ * Stop the radar and report the stop. The board stays STATIONARY until the drone flies on.
+ */
+void finish_stop()
+{
+	TRACE_SCOPE(TRACE_FSM_FINISH_STOP);
+
+	event_loop_arm_timer(loop, temperature_timer, 0, 0);
+	event_loop_arm_timer(loop, radar_watchdog_timer, 0, 0);
+	stop_phase = STOP_PHASE_DONE;
+
+	fmcw_radar_sensor->fmcw_radar_sensor_stop_streaming();
+	log_stream_stats();
+	// radar LED off tells the pilot to move on
+	int8_t rc = fmcw_radar_sensor->fmcw_radar_sensor_stop_tx_signal();
+	if (rc != SUCCESS)
+		logging_write(LOG_WARN, "FMCW radar did not acknowledge hibernating (err %d)", rc);
+	raw_data_log.sync(); // the stop's records are complete, get them onto the SD card
+
+	bool converged = dwell_controller_half_width(&dwell) <= DWELL_TOLERANCE_METERS;
+	logging_write(LOG_INFO, "Stop done after %d reads (%s): mean thickness %.2f +/- %.2f cm",
+	              dwell.num_reads, converged ? "converged" : "read cap", dwell.mean_m * 100,
+	              dwell_controller_half_width(&dwell) * 100);
+
+	telemetry_stop_report_t report = {};
+	report.timestamp_usec = clock_realtime_usec();
+	report.num_reads = dwell.num_reads;
+	report.num_estimates = dwell.num_estimates;
+	report.thickness_m = dwell.mean_m;
+	report.half_width_m = dwell_controller_half_width(&dwell);
+	if (converged)
+		report.flags |= TELEMETRY_STOP_CONVERGED;
+
+	/* Averaging the stop's frames knocks down the noise for a second estimate. It has no
+	   confidence interval of its own, so the report's thickness stays the mean, which its
+	   half-width and the coverage grid belong to. */
+	spectrum_stack_result_t stack;
+	if (spectrum_stack(stop_frames, dwell.num_reads, &stack) == SUCCESS)
+	{
+		ice_thickness_estimate_t estimate;
+		report.snr_db = stack.peak_snr_db;
+		if (ice_thickness_estimate(stack.mean, FMCW_RADAR_FFT_SIZE, &estimate) == SUCCESS)
 		{
-			logging_write(LOG_ERROR, "Temperature sensor read failed! (err %d)", rc);
-			return BOARD_STATE_FAULT;
+			logging_write(LOG_INFO, "Stop: %u frames stacked, thickness %.2f cm, SNR %.1f dB",
+			              stack.num_frames, estimate.thickness_m * 100, stack.peak_snr_db);
+			report.stacked_thickness_m = estimate.thickness_m;
+			report.flags |= TELEMETRY_STOP_HAS_ESTIMATE;
 		}
-
-		if ((rc = fmcw_radar_sensor->fmcw_radar_sensor_read_rx_signal(&waveform_data)) != SUCCESS)
+		else
 		{
-			logging_write(LOG_ERROR, "FMCW radar sensor read failed! (err %d)", rc);
-			return BOARD_STATE_FAULT;
+			logging_write(LOG_WARN, "Stop: %u frames stacked, no thickness estimate, SNR %.1f dB",
+			              stack.num_frames, stack.peak_snr_db);
 		}
-
-		persist_to_csv(gps_data.latitude, gps_data.longitude, tmp_data.temperature,
-		               (char *)waveform_data.raw_data);
 	}
 
-	fmcw_radar_sensor->fmcw_radar_sensor_stop_tx_signal();
+	release_stop_frames();
 
-	if (wait_until_flying() != SUCCESS)
+	gps_data_t fix = {};
+	temp_sensor_data_t temperature = {};
+	gps_history.nearest(clock_monotonic_usec(), &fix);
+	temperature_history.nearest(clock_monotonic_usec(), &temperature);
+	report.latitude = fix.latitude;
+	report.longitude = fix.longitude;
+	report.temperature = temperature.temperature;
+
+	// a stop without a single estimate says nothing about the ice, it leaves the grid alone
+	const coverage_cell_t *cell = nullptr;
+	if (dwell.num_estimates > 0)
 	{
-		return BOARD_STATE_FAULT;
+		cell = coverage_grid_add_stop(&coverage, fix.latitude, fix.longitude, report.thickness_m,
+		                              report.half_width_m);
+		if (cell == nullptr)
+			logging_write(LOG_WARN, "Coverage grid is full, stop not recorded");
 	}
-	return BOARD_STATE_FLYING;
+	if (cell != nullptr)
+	{
+		report.cell_stops = cell->num_stops;
+		report.cell_uncertainty_m = coverage_cell_uncertainty_m(cell);
+	}
+	telemetry.publish(&report); // the sender thread takes it from here
+}
+
+/**
+ * Give the stop's frames back to the radar driver's pool.
+ */
+void release_stop_frames()
+{
+	for (fmcw_frame_handle_t &frame : fft_frames)
+		frame.reset();
 }
 
 enum board_state board_fsm_fault()
@@ -328,12 +793,43 @@ enum board_state board_fsm_fault()
 
 enum board_state board_fsm_cleanup()
 {
+	trace_log_summary(); // where the flight's time went
+
+	event_loop_destroy(loop); // closes the timers
+	loop = nullptr;
+
+	release_stop_frames(); // before the pool they came from goes away
 	delete temp_sensor;
 	delete fmcw_radar_sensor;
 	delete gps;
 
-	if (raw_data_csv.is_open())
-		raw_data_csv.close();
+	if (raw_data_log.is_open())
+		raw_data_log.close();
+
+	// where a second pass would help most
+	const coverage_cell_t *uncertain[COVERAGE_REPORT_CELLS];
+	size_t num_uncertain =
+	    coverage_grid_most_uncertain(&coverage, uncertain, COVERAGE_REPORT_CELLS);
+	logging_write(LOG_INFO, "Coverage: %zu cells of %.0f m", coverage.num_cells,
+	              COVERAGE_CELL_SIZE_METERS);
+	for (size_t i = 0; i < num_uncertain; i++)
+	{
+		logging_write(LOG_INFO, "Uncertain cell %.0f m east, %.0f m north: %.2f +/- %.2f cm, "
+		              "%u stops", uncertain[i]->east_m, uncertain[i]->north_m,
+		              uncertain[i]->mean_m * 100, coverage_cell_uncertainty_m(uncertain[i]) * 100,
+		              uncertain[i]->num_stops);
+	}
+
+	logging_write(LOG_INFO, "Radar stream over the flight: %u frames, %u dropped, %u missed, "
+	              "%u serial overruns, longest gap %.1f ms", stream_totals.frames,
+	              stream_totals.dropped_frames, stream_totals.missed_frames,
+	              stream_totals.serial_overruns, stream_totals.max_frame_gap_usec / 1000.0);
+
+	telemetry.close(); // sends the last stop's report if it is still queued
+	telemetry_stats_t stats;
+	telemetry.get_stats(&stats);
+	logging_write(LOG_INFO, "Telemetry: %u stop reports sent, %u dropped, %u send errors",
+	              stats.sent, stats.dropped, stats.send_errors);
 
 	return BOARD_STATE_DONE;
 }
@@ -360,35 +856,3 @@ const char *board_fsm_state_to_str(enum board_state state)
 		return "BOARD_STATE_INVALID";
 	}
 }
-
-/**
- * Compute the distance between two points on Earth (latitude/longitude in degrees).
- *
- * @param lat1 Latitude of the first point, in degrees.
- * @param lon1 Longitude of the first point, in degrees.
- * @param lat2 Latitude of the second point, in degrees.
- * @param lon2 Longitude of the second point, in degrees.
- *
- * @return The distance in meters.
- */
-double haversine(double lat1, double lon1, double lat2, double lon2)
-{
-	constexpr double EARTH_RADIUS_METERS = 6371000.0;
-	const double R = EARTH_RADIUS_METERS;
-
-	// convert degrees to radians
-	lat1 = lat1 * M_PI / 180.0;
-	lon1 = lon1 * M_PI / 180.0;
-	lat2 = lat2 * M_PI / 180.0;
-	lon2 = lon2 * M_PI / 180.0;
-
-	double dLat = lat2 - lat1;
-	double dLon = lon2 - lon1;
-
-	double a = std::sin(dLat / 2) * std::sin(dLat / 2) +
-	           std::cos(lat1) * std::cos(lat2) * std::sin(dLon / 2) * std::sin(dLon / 2);
-
-	double c = 2 * std::atan2(std::sqrt(a), std::sqrt(1 - a));
-
-	return R * c;
-}
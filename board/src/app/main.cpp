@@ -1,8 +1,8 @@
 #include "board_fsm.hpp"
 #include "common/common.h"
 #include "common/logging.h"
+#include "common/rt_profile.h"
 #include <stdlib.h>
-#include <unistd.h>
 
 int main()
 {
@@ -15,6 +15,12 @@ int main()
 
 	logging_write(LOG_INFO, "New run starting");
 
+	/* Before the FSM starts the sensors, so their reader threads are created under it */
+	struct rt_profile profile;
+	rt_profile_load(&profile);
+	if (rt_profile_apply(&profile) != 0)
+		logging_write(LOG_WARN, "Running without parts of the real-time profile");
+
 	enum board_state current_state = BOARD_STATE_INIT;
 	enum board_state previous_state = current_state;
 
@@ -27,11 +33,9 @@ int main()
 			logging_write(LOG_INFO, "Board FSM state transition: %s -> %s",
 			              board_fsm_state_to_str(previous_state),
 			              board_fsm_state_to_str(current_state));
+			logging_sync();
 			previous_state = current_state;
 		}
-
-		usleep(15000); /* Reduce CPU usage */
-
 	} while (current_state != BOARD_STATE_DONE);
 
 	logging_cleanup();
@@ -10,6 +10,12 @@
  */
 
 #include "adafruit_tm117.hpp"
+#include "common/clock.h"
+#include "common/trace.h"
+
+#ifdef RADAR_SIMULATION
+#include "flight_replay.hpp"
+#endif
 
 //---------------------------------------------------------------------
 // static variable initialization
@@ -32,16 +38,24 @@ TEMPERATURE_SENSOR *ADAFRUIT_TM117::get_temperature_sensor_instance(const uint8_
  * Constructor for the ADAFRUIT_TM117 class
  * @param i2c_addr The I2C slave address of the temperature sensor
  */
-ADAFRUIT_TM117::ADAFRUIT_TM117(uint8_t i2c_addr) : i2c_addr(i2c_addr) {}
+ADAFRUIT_TM117::ADAFRUIT_TM117(uint8_t i2c_addr)
+    : i2c_addr(i2c_addr), fd(-1), last_sample{}, has_sample(false)
+{
+#ifdef RADAR_SIMULATION
+	replay = nullptr;
+#endif
+}
 
 /**
- * Initialized the temperature sensor
+ * Initialized the temperature sensor, switching it to continuous conversion and parking the
+ * pointer register on the temperature result.
  *
  * @return 0 on success, -X on failure with failure code
  */
 int8_t ADAFRUIT_TM117::temperature_sensor_init()
 {
 #ifdef RADAR_SIMULATION
+	replay = flight_replay_active();
 	return 0;
 #endif
 	fd = open(TMP117_I2C_ID, O_RDWR);
@@ -57,44 +71,170 @@ int8_t ADAFRUIT_TM117::temperature_sensor_init()
 		close(fd);
 		return -2;
 	}
+
+	uint16_t device_id;
+	if (read_register(TMP117_REG_DEVICE_ID, &device_id) != 0 ||
+	    (device_id & 0x0FFF) != TMP117_DEVICE_ID)
+	{
+		printf("No TMP117 at I2C address 0x%02X\n", i2c_addr);
+		close(fd);
+		return -3;
+	}
+
+	if (write_register(TMP117_REG_CONFIGURATION, TMP117_CONFIG) != 0 ||
+	    set_pointer(TMP117_REG_TEMP_RESULT) != 0)
+	{
+		printf("Failed to configure continuous conversion\n");
+		close(fd);
+		return -4;
+	}
+
+	has_sample = false;
 	return 0;
 }
 
 /**
- * Reads the current temperature sensor reading over I2C
+ * Reads a 16 bit register. Moves the pointer register, so set_pointer() back to the
+ * temperature result afterwards.
+ *
+ * @return 0 on success, -X on failure with failure code.
+ */
+int8_t ADAFRUIT_TM117::read_register(uint8_t reg, uint16_t *value)
+{
+	if (set_pointer(reg) != 0)
+		return -1;
+
+	uint8_t buf[2];
+	if (read(fd, buf, 2) != 2)
+		return -2;
+
+	*value = (uint16_t)((buf[0] << 8) | buf[1]);
+	return 0;
+}
+
+/**
+ * Writes a 16 bit register, most significant byte first. This also moves the pointer register.
+ *
+ * @return 0 on success, -X on failure with failure code.
+ */
+int8_t ADAFRUIT_TM117::write_register(uint8_t reg, uint16_t value)
+{
+	uint8_t buf[3] = {reg, (uint8_t)(value >> 8), (uint8_t)(value & 0xFF)};
+	return write(fd, buf, 3) == 3 ? 0 : -1;
+}
+
+/**
+ * Points later reads at reg.
+ *
+ * @return 0 on success, -X on failure with failure code.
+ */
+int8_t ADAFRUIT_TM117::set_pointer(uint8_t reg)
+{
+	return write(fd, &reg, 1) == 1 ? 0 : -1;
+}
+
+/**
+ * Reads the latest conversion. The pointer register is already on the temperature result, so
+ * this is one I2C read, and none at all if the last read was within the same conversion
+ * cycle.
  * @param data Pointer to the structure to store the recieved temperature
  *
  * @return 0 on success, -X on failure with failure code.
  */
 int8_t ADAFRUIT_TM117::temperature_sensor_read(temp_sensor_data_t *data)
 {
-#ifdef RADAR_SIMULATION
-	data->temperature = -12.4; // fake, hard-coded temperature data
-	return 0;
-#endif
-	uint8_t buf[2] = {};
-	if (write(fd, buf, 1) != 1)
+	TRACE_SCOPE(TRACE_TEMPERATURE_READ);
+
+	uint64_t now_usec = clock_monotonic_usec();
+	if (has_sample && now_usec - last_sample.timestamp_usec < TMP117_CONVERSION_CYCLE_USEC)
 	{
-		printf("Failed to write register address\n");
-		close(fd);
-		return -1;
+		*data = last_sample; // no new conversion since
+		return 0;
 	}
 
+#ifdef RADAR_SIMULATION
+	double celcius;
+	if (replay != nullptr && replay->temperature(&celcius))
+		last_sample.temperature = celcius;
+	else
+		last_sample.temperature = -12.4; // fake, hard-coded temperature data
+#else
+	uint8_t buf[2] = {};
 	if (read(fd, buf, 2) != 2)
 	{
 		printf("Failed to read temperature data\n");
-		close(fd);
 		return -2;
 	}
 
 	// TMP117 returns 16-bit signed value: bits 15:0 with 0.0078°C resolution
-	int16_t raw = (buf[0] << 8) | buf[1];
-	double temperature = raw * 0.0078125f; // 1/128 = 0.0078125
+	int16_t raw = (int16_t)((buf[0] << 8) | buf[1]);
+	if (raw == TMP117_NO_CONVERSION_YET)
+		return -3;
+
+	last_sample.temperature = raw * TMP117_RESOLUTION_C;
+#endif
+	last_sample.timestamp_usec = now_usec;
+	has_sample = true;
 
-	data->temperature = temperature;
+	*data = last_sample;
 	return 0;
 }
 
+/**
+ * Reads max_samples conversions, waiting for each one to finish, so no two samples are from
+ * the same conversion.
+ * @param samples Array to store the samples in
+ * @param max_samples Number of samples to read
+ *
+ * @return the number of samples stored, -X on failure with failure code.
+ */
+int ADAFRUIT_TM117::temperature_sensor_read_samples(temp_sensor_data_t *samples,
+                                                    size_t max_samples)
+{
+	if (!samples)
+		return -4;
+
+	for (size_t i = 0; i < max_samples; i++)
+	{
+		if (has_sample)
+		{
+			uint64_t next_usec = last_sample.timestamp_usec + TMP117_CONVERSION_CYCLE_USEC;
+			uint64_t now_usec = clock_monotonic_usec();
+			if (now_usec < next_usec)
+				usleep(static_cast<useconds_t>(next_usec - now_usec));
+		}
+
+		int8_t rc = temperature_sensor_read(&samples[i]);
+		if (rc != 0)
+			return i > 0 ? static_cast<int>(i) : rc;
+	}
+
+	return static_cast<int>(max_samples);
+}
+
+/**
+ * Returns the conversion finished since the last read, if there is one, without waiting.
+ * The sensor only holds its latest conversion, so that is at most one sample.
+ * @param samples Array to store the samples in
+ * @param max_samples Capacity of samples
+ *
+ * @return the number of samples stored, -X on failure with failure code.
+ */
+int ADAFRUIT_TM117::temperature_sensor_try_read_samples(temp_sensor_data_t *samples,
+                                                        size_t max_samples)
+{
+	if (!samples)
+		return -4;
+
+	if (max_samples == 0 ||
+	    (has_sample &&
+	     clock_monotonic_usec() - last_sample.timestamp_usec < TMP117_CONVERSION_CYCLE_USEC))
+		return 0;
+
+	int8_t rc = temperature_sensor_read(&samples[0]);
+	return rc == 0 ? 1 : rc;
+}
+
 TEMPERATURE_SENSOR *instantiate_temperature_sensor()
 {
 	return ADAFRUIT_TM117::get_temperature_sensor_instance(TMP117_I2C_ADDR);
@@ -102,6 +242,6 @@ TEMPERATURE_SENSOR *instantiate_temperature_sensor()
 
 ADAFRUIT_TM117::~ADAFRUIT_TM117()
 {
-	if (fd)
+	if (fd >= 0)
 		close(fd);
 }
@@ -19,6 +19,8 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 
+class FLIGHT_REPLAY;
+
 #ifndef RADAR_SIMULATION
 	#include <linux/i2c-dev.h>
 #else
@@ -31,6 +33,24 @@
 #define TMP117_SCL_PIN 5 // GPIO3
 #define TMP117_I2C_ID "/dev/i2c-1"
 
+// Registers
+#define TMP117_REG_TEMP_RESULT 0x00
+#define TMP117_REG_CONFIGURATION 0x01
+#define TMP117_REG_DEVICE_ID 0x0F
+#define TMP117_DEVICE_ID 0x0117 // bits 11:0 of the device ID register
+
+/* Configuration: continuous conversion (MOD = 00), a conversion every 250 ms (CONV = 010)
+   averaging 8 samples (AVG = 01), ALERT pin signals data ready (DR/Alert = 1). That matches
+   the rate the board polls at while profiling. */
+#define TMP117_CONFIG_CONV_250MS (0x2 << 7)
+#define TMP117_CONFIG_AVG_8 (0x1 << 5)
+#define TMP117_CONFIG_DR_ALERT (1 << 2)
+#define TMP117_CONFIG (TMP117_CONFIG_CONV_250MS | TMP117_CONFIG_AVG_8 | TMP117_CONFIG_DR_ALERT)
+#define TMP117_CONVERSION_CYCLE_USEC 250000
+
+#define TMP117_RESOLUTION_C 0.0078125 // 1/128 degrees per LSB
+#define TMP117_NO_CONVERSION_YET ((int16_t)0x8000) // reset value of the result register
+
 class ADAFRUIT_TM117 : public TEMPERATURE_SENSOR
 {
 public:
@@ -44,6 +64,9 @@ public:
 
 	int8_t temperature_sensor_init() override;
 	int8_t temperature_sensor_read(temp_sensor_data_t *data) override;
+	int temperature_sensor_read_samples(temp_sensor_data_t *samples, size_t max_samples) override;
+	int temperature_sensor_try_read_samples(temp_sensor_data_t *samples,
+	                                        size_t max_samples) override;
 
 	~ADAFRUIT_TM117() override;
 
@@ -51,9 +74,22 @@ private:
 	// constructor is private to enforce factory function usage
 	ADAFRUIT_TM117(uint8_t i2c_addr);
 
+	int8_t read_register(uint8_t reg, uint16_t *value);
+	int8_t write_register(uint8_t reg, uint16_t value);
+	int8_t set_pointer(uint8_t reg);
+
 private:
 	static ADAFRUIT_TM117 *instance;
 	uint8_t i2c_addr;
 	int fd; // file descriptor
+
+	/* The pointer register stays on the temperature result, so a sample is a single 2 byte
+	   read. Reads within one conversion cycle of the last sample return it without touching
+	   the bus, the TMP117 would return the same value. */
+	temp_sensor_data_t last_sample;
+	bool has_sample;
+#ifdef RADAR_SIMULATION
+	FLIGHT_REPLAY *replay; // nullptr reports a fixed temperature
+#endif
 };
 #endif // #ifndef ADAFRUIT_TM117_H
@@ -11,36 +11,65 @@
 
 #include "adafruit_ultimate_gps_pa1616d.hpp"
 #include "bsp/gps.hpp"
+#include "gps_position_hint.hpp"
+#include "common/clock.h"
+#include "common/event_loop.h"
 #include "common/logging.h"
+#include "common/rt_profile.h"
+#include "common/trace.h"
+#include <cstdio>
+#include <cstring>
 #include <fcntl.h>
-#include <sstream>
-#include <string>
 #include <termios.h>
-#include <vector>
 
-#define GNGGA_FIELD_LATITUDE 2
-#define GNGGA_FIELD_NS_HEMISPHERE 3
-#define GNGGA_FIELD_LONGITUDE 4
-#define GNGGA_FIELD_EW_HEMISPHERE 5
-#define GNGGA_FIELD_FIX_QUALITY 6
-
-#define GNGGA_INVALID_FIX "0"
-
-#define GPS_INIT_TIMEOUT 240 // it usually takes 180 seconds
-
-std::vector<std::string> split_nmea_sentence(const std::string &sentence);
+#ifdef RADAR_SIMULATION
+#include "flight_replay.hpp"
+#endif
 
-static double nmea_coordinate_to_double(const std::string &coordinate,
-                                        const std::string &hemisphere);
+#define GPS_SIM_LATITUDE 45.3848
+#define GPS_SIM_LONGITUDE -75.7047
+
+/* The module powers up at 9600 baud sending 1 Hz fixes. 10 Hz fixes of the sentences we use
+   need about 3 KB/s, so switch to 115200 baud first. */
+#define PMTK_SET_BAUD_115200 "PMTK251,115200"
+#define PMTK_SET_FIX_INTERVAL_100MS "PMTK220,100"
+// Sentence rates in GLL,RMC,VTG,GGA,GSA,GSV,...,MCHN order: only RMC, VTG, GGA and GSA
+#define PMTK_SET_SENTENCES "PMTK314,0,1,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0"
+#define PMTK_ACK_SUCCESS '3'
+#define PMTK_BAUD_SWITCH_USEC 100000 // the module needs a moment before it listens at the new rate
+
+/* The last fix is cached so the next boot can aid the module with its position and the time,
+   and hot start it while its battery backed ephemeris is still valid. EASY extends that with
+   ephemeris the module predicts itself for up to 3 days. */
+#define GPS_POSITION_HINT_PATH "./gps_position_hint"
+#define PMTK_HOT_START "PMTK101"
+#define PMTK_WARM_START "PMTK102"
+#define PMTK_ENABLE_EASY "PMTK869,1,1"
+#define PMTK_RESTART_USEC 500000 // the module ignores commands while it restarts
 
 ADAFRUIT_ULTIMATE_GPS_PA1616D *ADAFRUIT_ULTIMATE_GPS_PA1616D::instance = nullptr;
 
-ADAFRUIT_ULTIMATE_GPS_PA1616D::ADAFRUIT_ULTIMATE_GPS_PA1616D() : fd(-1) {}
+ADAFRUIT_ULTIMATE_GPS_PA1616D::ADAFRUIT_ULTIMATE_GPS_PA1616D()
+    : fd(-1), ingesting(false), fix_event_fd(event_fd_create(false)), last_read_sequence(0),
+      nmea_fix{}, fix_sequence(0), bad_sentences(0)
+{
+}
 
+/**
+ * Destructor for the ADAFRUIT_ULTIMATE_GPS_PA1616D class. Stops the ingest thread before
+ * closing the port it reads from.
+ */
 ADAFRUIT_ULTIMATE_GPS_PA1616D::~ADAFRUIT_ULTIMATE_GPS_PA1616D()
 {
+	ingesting.store(false, std::memory_order_release);
+	if (ingest_thread.joinable())
+		ingest_thread.join();
+
 	if (fd >= 0)
 		close(fd);
+
+	if (fix_event_fd >= 0)
+		close(fix_event_fd);
 }
 
 GPS *instantiate_gps()
@@ -61,47 +90,165 @@ GPS *ADAFRUIT_ULTIMATE_GPS_PA1616D::get_gps_instance()
 }
 
 /**
- * Initialize the GPS.
+ * Initialize the GPS. Does not wait for a fix: the module keeps searching for satellites in
+ * the background and gps_fix_event_fd() wakes the caller on the first one.
  *
  * @return 0 on success, -X on failure with failure code
  */
 int8_t ADAFRUIT_ULTIMATE_GPS_PA1616D::gps_init()
 {
 #ifdef RADAR_SIMULATION
-	return 0;
-#endif
+	// a replayed flight goes through the real NMEA parsing, otherwise the drone hovers
+	FLIGHT_REPLAY *replay = flight_replay_active();
+	if (replay == nullptr)
+	{
+		ingesting.store(true, std::memory_order_release);
+		ingest_thread = std::thread(&ADAFRUIT_ULTIMATE_GPS_PA1616D::simulate_loop, this);
+		return 0;
+	}
+	line_reader.attach(replay->gps_fd());
+#else
 	fd = open(GPS_SERIAL_DEVICE, O_RDWR);
 	if (fd < 0)
 		return -1;
 
-	if (!configure_serial())
+	if (!configure_serial(B9600))
 		return -2;
+	if (rt_profile_serial_low_latency(fd) != 0)
+		logging_write(LOG_INFO, "GPS: serial port does not support low latency mode");
 
-	int seconds_elasped = 0;
-	std::string sentence;
+	line_reader.attach(fd);
+	if (!configure_module())
+		logging_write(LOG_WARN, "GPS: module did not take the 10 Hz configuration");
+#endif
 
-	// GPS might take some time to search for satellites.
-	while (seconds_elasped < GPS_INIT_TIMEOUT)
+	ingesting.store(true, std::memory_order_release);
+	ingest_thread = std::thread(&ADAFRUIT_ULTIMATE_GPS_PA1616D::ingest_loop, this);
+	return 0;
+}
+
+/**
+ * Switch the module to 115200 baud and 10 Hz fixes, starting it from the cached position
+ * hint if there is one. A module that is already at 115200 from before a restart ignores the
+ * baud command, so this works either way.
+ *
+ * @return true if the module acknowledged the rate and sentence commands
+ */
+bool ADAFRUIT_ULTIMATE_GPS_PA1616D::configure_module()
+{
+	if (!switch_baud())
+		return false;
+
+	// a software restart brings the module back at its power up rate
+	if (start_from_hint() && !switch_baud())
+		return false;
+
+	bool sentences_ok = send_pmtk_command(PMTK_SET_SENTENCES, true);
+	bool rate_ok = send_pmtk_command(PMTK_SET_FIX_INTERVAL_100MS, true);
+	return sentences_ok && rate_ok;
+}
+
+/**
+ * Switch the module from its 9600 baud power up rate to 115200 baud.
+ *
+ * @return true if the port was reconfigured
+ */
+bool ADAFRUIT_ULTIMATE_GPS_PA1616D::switch_baud()
+{
+	if (!configure_serial(B9600))
+		return false;
+
+	send_pmtk_command(PMTK_SET_BAUD_115200, false); // not acknowledged at the old rate
+	tcdrain(fd);
+	usleep(PMTK_BAUD_SWITCH_USEC);
+
+	if (!configure_serial(B115200))
+		return false;
+	tcflush(fd, TCIFLUSH); // anything buffered was received at the wrong rate
+	line_reader.discard();
+	return true;
+}
+
+/**
+ * Hot or warm start the module from the cached position hint, and aid it with the position
+ * and the time. Without a usable hint the module cold starts on its own.
+ *
+ * @return true if the module was restarted
+ */
+bool ADAFRUIT_ULTIMATE_GPS_PA1616D::start_from_hint()
+{
+	gps_position_hint_t hint;
+	if (gps_position_hint_load(GPS_POSITION_HINT_PATH, &hint) != 0)
 	{
-		if (read_nmea_gngga_sentence(sentence))
-		{
-			std::vector<std::string> fields = split_nmea_sentence(sentence);
-			if (fields.size() > GNGGA_FIELD_FIX_QUALITY &&
-			    fields[GNGGA_FIELD_FIX_QUALITY] != GNGGA_INVALID_FIX)
-			{
-				return 0;
-			}
-		}
+		logging_write(LOG_INFO, "GPS: no position hint, cold start");
+		return false;
+	}
+
+	uint64_t now_utc_usec = clock_realtime_usec();
+	enum gps_start_mode mode = gps_position_hint_start_mode(&hint, now_utc_usec);
+	if (mode == GPS_START_COLD)
+	{
+		logging_write(LOG_INFO, "GPS: position hint is stale or the clock is behind it, "
+		                        "cold start");
+		return false;
+	}
+
+	// EASY predicts ephemeris from what was last received, useful for the next boot too
+	send_pmtk_command(PMTK_ENABLE_EASY, true);
+	send_pmtk_command(mode == GPS_START_HOT ? PMTK_HOT_START : PMTK_WARM_START, false);
+	tcdrain(fd);
+	usleep(PMTK_RESTART_USEC);
+
+	char aiding[96];
+	if (gps_position_hint_format_aiding(&hint, now_utc_usec, aiding, sizeof(aiding)) > 0)
+		send_pmtk_command(aiding, true);
+
+	logging_write(LOG_INFO, "GPS: %s start near %.4f, %.4f from a %llu min old hint",
+	              mode == GPS_START_HOT ? "hot" : "warm", hint.latitude, hint.longitude,
+	              (unsigned long long)((now_utc_usec - hint.utc_usec) / 60000000));
+	return true;
+}
+
+/**
+ * Send a PMTK command, e.g. "PMTK220,100", framed with '$' and its checksum.
+ * @param body The command without the framing
+ * @param wait_for_ack Whether to wait for the module's "$PMTK001,<cmd>,3" reply
+ *
+ * @return true if the command was sent (and acknowledged, when waiting for it)
+ */
+bool ADAFRUIT_ULTIMATE_GPS_PA1616D::send_pmtk_command(const char *body, bool wait_for_ack)
+{
+	char command[96];
+	int len = snprintf(command, sizeof(command), "$%s*%02X\r\n", body, nmea_checksum(body));
+	if (len < 0 || len >= (int)sizeof(command) || write(fd, command, len) != len)
+		return false;
+
+	if (!wait_for_ack)
+		return true;
 
-		sleep(1);
-		seconds_elasped++;
+	// The reply names the command it acknowledges, e.g. "$PMTK001,220,3*30" for PMTK220
+	char ack_prefix[16];
+	snprintf(ack_prefix, sizeof(ack_prefix), "$PMTK001,%.3s,", body + 4);
+	size_t ack_prefix_len = strlen(ack_prefix);
+
+	uint64_t deadline_usec = clock_monotonic_usec() + PMTK_ACK_TIMEOUT_MS * 1000ULL;
+	while (clock_monotonic_usec() < deadline_usec)
+	{
+		std::string_view line;
+		if (line_reader.read_line(&line, PMTK_ACK_TIMEOUT_MS) < 0)
+			break;
+
+		nmea_fields_t fields;
+		if (line.compare(0, ack_prefix_len, ack_prefix) == 0 && nmea_tokenize(line, &fields) == 0)
+			return fields.count > 2 && fields.field[2].size() == 1 &&
+			       fields.field[2][0] == PMTK_ACK_SUCCESS;
 	}
 
-	// Breaking out of the loop means we timed out.
-	return -3;
+	logging_write(LOG_WARN, "GPS: no acknowledgement for %s", body);
+	return false;
 }
 
-bool ADAFRUIT_ULTIMATE_GPS_PA1616D::configure_serial()
+bool ADAFRUIT_ULTIMATE_GPS_PA1616D::configure_serial(speed_t baud)
 {
 	struct termios tty;
 
@@ -111,8 +258,8 @@ bool ADAFRUIT_ULTIMATE_GPS_PA1616D::configure_serial()
 		return false;
 	}
 
-	cfsetospeed(&tty, B9600);
-	cfsetispeed(&tty, B9600);
+	cfsetospeed(&tty, baud);
+	cfsetispeed(&tty, baud);
 
 	tty.c_cflag &= ~PARENB; // No parity
 	tty.c_cflag &= ~CSTOPB; // 1 stop bit
@@ -132,8 +279,9 @@ bool ADAFRUIT_ULTIMATE_GPS_PA1616D::configure_serial()
 	tty.c_oflag &= ~OPOST;
 	tty.c_oflag &= ~ONLCR;
 
-	tty.c_cc[VMIN] = 1;  // read at least 1 byte
-	tty.c_cc[VTIME] = 1; // timeout in deciseconds
+	// Non-blocking reads, the line reader waits for data with poll()
+	tty.c_cc[VMIN] = 0;
+	tty.c_cc[VTIME] = 0;
 
 	if (tcsetattr(fd, TCSANOW, &tty) != 0)
 	{
@@ -145,117 +293,191 @@ bool ADAFRUIT_ULTIMATE_GPS_PA1616D::configure_serial()
 }
 
 /**
- * Read data from GPS.
+ * Read the latest fix from GPS. The ingest thread keeps it current, so this never waits for
+ * the module; check timestamp_usec or sequence to tell how fresh it is.
  * @param data pointer to store the gps data.
  *
  * @return 0 on success, -X on failure with failure code.
  */
 int8_t ADAFRUIT_ULTIMATE_GPS_PA1616D::gps_read(gps_data_t *data)
 {
-#ifdef RADAR_SIMULATION
-	return 0;
-#endif
+	TRACE_SCOPE(TRACE_GPS_READ);
+
+#ifndef RADAR_SIMULATION
 	if (fd < 0)
 		return -1;
+#endif
 
 	if (!data)
 		return -2;
 
-	std::string line;
+	if (!latest_fix.load(data))
+		return -3; // no fix yet
 
-	// Keep reading until we get a valid GNGGA sentence
-	while (!read_nmea_gngga_sentence(line))
+	return 0;
+}
+
+/**
+ * Copies every fix published since the last call, oldest first, without blocking. Only the
+ * last RECENT_FIXES are kept; older ones are skipped and show up as a gap in sequence.
+ * @param fixes array to store the fixes in.
+ * @param max_fixes capacity of fixes, the rest are returned by the next call.
+ *
+ * @return the number of fixes stored, -X on failure with failure code.
+ */
+int ADAFRUIT_ULTIMATE_GPS_PA1616D::gps_read_fixes(gps_data_t *fixes, size_t max_fixes)
+{
+	TRACE_SCOPE(TRACE_GPS_READ);
+
+#ifndef RADAR_SIMULATION
+	if (fd < 0)
+		return -1;
+#endif
+
+	if (!fixes)
+		return -2;
+
+	gps_data_t latest;
+	if (!latest_fix.load(&latest))
+		return 0; // no fix yet
+
+	// every fix up to latest was stored in its slot before latest was published
+	uint32_t next = last_read_sequence + 1;
+	if (latest.sequence - last_read_sequence > RECENT_FIXES)
+		next = latest.sequence - RECENT_FIXES + 1;
+
+	size_t count = 0;
+	for (; count < max_fixes && static_cast<int32_t>(latest.sequence - next) >= 0; next++)
 	{
+		last_read_sequence = next;
+		// a slot the ingest thread overwrote while we got to it holds a newer fix
+		if (recent_fixes[next % RECENT_FIXES].load(&fixes[count]) && fixes[count].sequence == next)
+			count++;
 	}
 
-	std::vector<std::string> fields = split_nmea_sentence(line);
-
-	data->latitude =
-	    nmea_coordinate_to_double(fields[GNGGA_FIELD_LATITUDE], fields[GNGGA_FIELD_NS_HEMISPHERE]);
-	data->longitude =
-	    nmea_coordinate_to_double(fields[GNGGA_FIELD_LONGITUDE], fields[GNGGA_FIELD_EW_HEMISPHERE]);
+	return static_cast<int>(count);
+}
 
-	return 0;
+/**
+ * Returns the eventfd that becomes readable whenever a new fix is published.
+ */
+int ADAFRUIT_ULTIMATE_GPS_PA1616D::gps_fix_event_fd()
+{
+	return fix_event_fd;
 }
 
-/*
- * Read a GNGGA NMEA sentence from the GPS module, e.g.,
- *
- * $GNGGA,012422.000,4515.9532,N,07543.7486,W,2,14,0.89,97.1,M,-34.2,M,,*77.
+/**
+ * Saves the latest fix as the position hint for the next boot. The save syncs the file to
+ * disk, which can block for a while, so it is never done on the ingest thread.
  *
- * An NMEA sentence is a string of data outputted from GPS modules. NMEA is a common standard
- * for GPS modules. GNGGA is a type of NMEA sentence that provides latitude and longitude.
+ * @return 0 on success, -X on failure with failure code.
  */
-bool ADAFRUIT_ULTIMATE_GPS_PA1616D::read_nmea_gngga_sentence(std::string &sentence)
+int8_t ADAFRUIT_ULTIMATE_GPS_PA1616D::gps_save_position_hint()
 {
-	static char serial_buf[SERIAL_BUF_SIZE];
-	static int serial_buf_idx;
-	char ch;
+#ifdef RADAR_SIMULATION
+	return 0; // a simulated or replayed fix is not where the board is
+#else
+	gps_data_t fix;
+	if (!latest_fix.load(&fix))
+		return -1; // no fix yet
+
+	// the wall clock time the fix was received, not when it is saved
+	uint64_t age_usec = clock_monotonic_usec() - fix.timestamp_usec;
+	gps_position_hint_t hint = {fix.latitude, fix.longitude, clock_realtime_usec() - age_usec};
+	if (gps_position_hint_save(GPS_POSITION_HINT_PATH, &hint) != 0)
+		return -2;
+	return 0;
+#endif
+}
 
-	/* Read by byte instead of a full line because the serial port delivers streaming bytes,
-	 * not full lines. */
-	while (read(fd, &ch, 1) == 1)
+/**
+ * Body of the ingest thread. Reads every sentence the module sends as it arrives. Runs as
+ * RT_THREAD_GPS under the real-time profile.
+ */
+void ADAFRUIT_ULTIMATE_GPS_PA1616D::ingest_loop()
+{
+	rt_profile_enter(RT_THREAD_GPS);
+	while (ingesting.load(std::memory_order_acquire))
 	{
-		if (ch == '\n')
-		{
-			serial_buf[serial_buf_idx] = '\0';
-			std::string line(serial_buf);
-			serial_buf_idx = 0;
-
-			if (line.rfind(GNGGA_SENTENCE_HEADER, 0) == 0)
-			{
-				sentence = line;
-				return true;
-			}
-		}
-		else if (serial_buf_idx < SERIAL_BUF_SIZE - 1)
-		{
-			serial_buf[serial_buf_idx++] = ch;
-		}
-		else
+		std::string_view sentence;
+		int8_t rc = line_reader.read_line(&sentence, LINE_TIMEOUT_MS);
+		if (rc == -1)
+			continue; // timed out, check whether we were asked to stop
+
+		if (rc < 0)
 		{
-			// Reset idx to prevent buffer overflow
-			serial_buf_idx = 0;
+			logging_write(LOG_WARN, "GPS serial read failed! (err %d)", rc);
+			usleep(LINE_TIMEOUT_MS * 1000);
+			continue;
 		}
-	}
 
-	return false;
+		handle_sentence(sentence);
+	}
 }
 
 /*
- * Split an NMEA sentence into a vector of strings, each representing an individual field.
+ * Fold one NMEA sentence into the current fix, e.g.,
+ *
+ * $GNGGA,012422.000,4515.9532,N,07543.7486,W,2,14,0.89,97.1,M,-34.2,M,,*77
+ *
+ * An NMEA sentence is a string of data outputted from GPS modules. NMEA is a common standard
+ * for GPS modules. The module sends RMC and VTG (speed) before GGA (position) each epoch, so
+ * publishing on GGA gives a fix with everything from the same epoch.
  */
-std::vector<std::string> split_nmea_sentence(const std::string &sentence)
+void ADAFRUIT_ULTIMATE_GPS_PA1616D::handle_sentence(std::string_view sentence)
 {
-	std::vector<std::string> fields;
-	std::stringstream ss(sentence);
-	std::string field;
+	TRACE_SCOPE(TRACE_GPS_PARSE);
 
-	while (std::getline(ss, field, ','))
+	int type = nmea_parse_sentence(sentence, &nmea_fix);
+	if (type < 0)
 	{
-		fields.push_back(field);
+		// line noise, counted so a bad cable shows up in the log without flooding it
+		bad_sentences++;
+		if ((bad_sentences & (bad_sentences - 1)) == 0) // at powers of two
+			logging_write(LOG_WARN, "GPS: %u bad NMEA sentences (err %d)", bad_sentences, type);
+		return;
 	}
 
-	return fields;
+	if (type != NMEA_SENTENCE_GGA || nmea_fix.fix_quality == 0)
+		return; // no fix, keep publishing the last good one
+
+	gps_data_t fix;
+	fix.latitude = nmea_fix.latitude_e7 * 1e-7;
+	fix.longitude = nmea_fix.longitude_e7 * 1e-7;
+	fix.speed_mps = nmea_fix.speed_mm_s * 1e-3;
+	fix.course_deg = nmea_fix.course_cdeg * 1e-2;
+	fix.hdop = nmea_fix.hdop_x100 * 1e-2;
+	fix.fix_quality = nmea_fix.fix_quality;
+	fix.num_satellites = nmea_fix.num_satellites;
+	publish_fix(&fix);
 }
 
-/*
- * Convert an NMEA sentence-formated ASCII coordinate to double.
+/**
+ * Stamps a fix, keeps it with the recent ones, makes it the latest and wakes whoever waits on
+ * fix_event_fd.
  */
-static double nmea_coordinate_to_double(const std::string &coordinate,
-                                        const std::string &hemisphere)
+void ADAFRUIT_ULTIMATE_GPS_PA1616D::publish_fix(gps_data_t *fix)
 {
-	if (coordinate.empty())
-		return 0;
-
-	double raw = std::stod(coordinate);
-	double deg = static_cast<int>(raw / 100);
-	double min = raw - (deg * 100);
-	double dec = deg + min / 60.0;
-
-	// Convention is that N and E are positive, while S and W are negative
-	if (hemisphere == "S" || hemisphere == "W")
-		dec *= -1;
+	fix->timestamp_usec = clock_monotonic_usec();
+	fix->sequence = ++fix_sequence;
+	recent_fixes[fix->sequence % RECENT_FIXES].store(*fix);
+	latest_fix.store(*fix);
+	event_fd_signal(fix_event_fd);
+}
 
-	return dec;
+/**
+ * Body of the ingest thread in simulation: a drone hovering over the test site, publishing
+ * fixes at the real module's rate.
+ */
+void ADAFRUIT_ULTIMATE_GPS_PA1616D::simulate_loop()
+{
+	while (ingesting.load(std::memory_order_acquire))
+	{
+		gps_data_t fix = {};
+		fix.latitude = GPS_SIM_LATITUDE;
+		fix.longitude = GPS_SIM_LONGITUDE;
+		fix.fix_quality = 1;
+		publish_fix(&fix);
+		usleep(SIM_FIX_INTERVAL_USEC);
+	}
 }
@@ -14,7 +14,13 @@
 #define ADAFRUIT_ULTIMATE_GPS_PA1616D_H
 
 #include "bsp/gps.hpp"
-#include <string>
+#include "common/seqlock.hpp"
+#include "nmea_parser.hpp"
+#include "serial_line_reader.hpp"
+#include <atomic>
+#include <string_view>
+#include <termios.h>
+#include <thread>
 #include <unistd.h>
 
 class ADAFRUIT_ULTIMATE_GPS_PA1616D : public GPS
@@ -30,6 +36,9 @@ public:
 
 	int8_t gps_init() override;
 	int8_t gps_read(gps_data_t *data) override;
+	int gps_read_fixes(gps_data_t *fixes, size_t max_fixes) override;
+	int gps_fix_event_fd() override;
+	int8_t gps_save_position_hint() override;
 
 	~ADAFRUIT_ULTIMATE_GPS_PA1616D() override;
 
@@ -37,17 +46,42 @@ private:
 	// constructor is private to enforce factory function usage
 	ADAFRUIT_ULTIMATE_GPS_PA1616D();
 
-	bool configure_serial();
-	bool read_nmea_gngga_sentence(std::string &sentence);
+	bool configure_serial(speed_t baud);
+	bool configure_module();
+	bool switch_baud();
+	bool start_from_hint();
+	bool send_pmtk_command(const char *body, bool wait_for_ack);
+	void ingest_loop();
+	void handle_sentence(std::string_view sentence);
+	void simulate_loop();
+	void publish_fix(gps_data_t *fix);
 
 private:
 	static ADAFRUIT_ULTIMATE_GPS_PA1616D *instance;
 
 	static constexpr const char *GPS_SERIAL_DEVICE = "/dev/serial0";
-	static constexpr const char *GNGGA_SENTENCE_HEADER = "$GNGGA";
-	static constexpr size_t SERIAL_BUF_SIZE = 256; // minimum safe NMEA sentence is 82 bytes
+	static constexpr int PMTK_ACK_TIMEOUT_MS = 1000;
+	static constexpr int LINE_TIMEOUT_MS = 200; // also how quickly the ingest thread notices a stop
+	static constexpr useconds_t SIM_FIX_INTERVAL_USEC = 100000; // the real module's 10 Hz
+	static constexpr uint32_t RECENT_FIXES = 16; // 1.6 s of fixes at 10 Hz
 
 	int fd;
+
+	// The ingest thread parses every sentence as it arrives and publishes the latest fix
+	SERIAL_LINE_READER line_reader;
+	std::thread ingest_thread;
+	std::atomic<bool> ingesting;
+	SEQLOCK<gps_data_t> latest_fix;
+	SEQLOCK<gps_data_t> recent_fixes[RECENT_FIXES]; // fix n lives in slot n % RECENT_FIXES
+	int fix_event_fd; // signalled after every published fix
+
+	// only touched by the reader of gps_read_fixes()
+	uint32_t last_read_sequence;
+
+	// only touched by the ingest thread
+	nmea_fix_t nmea_fix; // accumulates the sentences of the current epoch
+	uint32_t fix_sequence;
+	uint32_t bad_sentences;
 };
 
 #endif // #ifndef ADAFRUIT_ULTIMATE_GPS_PA1616D_H
@@ -0,0 +1,432 @@
+/**
+ * Name: flight_replay.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the flight replay described in flight_replay.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "flight_replay.hpp"
+#include "common/clock.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <mutex>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+//--------------------------------
+#define FLIGHT_REPLAY_WRITE_POLL_MS 100     // how often a blocked write checks for stop()
+#define FLIGHT_REPLAY_MAX_SLEEP_USEC 100000 // how often a paced wait checks for stop()
+
+//---------------------------------------------------------------------
+// static variable initialization
+FLIGHT_REPLAY *FLIGHT_REPLAY::instance = nullptr;
+
+/**
+ * Factory function to instance the flight replay.
+ *
+ * @return Pointer to the FLIGHT_REPLAY object.
+ */
+FLIGHT_REPLAY *FLIGHT_REPLAY::get_instance()
+{
+	if (instance == nullptr)
+		instance = new FLIGHT_REPLAY();
+	return instance;
+}
+
+/**
+ * Constructor for the FLIGHT_REPLAY class. Nothing is replayed until a file is opened and
+ * started.
+ */
+FLIGHT_REPLAY::FLIGHT_REPLAY()
+    : data(nullptr), size(0), speed(1.0), radar_pipe{-1, -1}, gps_pipe{-1, -1}, replaying(false),
+      done(false), latest_temperature(0.0), has_temperature(false), radar_lines(0),
+      radar_lines_dropped(0), gps_sentences(0), temperature_samples(0), bad_lines(0)
+{
+}
+
+/**
+ * Destructor for the FLIGHT_REPLAY class. Stops the replay thread and releases the file.
+ */
+FLIGHT_REPLAY::~FLIGHT_REPLAY()
+{
+	close();
+}
+
+/**
+ * Maps a replay file and creates the pipes the drivers read from.
+ * @param path The replay file, see flight_replay.hpp for its format.
+ *
+ * @return Returns 0 on success, -X on failure with failure code.
+ */
+int8_t FLIGHT_REPLAY::open(const char *path)
+{
+	if (data != nullptr)
+		return -1; // already open
+
+	int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		printf("Failed to open flight replay `%s`: %s\n", path, strerror(errno));
+		return -2;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		printf("Flight replay `%s` is empty\n", path);
+		::close(fd);
+		return -3;
+	}
+
+	void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (mapping == MAP_FAILED)
+	{
+		printf("Failed to map flight replay `%s`: %s\n", path, strerror(errno));
+		return -4;
+	}
+	madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+
+	// the write ends never block so the replay thread can always notice stop()
+	if (pipe2(radar_pipe, O_CLOEXEC | O_NONBLOCK) != 0 ||
+	    pipe2(gps_pipe, O_CLOEXEC | O_NONBLOCK) != 0)
+	{
+		printf("Failed to create the flight replay pipes: %s\n", strerror(errno));
+		munmap(mapping, st.st_size);
+		close();
+		return -5;
+	}
+
+	data = static_cast<const char *>(mapping);
+	size = st.st_size;
+	done.store(false, std::memory_order_relaxed);
+	has_temperature.store(false, std::memory_order_relaxed);
+	radar_lines.store(0, std::memory_order_relaxed);
+	radar_lines_dropped.store(0, std::memory_order_relaxed);
+	gps_sentences.store(0, std::memory_order_relaxed);
+	temperature_samples.store(0, std::memory_order_relaxed);
+	bad_lines.store(0, std::memory_order_relaxed);
+	return 0;
+}
+
+/**
+ * Starts feeding the opened replay to the pipes.
+ * @param speed How fast to replay, 1 is real time. 0 replays as fast as the radar and GPS are
+ *              read, radar lines then wait for the reader instead of being dropped.
+ *
+ * @return Returns 0 on success, -X on failure with failure code.
+ */
+int8_t FLIGHT_REPLAY::start(double speed)
+{
+	if (data == nullptr)
+		return -1; // not open
+	if (replaying.load(std::memory_order_acquire))
+		return -2; // already started
+	if (speed < 0)
+		return -3;
+
+	this->speed = speed;
+	done.store(false, std::memory_order_relaxed);
+	replaying.store(true, std::memory_order_release);
+	replay_thread = std::thread(&FLIGHT_REPLAY::replay_loop, this);
+	return 0;
+}
+
+/**
+ * Stops the replay thread. The pipes stay open, so readers just see the data stop.
+ */
+void FLIGHT_REPLAY::stop()
+{
+	replaying.store(false, std::memory_order_release);
+	if (replay_thread.joinable())
+		replay_thread.join();
+}
+
+/**
+ * Stops the replay and releases the file and pipes.
+ */
+void FLIGHT_REPLAY::close()
+{
+	stop();
+
+	if (data != nullptr)
+		munmap(const_cast<char *>(data), size);
+	data = nullptr;
+	size = 0;
+
+	for (int *fd : {&radar_pipe[0], &radar_pipe[1], &gps_pipe[0], &gps_pipe[1]})
+	{
+		if (*fd >= 0)
+			::close(*fd);
+		*fd = -1;
+	}
+}
+
+bool FLIGHT_REPLAY::is_open() const
+{
+	return data != nullptr;
+}
+
+/**
+ * @return Returns true once every event in the file has been replayed.
+ */
+bool FLIGHT_REPLAY::finished() const
+{
+	return done.load(std::memory_order_acquire);
+}
+
+/**
+ * @return Returns the non-blocking pipe the radar lines come out of.
+ */
+int FLIGHT_REPLAY::radar_fd() const
+{
+	return radar_pipe[0];
+}
+
+/**
+ * @return Returns the non-blocking pipe the NMEA sentences come out of.
+ */
+int FLIGHT_REPLAY::gps_fd() const
+{
+	return gps_pipe[0];
+}
+
+/**
+ * Drops the radar lines waiting in the pipe, the replay's tcflush(TCIFLUSH).
+ */
+void FLIGHT_REPLAY::discard_radar()
+{
+	char buf[4096];
+	while (read(radar_pipe[0], buf, sizeof(buf)) > 0)
+	{
+	}
+}
+
+/**
+ * Gets the latest replayed temperature reading.
+ * @param celcius Where to store the temperature.
+ *
+ * @return Returns true if a reading has been replayed yet.
+ */
+bool FLIGHT_REPLAY::temperature(double *celcius) const
+{
+	if (!has_temperature.load(std::memory_order_acquire))
+		return false;
+	*celcius = latest_temperature.load(std::memory_order_relaxed);
+	return true;
+}
+
+void FLIGHT_REPLAY::get_stats(flight_replay_stats_t *stats) const
+{
+	stats->radar_lines = radar_lines.load(std::memory_order_relaxed);
+	stats->radar_lines_dropped = radar_lines_dropped.load(std::memory_order_relaxed);
+	stats->gps_sentences = gps_sentences.load(std::memory_order_relaxed);
+	stats->temperature_samples = temperature_samples.load(std::memory_order_relaxed);
+	stats->bad_lines = bad_lines.load(std::memory_order_relaxed);
+}
+
+//------------------------------ Helper Functions -------------------------------
+/**
+ * Writes a line and its "\r\n" to a non-blocking pipe.
+ * @param fd The write end of the pipe.
+ * @param line The line to write.
+ * @param len The length of line.
+ * @param lossy Drop the line if the pipe is full instead of waiting for the reader.
+ * @param running Keeps waiting for the reader while this is true.
+ *
+ * @return Returns true if the line was written.
+ */
+static bool write_line(int fd, const char *line, size_t len, bool lossy,
+                       const std::atomic<bool> &running)
+{
+	static const char LINE_END[] = "\r\n";
+	struct iovec parts[2] = {
+	    {const_cast<char *>(line), len},
+	    {const_cast<char *>(LINE_END), 2},
+	};
+	size_t remaining = len + 2;
+	int part = 0;
+
+	while (remaining > 0)
+	{
+		// a line up to PIPE_BUF long is written whole or not at all
+		ssize_t written = writev(fd, parts + part, 2 - part);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			if (errno != EAGAIN)
+				return false;
+			if (lossy && remaining == len + 2)
+				return false; // the reader is not keeping up, like an overflowing tty
+
+			struct pollfd pfd = {fd, POLLOUT, 0};
+			while (running.load(std::memory_order_acquire) &&
+			       poll(&pfd, 1, FLIGHT_REPLAY_WRITE_POLL_MS) == 0)
+			{
+			}
+			if (!running.load(std::memory_order_acquire))
+				return false;
+			continue;
+		}
+
+		remaining -= written;
+		while (part < 2 && static_cast<size_t>(written) >= parts[part].iov_len)
+			written -= parts[part++].iov_len;
+		if (part < 2)
+		{
+			parts[part].iov_base = static_cast<char *>(parts[part].iov_base) + written;
+			parts[part].iov_len -= written;
+		}
+	}
+	return true;
+}
+
+/**
+ * Body of the replay thread. Walks the mapped file once, waiting for each event's time when
+ * pacing, then marks the replay finished.
+ */
+void FLIGHT_REPLAY::replay_loop()
+{
+	uint64_t start_usec = clock_monotonic_usec();
+	const char *cursor = data;
+	const char *end = data + size;
+
+	while (cursor < end && replaying.load(std::memory_order_acquire))
+	{
+		const char *newline = static_cast<const char *>(memchr(cursor, '\n', end - cursor));
+		const char *line_end = newline ? newline : end;
+		const char *line = cursor;
+		cursor = newline ? newline + 1 : end;
+
+		size_t len = line_end - line;
+		if (len > 0 && line[len - 1] == '\r')
+			len--;
+		if (len == 0 || line[0] == '#')
+			continue;
+
+		// the file is not NUL terminated, so the time is parsed by hand
+		uint64_t offset_usec = 0;
+		size_t i = 0;
+		for (; i < len && line[i] >= '0' && line[i] <= '9'; i++)
+			offset_usec = offset_usec * 10 + (line[i] - '0');
+		if (i == 0 || i == len || line[i] != ' ')
+		{
+			bad_lines.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		if (speed > 0)
+		{
+			uint64_t due_usec = start_usec + static_cast<uint64_t>(offset_usec / speed);
+			uint64_t now_usec;
+			while ((now_usec = clock_monotonic_usec()) < due_usec &&
+			       replaying.load(std::memory_order_acquire))
+			{
+				uint64_t wait_usec = due_usec - now_usec;
+				usleep(wait_usec < FLIGHT_REPLAY_MAX_SLEEP_USEC ? wait_usec
+				                                                : FLIGHT_REPLAY_MAX_SLEEP_USEC);
+			}
+		}
+
+		replay_line(line + i + 1, len - i - 1);
+	}
+
+	done.store(true, std::memory_order_release);
+}
+
+/**
+ * Replays one event.
+ * @param event The event type, a space and its payload, without the time or line ending.
+ * @param len The length of event.
+ */
+void FLIGHT_REPLAY::replay_line(const char *event, size_t len)
+{
+	if (len < 3 || event[1] != ' ')
+	{
+		bad_lines.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	const char *payload = event + 2;
+	size_t payload_len = len - 2;
+
+	switch (event[0])
+	{
+	case 'R':
+		if (write_line(radar_pipe[1], payload, payload_len, speed > 0, replaying))
+			radar_lines.fetch_add(1, std::memory_order_relaxed);
+		else
+			radar_lines_dropped.fetch_add(1, std::memory_order_relaxed);
+		break;
+
+	case 'G':
+		if (write_line(gps_pipe[1], payload, payload_len, false, replaying))
+			gps_sentences.fetch_add(1, std::memory_order_relaxed);
+		break;
+
+	case 'T':
+	{
+		char number[32];
+		size_t n = payload_len < sizeof(number) - 1 ? payload_len : sizeof(number) - 1;
+		memcpy(number, payload, n);
+		number[n] = '\0';
+
+		char *parsed_end;
+		double celcius = strtod(number, &parsed_end);
+		if (parsed_end == number)
+		{
+			bad_lines.fetch_add(1, std::memory_order_relaxed);
+			break;
+		}
+		latest_temperature.store(celcius, std::memory_order_relaxed);
+		has_temperature.store(true, std::memory_order_release);
+		temperature_samples.fetch_add(1, std::memory_order_relaxed);
+		break;
+	}
+
+	default:
+		bad_lines.fetch_add(1, std::memory_order_relaxed);
+		break;
+	}
+}
+
+/**
+ * The replay the simulation drivers should use. The first driver to ask opens and starts the
+ * one named by FLIGHT_REPLAY_PATH_ENV, so the replay's clock starts with the board.
+ *
+ * @return Pointer to the running FLIGHT_REPLAY, nullptr when there is none.
+ */
+FLIGHT_REPLAY *flight_replay_active()
+{
+	static std::mutex start_lock;
+	std::lock_guard<std::mutex> guard(start_lock);
+
+	FLIGHT_REPLAY *replay = FLIGHT_REPLAY::get_instance();
+	if (replay->is_open())
+		return replay;
+
+	const char *path = getenv(FLIGHT_REPLAY_PATH_ENV);
+	if (path == nullptr || path[0] == '\0')
+		return nullptr;
+
+	const char *speed_env = getenv(FLIGHT_REPLAY_SPEED_ENV);
+	double speed = speed_env ? strtod(speed_env, nullptr) : 1.0;
+	if (replay->open(path) != 0 || replay->start(speed) != 0)
+	{
+		replay->close();
+		return nullptr;
+	}
+	printf("Replaying flight `%s` at speed %.2f\n", path, speed);
+	return replay;
+}
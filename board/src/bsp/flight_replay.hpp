@@ -0,0 +1,104 @@
+/**
+ * Name: flight_replay.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes the flight replay used by the RADAR_SIMULATION drivers. A replay file
+ * is memory mapped and its events are fed, on their original schedule or as fast as they are
+ * consumed, through pipes the drivers attach their line readers to, so a replayed flight goes
+ * through the same parse paths as the real sensors.
+ *
+ * Replay file format, one event per line, times increasing:
+ *     <usec since start> R {"FFT":[...]}     a line as the radar streams it
+ *     <usec since start> G $GNGGA,...*hh     an NMEA sentence from the GPS
+ *     <usec since start> T -12.43            a temperature reading in celcius
+ * Blank lines and lines starting with '#' are skipped. scripts/make_flight_replay.py writes
+ * one.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef FLIGHT_REPLAY_H
+#define FLIGHT_REPLAY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+//--------------------------------
+#define FLIGHT_REPLAY_PATH_ENV "SNOW_ANGEL_REPLAY"   // replay file the simulation drivers use
+#define FLIGHT_REPLAY_SPEED_ENV "SNOW_ANGEL_REPLAY_SPEED" // 1 is real time, 0 as fast as possible
+
+typedef struct flight_replay_stats
+{
+	uint64_t radar_lines;
+	uint64_t radar_lines_dropped; // nobody was reading the radar, like a full tty buffer
+	uint64_t gps_sentences;
+	uint64_t temperature_samples;
+	uint64_t bad_lines;
+} flight_replay_stats_t;
+
+class FLIGHT_REPLAY
+{
+public:
+	static FLIGHT_REPLAY *get_instance();
+
+	// FLIGHT_REPLAY owns its mapping and pipes, it should not be cloneable.
+	FLIGHT_REPLAY(FLIGHT_REPLAY &other) = delete;
+
+	// FLIGHT_REPLAY should not be assignable.
+	void operator=(const FLIGHT_REPLAY &) = delete;
+
+	int8_t open(const char *path);
+	int8_t start(double speed);
+	void stop();
+	void close();
+
+	bool is_open() const;
+	bool finished() const;
+	int radar_fd() const;
+	int gps_fd() const;
+	void discard_radar();
+	bool temperature(double *celcius) const;
+	void get_stats(flight_replay_stats_t *stats) const;
+
+	~FLIGHT_REPLAY();
+
+private:
+	// constructor is private to enforce factory function usage
+	FLIGHT_REPLAY();
+
+	void replay_loop();
+	void replay_line(const char *line, size_t len);
+
+private:
+	static FLIGHT_REPLAY *instance;
+
+	const char *data; // the mapped replay file
+	size_t size;
+
+	double speed;
+	int radar_pipe[2]; // [0] is read by the radar driver, [1] written by the replay thread
+	int gps_pipe[2];
+	std::thread replay_thread;
+	std::atomic<bool> replaying;
+	std::atomic<bool> done;
+	std::atomic<double> latest_temperature;
+	std::atomic<bool> has_temperature;
+
+	std::atomic<uint64_t> radar_lines;
+	std::atomic<uint64_t> radar_lines_dropped;
+	std::atomic<uint64_t> gps_sentences;
+	std::atomic<uint64_t> temperature_samples;
+	std::atomic<uint64_t> bad_lines;
+};
+
+/**
+ * The replay the simulation drivers should use: the one already started, or the one named by
+ * FLIGHT_REPLAY_PATH_ENV, started at FLIGHT_REPLAY_SPEED_ENV. nullptr when there is none.
+ */
+FLIGHT_REPLAY *flight_replay_active();
+
+#endif // #ifndef FLIGHT_REPLAY_H
@@ -0,0 +1,225 @@
+/**
+ *
+ * Name: fmcw_fft_parser.cpp
+ * Author: Karran Dhillon
+ *
+ * This file implements the parser that turns the radar's ASCII FFT and ADC output into binary
+ * bins and samples.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "bsp/fmcw_radar_sensor.hpp"
+#include <cstdint>
+
+static inline bool is_digit(char ch)
+{
+	return ch >= '0' && ch <= '9';
+}
+
+static inline bool is_space(char ch)
+{
+	return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+/**
+ * Parses a comma separated list of FFT magnitudes into integer bins. Fractional parts are
+ * rounded to the nearest integer, negative values clamp to 0 and values that do not fit in a
+ * uint16_t saturate.
+ * @param text The ASCII magnitudes, e.g. "0.0,61.0,263.0,..."
+ * @param len The number of characters in text
+ * @param bins The array to store the parsed magnitudes in
+ * @param max_bins The capacity of bins
+ *
+ * @return The number of bins parsed on success, -X on failure with failure code.
+ */
+int fmcw_radar_parse_fft_bins(const char *text, size_t len, uint16_t *bins, size_t max_bins)
+{
+	if (text == nullptr || bins == nullptr)
+		return -1;
+
+	const char *p = text;
+	const char *end = text + len;
+	size_t num_bins = 0;
+
+	while (p < end)
+	{
+		while (p < end && is_space(*p))
+			p++;
+		if (p == end)
+			break; // trailing whitespace
+
+		bool negative = false;
+		if (*p == '-')
+		{
+			negative = true;
+			p++;
+		}
+
+		if (p == end || !is_digit(*p))
+			return -2; // empty field or garbage
+
+		uint32_t value = 0;
+		while (p < end && is_digit(*p))
+		{
+			if (value <= UINT16_MAX)
+				value = value * 10 + (*p - '0');
+			p++;
+		}
+
+		if (p < end && *p == '.')
+		{
+			p++;
+			if (p < end && is_digit(*p) && *p >= '5')
+				value++; // round half up on the first fractional digit
+			while (p < end && is_digit(*p))
+				p++;
+		}
+
+		while (p < end && is_space(*p))
+			p++;
+
+		if (p < end && *p != ',')
+			return -2;
+
+		if (num_bins == max_bins)
+			return -3; // more bins than the caller has room for
+
+		if (negative)
+			value = 0;
+		bins[num_bins++] = value > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(value);
+
+		if (p < end)
+		{
+			p++; // skip the comma
+			if (p == end)
+				return -2; // dangling comma
+		}
+	}
+
+	return static_cast<int>(num_bins);
+}
+
+/**
+ * Parses a comma separated list of ADC samples. Unlike FFT magnitudes, samples keep their
+ * sign and fractional part.
+ * @param text The ASCII samples, e.g. "2048,2311,-12,..."
+ * @param len The number of characters in text
+ * @param samples The array to store the parsed samples in
+ * @param max_samples The capacity of samples
+ *
+ * @return The number of samples parsed on success, -X on failure with failure code.
+ */
+int fmcw_radar_parse_adc_samples(const char *text, size_t len, float *samples, size_t max_samples)
+{
+	if (text == nullptr || samples == nullptr)
+		return -1;
+
+	const char *p = text;
+	const char *end = text + len;
+	size_t num_samples = 0;
+
+	while (p < end)
+	{
+		while (p < end && is_space(*p))
+			p++;
+		if (p == end)
+			break; // trailing whitespace
+
+		bool negative = false;
+		if (*p == '-')
+		{
+			negative = true;
+			p++;
+		}
+
+		if (p == end || !is_digit(*p))
+			return -2; // empty field or garbage
+
+		float value = 0.0f;
+		while (p < end && is_digit(*p))
+			value = value * 10.0f + static_cast<float>(*p++ - '0');
+
+		if (p < end && *p == '.')
+		{
+			p++;
+			float scale = 0.1f;
+			for (; p < end && is_digit(*p); p++, scale *= 0.1f)
+				value += scale * static_cast<float>(*p - '0');
+		}
+
+		while (p < end && is_space(*p))
+			p++;
+
+		if (p < end && *p != ',')
+			return -2;
+
+		if (num_samples == max_samples)
+			return -3; // more samples than the caller has room for
+
+		samples[num_samples++] = negative ? -value : value;
+
+		if (p < end)
+		{
+			p++; // skip the comma
+			if (p == end)
+				return -2; // dangling comma
+		}
+	}
+
+	return static_cast<int>(num_samples);
+}
+
+/**
+ * Finds the contents of a JSON array in one line from the radar.
+ * @param line One line from the radar
+ * @param pattern The start of the line up to and including the array's opening bracket
+ * @param contents The view to point at the array's contents, a view into line
+ *
+ * @return 0 on success, -1 if the line does not hold the array.
+ */
+static int8_t extract_array(std::string_view line, std::string_view pattern,
+                            std::string_view *contents)
+{
+	size_t start = line.find(pattern);
+	if (start == std::string_view::npos)
+		return -1; // line not valid
+	line.remove_prefix(start + pattern.size());
+
+	size_t end = line.find("]}");
+	if (end == std::string_view::npos)
+		return -1; // line not valid
+	*contents = line.substr(0, end);
+	return 0;
+}
+
+/**
+ * Finds the contents of the "FFT" array in one JSON line from the radar.
+ * @param line One line from the radar, e.g. {"FFT":[0.0,61.0,...]}
+ * @param fft_data The view to point at the magnitudes, a view into line
+ *
+ * @return 0 on success, -1 if the line is not FFT data.
+ */
+int8_t fmcw_radar_extract_fft(std::string_view line, std::string_view *fft_data)
+{
+	return extract_array(line, "{\"FFT\":[", fft_data);
+}
+
+/**
+ * Finds the contents of the "I" or "Q" array in one JSON line from the radar.
+ * @param line One line from the radar, e.g. {"I":[2048,2311,...]}
+ * @param channel 'I' or 'Q'
+ * @param samples The view to point at the samples, a view into line
+ *
+ * @return 0 on success, -1 if the line is not that channel's ADC samples.
+ */
+int8_t fmcw_radar_extract_adc(std::string_view line, char channel, std::string_view *samples)
+{
+	if (channel == 'I')
+		return extract_array(line, "{\"I\":[", samples);
+	if (channel == 'Q')
+		return extract_array(line, "{\"Q\":[", samples);
+	return -1;
+}
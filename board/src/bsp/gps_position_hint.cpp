@@ -0,0 +1,131 @@
+/**
+ * Name: gps_position_hint.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the functions declared in gps_position_hint.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "gps_position_hint.hpp"
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+
+#define GPS_HINT_FORMAT_VERSION 1
+
+enum gps_start_mode gps_position_hint_start_mode(const gps_position_hint_t *hint,
+                                                 uint64_t now_utc_usec)
+{
+	if (hint == nullptr || now_utc_usec < hint->utc_usec)
+		return GPS_START_COLD;
+
+	uint64_t age_usec = now_utc_usec - hint->utc_usec;
+	if (age_usec > GPS_HINT_MAX_AGE_USEC)
+		return GPS_START_COLD;
+	if (age_usec > GPS_EPHEMERIS_VALID_USEC)
+		return GPS_START_WARM;
+	return GPS_START_HOT;
+}
+
+int gps_position_hint_format_aiding(const gps_position_hint_t *hint, uint64_t now_utc_usec,
+                                    char *body, size_t size)
+{
+	time_t now = static_cast<time_t>(now_utc_usec / 1000000);
+	struct tm utc;
+	if (gmtime_r(&now, &utc) == nullptr)
+		return -1;
+
+	// the altitude is not cached, sea level is close enough for aiding
+	int len = snprintf(body, size, "PMTK741,%.6f,%.6f,0,%04d,%02d,%02d,%02d,%02d,%02d",
+	                   hint->latitude, hint->longitude, utc.tm_year + 1900, utc.tm_mon + 1,
+	                   utc.tm_mday, utc.tm_hour, utc.tm_min, utc.tm_sec);
+	if (len < 0 || static_cast<size_t>(len) >= size)
+		return -1;
+	return len;
+}
+
+/**
+ * Reads a hint saved by gps_position_hint_save().
+ *
+ * @return 0 on success, -1 if there is no hint, -2 if it is malformed.
+ */
+int8_t gps_position_hint_load(const char *path, gps_position_hint_t *hint)
+{
+	FILE *f = fopen(path, "r");
+	if (f == nullptr)
+		return -1;
+
+	int version = 0;
+	gps_position_hint_t loaded;
+	int fields = fscanf(f, "SAUVHINT %d %lf %lf %" SCNu64, &version, &loaded.latitude,
+	                    &loaded.longitude, &loaded.utc_usec);
+	fclose(f);
+
+	if (fields != 4 || version != GPS_HINT_FORMAT_VERSION || !std::isfinite(loaded.latitude) ||
+	    !std::isfinite(loaded.longitude) || std::fabs(loaded.latitude) > 90 ||
+	    std::fabs(loaded.longitude) > 180)
+		return -2;
+
+	*hint = loaded;
+	return 0;
+}
+
+/**
+ * Syncs the directory a file was just renamed into, so the rename itself survives a power cut.
+ */
+static int8_t sync_parent_dir(const char *path)
+{
+	std::string dir = path;
+	size_t slash = dir.rfind('/');
+	dir = slash == std::string::npos ? "." : slash == 0 ? "/" : dir.substr(0, slash);
+
+	int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+	if (fd < 0)
+		return -1;
+	int rc = fsync(fd);
+	close(fd);
+	return rc == 0 ? 0 : -2;
+}
+
+/**
+ * Saves a hint, replacing the old one in one rename so a power cut never leaves half a file.
+ * The new file is synced before the rename, otherwise the rename can reach the disk first and
+ * leave an empty hint behind.
+ *
+ * @return 0 on success, -X on failure with failure code.
+ */
+int8_t gps_position_hint_save(const char *path, const gps_position_hint_t *hint)
+{
+	char tmp_path[256];
+	if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path) >= (int)sizeof(tmp_path))
+		return -1;
+
+	FILE *f = fopen(tmp_path, "w");
+	if (f == nullptr)
+		return -2;
+
+	int written = fprintf(f, "SAUVHINT %d %.7f %.7f %" PRIu64 "\n", GPS_HINT_FORMAT_VERSION,
+	                      hint->latitude, hint->longitude, hint->utc_usec);
+	bool synced = written >= 0 && fflush(f) == 0 && fsync(fileno(f)) == 0;
+	if (fclose(f) != 0 || !synced)
+	{
+		remove(tmp_path);
+		return -3;
+	}
+
+	if (rename(tmp_path, path) != 0)
+	{
+		remove(tmp_path);
+		return -4;
+	}
+	if (sync_parent_dir(path) != 0)
+		return -5;
+	return 0;
+}
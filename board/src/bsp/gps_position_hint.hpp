@@ -0,0 +1,66 @@
+/**
+ * Name: gps_position_hint.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes the position hint the GPS driver keeps across restarts. The last fix
+ * is cached on disk, at the next boot it tells the module where it is and what time it is so
+ * it only has to search for the satellites above it, and whether its battery backed
+ * ephemeris is still fresh enough for a hot start.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef GPS_POSITION_HINT_H
+#define GPS_POSITION_HINT_H
+
+#include <cstddef>
+#include <cstdint>
+
+//--------------------------------
+#define GPS_EPHEMERIS_VALID_USEC (4ULL * 3600 * 1000000) // broadcast ephemeris is good for ~4 h
+#define GPS_HINT_MAX_AGE_USEC (30ULL * 86400 * 1000000)  // older hints are not worth trusting
+
+typedef struct gps_position_hint
+{
+	double latitude;
+	double longitude;
+	uint64_t utc_usec; // wall clock time of the fix, see clock_realtime_usec()
+} gps_position_hint_t;
+
+enum gps_start_mode
+{
+	GPS_START_COLD = 0, // no usable hint, the module searches the whole sky
+	GPS_START_WARM,     // position and time are known, the ephemeris has expired
+	GPS_START_HOT,      // the module's ephemeris is still valid as well
+};
+
+/**
+ * Picks how the module should start from a cached hint. A clock that is behind the hint
+ * cannot be trusted for time aiding, e.g. a Pi that booted without network or RTC.
+ * @param hint The cached hint
+ * @param now_utc_usec The current wall clock time
+ *
+ * @return The start mode
+ */
+enum gps_start_mode gps_position_hint_start_mode(const gps_position_hint_t *hint,
+                                                 uint64_t now_utc_usec);
+
+/**
+ * Formats the PMTK741 position and time aiding command body, e.g.
+ * "PMTK741,45.384800,-75.704700,0,2025,11,20,15,00,00".
+ * @param hint The cached position
+ * @param now_utc_usec The time to aid with
+ * @param body Where to store the command body, without framing
+ * @param size The capacity of body
+ *
+ * @return The length of the body on success, -1 if it does not fit.
+ */
+int gps_position_hint_format_aiding(const gps_position_hint_t *hint, uint64_t now_utc_usec,
+                                    char *body, size_t size);
+
+int8_t gps_position_hint_load(const char *path, gps_position_hint_t *hint);
+int8_t gps_position_hint_save(const char *path, const gps_position_hint_t *hint);
+
+#endif // #ifndef GPS_POSITION_HINT_H
@@ -0,0 +1,294 @@
+/**
+ * Name: nmea_parser.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the functions declared in nmea_parser.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "nmea_parser.hpp"
+
+#define GGA_FIELD_LATITUDE 2
+#define GGA_FIELD_NS_HEMISPHERE 3
+#define GGA_FIELD_LONGITUDE 4
+#define GGA_FIELD_EW_HEMISPHERE 5
+#define GGA_FIELD_FIX_QUALITY 6
+#define GGA_FIELD_NUM_SATELLITES 7
+#define GGA_FIELD_HDOP 8
+
+#define RMC_FIELD_STATUS 2
+#define RMC_FIELD_SPEED_KNOTS 7
+#define RMC_FIELD_COURSE 8
+
+#define VTG_FIELD_COURSE 1
+#define VTG_FIELD_SPEED_KNOTS 5
+#define VTG_FIELD_SPEED_KMH 7
+
+#define GSA_FIELD_FIX_MODE 2
+#define GSA_FIELD_HDOP 16
+
+#define COORDINATE_DECIMALS 7 // 10^-7 degrees is about 1 cm
+
+static inline bool is_digit(char ch)
+{
+	return ch >= '0' && ch <= '9';
+}
+
+static inline int hex_value(char ch)
+{
+	if (ch >= '0' && ch <= '9')
+		return ch - '0';
+	if (ch >= 'A' && ch <= 'F')
+		return ch - 'A' + 10;
+	if (ch >= 'a' && ch <= 'f')
+		return ch - 'a' + 10;
+	return -1;
+}
+
+uint8_t nmea_checksum(std::string_view body)
+{
+	uint8_t checksum = 0;
+	for (char ch : body)
+		checksum ^= static_cast<uint8_t>(ch);
+	return checksum;
+}
+
+int8_t nmea_tokenize(std::string_view sentence, nmea_fields_t *fields)
+{
+	if (sentence.size() < 4 || sentence[0] != '$')
+		return -1;
+
+	size_t star = sentence.rfind('*');
+	if (star == std::string_view::npos || star + 3 != sentence.size())
+		return -1; // every sentence we use ends in "*hh"
+
+	int high = hex_value(sentence[star + 1]);
+	int low = hex_value(sentence[star + 2]);
+	if (high < 0 || low < 0)
+		return -1;
+
+	// The checksum is the XOR of everything between '$' and '*', tokenize in the same pass
+	uint8_t checksum = 0;
+	size_t count = 0;
+	size_t start = 1;
+	for (size_t i = 1; i <= star; i++)
+	{
+		if (i < star)
+			checksum ^= static_cast<uint8_t>(sentence[i]);
+
+		if (i == star || sentence[i] == ',')
+		{
+			if (count == NMEA_MAX_FIELDS)
+				return -3;
+			fields->field[count++] = sentence.substr(start, i - start);
+			start = i + 1;
+		}
+	}
+
+	if (checksum != ((high << 4) | low))
+		return -2;
+
+	fields->count = count;
+	return 0;
+}
+
+bool nmea_parse_fixed(std::string_view field, int decimals, int32_t *value)
+{
+	size_t i = 0;
+	bool negative = false;
+	if (i < field.size() && field[i] == '-')
+	{
+		negative = true;
+		i++;
+	}
+
+	int64_t result = 0;
+	size_t digits = 0;
+	for (; i < field.size() && is_digit(field[i]); i++, digits++)
+	{
+		result = result * 10 + (field[i] - '0');
+		if (result > INT32_MAX)
+			return false;
+	}
+
+	int fraction_digits = 0;
+	if (i < field.size() && field[i] == '.')
+	{
+		for (i++; i < field.size() && is_digit(field[i]); i++, digits++)
+		{
+			if (fraction_digits < decimals)
+			{
+				result = result * 10 + (field[i] - '0');
+				fraction_digits++;
+			}
+		}
+	}
+
+	if (digits == 0 || i != field.size())
+		return false; // empty or garbage
+
+	for (; fraction_digits < decimals; fraction_digits++)
+		result *= 10;
+	if (result > INT32_MAX)
+		return false;
+
+	*value = static_cast<int32_t>(negative ? -result : result);
+	return true;
+}
+
+bool nmea_parse_coordinate(std::string_view field, std::string_view hemisphere, int32_t *deg_e7)
+{
+	// Split "ddmm.mmmm" so degrees never go through a floating point division
+	size_t dot = field.find('.');
+	size_t int_len = dot == std::string_view::npos ? field.size() : dot;
+	if (int_len < 3 || hemisphere.size() != 1)
+		return false;
+
+	int32_t degrees, minutes_e7;
+	if (!nmea_parse_fixed(field.substr(0, int_len - 2), 0, &degrees) ||
+	    !nmea_parse_fixed(field.substr(int_len - 2), COORDINATE_DECIMALS, &minutes_e7) ||
+	    degrees < 0 || degrees > 180 || minutes_e7 < 0 || minutes_e7 >= 600000000)
+	{
+		return false;
+	}
+
+	int32_t result = degrees * 10000000 + minutes_e7 / 60;
+
+	// Convention is that N and E are positive, while S and W are negative
+	switch (hemisphere[0])
+	{
+	case 'N':
+	case 'E':
+		break;
+	case 'S':
+	case 'W':
+		result = -result;
+		break;
+	default:
+		return false;
+	}
+
+	*deg_e7 = result;
+	return true;
+}
+
+static int parse_gga(const nmea_fields_t *fields, nmea_fix_t *fix)
+{
+	if (fields->count <= GGA_FIELD_HDOP)
+		return -4;
+
+	int32_t quality;
+	if (!nmea_parse_fixed(fields->field[GGA_FIELD_FIX_QUALITY], 0, &quality))
+		return -4;
+
+	if (quality == 0)
+	{
+		fix->fix_quality = 0; // the module reports no fix, position fields are empty
+		return NMEA_SENTENCE_GGA;
+	}
+
+	int32_t latitude, longitude, satellites, hdop;
+	if (!nmea_parse_coordinate(fields->field[GGA_FIELD_LATITUDE],
+	                           fields->field[GGA_FIELD_NS_HEMISPHERE], &latitude) ||
+	    !nmea_parse_coordinate(fields->field[GGA_FIELD_LONGITUDE],
+	                           fields->field[GGA_FIELD_EW_HEMISPHERE], &longitude) ||
+	    !nmea_parse_fixed(fields->field[GGA_FIELD_NUM_SATELLITES], 0, &satellites) ||
+	    !nmea_parse_fixed(fields->field[GGA_FIELD_HDOP], 2, &hdop))
+	{
+		return -4;
+	}
+
+	fix->latitude_e7 = latitude;
+	fix->longitude_e7 = longitude;
+	fix->fix_quality = static_cast<uint8_t>(quality);
+	fix->num_satellites = static_cast<uint8_t>(satellites);
+	fix->hdop_x100 = static_cast<uint16_t>(hdop);
+	return NMEA_SENTENCE_GGA;
+}
+
+static int parse_rmc(const nmea_fields_t *fields, nmea_fix_t *fix)
+{
+	if (fields->count <= RMC_FIELD_COURSE)
+		return -4;
+
+	if (fields->field[RMC_FIELD_STATUS] != "A")
+		return NMEA_SENTENCE_RMC; // V: no fix, nothing to take
+
+	int32_t knots_e3, course_cdeg = fix->course_cdeg;
+	if (!nmea_parse_fixed(fields->field[RMC_FIELD_SPEED_KNOTS], 3, &knots_e3))
+		return -4;
+	if (!fields->field[RMC_FIELD_COURSE].empty() &&
+	    !nmea_parse_fixed(fields->field[RMC_FIELD_COURSE], 2, &course_cdeg))
+		return -4; // course is left empty when not moving
+
+	fix->speed_mm_s = static_cast<uint32_t>((int64_t)knots_e3 * 1852 / 3600); // 1 kn = 1852 m/h
+	fix->course_cdeg = static_cast<uint16_t>(course_cdeg);
+	return NMEA_SENTENCE_RMC;
+}
+
+static int parse_vtg(const nmea_fields_t *fields, nmea_fix_t *fix)
+{
+	if (fields->count <= VTG_FIELD_SPEED_KMH)
+		return -4;
+
+	int32_t speed, course_cdeg = fix->course_cdeg;
+	uint32_t speed_mm_s;
+	if (nmea_parse_fixed(fields->field[VTG_FIELD_SPEED_KMH], 3, &speed))
+		speed_mm_s = static_cast<uint32_t>((int64_t)speed * 1000 / 3600);
+	else if (nmea_parse_fixed(fields->field[VTG_FIELD_SPEED_KNOTS], 3, &speed))
+		speed_mm_s = static_cast<uint32_t>((int64_t)speed * 1852 / 3600);
+	else
+		return NMEA_SENTENCE_VTG; // empty without a fix
+
+	if (!fields->field[VTG_FIELD_COURSE].empty() &&
+	    !nmea_parse_fixed(fields->field[VTG_FIELD_COURSE], 2, &course_cdeg))
+		return -4;
+
+	fix->speed_mm_s = speed_mm_s;
+	fix->course_cdeg = static_cast<uint16_t>(course_cdeg);
+	return NMEA_SENTENCE_VTG;
+}
+
+static int parse_gsa(const nmea_fields_t *fields, nmea_fix_t *fix)
+{
+	if (fields->count <= GSA_FIELD_HDOP)
+		return -4;
+
+	int32_t mode, hdop = fix->hdop_x100;
+	if (!nmea_parse_fixed(fields->field[GSA_FIELD_FIX_MODE], 0, &mode))
+		return -4;
+	if (!fields->field[GSA_FIELD_HDOP].empty() &&
+	    !nmea_parse_fixed(fields->field[GSA_FIELD_HDOP], 2, &hdop))
+		return -4;
+
+	fix->fix_mode = static_cast<uint8_t>(mode);
+	fix->hdop_x100 = static_cast<uint16_t>(hdop);
+	return NMEA_SENTENCE_GSA;
+}
+
+int nmea_parse_sentence(std::string_view sentence, nmea_fix_t *fix)
+{
+	nmea_fields_t fields;
+	int8_t rc = nmea_tokenize(sentence, &fields);
+	if (rc < 0)
+		return rc;
+
+	// The first two letters name the talker (GP, GN, GL, ...), the rest the sentence
+	std::string_view address = fields.field[0];
+	if (address.size() != 5)
+		return NMEA_SENTENCE_UNKNOWN; // e.g. proprietary $PMTK replies
+
+	std::string_view type = address.substr(2);
+	if (type == "GGA")
+		return parse_gga(&fields, fix);
+	if (type == "RMC")
+		return parse_rmc(&fields, fix);
+	if (type == "VTG")
+		return parse_vtg(&fields, fix);
+	if (type == "GSA")
+		return parse_gsa(&fields, fix);
+	return NMEA_SENTENCE_UNKNOWN;
+}
@@ -0,0 +1,85 @@
+/**
+ * Name: nmea_parser.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes an allocation free parser for the NMEA sentences GPS modules output.
+ * Sentences are tokenized in place into views of the caller's buffer, checksums are verified
+ * and numbers are parsed with integer fixed point math.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef NMEA_PARSER_H
+#define NMEA_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//--------------------------------
+#define NMEA_MAX_FIELDS 24 // GSV is the longest standard sentence at 20 fields
+
+enum nmea_sentence_type
+{
+	NMEA_SENTENCE_UNKNOWN = 0, // well formed, but not a sentence we use
+	NMEA_SENTENCE_GGA,         // position, fix quality, satellites, HDOP
+	NMEA_SENTENCE_RMC,         // position, speed and course
+	NMEA_SENTENCE_VTG,         // speed and course
+	NMEA_SENTENCE_GSA,         // 2D/3D fix mode and dilution of precision
+};
+
+typedef struct nmea_fields
+{
+	std::string_view field[NMEA_MAX_FIELDS]; // field[0] is the address, e.g. "GNGGA"
+	size_t count;
+} nmea_fields_t;
+
+/* Everything the sentences we parse report. Each sentence only updates its own fields, so
+   one struct accumulates a full fix across the sentences of an epoch. */
+typedef struct nmea_fix
+{
+	int32_t latitude_e7;  // degrees * 10^7, north positive
+	int32_t longitude_e7; // degrees * 10^7, east positive
+	uint32_t speed_mm_s;  // over ground
+	uint16_t course_cdeg; // true course over ground in hundredths of a degree
+	uint16_t hdop_x100;
+	uint8_t fix_quality;  // GGA: 0 invalid, 1 GPS, 2 DGPS, ...
+	uint8_t fix_mode;     // GSA: 1 no fix, 2 2D, 3 3D
+	uint8_t num_satellites;
+} nmea_fix_t;
+
+/**
+ * XOR of every character, the checksum of a sentence whose body (between '$' and '*') is body.
+ */
+uint8_t nmea_checksum(std::string_view body);
+
+/**
+ * Splits "$<address>,<field>,...*<checksum>" into fields after verifying the checksum.
+ *
+ * @return 0 on success, -1 if not framed like a sentence, -2 on a checksum mismatch, -3 if it
+ *         has more than NMEA_MAX_FIELDS fields
+ */
+int8_t nmea_tokenize(std::string_view sentence, nmea_fields_t *fields);
+
+/**
+ * Tokenizes a sentence and folds the GGA, RMC, VTG or GSA fields it carries into fix.
+ *
+ * @return The nmea_sentence_type on success, negative number on failure (see nmea_tokenize,
+ *         -4 if a field we need is malformed). fix is not modified on failure.
+ */
+int nmea_parse_sentence(std::string_view sentence, nmea_fix_t *fix);
+
+/**
+ * Parses "[-]digits[.digits]" into an integer scaled by 10^decimals. Extra fraction digits are
+ * truncated.
+ */
+bool nmea_parse_fixed(std::string_view field, int decimals, int32_t *value);
+
+/**
+ * Parses a (d)ddmm.mmmm coordinate and its N/S/E/W hemisphere into degrees * 10^7.
+ */
+bool nmea_parse_coordinate(std::string_view field, std::string_view hemisphere, int32_t *deg_e7);
+
+#endif // #ifndef NMEA_PARSER_H
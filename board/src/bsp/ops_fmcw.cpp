@@ -11,6 +11,11 @@
  */
 
 #include "ops_fmcw.hpp"
+#include "common/clock.h"
+#include "common/event_loop.h"
+#include "common/rt_profile.h"
+#include "common/trace.h"
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <errno.h>
@@ -19,6 +24,8 @@
 #include <unistd.h>
 
 #ifdef RADAR_SIMULATION
+#include "flight_replay.hpp"
+#include <cmath>
 #include <fstream>
 #define RADAR_SIM_PATH "../sim/radar_ice_fft_data.sim"
 #endif
@@ -44,7 +51,28 @@ FMCW_RADAR_SENSOR *OPS_FMCW::get_fmcw_radar_instance(const char *usb_port)
  * Constructor for the OPS_FMCW class.
  * @param usb_port The USB port number where the radar sensor is connected.
  */
-OPS_FMCW::OPS_FMCW(const char *usb_port) : usb_port(usb_port) {}
+OPS_FMCW::OPS_FMCW(const char *usb_port)
+    : usb_port(usb_port), fd(-1), frame_sequence(0), streaming(false), queued_frames(0),
+      dropped_frames(0), missed_frames(0), max_frame_gap_usec(0), serial_overruns_at_start(0),
+      frame_event_fd(event_fd_create(false))
+{
+#ifdef RADAR_SIMULATION
+	next_sim_line = 0;
+	replay = nullptr;
+#endif
+}
+
+/**
+ * Destructor for the OPS_FMCW class. Makes sure the reader thread is not left running.
+ */
+OPS_FMCW::~OPS_FMCW()
+{
+	if (streaming.load(std::memory_order_acquire))
+		fmcw_radar_sensor_stop_streaming();
+
+	if (frame_event_fd >= 0)
+		close(frame_event_fd);
+}
 
 /**
  * Initializes the radar sensor.
@@ -53,8 +81,21 @@ OPS_FMCW::OPS_FMCW(const char *usb_port) : usb_port(usb_port) {}
  */
 int8_t OPS_FMCW::fmcw_radar_sensor_init()
 {
+#ifdef RADAR_ADC_CAPTURE
+	static_assert(FMCW_RADAR_ZOOM_SIZE <= RADAR_ZOOM_MAX_POINTS, "zoom is too large to plan");
+	if (radar_zoom_plan_init(&zoom_plan, FMCW_RADAR_ZOOM_START_M, FMCW_RADAR_ZOOM_END_M,
+	                         FMCW_RADAR_ZOOM_SIZE) != 0)
+		return -6;
+#endif
 #ifdef RADAR_SIMULATION
-	return 0;
+	// a replayed flight goes through the real line parsing, otherwise the sim file is served
+	replay = flight_replay_active();
+	if (replay != nullptr)
+	{
+		line_reader.attach(replay->radar_fd());
+		return 0;
+	}
+	return load_sim_lines();
 #endif
 	fd = open(FMCW_RADAR_USB_PORT, O_RDWR | O_NOCTTY | O_SYNC);
 	if (fd < 0)
@@ -78,8 +119,8 @@ int8_t OPS_FMCW::fmcw_radar_sensor_init()
 	tty.c_iflag &= ~IGNBRK;                     // Don't ignore break characters
 	tty.c_lflag = 0;                            // no signaling chars, no echo
 	tty.c_oflag = 0;                            // no remapping
-	tty.c_cc[VMIN] = 1;                         // read at least 1 char
-	tty.c_cc[VTIME] = 1;                        // or 0.1s read timeout
+	tty.c_cc[VMIN] = 0;                         // never block in read(), the line reader
+	tty.c_cc[VTIME] = 0;                        // waits with poll() and reads in bulk
 
 	tty.c_iflag &= ~(IXON | IXOFF | IXANY); // turn off s/w flow control
 	tty.c_cflag |= (CLOCAL | CREAD);        // ignore modem controls
@@ -92,14 +133,32 @@ int8_t OPS_FMCW::fmcw_radar_sensor_init()
 		printf("Failed to set tty attributes with error: %s\n", strerror(errno));
 		return -3;
 	}
+	if (rt_profile_serial_low_latency(fd) != 0)
+		printf("USB port to OPS 241-B does not support low latency mode\n");
+	line_reader.attach(fd);
+	sequencer.attach(fd, &line_reader);
 
-	// Temporarily disable continious stream (to query sensor)
-	send_command(FMCW_CMD_DISABLE_STREAM);
-	send_command(FMCW_CMD_TURN_ON_FFT);
-	send_command(FMCW_CMD_TURN_ON_ADC);
-	send_command(FMCW_CMD_TURN_OFF_FFT);
-	send_command(FMCW_CMD_TURN_OFF_ADC);
-	usleep(1000000); // 1s delay to let the configuration settle
+	// JSON mode goes first and on its own: until then the sensor answers in plain text, which
+	// acknowledges no command but this one
+	static const char *const json_commands[] = {FMCW_CMD_JSON_MODE};
+	int8_t rc = sequencer.run(json_commands, sizeof(json_commands) / sizeof(*json_commands));
+	if (rc != 0)
+	{
+		printf("Radar did not acknowledge JSON mode (err %d)\n", rc);
+		return -4;
+	}
+
+	// Temporarily disable continious stream (to query sensor), cycling the outputs leaves
+	// them in a known state
+	static const char *const quiet_commands[] = {FMCW_CMD_DISABLE_STREAM, FMCW_CMD_TURN_ON_FFT,
+	                                             FMCW_CMD_TURN_ON_ADC, FMCW_CMD_TURN_OFF_FFT,
+	                                             FMCW_CMD_TURN_OFF_ADC};
+	rc = sequencer.run(quiet_commands, sizeof(quiet_commands) / sizeof(*quiet_commands));
+	if (rc != 0)
+	{
+		printf("Radar did not acknowledge disabling its output (err %d)\n", rc);
+		return -4;
+	}
 
 	// Query device information
 	std::string response;
@@ -108,14 +167,15 @@ int8_t OPS_FMCW::fmcw_radar_sensor_init()
 	    16); // inconsistent number of response lines (though there should be 8), read 16 to be safe
 
 	// Setup radar for FFT data
-	send_command(FMCW_CMD_JSON_MODE);
-	send_command(FMCW_CMD_PRECISION);
-	send_command(FMCW_CMD_SET_UNITS_M);
-	send_command(FMCW_CMD_SET_FFT_SIZE);
-	usleep(100000);
-	send_command(FMCW_CMD_SET_FFT_CFG);
-	send_command(FMCW_CMD_LED_OFF);
-	send_command(FMCW_CMD_HIBERNATE);
+	static const char *const fft_commands[] = {FMCW_CMD_PRECISION,    FMCW_CMD_SET_UNITS_M,
+	                                           FMCW_CMD_SET_FFT_SIZE, FMCW_CMD_SET_FFT_CFG,
+	                                           FMCW_CMD_LED_OFF,      FMCW_CMD_HIBERNATE};
+	rc = sequencer.run(fft_commands, sizeof(fft_commands) / sizeof(*fft_commands));
+	if (rc != 0)
+	{
+		printf("Radar did not acknowledge the FFT configuration (err %d)\n", rc);
+		return -5;
+	}
 
 	return 0;
 }
@@ -130,66 +190,263 @@ int8_t OPS_FMCW::fmcw_radar_sensor_start_tx_signal()
 #ifdef RADAR_SIMULATION
 	return 0;
 #endif
-	send_command(FMCW_CMD_WAKEUP);
-	send_command(FMCW_CMD_TURN_ON_FFT); // starts continiously streaming FFT data
-	send_command(FMCW_CMD_LED_ON);
+	if (streaming.load(std::memory_order_acquire))
+		return -1; // the reader thread owns the sensor's output
+
+	// the output starts continiously streaming FFT data, or ADC samples
+#ifdef RADAR_ADC_CAPTURE
+	radar_config_t transmitting = {RADAR_SETTING_OFF, RADAR_SETTING_ON, RADAR_SETTING_ON,
+	                               RADAR_SETTING_ON};
+#else
+	radar_config_t transmitting = {RADAR_SETTING_ON, RADAR_SETTING_OFF, RADAR_SETTING_ON,
+	                               RADAR_SETTING_ON};
+#endif
+	int8_t rc = sequencer.configure(&transmitting);
+	if (rc != 0)
+	{
+		printf("Radar did not acknowledge starting to transmit (err %d)\n", rc);
+		return -2;
+	}
 	return 0;
 }
 
 /**
- * Reads the received FMCW signal data from the radar sensor.
+ * Reads the received FMCW signal data from the radar sensor. In ADC capture mode the spectrum
+ * computed on board is formatted the way the radar sends its own.
  * @param data Pointer to the structure to store the received waveform data.
  *
  * @return Returns 0 on success, -X on failure with failure code.
  */
 int8_t OPS_FMCW::fmcw_radar_sensor_read_rx_signal(fmcw_waveform_data_t *data)
 {
-#ifdef RADAR_SIMULATION
-	// use fake FFT data
-	// has peaks at 458.3 Hz and 550 Hz (10cm ice thickness)
-	// drone: 50cm above surface, 1.6ms chirp slope, 2048 samples, 220MHz bandwidth
+#ifdef RADAR_ADC_CAPTURE
+	fmcw_fft_frame_t frame;
+	int8_t rc = fmcw_radar_sensor_read_fft_frame(&frame);
+	if (rc != 0)
+		return rc;
 
-	std::ifstream sim_file(RADAR_SIM_PATH);
-	if (!sim_file.is_open())
+	char *out = reinterpret_cast<char *>(data->raw_data);
+	size_t len = 0;
+	out[0] = '\0';
+	for (size_t k = 0; k < frame.num_bins && len + 1 < sizeof(data->raw_data); k++)
+		len += snprintf(out + len, sizeof(data->raw_data) - len, k == 0 ? "%u" : ",%u",
+		                frame.bins[k]);
+	return 0;
+#else
+	std::string_view fft_data;
+	int8_t rc = read_fft_line(&fft_data);
+	if (rc != 0)
+		return rc;
+
+	size_t len = std::min(fft_data.size(), sizeof(data->raw_data) - 1);
+	memcpy(data->raw_data, fft_data.data(), len);
+	data->raw_data[len] = '\0';
+	return 0;
+#endif
+}
+
+/**
+ * Reads the received FMCW signal data from the radar sensor and parses it into binary bins.
+ * While streaming, this pops the oldest frame captured by the reader thread instead of
+ * waiting for a fresh one.
+ * @param frame Pointer to the structure to store the parsed frame.
+ *
+ * @return Returns 0 on success, -X on failure with failure code.
+ */
+int8_t OPS_FMCW::fmcw_radar_sensor_read_fft_frame(fmcw_fft_frame_t *frame)
+{
+	TRACE_SCOPE(TRACE_RADAR_READ_FRAME);
+
+	if (streaming.load(std::memory_order_acquire))
 	{
-		printf("Failed to open file: %s\n", RADAR_SIM_PATH);
-		return -1;
+		uint64_t deadline_usec =
+		    clock_monotonic_usec() + MAX_READ_ATTEMPTS * FMCW_RADAR_LINE_TIMEOUT_MS * 1000ULL;
+		fmcw_frame_handle_t handle;
+		while (!stream_queue.pop(&handle))
+		{
+			if (clock_monotonic_usec() >= deadline_usec)
+				return -1;
+			usleep(FMCW_RADAR_STREAM_POLL_USEC);
+		}
+		*frame = *handle;
+		return 0;
 	}
 
-	std::string line;
-	if (!std::getline(sim_file, line))
+	discard_input();
+	for (int8_t i = 0; i < MAX_READ_ATTEMPTS; i++)
 	{
-		printf("Failed to read line from file: %s\n", RADAR_SIM_PATH);
-		sim_file.close();
+		if (next_frame(frame) == 0)
+			return 0;
+	}
+	return -1;
+}
+
+/**
+ * Reads a batch of frames from the radar sensor. While streaming, this waits for the oldest
+ * queued frame like fmcw_radar_sensor_read_fft_frame() and takes every other queued frame with
+ * it. Otherwise it reads max_frames frames back to back, as fresh as the first.
+ * @param frames Where to store the frames, oldest first.
+ * @param max_frames The capacity of frames.
+ *
+ * @return Returns the number of frames read, -X on failure with failure code.
+ */
+int OPS_FMCW::fmcw_radar_sensor_read_fft_frames(fmcw_fft_frame_t *frames, size_t max_frames)
+{
+	if (frames == nullptr)
 		return -2;
+	if (max_frames == 0)
+		return 0;
+
+	if (streaming.load(std::memory_order_acquire))
+	{
+		int8_t rc = fmcw_radar_sensor_read_fft_frame(&frames[0]);
+		if (rc != 0)
+			return rc;
+
+		size_t num_frames = 1;
+		fmcw_frame_handle_t handle;
+		while (num_frames < max_frames && stream_queue.pop(&handle))
+			frames[num_frames++] = *handle;
+		return static_cast<int>(num_frames);
 	}
-	std::snprintf(reinterpret_cast<char *>(data->raw_data), sizeof(data->raw_data), "%s",
-	              line.c_str());
-	sim_file.close();
-	return 0;
-#endif
-	tcflush(fd, TCIFLUSH); // clear the input buffer of stale data
 
-	// Read the FFT data
-	for (int8_t i = 0; i < MAX_READ_ATTEMPTS; i++)
+	TRACE_SCOPE(TRACE_RADAR_READ_FRAME);
+	discard_input();
+	size_t num_frames = 0;
+	int8_t failures = 0; // in a row, every frame gets MAX_READ_ATTEMPTS
+	while (num_frames < max_frames && failures < MAX_READ_ATTEMPTS)
 	{
-		std::string fft_data;
-		read_response(&fft_data);
-
-		std::string pattern = "{\"FFT\":[";
-		size_t start = fft_data.find(pattern);
-		if (start == std::string::npos)
-			continue; // line not valid
-		fft_data.erase(0, start + pattern.size());
-
-		size_t end = fft_data.find("]}");
-		if (end == std::string::npos)
-			continue; // line not valid
-		fft_data.erase(end);
-		memcpy(data->raw_data, fft_data.c_str(), sizeof(data->raw_data));
+		if (next_frame(&frames[num_frames]) == 0)
+		{
+			num_frames++;
+			failures = 0;
+		}
+		else
+		{
+			failures++;
+		}
+	}
+	return num_frames > 0 ? static_cast<int>(num_frames) : -1;
+}
+
+/**
+ * Takes every streamed frame that is already queued, up to max_frames, without waiting.
+ * @param frames Where to store the frames, oldest first.
+ * @param max_frames The capacity of frames.
+ *
+ * @return Returns the number of frames taken, 0 if none is queued or the sensor is not
+ *         streaming, -X on failure with failure code.
+ */
+int OPS_FMCW::fmcw_radar_sensor_try_read_fft_frames(fmcw_fft_frame_t *frames, size_t max_frames)
+{
+	TRACE_SCOPE(TRACE_RADAR_READ_FRAME);
+
+	if (frames == nullptr)
+		return -2;
+	if (!streaming.load(std::memory_order_acquire))
 		return 0;
+
+	size_t num_frames = 0;
+	fmcw_frame_handle_t handle;
+	while (num_frames < max_frames && stream_queue.pop(&handle))
+		frames[num_frames++] = *handle;
+	return static_cast<int>(num_frames);
+}
+
+/**
+ * Takes handles to every streamed frame that is already queued, up to max_frames, without
+ * waiting or copying them. Each frame goes back to the pool when its last handle is reset.
+ * @param frames Where to store the handles, oldest first.
+ * @param max_frames The capacity of frames.
+ *
+ * @return Returns the number of frames taken, 0 if none is queued or the sensor is not
+ *         streaming, -X on failure with failure code.
+ */
+int OPS_FMCW::fmcw_radar_sensor_try_acquire_fft_frames(fmcw_frame_handle_t *frames,
+                                                       size_t max_frames)
+{
+	TRACE_SCOPE(TRACE_RADAR_READ_FRAME);
+
+	if (frames == nullptr)
+		return -2;
+	if (!streaming.load(std::memory_order_acquire))
+		return 0;
+	return static_cast<int>(stream_queue.pop_many(frames, max_frames));
+}
+
+/**
+ * Starts a reader thread that captures every FFT frame the sensor streams into a queue, so
+ * frames keep arriving between calls to fmcw_radar_sensor_read_fft_frame(). Frames are buffered
+ * up to the queue and frame pool capacity, any captured while either is full are dropped and
+ * counted in dropped_frames. The transmitter should already be started.
+ *
+ * @return Returns 0 on success, -X on failure with failure code.
+ */
+int8_t OPS_FMCW::fmcw_radar_sensor_start_streaming()
+{
+	if (streaming.load(std::memory_order_acquire))
+		return -1; // already streaming
+
+	discard_input(); // anything buffered predates the transmitter starting
+	stream_queue.clear();
+	while (event_fd_drain(frame_event_fd) > 0)
+	{
 	}
-	return -1;
+	queued_frames.store(0, std::memory_order_relaxed);
+	dropped_frames.store(0, std::memory_order_relaxed);
+	missed_frames.store(0, std::memory_order_relaxed);
+	max_frame_gap_usec.store(0, std::memory_order_relaxed);
+	if (fd < 0 || rt_profile_serial_overruns(fd, &serial_overruns_at_start) != 0)
+		serial_overruns_at_start = 0;
+
+	streaming.store(true, std::memory_order_release);
+	stream_thread = std::thread(&OPS_FMCW::stream_loop, this);
+	return 0;
+}
+
+/**
+ * Stops the reader thread and discards any frames that were not read.
+ *
+ * @return Returns 0 on success, -X on failure with failure code.
+ */
+int8_t OPS_FMCW::fmcw_radar_sensor_stop_streaming()
+{
+	if (!streaming.load(std::memory_order_acquire))
+		return -1; // not streaming
+
+	streaming.store(false, std::memory_order_release);
+	if (stream_thread.joinable())
+		stream_thread.join();
+	stream_queue.clear();
+	while (event_fd_drain(frame_event_fd) > 0)
+	{
+	}
+	return 0;
+}
+
+/**
+ * Gets what the frame stream lost since streaming last started.
+ * @param stats Pointer to store the counts in.
+ */
+void OPS_FMCW::fmcw_radar_sensor_get_stream_stats(fmcw_stream_stats_t *stats)
+{
+	stats->frames = queued_frames.load(std::memory_order_relaxed);
+	stats->dropped_frames = dropped_frames.load(std::memory_order_relaxed);
+	stats->missed_frames = missed_frames.load(std::memory_order_relaxed);
+	stats->max_frame_gap_usec = max_frame_gap_usec.load(std::memory_order_relaxed);
+
+	uint32_t overruns;
+	stats->serial_overruns = 0;
+	if (fd >= 0 && rt_profile_serial_overruns(fd, &overruns) == 0)
+		stats->serial_overruns = overruns - serial_overruns_at_start;
+}
+
+/**
+ * Returns the eventfd that is readable while streamed frames are waiting to be read.
+ */
+int OPS_FMCW::fmcw_radar_sensor_frame_event_fd()
+{
+	return frame_event_fd;
 }
 
 /**
@@ -202,13 +459,259 @@ int8_t OPS_FMCW::fmcw_radar_sensor_stop_tx_signal()
 #ifdef RADAR_SIMULATION
 	return 0;
 #endif
-	send_command(FMCW_CMD_TURN_OFF_FFT);
-	send_command(FMCW_CMD_LED_OFF);
-	send_command(FMCW_CMD_HIBERNATE);
+	if (streaming.load(std::memory_order_acquire))
+		return -1; // the reader thread owns the sensor's output
+
+	radar_config_t hibernating = {RADAR_SETTING_OFF, RADAR_SETTING_OFF, RADAR_SETTING_OFF,
+	                              RADAR_SETTING_OFF};
+	int8_t rc = sequencer.configure(&hibernating);
+	if (rc != 0)
+	{
+		printf("Radar did not acknowledge stopping to transmit (err %d)\n", rc);
+		return -2;
+	}
 	return 0;
 }
 
 //------------------------------ Helper Functions -------------------------------
+/**
+ * Waits for a fresh FFT line from the radar sensor, discarding anything already buffered.
+ * @param fft_data The view to point at the comma separated FFT magnitudes. Valid until the
+ *                 next read from the sensor.
+ *
+ * @return Returns 0 on success, -X on failure with failure code.
+ */
+int8_t OPS_FMCW::read_fft_line(std::string_view *fft_data)
+{
+	discard_input(); // clear the input buffer of stale data
+	for (int8_t i = 0; i < MAX_READ_ATTEMPTS; i++)
+	{
+		if (next_fft_line(fft_data) == 0)
+			return 0;
+	}
+	return -1;
+}
+
+/**
+ * Drops everything the radar sensor sent that was not read yet.
+ */
+void OPS_FMCW::discard_input()
+{
+#ifdef RADAR_SIMULATION
+	if (replay != nullptr)
+		replay->discard_radar();
+#else
+	tcflush(fd, TCIFLUSH);
+#endif
+	line_reader.discard();
+}
+
+/**
+ * Reads the next line from the radar sensor.
+ * @param line The view to point at the line. Valid until the next read from the sensor.
+ *
+ * @return Returns 0 on success, -1 if no line arrived in time.
+ */
+int8_t OPS_FMCW::next_line(std::string_view *line)
+{
+	TRACE_SCOPE(TRACE_RADAR_SERIAL_READ);
+#ifdef RADAR_SIMULATION
+	if (replay == nullptr)
+	{
+		if (sim_lines.empty())
+			return -2; // the sim file failed to load at init
+		*line = sim_lines[next_sim_line++ % sim_lines.size()];
+		return 0;
+	}
+#endif
+	if (line_reader.read_line(line, FMCW_RADAR_LINE_TIMEOUT_MS) != 0)
+		return -1; // timed out
+	return 0;
+}
+
+/**
+ * Reads the next line from the radar sensor and strips the JSON wrapper around its FFT data.
+ * @param fft_data The view to point at the comma separated FFT magnitudes. Valid until the
+ *                 next read from the sensor.
+ *
+ * @return Returns 0 on success, -1 if the line was not FFT data or did not arrive in time.
+ */
+int8_t OPS_FMCW::next_fft_line(std::string_view *fft_data)
+{
+	std::string_view line;
+	int8_t rc = next_line(&line);
+	if (rc != 0)
+		return rc;
+
+	return fmcw_radar_extract_fft(line, fft_data);
+}
+
+/**
+ * Reads the next frame from the radar sensor, in whichever output mode it is in.
+ * @param frame Pointer to the structure to store the frame.
+ *
+ * @return Returns 0 on success, -X on failure with failure code.
+ */
+int8_t OPS_FMCW::next_frame(fmcw_fft_frame_t *frame)
+{
+#ifdef RADAR_ADC_CAPTURE
+	return next_adc_frame(frame);
+#else
+	std::string_view fft_data;
+	int8_t rc = next_fft_line(&fft_data);
+	if (rc != 0)
+		return rc;
+	return parse_fft_frame(fft_data, frame);
+#endif
+}
+
+/**
+ * Parses FFT magnitudes into a frame and stamps it with the capture time and sequence number.
+ * @param fft_data The comma separated FFT magnitudes.
+ * @param frame Pointer to the structure to store the parsed frame.
+ *
+ * @return Returns 0 on success, -3 if the data could not be parsed.
+ */
+int8_t OPS_FMCW::parse_fft_frame(std::string_view fft_data, fmcw_fft_frame_t *frame)
+{
+	TRACE_SCOPE(TRACE_RADAR_PARSE);
+	uint64_t timestamp_usec = clock_realtime_usec();
+	uint64_t monotonic_usec = clock_monotonic_usec();
+
+	int num_bins = fmcw_radar_parse_fft_bins(fft_data.data(), fft_data.size(), frame->bins,
+	                                         FMCW_RADAR_FFT_SIZE);
+	if (num_bins < 0)
+	{
+		printf("Failed to parse FFT data with error: %d\n", num_bins);
+		return -3;
+	}
+
+	frame->timestamp_usec = timestamp_usec;
+	frame->monotonic_usec = monotonic_usec;
+	frame->sequence = frame_sequence++;
+	frame->num_bins = static_cast<uint16_t>(num_bins);
+	frame->num_zoom_bins = 0; // the radar's own FFT only covers its fixed bins
+	return 0;
+}
+
+#ifdef RADAR_ADC_CAPTURE
+/**
+ * Reads one chirp's I and Q lines from the radar sensor and computes its spectrum and zoomed
+ * spectrum into a frame, stamped with the time its I line arrived.
+ * @param frame Pointer to the structure to store the frame.
+ *
+ * @return Returns 0 on success, -1 if the lines were not a chirp or did not arrive in time,
+ *         -3 if the samples could not be parsed.
+ */
+int8_t OPS_FMCW::next_adc_frame(fmcw_fft_frame_t *frame)
+{
+	std::string_view line;
+	std::string_view samples;
+	int8_t rc = next_line(&line);
+	if (rc != 0)
+		return rc;
+	if (fmcw_radar_extract_adc(line, 'I', &samples) != 0)
+		return -1; // not the start of a chirp
+
+	uint64_t timestamp_usec = clock_realtime_usec();
+	uint64_t monotonic_usec = clock_monotonic_usec();
+	{
+		TRACE_SCOPE(TRACE_RADAR_PARSE);
+		int num_i = fmcw_radar_parse_adc_samples(samples.data(), samples.size(), adc_i,
+		                                         RADAR_FFT_CHIRP_SAMPLES);
+		if (num_i != RADAR_FFT_CHIRP_SAMPLES)
+		{
+			printf("Failed to parse ADC I samples with error: %d\n", num_i);
+			return -3;
+		}
+	}
+
+	// the I line views are gone once the Q line is read
+	if ((rc = next_line(&line)) != 0)
+		return rc;
+	if (fmcw_radar_extract_adc(line, 'Q', &samples) != 0)
+		return -1;
+	{
+		TRACE_SCOPE(TRACE_RADAR_PARSE);
+		int num_q = fmcw_radar_parse_adc_samples(samples.data(), samples.size(), adc_q,
+		                                         RADAR_FFT_CHIRP_SAMPLES);
+		if (num_q != RADAR_FFT_CHIRP_SAMPLES)
+		{
+			printf("Failed to parse ADC Q samples with error: %d\n", num_q);
+			return -3;
+		}
+	}
+
+	TRACE_SCOPE(TRACE_RADAR_FFT);
+	radar_fft_spectrum(adc_i, adc_q, RADAR_FFT_CHIRP_SAMPLES, spectrum);
+	radar_zoom_spectrum(&zoom_plan, adc_i, adc_q, RADAR_FFT_CHIRP_SAMPLES, zoom);
+
+	auto to_bin = [](float magnitude) {
+		return static_cast<uint16_t>(std::min(magnitude + 0.5f, static_cast<float>(UINT16_MAX)));
+	};
+	for (size_t k = 0; k < RADAR_FFT_BINS; k++)
+		frame->bins[k] = to_bin(spectrum[k]);
+	for (size_t k = 0; k < zoom_plan.num_points; k++)
+		frame->zoom_bins[k] = to_bin(zoom[k]);
+
+	frame->timestamp_usec = timestamp_usec;
+	frame->monotonic_usec = monotonic_usec;
+	frame->sequence = frame_sequence++;
+	frame->num_bins = RADAR_FFT_BINS;
+	frame->num_zoom_bins = zoom_plan.num_points;
+	frame->zoom_start_m = zoom_plan.start_m;
+	frame->zoom_step_m = zoom_plan.step_m;
+	return 0;
+}
+#endif
+
+/**
+ * Body of the streaming reader thread. Parses every FFT line as it arrives, straight into a
+ * slot of the frame pool, and queues it for the application. Frames that arrive while the
+ * queue is full or the application holds every free slot are dropped and counted, and so are
+ * frames that never arrive or arrive damaged. Runs as RT_THREAD_RADAR under the real-time
+ * profile.
+ */
+void OPS_FMCW::stream_loop()
+{
+	fmcw_fft_frame_t discarded; // still parsed, to keep the sequence numbers counting
+	uint64_t last_frame_usec = 0;
+	rt_profile_enter(RT_THREAD_RADAR);
+
+	while (streaming.load(std::memory_order_acquire))
+	{
+		fmcw_frame_handle_t handle = frame_pool.acquire();
+		fmcw_fft_frame_t *frame = handle ? handle.get() : &discarded;
+		if (next_frame(frame) != 0)
+		{
+			if (streaming.load(std::memory_order_acquire))
+				missed_frames.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		// only this thread writes the gap, it is atomic for readers of the stats
+		uint64_t gap_usec = last_frame_usec != 0 ? frame->monotonic_usec - last_frame_usec : 0;
+		if (gap_usec > max_frame_gap_usec.load(std::memory_order_relaxed))
+			max_frame_gap_usec.store(static_cast<uint32_t>(gap_usec), std::memory_order_relaxed);
+		last_frame_usec = frame->monotonic_usec;
+
+		if (handle && stream_queue.push(std::move(handle)))
+		{
+			queued_frames.fetch_add(1, std::memory_order_relaxed);
+			event_fd_signal(frame_event_fd);
+		}
+		else
+		{
+			dropped_frames.fetch_add(1, std::memory_order_relaxed);
+		}
+
+#ifdef RADAR_SIMULATION
+		if (replay == nullptr)
+			usleep(FMCW_RADAR_SIM_FRAME_PERIOD_USEC); // the sim file never runs dry, pace it
+#endif
+	}
+}
+
 /**
  * Sends a command to the radar sensor over the serial port
  * @param cmd The command string to send.
@@ -225,33 +728,18 @@ int8_t OPS_FMCW::send_command(std::string cmd)
 }
 
 /**
- * Reads a line from the radar sensor over the serial port. Note
- * std::string used due to dynamic length of response.
+ * Reads a line from the radar sensor over the serial port and appends it to response.
  * @param response The string to store the response.
+ * @param timeout_ms How long to wait for the line to arrive.
  *
  * @return Returns 0 on success, -1 on failure.
  */
-int8_t OPS_FMCW::read_response(std::string *response)
+int8_t OPS_FMCW::read_response(std::string *response, int timeout_ms)
 {
-	char ch;
-	while (true)
-	{
-		int n = read(fd, &ch, 1); // reading 1 character at a time
-		if (n > 0)
-		{
-			if (ch == '\n' || ch == '\r') // end of line
-				break;
-			else
-				*response += ch;
-		}
-		else if (n < 0)
-		{
-			printf("Failed to read response with error: %s\n", strerror(errno));
-			break;
-		}
-		else       // EoF or nore more characters
-			break; // timeout
-	}
+	std::string_view line;
+	if (line_reader.read_line(&line, timeout_ms) != 0)
+		return -1;
+	response->append(line);
 	return 0;
 }
 
@@ -266,12 +754,75 @@ int8_t OPS_FMCW::read_response(std::string *response)
 int8_t OPS_FMCW::query(std::string cmd, std::string *response, uint8_t num_lines)
 {
 	tcflush(fd, TCIFLUSH); // flush the input buffer of stail data
-	send_command(cmd);
-	usleep(100000); // Pi runs faster than radar, give 100ms buffer time
-	for (int8_t i = 0; i < num_lines; i++)
-		read_response(response);
+	line_reader.discard();
+	if (send_command(cmd) != 0)
+		return -1;
+
+	// the first line takes the sensor's turnaround, the rest follow back to back
+	if (read_response(response, RADAR_CMD_ACK_TIMEOUT_MS + FMCW_RADAR_QUERY_TIMEOUT_MS) != 0)
+		return -1;
+	for (int8_t i = 1; i < num_lines; i++)
+	{
+		if (read_response(response, FMCW_RADAR_QUERY_TIMEOUT_MS) != 0)
+			break; // sensor has nothing more to say
+	}
+	return 0;
+}
+
+#ifdef RADAR_SIMULATION
+/**
+ * Loads the fake radar output served when no flight is replayed. The FFT has peaks at
+ * 458.3 Hz and 550 Hz (10cm ice thickness) for a drone 50cm above the surface, 1.6ms chirp
+ * slope, 2048 samples and 220MHz bandwidth. In ADC capture mode a chirp is made up instead,
+ * with the ice 35cm thick: 128 windowed samples cannot tell reflections 10cm apart.
+ *
+ * @return Returns 0 on success, -X on failure with failure code.
+ */
+int8_t OPS_FMCW::load_sim_lines()
+{
+#ifdef RADAR_ADC_CAPTURE
+	constexpr double SIM_SURFACE_M = 0.40;
+	constexpr double SIM_BOTTOM_M = 0.75;
+	std::string i_line = "{\"I\":[";
+	std::string q_line = "{\"Q\":[";
+	for (size_t n = 0; n < RADAR_FFT_CHIRP_SAMPLES; n++)
+	{
+		double re = 2048;
+		double im = 2048;
+		for (double range_m : {SIM_SURFACE_M, SIM_BOTTOM_M})
+		{
+			double amplitude = range_m == SIM_SURFACE_M ? 600 : 250;
+			double hz = range_m / radar_fft_hz_to_range_m(1.0);
+			double cycles = hz / (FMCW_RADAR_FS_KHZ * 1000.0);
+			double phase = 2 * 3.14159265358979323846 * cycles * n;
+			re += amplitude * std::cos(phase);
+			im += amplitude * std::sin(phase);
+		}
+		const char *separator = n + 1 < RADAR_FFT_CHIRP_SAMPLES ? "," : "]}";
+		i_line += std::to_string(std::lround(re)) + separator;
+		q_line += std::to_string(std::lround(im)) + separator;
+	}
+	sim_lines = {i_line, q_line};
+	return 0;
+#else
+	std::ifstream sim_file(RADAR_SIM_PATH);
+	if (!sim_file.is_open())
+	{
+		printf("Failed to open file: %s\n", RADAR_SIM_PATH);
+		return -1;
+	}
+
+	std::string fft_data;
+	if (!std::getline(sim_file, fft_data))
+	{
+		printf("Failed to read line from file: %s\n", RADAR_SIM_PATH);
+		return -2;
+	}
+	sim_lines = {"{\"FFT\":[" + fft_data + "]}"};
 	return 0;
+#endif
 }
+#endif
 
 //------------------------------ Debug Functions -------------------------------
 /**
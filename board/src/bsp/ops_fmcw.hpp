@@ -14,18 +14,46 @@
 #define OPS_FMCW_H
 
 #include "bsp/fmcw_radar_sensor.hpp"
+#include "common/spsc_queue.hpp"
+#include "dsp/radar_fft.hpp"
+#include "radar_command_sequencer.hpp"
+#include "serial_line_reader.hpp"
+#include <atomic>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class FLIGHT_REPLAY;
 
 //--------------------------------
 #define MAX_READ_ATTEMPTS 10
+#define FMCW_RADAR_LINE_TIMEOUT_MS 500 // longest we wait for one line while streaming
+#define FMCW_RADAR_QUERY_TIMEOUT_MS 100 // longest we wait for each line of a query response
+
+//--------------------------------
+// Streaming mode
+#define FMCW_RADAR_STREAM_QUEUE_DEPTH 32     // frames buffered between reader thread and app
+#define FMCW_RADAR_STREAM_POLL_USEC 1000     // how often a reader checks for a queued frame
+#define FMCW_RADAR_SIM_FRAME_PERIOD_USEC 50000 // pretend frame rate in RADAR_SIMULATION
+static_assert(FMCW_RADAR_STREAM_QUEUE_DEPTH + FMCW_RADAR_MAX_HELD_FRAMES + 1 <=
+                  FMCW_RADAR_FRAME_POOL_SIZE,
+              "the frame pool must cover the stream queue and the frames held by the app");
+
+//--------------------------------
+// ADC capture mode (RADAR_ADC_CAPTURE): the radar streams each chirp's raw I/Q samples and the
+// spectrum is computed on board, with a zoomed spectrum over the ice range gate that the
+// surface is expected in at survey height
+#define FMCW_RADAR_ZOOM_START_M 0.1
+#define FMCW_RADAR_ZOOM_END_M 1.0
 
 //--------------------------------
 #define FMCW_RADAR_BUFFER_SIZE 512 // fft buffer size per chirp
 #define FMCW_RADAR_CT_MS 1.6       // chirp time
 #define FMCW_RADAR_FS_KHZ 80       // sample rate
 #define FMCW_RADAR_BW_MHZ 990      // chirp bandwidth (ramp length)
-#define FMCW_RADAR_SLOPE (FMCW_RADAR_BW_MHZ * 1000000) / (FMCW_RADAR_CT_MS / 1000) // Hz/sec
+#define FMCW_RADAR_SLOPE ((FMCW_RADAR_BW_MHZ * 1000000.0) / (FMCW_RADAR_CT_MS / 1000)) // Hz/sec
 
 //--------------------------------
 // Serial interface
@@ -75,9 +103,19 @@ public:
 
 	int8_t fmcw_radar_sensor_init() override;
 	int8_t fmcw_radar_sensor_read_rx_signal(fmcw_waveform_data_t *data) override;
+	int8_t fmcw_radar_sensor_read_fft_frame(fmcw_fft_frame_t *frame) override;
+	int fmcw_radar_sensor_read_fft_frames(fmcw_fft_frame_t *frames, size_t max_frames) override;
+	int fmcw_radar_sensor_try_read_fft_frames(fmcw_fft_frame_t *frames,
+	                                          size_t max_frames) override;
+	int fmcw_radar_sensor_try_acquire_fft_frames(fmcw_frame_handle_t *frames,
+	                                             size_t max_frames) override;
 	int8_t fmcw_radar_sensor_start_tx_signal() override;
 	int8_t fmcw_radar_sensor_stop_tx_signal() override;
-	~OPS_FMCW() override {}
+	int8_t fmcw_radar_sensor_start_streaming() override;
+	int8_t fmcw_radar_sensor_stop_streaming() override;
+	void fmcw_radar_sensor_get_stream_stats(fmcw_stream_stats_t *stats) override;
+	int fmcw_radar_sensor_frame_event_fd() override;
+	~OPS_FMCW() override;
 
 private:
 	// Constructor is private to enforce factory function usage.
@@ -86,8 +124,21 @@ private:
 
 	// helper functions
 	int8_t send_command(std::string cmd);
-	int8_t read_response(std::string *response);
+	int8_t read_response(std::string *response, int timeout_ms = FMCW_RADAR_LINE_TIMEOUT_MS);
 	int8_t query(std::string cmd, std::string *response, uint8_t num_lines = 1);
+	int8_t read_fft_line(std::string_view *fft_data);
+	void discard_input();
+	int8_t next_line(std::string_view *line);
+	int8_t next_fft_line(std::string_view *fft_data);
+	int8_t next_frame(fmcw_fft_frame_t *frame);
+	int8_t parse_fft_frame(std::string_view fft_data, fmcw_fft_frame_t *frame);
+#ifdef RADAR_ADC_CAPTURE
+	int8_t next_adc_frame(fmcw_fft_frame_t *frame);
+#endif
+	void stream_loop();
+#ifdef RADAR_SIMULATION
+	int8_t load_sim_lines();
+#endif
 
 	// debug functions
 	int8_t log_rx_signal(fmcw_waveform_data_t *data);
@@ -96,6 +147,34 @@ private:
 	static OPS_FMCW *instance;
 	std::string usb_port;
 	int8_t fd;
+	uint32_t frame_sequence;
+	SERIAL_LINE_READER line_reader;
+	RADAR_COMMAND_SEQUENCER sequencer; // tracks the settings the sensor acknowledged
+
+	// streaming mode, the reader thread is the producer and the application the consumer
+	std::thread stream_thread;
+	std::atomic<bool> streaming;
+	std::atomic<uint32_t> queued_frames;
+	std::atomic<uint32_t> dropped_frames;
+	std::atomic<uint32_t> missed_frames;
+	std::atomic<uint32_t> max_frame_gap_usec;
+	uint32_t serial_overruns_at_start; // the driver's count when streaming started
+	int frame_event_fd; // eventfd, signalled after every queued frame
+	fmcw_frame_pool_t frame_pool; // the reader thread captures straight into its slots
+	SPSC_QUEUE<fmcw_frame_handle_t, FMCW_RADAR_STREAM_QUEUE_DEPTH> stream_queue;
+#ifdef RADAR_ADC_CAPTURE
+	// one chirp at a time, only touched by whoever is reading frames
+	float adc_i[RADAR_FFT_CHIRP_SAMPLES];
+	float adc_q[RADAR_FFT_CHIRP_SAMPLES];
+	float spectrum[RADAR_FFT_BINS];
+	float zoom[FMCW_RADAR_ZOOM_SIZE];
+	radar_zoom_plan_t zoom_plan;
+#endif
+#ifdef RADAR_SIMULATION
+	std::vector<std::string> sim_lines; // served over and over
+	size_t next_sim_line;
+	FLIGHT_REPLAY *replay; // nullptr serves sim_lines instead
+#endif
 };
 
 #endif // #ifndef OPS_FMCW_H
@@ -0,0 +1,317 @@
+/**
+ * Name: radar_command_sequencer.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the functions declared in radar_command_sequencer.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "radar_command_sequencer.hpp"
+#include "common/clock.h"
+#include "ops_fmcw.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+// the command that takes each tracked setting to off and to on
+struct radar_setting_commands
+{
+	enum radar_setting radar_config_t::*setting;
+	const char *off;
+	const char *on;
+};
+
+static const radar_setting_commands setting_commands[] = {
+    {&radar_config_t::awake, FMCW_CMD_HIBERNATE, FMCW_CMD_WAKEUP},
+    {&radar_config_t::fft_output, FMCW_CMD_TURN_OFF_FFT, FMCW_CMD_TURN_ON_FFT},
+    {&radar_config_t::adc_output, FMCW_CMD_TURN_OFF_ADC, FMCW_CMD_TURN_ON_ADC},
+    {&radar_config_t::led, FMCW_CMD_LED_OFF, FMCW_CMD_LED_ON},
+};
+static constexpr size_t num_setting_commands = sizeof(setting_commands) / sizeof(*setting_commands);
+
+static bool setting_changes(enum radar_setting current, enum radar_setting desired)
+{
+	return desired != RADAR_SETTING_UNKNOWN && current != desired;
+}
+
+size_t radar_config_commands(const radar_config_t *current, const radar_config_t *desired,
+                             const char **commands, size_t max_commands)
+{
+	size_t num_commands = 0;
+	auto add = [&](const char *command) {
+		if (num_commands < max_commands)
+			commands[num_commands++] = command;
+	};
+
+	// a hibernating sensor ignores everything but the wake up
+	const radar_setting_commands &power = setting_commands[0];
+	if (desired->awake == RADAR_SETTING_ON && setting_changes(current->awake, desired->awake))
+		add(power.on);
+
+	for (size_t i = 1; i < num_setting_commands; i++)
+	{
+		const radar_setting_commands &entry = setting_commands[i];
+		enum radar_setting want = desired->*entry.setting;
+		if (setting_changes(current->*entry.setting, want))
+			add(want == RADAR_SETTING_ON ? entry.on : entry.off);
+	}
+
+	if (desired->awake == RADAR_SETTING_OFF && setting_changes(current->awake, desired->awake))
+		add(power.off);
+	return num_commands;
+}
+
+void radar_config_apply(radar_config_t *config, std::string_view command)
+{
+	for (const radar_setting_commands &entry : setting_commands)
+	{
+		if (command == entry.off)
+			config->*entry.setting = RADAR_SETTING_OFF;
+		else if (command == entry.on)
+			config->*entry.setting = RADAR_SETTING_ON;
+	}
+}
+
+static void forget_setting(radar_config_t *config, std::string_view command)
+{
+	for (const radar_setting_commands &entry : setting_commands)
+	{
+		if (command == entry.off || command == entry.on)
+			config->*entry.setting = RADAR_SETTING_UNKNOWN;
+	}
+}
+
+int8_t radar_reply_classify(std::string_view line, std::string_view command)
+{
+	if (line.empty() || line.find('[') != std::string_view::npos)
+		return 0; // streamed FFT and ADC lines are JSON arrays, replies never are
+
+	if (line.find("rror") != std::string_view::npos ||
+	    line.find("nvalid") != std::string_view::npos)
+		return -1; // "Error", "error", "Invalid" and "invalid"
+
+	// a sensor that is not in JSON mode yet answers the switch to it in plain text
+	if (command == FMCW_CMD_JSON_MODE && line.front() != '{')
+		return 1;
+
+	// the command as a whole JSON string, commands differ only in case, e.g. oF and of
+	for (size_t pos = line.find(command); pos != std::string_view::npos;
+	     pos = line.find(command, pos + 1))
+	{
+		size_t end = pos + command.size();
+		if (pos > 0 && line[pos - 1] == '"' && end < line.size() && line[end] == '"')
+			return 1;
+	}
+	return -2;
+}
+
+/**
+ * Constructor for the RADAR_COMMAND_SEQUENCER class. Nothing is known about the sensor's
+ * configuration until commands are acknowledged.
+ */
+RADAR_COMMAND_SEQUENCER::RADAR_COMMAND_SEQUENCER() : fd(-1), reader(nullptr), stats{}
+{
+	forget_config();
+}
+
+/**
+ * Attaches the sequencer to the sensor.
+ * @param fd The file descriptor commands are written to
+ * @param reader The reader of the sensor's output, already attached
+ */
+void RADAR_COMMAND_SEQUENCER::attach(int fd, SERIAL_LINE_READER *reader)
+{
+	this->fd = fd;
+	this->reader = reader;
+	forget_config();
+}
+
+/**
+ * Sends a batch of commands and waits for the sensor to acknowledge each of them, in order.
+ * If a reply does not arrive in time, reports an error or echoes another command, that
+ * command and every one after it are sent again. The commands should be safe to repeat, all
+ * of the sensor's settings are.
+ * @param commands The commands to send, without line endings
+ * @param num_commands The number of commands
+ *
+ * @return Returns 0 on success, -1 on bad arguments, -2 if writing failed, -3 if the sensor
+ *         did not acknowledge every command.
+ */
+int8_t RADAR_COMMAND_SEQUENCER::run(const char *const *commands, size_t num_commands)
+{
+	if (fd < 0 || reader == nullptr || num_commands > RADAR_CMD_MAX_BATCH)
+		return -1;
+
+	size_t acked = 0;
+	for (int attempt = 0; acked < num_commands; attempt++)
+	{
+		if (attempt > RADAR_CMD_MAX_RETRIES)
+		{
+			// whatever the sensor did with the rest, their settings are no longer known
+			for (size_t i = acked; i < num_commands; i++)
+				forget_setting(&config, commands[i]);
+			return -3;
+		}
+		if (attempt > 0)
+		{
+			stats.retries++;
+			reader->discard(); // a late reply to the last attempt would be taken for this one's
+		}
+
+		if (write_batch(commands + acked, num_commands - acked) != 0)
+			return -2;
+		acked += read_acks(commands + acked, num_commands - acked);
+	}
+	return 0;
+}
+
+/**
+ * Takes the sensor to a configuration, sending only the commands that change a setting.
+ * @param desired The configuration to go to, unknown settings are left as they are
+ *
+ * @return Returns 0 on success, -X on failure with failure code, see run().
+ */
+int8_t RADAR_COMMAND_SEQUENCER::configure(const radar_config_t *desired)
+{
+	const char *commands[RADAR_CMD_MAX_BATCH];
+	size_t num_commands = radar_config_commands(&config, desired, commands, RADAR_CMD_MAX_BATCH);
+	if (num_commands == 0)
+		return 0;
+	return run(commands, num_commands);
+}
+
+/**
+ * Marks every setting unknown, e.g. after the sensor was reset, so the next configure()
+ * sends all of them.
+ */
+void RADAR_COMMAND_SEQUENCER::forget_config()
+{
+	config = {RADAR_SETTING_UNKNOWN, RADAR_SETTING_UNKNOWN, RADAR_SETTING_UNKNOWN,
+	          RADAR_SETTING_UNKNOWN};
+}
+
+/**
+ * Returns the configuration the sensor acknowledged.
+ */
+void RADAR_COMMAND_SEQUENCER::get_config(radar_config_t *config) const
+{
+	*config = this->config;
+}
+
+/**
+ * Returns the command counters since the sequencer was created.
+ */
+void RADAR_COMMAND_SEQUENCER::get_stats(radar_sequencer_stats_t *stats) const
+{
+	*stats = this->stats;
+}
+
+//------------------------------ Helper Functions -------------------------------
+/**
+ * Writes a batch of commands to the sensor with a single write.
+ *
+ * @return Returns 0 on success, -1 on failure.
+ */
+int8_t RADAR_COMMAND_SEQUENCER::write_batch(const char *const *commands, size_t num_commands)
+{
+	char batch[RADAR_CMD_MAX_BATCH * (RADAR_CMD_MAX_LENGTH + 2)];
+	size_t len = 0;
+	for (size_t i = 0; i < num_commands; i++)
+	{
+		size_t command_len = strlen(commands[i]);
+		if (command_len > RADAR_CMD_MAX_LENGTH)
+			return -1;
+		memcpy(batch + len, commands[i], command_len);
+		len += command_len;
+		batch[len++] = '\r';
+		batch[len++] = '\n';
+	}
+
+	size_t written = 0;
+	while (written < len)
+	{
+		ssize_t rc = write(fd, batch + written, len - written);
+		if (rc < 0 && errno == EINTR)
+			continue;
+		if (rc <= 0)
+		{
+			printf("Failed to write radar commands with error: %s\n", strerror(errno));
+			return -1;
+		}
+		written += rc;
+	}
+	stats.commands_sent += num_commands;
+	return 0;
+}
+
+/**
+ * Waits for the sensor's next reply, skipping streamed data.
+ * @param command The command the reply is expected for
+ * @param line The view to point at the reply. Valid until the next read from the sensor.
+ *
+ * @return 1 if it acknowledges command, -1 if it reports an error, -2 if it echoes another
+ *         command, 0 if none arrived in time.
+ */
+int8_t RADAR_COMMAND_SEQUENCER::next_reply(const char *command, std::string_view *line)
+{
+	uint64_t deadline_usec = clock_monotonic_usec() + RADAR_CMD_ACK_TIMEOUT_MS * 1000ULL;
+	while (true)
+	{
+		uint64_t now_usec = clock_monotonic_usec();
+		if (now_usec >= deadline_usec)
+			return 0;
+
+		int timeout_ms = (int)((deadline_usec - now_usec + 999) / 1000);
+		if (reader->read_line(line, timeout_ms) != 0)
+			return 0;
+
+		int8_t reply = radar_reply_classify(*line, command);
+		if (reply != 0)
+			return reply;
+	}
+}
+
+/**
+ * Reads back the sensor's replies to a batch. The sensor answers in order, so each reply has
+ * to echo the next unacknowledged command. Each command has its own deadline, starting when
+ * the one before it was acknowledged.
+ *
+ * @return The number of commands acknowledged before a reply was missing, reported an error
+ *         or echoed another command.
+ */
+size_t RADAR_COMMAND_SEQUENCER::read_acks(const char *const *commands, size_t num_commands)
+{
+	size_t acked = 0;
+	std::string_view line;
+	while (acked < num_commands)
+	{
+		int8_t reply = next_reply(commands[acked], &line);
+		if (reply == 0)
+			break;
+		if (reply < 0)
+		{
+			printf("Radar %s `%s`: %.*s\n", reply == -1 ? "rejected" : "did not echo",
+			       commands[acked], (int)line.size(), line.data());
+			if (reply == -1)
+				stats.nacks++;
+			else
+				stats.mismatches++;
+
+			// the sensor still answers the commands after it, those are not the resend's replies
+			for (size_t i = acked + 1; i < num_commands && next_reply(commands[i], &line) != 0;
+			     i++)
+			{
+			}
+			break;
+		}
+
+		radar_config_apply(&config, commands[acked]);
+		stats.commands_acked++;
+		acked++;
+	}
+	return acked;
+}
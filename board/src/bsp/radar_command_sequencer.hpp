@@ -0,0 +1,123 @@
+/**
+ * Name: radar_command_sequencer.hpp
+ * Author: Hubert Dang
+ *
+ * This file describes the command sequencer for the OPS-243C. A batch of commands is written
+ * in one go and the sensor's reply to each is read back in order against a deadline, instead
+ * of sleeping and hoping every setting was applied. A reply only acknowledges a command if it
+ * echoes it, so a late reply to an earlier command is not taken for the current one's.
+ * Commands that are not acknowledged are resent. The sequencer also keeps track of the
+ * sensor's output, LED and power settings so a caller asks for a configuration and only the
+ * commands that change something are sent.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef RADAR_COMMAND_SEQUENCER_H
+#define RADAR_COMMAND_SEQUENCER_H
+
+#include "serial_line_reader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//--------------------------------
+#define RADAR_CMD_ACK_TIMEOUT_MS 100 // longest the sensor takes to answer one command
+#define RADAR_CMD_MAX_RETRIES 3      // resends of the unacknowledged part of a batch
+#define RADAR_CMD_MAX_BATCH 16
+#define RADAR_CMD_MAX_LENGTH 16 // of one command, without the line ending
+
+enum radar_setting
+{
+	RADAR_SETTING_UNKNOWN = -1, // not known yet, or "leave it as it is" in a request
+	RADAR_SETTING_OFF = 0,
+	RADAR_SETTING_ON = 1,
+};
+
+typedef struct radar_config
+{
+	enum radar_setting fft_output;
+	enum radar_setting adc_output;
+	enum radar_setting led;
+	enum radar_setting awake; // off while hibernating
+} radar_config_t;
+
+typedef struct radar_sequencer_stats
+{
+	uint32_t commands_sent; // including resends
+	uint32_t commands_acked;
+	uint32_t retries;    // resent batches
+	uint32_t nacks;      // replies reporting an error
+	uint32_t mismatches; // replies echoing another command, e.g. late ones
+} radar_sequencer_stats_t;
+
+/**
+ * Lists the commands that take the sensor from one configuration to another, in the order
+ * they have to be sent: the sensor is woken up before anything else and put to sleep last.
+ * Settings that are unknown in current are always sent, settings that are unknown in desired
+ * are left alone.
+ * @param current The configuration the sensor is in
+ * @param desired The configuration to go to
+ * @param commands Where to store the commands
+ * @param max_commands The capacity of commands
+ *
+ * @return The number of commands stored.
+ */
+size_t radar_config_commands(const radar_config_t *current, const radar_config_t *desired,
+                             const char **commands, size_t max_commands);
+
+/**
+ * Updates a configuration with the effect of a command the sensor acknowledged. Commands
+ * that do not touch the tracked settings leave it unchanged.
+ * @param config The configuration to update
+ * @param command The acknowledged command
+ */
+void radar_config_apply(radar_config_t *config, std::string_view command);
+
+/**
+ * Classifies a line read back from the sensor while a command is outstanding. In JSON mode
+ * the sensor answers a command with an object that echoes it as a string, e.g. {"Command":"OJ"}
+ * for OJ, only such a reply acknowledges the command. The exception is OJ itself, which a
+ * sensor still in plain text mode acknowledges with any reply that is not an error.
+ * @param line The line, without its line ending
+ * @param command The command the reply is expected for
+ *
+ * @return 1 if it acknowledges command, -1 if it reports an error, -2 if it is a reply that
+ *         does not echo command, 0 if it is streamed data or empty and has nothing to do with
+ *         the commands.
+ */
+int8_t radar_reply_classify(std::string_view line, std::string_view command);
+
+class RADAR_COMMAND_SEQUENCER
+{
+public:
+	RADAR_COMMAND_SEQUENCER();
+
+	// RADAR_COMMAND_SEQUENCER tracks the state of one sensor, so it should not be cloneable.
+	RADAR_COMMAND_SEQUENCER(RADAR_COMMAND_SEQUENCER &other) = delete;
+
+	// RADAR_COMMAND_SEQUENCER should not be assignable.
+	void operator=(const RADAR_COMMAND_SEQUENCER &) = delete;
+
+	void attach(int fd, SERIAL_LINE_READER *reader);
+	int8_t run(const char *const *commands, size_t num_commands);
+	int8_t configure(const radar_config_t *desired);
+	void forget_config();
+	void get_config(radar_config_t *config) const;
+	void get_stats(radar_sequencer_stats_t *stats) const;
+
+private:
+	int8_t write_batch(const char *const *commands, size_t num_commands);
+	int8_t next_reply(const char *command, std::string_view *line);
+	size_t read_acks(const char *const *commands, size_t num_commands);
+
+private:
+	int fd;
+	SERIAL_LINE_READER *reader; // shared with the driver, only used while it is not streaming
+	radar_config_t config;
+	radar_sequencer_stats_t stats;
+};
+
+#endif // #ifndef RADAR_COMMAND_SEQUENCER_H
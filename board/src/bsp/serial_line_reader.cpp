@@ -0,0 +1,146 @@
+/**
+ * Name: serial_line_reader.cpp
+ * Author: Karran Dhillon
+ *
+ * This file implements the functions declared in serial_line_reader.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "serial_line_reader.hpp"
+#include "common/clock.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+
+/**
+ * Constructor for the SERIAL_LINE_READER class. The reader is unusable until a file
+ * descriptor is attached.
+ */
+SERIAL_LINE_READER::SERIAL_LINE_READER() : head(0), scan(0), tail(0), fd(-1) {}
+
+/**
+ * Attaches the reader to an open serial port and drops anything buffered from a previous one.
+ * The tty should be configured with VMIN = 0 and VTIME = 0 so reads never block; waiting is
+ * done with poll() instead.
+ * @param fd The file descriptor of the serial port.
+ */
+void SERIAL_LINE_READER::attach(int fd)
+{
+	this->fd = fd;
+	discard();
+}
+
+/**
+ * Drops every buffered byte. Call this together with tcflush() to get rid of stale data.
+ */
+void SERIAL_LINE_READER::discard()
+{
+	head = scan = tail = 0;
+}
+
+/**
+ * Reads the next non-empty line from the serial port. Lines may end in '\n', '\r' or both.
+ * Bytes are pulled from the device in bulk, so most calls are served from the buffer without
+ * a syscall.
+ * @param line The view to point at the line, without its line ending. The view is only valid
+ *             until the next call to read_line() or discard().
+ * @param timeout_ms How long to wait for a complete line to arrive.
+ *
+ * @return Returns 0 on success, -1 on timeout, -2 on a read error.
+ */
+int8_t SERIAL_LINE_READER::read_line(std::string_view *line, int timeout_ms)
+{
+	uint64_t deadline_usec = clock_monotonic_usec() + static_cast<uint64_t>(timeout_ms) * 1000;
+
+	while (true)
+	{
+		while (scan < tail)
+		{
+			char ch = buf[scan++];
+			if (ch != '\n' && ch != '\r')
+				continue;
+
+			size_t start = head;
+			size_t len = scan - 1 - head;
+			head = scan;
+			if (len == 0)
+				continue; // second half of a "\r\n" or a blank line
+
+			*line = std::string_view(buf + start, len);
+			return 0;
+		}
+
+		if (head == tail)
+		{
+			head = scan = tail = 0; // everything consumed, start from the front again
+		}
+		else if (tail == sizeof(buf))
+		{
+			if (head == 0)
+			{
+				// a single line larger than the buffer is garbage, drop it
+				printf("Serial line exceeds %d bytes, discarding\n", SERIAL_LINE_READER_BUF_SIZE);
+				discard();
+			}
+			else
+			{
+				// move the partial line to the front so the next line stays contiguous
+				memmove(buf, buf + head, tail - head);
+				scan -= head;
+				tail -= head;
+				head = 0;
+			}
+		}
+
+		uint64_t now_usec = clock_monotonic_usec();
+		if (now_usec >= deadline_usec)
+			return -1;
+
+		int8_t rc = fill(static_cast<int>((deadline_usec - now_usec + 999) / 1000));
+		if (rc < 0)
+			return rc;
+	}
+}
+
+/**
+ * Waits for the serial port to become readable, then reads as many bytes as fit in the buffer.
+ * @param timeout_ms How long to wait for data.
+ *
+ * @return Returns 0 on success (including a timeout when no data arrived), -2 on failure.
+ */
+int8_t SERIAL_LINE_READER::fill(int timeout_ms)
+{
+	struct pollfd pfd = {};
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+
+	int ready = poll(&pfd, 1, timeout_ms);
+	if (ready < 0)
+	{
+		if (errno == EINTR)
+			return 0;
+		printf("Failed to poll serial port with error: %s\n", strerror(errno));
+		return -2;
+	}
+	if (ready == 0)
+		return 0;
+
+	ssize_t n = read(fd, buf + tail, sizeof(buf) - tail);
+	if (n < 0)
+	{
+		if (errno == EAGAIN || errno == EINTR)
+			return 0;
+		printf("Failed to read serial port with error: %s\n", strerror(errno));
+		return -2;
+	}
+	if (n == 0 && (pfd.revents & POLLHUP))
+		return -2; // device went away
+
+	tail += static_cast<size_t>(n);
+	return 0;
+}
@@ -0,0 +1,48 @@
+/**
+ * Name: serial_line_reader.hpp
+ * Author: Karran Dhillon
+ *
+ * This file describes a buffered line reader for the serial devices used by the bsp layer.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#ifndef SERIAL_LINE_READER_H
+#define SERIAL_LINE_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//--------------------------------
+#define SERIAL_LINE_READER_BUF_SIZE 8192 // must hold at least two full FFT lines
+
+class SERIAL_LINE_READER
+{
+public:
+	SERIAL_LINE_READER();
+
+	// SERIAL_LINE_READER hands out views into its buffer, so it should not be cloneable.
+	SERIAL_LINE_READER(SERIAL_LINE_READER &other) = delete;
+
+	// SERIAL_LINE_READER should not be assignable.
+	void operator=(const SERIAL_LINE_READER &) = delete;
+
+	void attach(int fd);
+	int8_t read_line(std::string_view *line, int timeout_ms);
+	void discard();
+
+private:
+	int8_t fill(int timeout_ms);
+
+private:
+	char buf[SERIAL_LINE_READER_BUF_SIZE];
+	size_t head; // start of the first unconsumed byte
+	size_t scan; // everything in [head, scan) is known not to contain a line ending
+	size_t tail; // end of the bytes read from the device
+	int fd;
+};
+
+#endif // #ifndef SERIAL_LINE_READER_H
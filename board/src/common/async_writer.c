@@ -0,0 +1,237 @@
+/**
+ *
+ * Name: async_writer.c
+ * Author: Hubert Dang
+ *
+ * This file implements the background writer described in async_writer.h
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "common/async_writer.h"
+#include "common/clock.h"
+#include "common/rt_profile.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+struct async_writer
+{
+	int fd;
+	struct async_writer_config config;
+
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t wakeup;
+
+	/* Protected by lock */
+	char *buffers[2];
+	size_t active;     /* index of the buffer producers copy into */
+	size_t active_len; /* bytes queued in the active buffer */
+	bool sync_requested;
+	bool stopping;
+	struct async_writer_stats stats;
+};
+
+static void *async_writer_thread(void *arg);
+
+struct async_writer *async_writer_create(int fd, const struct async_writer_config *config)
+{
+	if (fd < 0 || config == NULL || config->buffer_size == 0)
+		return NULL;
+
+	struct async_writer *writer = calloc(1, sizeof(*writer));
+	if (writer == NULL)
+		return NULL;
+
+	writer->fd = fd;
+	writer->config = *config;
+	writer->buffers[0] = malloc(config->buffer_size);
+	writer->buffers[1] = malloc(config->buffer_size);
+	if (writer->buffers[0] == NULL || writer->buffers[1] == NULL)
+		goto err_free;
+
+	pthread_condattr_t attr;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&writer->wakeup, &attr);
+	pthread_condattr_destroy(&attr);
+	pthread_mutex_init(&writer->lock, NULL);
+
+	if (pthread_create(&writer->thread, NULL, async_writer_thread, writer) != 0)
+	{
+		pthread_cond_destroy(&writer->wakeup);
+		pthread_mutex_destroy(&writer->lock);
+		goto err_free;
+	}
+
+	return writer;
+
+err_free:
+	free(writer->buffers[0]);
+	free(writer->buffers[1]);
+	free(writer);
+	return NULL;
+}
+
+int async_writer_write(struct async_writer *writer, const void *data, size_t len)
+{
+	int rc = 0;
+
+	pthread_mutex_lock(&writer->lock);
+
+	if (writer->active_len + len > writer->config.buffer_size)
+	{
+		writer->stats.bytes_dropped += len;
+		rc = -1;
+	}
+	else
+	{
+		memcpy(writer->buffers[writer->active] + writer->active_len, data, len);
+		writer->active_len += len;
+
+		/* Wake the thread early once half the buffer is used, so it never fills up */
+		if (writer->active_len >= writer->config.buffer_size / 2)
+			pthread_cond_signal(&writer->wakeup);
+	}
+
+	pthread_mutex_unlock(&writer->lock);
+	return rc;
+}
+
+void async_writer_sync(struct async_writer *writer)
+{
+	pthread_mutex_lock(&writer->lock);
+	writer->sync_requested = true;
+	pthread_cond_signal(&writer->wakeup);
+	pthread_mutex_unlock(&writer->lock);
+}
+
+void async_writer_get_stats(struct async_writer *writer, struct async_writer_stats *stats)
+{
+	pthread_mutex_lock(&writer->lock);
+	*stats = writer->stats;
+	pthread_mutex_unlock(&writer->lock);
+}
+
+void async_writer_destroy(struct async_writer *writer)
+{
+	if (writer == NULL)
+		return;
+
+	pthread_mutex_lock(&writer->lock);
+	writer->stopping = true;
+	pthread_cond_signal(&writer->wakeup);
+	pthread_mutex_unlock(&writer->lock);
+
+	pthread_join(writer->thread, NULL);
+
+	pthread_cond_destroy(&writer->wakeup);
+	pthread_mutex_destroy(&writer->lock);
+	close(writer->fd);
+	free(writer->buffers[0]);
+	free(writer->buffers[1]);
+	free(writer);
+}
+
+/* Write a whole buffer, retrying short writes. Returns 0 on success. */
+static int write_all(int fd, const char *data, size_t len)
+{
+	while (len > 0)
+	{
+		ssize_t n = write(fd, data, len);
+		if (n < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		data += n;
+		len -= (size_t)n;
+	}
+	return 0;
+}
+
+static struct timespec deadline_after_ms(unsigned ms)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	ts.tv_sec += ms / 1000;
+	ts.tv_nsec += (long)(ms % 1000) * 1000000L;
+	if (ts.tv_nsec >= 1000000000L)
+	{
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000L;
+	}
+	return ts;
+}
+
+static void *async_writer_thread(void *arg)
+{
+	struct async_writer *writer = arg;
+	uint64_t last_fsync_usec = clock_monotonic_usec();
+	bool unsynced = false; /* written data that has not been fsynced yet */
+
+	rt_profile_enter(RT_THREAD_BACKGROUND); /* SD card stalls must not hold up the readers */
+	pthread_mutex_lock(&writer->lock);
+	while (true)
+	{
+		if (!writer->stopping && !writer->sync_requested &&
+		    writer->active_len < writer->config.buffer_size / 2)
+		{
+			struct timespec deadline = deadline_after_ms(writer->config.flush_interval_ms);
+			pthread_cond_timedwait(&writer->wakeup, &writer->lock, &deadline);
+		}
+
+		/* Swap buffers so producers keep going while this thread does the I/O */
+		char *full = writer->buffers[writer->active];
+		size_t full_len = writer->active_len;
+		writer->active ^= 1;
+		writer->active_len = 0;
+
+		bool sync_requested = writer->sync_requested;
+		bool stopping = writer->stopping;
+		writer->sync_requested = false;
+
+		pthread_mutex_unlock(&writer->lock);
+
+		int write_rc = 0;
+		if (full_len > 0)
+		{
+			write_rc = write_all(writer->fd, full, full_len);
+			unsynced = true;
+		}
+
+		bool fsynced = false;
+		uint64_t now_usec = clock_monotonic_usec();
+		bool fsync_due = writer->config.fsync_interval_ms > 0 &&
+		                 now_usec - last_fsync_usec >= writer->config.fsync_interval_ms * 1000ULL;
+		if (unsynced && (sync_requested || stopping || fsync_due))
+		{
+			fsync(writer->fd);
+			fsynced = true;
+			unsynced = false;
+			last_fsync_usec = now_usec;
+		}
+
+		pthread_mutex_lock(&writer->lock);
+		if (write_rc == 0)
+			writer->stats.bytes_written += full_len;
+		else
+			writer->stats.write_errors++;
+		if (fsynced)
+			writer->stats.fsyncs++;
+
+		if (stopping && writer->active_len == 0)
+			break;
+	}
+	pthread_mutex_unlock(&writer->lock);
+
+	return NULL;
+}
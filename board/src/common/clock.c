@@ -0,0 +1,40 @@
+/**
+ *
+ * Name: clock.c
+ * Author: Hubert Dang
+ *
+ * This file implements the timestamp helpers shared by the board software.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "common/clock.h"
+#include <time.h>
+
+static uint64_t timespec_to_usec(const struct timespec *ts)
+{
+	return (uint64_t)ts->tv_sec * 1000000ULL + (uint64_t)ts->tv_nsec / 1000ULL;
+}
+
+uint64_t clock_realtime_usec()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return timespec_to_usec(&ts);
+}
+
+uint64_t clock_monotonic_usec()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return timespec_to_usec(&ts);
+}
+
+uint64_t clock_monotonic_nsec()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
@@ -0,0 +1,232 @@
+/**
+ *
+ * Name: event_loop.c
+ * Author: Hubert Dang
+ *
+ * This file implements the event loop described in event_loop.h
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "common/event_loop.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+struct event_source
+{
+	int fd; /* -1 when the slot is free */
+	bool is_timer;
+	event_loop_callback callback;
+	void *ctx;
+	uint32_t generation; /* a removed source's stale events must not reach its slot's next owner */
+};
+
+struct event_loop
+{
+	int epoll_fd;
+	bool running;
+	struct event_source sources[EVENT_LOOP_MAX_SOURCES];
+};
+
+static uint64_t event_loop_tag(size_t slot, uint32_t generation)
+{
+	return ((uint64_t)generation << 32) | slot;
+}
+
+struct event_loop *event_loop_create()
+{
+	struct event_loop *loop = calloc(1, sizeof(*loop));
+	if (loop == NULL)
+		return NULL;
+
+	loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (loop->epoll_fd < 0)
+	{
+		free(loop);
+		return NULL;
+	}
+
+	for (size_t i = 0; i < EVENT_LOOP_MAX_SOURCES; i++)
+		loop->sources[i].fd = -1;
+
+	return loop;
+}
+
+static int event_loop_add(struct event_loop *loop, int fd, bool is_timer,
+                          event_loop_callback callback, void *ctx)
+{
+	if (loop == NULL || fd < 0 || callback == NULL)
+		return -1;
+
+	for (size_t i = 0; i < EVENT_LOOP_MAX_SOURCES; i++)
+	{
+		struct event_source *source = &loop->sources[i];
+		if (source->fd >= 0)
+			continue;
+
+		source->generation++;
+		struct epoll_event event = {0};
+		event.events = EPOLLIN;
+		event.data.u64 = event_loop_tag(i, source->generation);
+		if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+			return -2;
+
+		source->fd = fd;
+		source->is_timer = is_timer;
+		source->callback = callback;
+		source->ctx = ctx;
+		return 0;
+	}
+
+	return -3; /* raise EVENT_LOOP_MAX_SOURCES */
+}
+
+int event_loop_add_fd(struct event_loop *loop, int fd, event_loop_callback callback, void *ctx)
+{
+	return event_loop_add(loop, fd, false, callback, ctx);
+}
+
+void event_loop_remove_fd(struct event_loop *loop, int fd)
+{
+	if (loop == NULL || fd < 0)
+		return;
+
+	for (size_t i = 0; i < EVENT_LOOP_MAX_SOURCES; i++)
+	{
+		if (loop->sources[i].fd == fd)
+		{
+			epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+			loop->sources[i].fd = -1;
+			return;
+		}
+	}
+}
+
+int event_loop_add_timer(struct event_loop *loop, event_loop_callback callback, void *ctx)
+{
+	int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (timer < 0)
+		return -1;
+
+	int rc = event_loop_add(loop, timer, true, callback, ctx);
+	if (rc != 0)
+	{
+		close(timer);
+		return rc - 1;
+	}
+	return timer;
+}
+
+static struct timespec usec_to_timespec(uint64_t usec)
+{
+	struct timespec ts;
+	ts.tv_sec = usec / 1000000;
+	ts.tv_nsec = (usec % 1000000) * 1000;
+	return ts;
+}
+
+int event_loop_arm_timer(struct event_loop *loop, int timer, uint64_t delay_usec,
+                         uint64_t period_usec)
+{
+	(void)loop;
+	struct itimerspec spec;
+	spec.it_value = usec_to_timespec(delay_usec);
+	spec.it_interval = usec_to_timespec(delay_usec == 0 ? 0 : period_usec);
+	return timerfd_settime(timer, 0, &spec, NULL) == 0 ? 0 : -1;
+}
+
+void event_loop_remove_timer(struct event_loop *loop, int timer)
+{
+	event_loop_remove_fd(loop, timer);
+	close(timer);
+}
+
+int event_loop_run_once(struct event_loop *loop, int timeout_ms)
+{
+	struct epoll_event events[EVENT_LOOP_MAX_SOURCES];
+	int num_events = epoll_wait(loop->epoll_fd, events, EVENT_LOOP_MAX_SOURCES, timeout_ms);
+	if (num_events < 0)
+		return errno == EINTR ? 0 : -1;
+
+	int dispatched = 0;
+	for (int i = 0; i < num_events; i++)
+	{
+		size_t slot = events[i].data.u64 & 0xFFFFFFFFu;
+		uint32_t generation = events[i].data.u64 >> 32;
+		struct event_source *source = &loop->sources[slot];
+
+		/* An earlier callback in this batch may have removed or replaced the source */
+		if (source->fd < 0 || source->generation != generation)
+			continue;
+
+		if (source->is_timer)
+		{
+			uint64_t expirations;
+			if (read(source->fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+				continue; /* rearmed or disarmed since it fired */
+		}
+
+		source->callback(source->ctx);
+		dispatched++;
+	}
+
+	return dispatched;
+}
+
+int event_loop_run(struct event_loop *loop)
+{
+	loop->running = true;
+	while (loop->running)
+	{
+		if (event_loop_run_once(loop, -1) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+void event_loop_stop(struct event_loop *loop)
+{
+	loop->running = false;
+}
+
+void event_loop_destroy(struct event_loop *loop)
+{
+	if (loop == NULL)
+		return;
+
+	for (size_t i = 0; i < EVENT_LOOP_MAX_SOURCES; i++)
+	{
+		if (loop->sources[i].fd >= 0 && loop->sources[i].is_timer)
+			close(loop->sources[i].fd);
+	}
+	close(loop->epoll_fd);
+	free(loop);
+}
+
+int event_fd_create(bool semaphore)
+{
+	return eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC | (semaphore ? EFD_SEMAPHORE : 0));
+}
+
+void event_fd_signal(int fd)
+{
+	uint64_t one = 1;
+	if (write(fd, &one, sizeof(one)) != sizeof(one))
+	{
+		/* only fails if the counter would overflow, the reader is awake already */
+	}
+}
+
+uint64_t event_fd_drain(int fd)
+{
+	uint64_t count;
+	if (read(fd, &count, sizeof(count)) != sizeof(count))
+		return 0;
+	return count;
+}
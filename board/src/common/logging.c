@@ -5,24 +5,91 @@
  *
  * This file implements logging functionality for the SnowAngel-UAV board software.
  *
+ * Formatting is deferred: logging_emit() only copies the format's address, a timestamp and the
+ * raw arguments into a lock free multi producer queue. A flusher thread formats the queued
+ * messages and hands the text to the async writer.
+ *
  * Date: October 2025
  *
  * Copyright 2025 SnowAngel-UAV
  */
 
 #include "common/logging.h"
+#include "common/async_writer.h"
+#include "common/clock.h"
 #include "time.h"
+#include <fcntl.h>
+#include <pthread.h>
 #include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #define LOG_FILE_NAME "./snow_angel_uav.log" /* located in board/build/ */
 #define TIMESTAMP_SIZE 20                    /* exactly enough for YYYY-MM-DD HH:MM:SS */
+#define LOG_LINE_SIZE 512                    /* longer messages are truncated */
+
+/* Logs reach the file within LOG_FLUSH_INTERVAL_MS and the SD card within LOG_FSYNC_INTERVAL_MS,
+   or right away on logging_sync() */
+#define LOG_BUFFER_SIZE (64 * 1024)
+#define LOG_FLUSH_INTERVAL_MS 100
+#define LOG_FSYNC_INTERVAL_MS 1000
+
+/* Messages waiting to be formatted. A message's arguments, with its strings copied, must fit
+   in LOG_ARGS_SIZE bytes, longer strings are truncated. */
+#define LOG_QUEUE_SIZE 1024 /* a power of two */
+#define LOG_ARGS_SIZE 224
+#define LOG_DRAIN_INTERVAL_USEC 10000
+
+struct log_entry
+{
+	uint64_t timestamp_usec;
+	const char *fmt;
+	uint8_t level;
+	uint16_t args_len;
+	unsigned char args[LOG_ARGS_SIZE];
+};
+
+/* Bounded multi producer queue (Vyukov): a slot is free for position pos when its sequence is
+   pos, and holds the message for position pos once its sequence is pos + 1. */
+struct log_slot
+{
+	atomic_size_t sequence;
+	struct log_entry entry;
+};
+
+/* A parsed %[flags][width][.precision][length]conversion */
+struct log_spec
+{
+	char flags[8];
+	bool width_from_arg; /* '*' */
+	int width;           /* -1 when absent */
+	bool precision_from_arg;
+	int precision; /* -1 when absent */
+	char length[3];
+	char conversion;
+};
+
+static struct async_writer *log_writer;
 
-static FILE *log_file;
+static struct log_slot log_queue[LOG_QUEUE_SIZE];
+static atomic_size_t enqueue_pos;
+static size_t dequeue_pos; /* guarded by drain_lock */
+static atomic_uint dropped_messages;
+static unsigned reported_drops; /* guarded by drain_lock */
+static pthread_mutex_t drain_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static atomic_bool accepting; /* logging_emit queues messages */
+static atomic_bool flushing;  /* the flusher thread keeps going */
+static pthread_t flush_thread;
 
 const char *logging_level_to_string(enum log_level level);
+static void *logging_flush_thread(void *arg);
+static int logging_drain();
 
 int logging_init()
 {
@@ -34,45 +101,477 @@ int logging_init()
 	char log_file_path[512]; /* Big enough for file in home */
 	snprintf(log_file_path, sizeof(log_file_path), "%s", LOG_FILE_NAME);
 
-	log_file = fopen(log_file_path, "a");
+	int fd = open(log_file_path, O_WRONLY | O_CREAT | O_APPEND, 0644);
 
-	if (log_file == NULL)
+	if (fd < 0)
 		return -2;
 
+	struct async_writer_config config = {
+	    .buffer_size = LOG_BUFFER_SIZE,
+	    .flush_interval_ms = LOG_FLUSH_INTERVAL_MS,
+	    .fsync_interval_ms = LOG_FSYNC_INTERVAL_MS,
+	};
+	log_writer = async_writer_create(fd, &config);
+
+	if (log_writer == NULL)
+	{
+		close(fd);
+		return -3;
+	}
+
+	for (size_t i = 0; i < LOG_QUEUE_SIZE; i++)
+		atomic_store_explicit(&log_queue[i].sequence, i, memory_order_relaxed);
+	atomic_store_explicit(&enqueue_pos, 0, memory_order_relaxed);
+	dequeue_pos = 0;
+
+	atomic_store(&flushing, true);
+	if (pthread_create(&flush_thread, NULL, logging_flush_thread, NULL) != 0)
+	{
+		async_writer_destroy(log_writer);
+		log_writer = NULL;
+		return -4;
+	}
+
+	atomic_store_explicit(&accepting, true, memory_order_release);
 	return 0;
 }
 
 void logging_cleanup()
 {
-	if (log_file)
-		fclose(log_file);
+	if (log_writer)
+	{
+		atomic_store_explicit(&accepting, false, memory_order_release);
+		atomic_store(&flushing, false);
+		pthread_join(flush_thread, NULL); /* drains what is left */
+
+		async_writer_destroy(log_writer);
+		log_writer = NULL;
+	}
+}
+
+void logging_sync()
+{
+	if (log_writer)
+	{
+		logging_drain();
+		async_writer_sync(log_writer);
+	}
 }
 
-void logging_write(enum log_level level, const char *fmt, ...)
+/* Parses the spec after a '%', returns where the spec ends or NULL if it is not supported */
+static const char *log_parse_spec(const char *p, struct log_spec *spec)
 {
-	if (log_file == NULL)
-		return;
+	size_t num_flags = 0;
+	while (*p && strchr("-+ #0", *p) && num_flags < sizeof(spec->flags) - 1)
+		spec->flags[num_flags++] = *p++;
+	spec->flags[num_flags] = '\0';
+
+	spec->width_from_arg = false;
+	spec->width = -1;
+	if (*p == '*')
+	{
+		spec->width_from_arg = true;
+		p++;
+	}
+	else if (*p >= '0' && *p <= '9')
+	{
+		spec->width = 0;
+		while (*p >= '0' && *p <= '9')
+			spec->width = spec->width * 10 + (*p++ - '0');
+	}
+
+	spec->precision_from_arg = false;
+	spec->precision = -1;
+	if (*p == '.')
+	{
+		p++;
+		spec->precision = 0;
+		if (*p == '*')
+		{
+			spec->precision_from_arg = true;
+			p++;
+		}
+		while (*p >= '0' && *p <= '9')
+			spec->precision = spec->precision * 10 + (*p++ - '0');
+	}
+
+	size_t length = 0;
+	while (*p && strchr("hlzjtL", *p) && length < sizeof(spec->length) - 1)
+		spec->length[length++] = *p++;
+	spec->length[length] = '\0';
+
+	spec->conversion = *p;
+	if (*p == '\0' || !strchr("diouxXcsfFeEgGaAp", *p))
+		return NULL;
+	return p + 1;
+}
+
+static bool log_put(struct log_entry *entry, const void *data, size_t len)
+{
+	if (entry->args_len + len > LOG_ARGS_SIZE)
+		return false;
+	memcpy(entry->args + entry->args_len, data, len);
+	entry->args_len += len;
+	return true;
+}
+
+/* Copies one argument of spec out of args. Integers are widened to 64 bits. */
+static bool log_capture_arg(struct log_entry *entry, const struct log_spec *spec, va_list *args)
+{
+	const char *length = spec->length;
+	bool is_long = strcmp(length, "l") == 0;
+	bool is_long_long = strcmp(length, "ll") == 0 || strcmp(length, "j") == 0;
+	bool is_size = strcmp(length, "z") == 0 || strcmp(length, "t") == 0;
 
-	const char *prefix = logging_level_to_string(level);
+	switch (spec->conversion)
+	{
+	case 'd':
+	case 'i':
+	case 'c':
+	{
+		int64_t value;
+		if (is_long)
+			value = va_arg(*args, long);
+		else if (is_long_long)
+			value = va_arg(*args, long long);
+		else if (is_size)
+			value = va_arg(*args, ptrdiff_t);
+		else if (strcmp(length, "hh") == 0)
+			value = (signed char)va_arg(*args, int);
+		else if (strcmp(length, "h") == 0)
+			value = (short)va_arg(*args, int);
+		else
+			value = va_arg(*args, int);
+		return log_put(entry, &value, sizeof(value));
+	}
+	case 'o':
+	case 'u':
+	case 'x':
+	case 'X':
+	{
+		uint64_t value;
+		if (is_long)
+			value = va_arg(*args, unsigned long);
+		else if (is_long_long)
+			value = va_arg(*args, unsigned long long);
+		else if (is_size)
+			value = va_arg(*args, size_t);
+		else if (strcmp(length, "hh") == 0)
+			value = (unsigned char)va_arg(*args, unsigned);
+		else if (strcmp(length, "h") == 0)
+			value = (unsigned short)va_arg(*args, unsigned);
+		else
+			value = va_arg(*args, unsigned);
+		return log_put(entry, &value, sizeof(value));
+	}
+	case 'p':
+	{
+		uint64_t value = (uintptr_t)va_arg(*args, void *);
+		return log_put(entry, &value, sizeof(value));
+	}
+	case 's':
+	{
+		const char *value = va_arg(*args, const char *);
+		if (value == NULL)
+			value = "(null)";
+		size_t room = LOG_ARGS_SIZE - entry->args_len;
+		if (room == 0)
+			return false;
+		size_t len = strnlen(value, room - 1);
+		log_put(entry, value, len);
+		entry->args[entry->args_len++] = '\0';
+		return true;
+	}
+	default:
+	{
+		double value =
+		    strcmp(length, "L") == 0 ? (double)va_arg(*args, long double) : va_arg(*args, double);
+		return log_put(entry, &value, sizeof(value));
+	}
+	}
+}
 
-	if (prefix == NULL)
+void logging_emit(enum log_level level, const char *fmt, ...)
+{
+	if (!atomic_load_explicit(&accepting, memory_order_acquire))
 		return;
 
-	time_t now = time(NULL);
-	struct tm *curr_time = localtime(&now);
+	/* Claim a slot */
+	struct log_slot *slot;
+	size_t pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+	while (true)
+	{
+		slot = &log_queue[pos & (LOG_QUEUE_SIZE - 1)];
+		size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+		if (diff == 0)
+		{
+			if (atomic_compare_exchange_weak_explicit(&enqueue_pos, &pos, pos + 1,
+			                                          memory_order_relaxed,
+			                                          memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0)
+		{
+			atomic_fetch_add_explicit(&dropped_messages, 1, memory_order_relaxed);
+			return; /* full */
+		}
+		else
+		{
+			pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+		}
+	}
 
-	char time_buf[TIMESTAMP_SIZE];
-	strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", curr_time);
+	struct log_entry *entry = &slot->entry;
+	entry->timestamp_usec = clock_realtime_usec();
+	entry->fmt = fmt;
+	entry->level = (uint8_t)level;
+	entry->args_len = 0;
 
 	va_list args;
 	va_start(args, fmt);
+	for (const char *p = fmt; (p = strchr(p, '%')) != NULL;)
+	{
+		if (p[1] == '%')
+		{
+			p += 2;
+			continue;
+		}
 
-	fprintf(log_file, "[%s][%s]: ", time_buf, prefix);
-	vfprintf(log_file, fmt, args);
-	fprintf(log_file, "\n");
+		struct log_spec spec;
+		p = log_parse_spec(p + 1, &spec);
+		if (p == NULL)
+			break;
 
+		int star;
+		if (spec.width_from_arg)
+		{
+			star = va_arg(args, int);
+			if (!log_put(entry, &star, sizeof(star)))
+				break;
+		}
+		if (spec.precision_from_arg)
+		{
+			star = va_arg(args, int);
+			if (!log_put(entry, &star, sizeof(star)))
+				break;
+		}
+		if (!log_capture_arg(entry, &spec, &args))
+			break; /* out of room, the rest of the message is cut off */
+	}
 	va_end(args);
-	fflush(log_file); /* make sure we don't lose logs if program crashes */
+
+	atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+}
+
+static bool log_take(const struct log_entry *entry, size_t *offset, void *data, size_t len)
+{
+	if (*offset + len > entry->args_len)
+		return false;
+	memcpy(data, entry->args + *offset, len);
+	*offset += len;
+	return true;
+}
+
+/* Formats the message of entry after a "[timestamp][LEVEL]: " prefix, returns its length */
+static size_t log_render(const struct log_entry *entry, char *line, size_t size)
+{
+	static time_t cached_second = -1;
+	static char time_buf[TIMESTAMP_SIZE];
+
+	/* Messages come in bursts within the same second, only reformat the time when it moves */
+	time_t second = (time_t)(entry->timestamp_usec / 1000000);
+	if (second != cached_second)
+	{
+		struct tm curr_time;
+		localtime_r(&second, &curr_time);
+		strftime(time_buf, sizeof(time_buf), "%Y-%m-%d %H:%M:%S", &curr_time);
+		cached_second = second;
+	}
+
+	const char *prefix = logging_level_to_string((enum log_level)entry->level);
+	size_t len = (size_t)snprintf(line, size, "[%s][%s]: ", time_buf, prefix ? prefix : "?");
+
+	size_t offset = 0;
+	bool cut_off = false; /* the message did not fit, in the queue or in line */
+	const char *p = entry->fmt;
+	while (*p && len < size - 1)
+	{
+		if (*p != '%')
+		{
+			line[len++] = *p++;
+			continue;
+		}
+		if (p[1] == '%')
+		{
+			line[len++] = '%';
+			p += 2;
+			continue;
+		}
+
+		struct log_spec spec;
+		const char *end = log_parse_spec(p + 1, &spec);
+		if (end == NULL)
+			break;
+		p = end;
+
+		int width = spec.width, precision = spec.precision;
+		if ((spec.width_from_arg && !log_take(entry, &offset, &width, sizeof(width))) ||
+		    (spec.precision_from_arg && !log_take(entry, &offset, &precision, sizeof(precision))))
+		{
+			cut_off = true;
+			break;
+		}
+
+		/* Rebuild the spec with literal width and precision and a 64 bit integer length */
+		char format[32];
+		int n = snprintf(format, sizeof(format), "%%%s%s", spec.flags, width < 0 ? "-" : "");
+		if (spec.width_from_arg || spec.width >= 0)
+			n += snprintf(format + n, sizeof(format) - n, "%d", width < 0 ? -width : width);
+		if (precision >= 0)
+			n += snprintf(format + n, sizeof(format) - n, ".%d", precision);
+
+		int written = -1;
+		switch (spec.conversion)
+		{
+		case 'd':
+		case 'i':
+		{
+			int64_t value;
+			if (!log_take(entry, &offset, &value, sizeof(value)))
+				break;
+			snprintf(format + n, sizeof(format) - n, "ll%c", spec.conversion);
+			written = snprintf(line + len, size - len, format, (long long)value);
+			break;
+		}
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+		{
+			uint64_t value;
+			if (!log_take(entry, &offset, &value, sizeof(value)))
+				break;
+			snprintf(format + n, sizeof(format) - n, "ll%c", spec.conversion);
+			written = snprintf(line + len, size - len, format, (unsigned long long)value);
+			break;
+		}
+		case 'c':
+		{
+			int64_t value;
+			if (!log_take(entry, &offset, &value, sizeof(value)))
+				break;
+			snprintf(format + n, sizeof(format) - n, "c");
+			written = snprintf(line + len, size - len, format, (int)value);
+			break;
+		}
+		case 'p':
+		{
+			uint64_t value;
+			if (!log_take(entry, &offset, &value, sizeof(value)))
+				break;
+			snprintf(format + n, sizeof(format) - n, "p");
+			written = snprintf(line + len, size - len, format, (void *)(uintptr_t)value);
+			break;
+		}
+		case 's':
+		{
+			if (offset >= entry->args_len)
+				break;
+			const char *value = (const char *)entry->args + offset;
+			offset += strlen(value) + 1;
+			snprintf(format + n, sizeof(format) - n, "s");
+			written = snprintf(line + len, size - len, format, value);
+			break;
+		}
+		default:
+		{
+			double value;
+			if (!log_take(entry, &offset, &value, sizeof(value)))
+				break;
+			snprintf(format + n, sizeof(format) - n, "%c", spec.conversion);
+			written = snprintf(line + len, size - len, format, value);
+			break;
+		}
+		}
+
+		if (written < 0)
+		{
+			cut_off = true; /* the arguments were cut off when the message was queued */
+			break;
+		}
+		len += (size_t)written;
+	}
+
+	if (*p || cut_off)
+	{
+		if (len > size - 5)
+			len = size - 5;
+		memcpy(line + len, "...", 3);
+		len += 3;
+	}
+
+	if (len > size - 2)
+		len = size - 2; /* truncated, keep room for the newline */
+	line[len++] = '\n';
+	return len;
+}
+
+/* Formats and writes every queued message, returns how many there were */
+static int logging_drain()
+{
+	char line[LOG_LINE_SIZE];
+	int drained = 0;
+
+	pthread_mutex_lock(&drain_lock);
+	while (true)
+	{
+		struct log_slot *slot = &log_queue[dequeue_pos & (LOG_QUEUE_SIZE - 1)];
+		size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+		if (sequence != dequeue_pos + 1)
+			break; /* empty, or the next message is still being written */
+
+		size_t len = log_render(&slot->entry, line, sizeof(line));
+		atomic_store_explicit(&slot->sequence, dequeue_pos + LOG_QUEUE_SIZE, memory_order_release);
+		dequeue_pos++;
+
+		/* Storage I/O happens on the writer thread, at most LOG_FLUSH_INTERVAL_MS later */
+		async_writer_write(log_writer, line, len);
+		drained++;
+	}
+
+	unsigned dropped = atomic_load_explicit(&dropped_messages, memory_order_relaxed);
+	if (dropped != reported_drops)
+	{
+		struct log_entry entry;
+		uint64_t count = dropped - reported_drops;
+		entry.timestamp_usec = clock_realtime_usec();
+		entry.fmt = "Log queue full, dropped %u messages";
+		entry.level = LOG_WARN;
+		entry.args_len = 0;
+		log_put(&entry, &count, sizeof(count));
+
+		size_t len = log_render(&entry, line, sizeof(line));
+		async_writer_write(log_writer, line, len);
+		reported_drops = dropped;
+	}
+	pthread_mutex_unlock(&drain_lock);
+
+	return drained;
+}
+
+static void *logging_flush_thread(void *arg)
+{
+	(void)arg;
+
+	while (atomic_load(&flushing))
+	{
+		if (logging_drain() == 0)
+			usleep(LOG_DRAIN_INTERVAL_USEC);
+	}
+
+	logging_drain();
+	return NULL;
 }
 
 const char *logging_level_to_string(enum log_level level)
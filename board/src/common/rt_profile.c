@@ -0,0 +1,255 @@
+/**
+ *
+ * Name: rt_profile.c
+ * Author: Hubert Dang
+ *
+ * This file implements the real-time profile described in rt_profile.h
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#define _GNU_SOURCE /* cpu_set_t and sched_setaffinity */
+
+#include "common/rt_profile.h"
+#include "common/logging.h"
+#include <dirent.h>
+#include <errno.h>
+#include <linux/serial.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* The readers must never wait for the FSM, the FSM only for them */
+#define RT_PRIORITY_RADAR 80
+#define RT_PRIORITY_GPS 70
+#define RT_PRIORITY_FSM 60
+
+#define RT_PREFAULT_STACK_SIZE (256 * 1024) /* of the main thread, touched while locking */
+#define RT_PAGE_SIZE 4096                   /* the smallest page the stack can fault on */
+
+static const char *const ROLE_NAMES[RT_THREAD_ROLES] = {"radar", "GPS", "FSM", "background"};
+
+/* Written by rt_profile_apply before any thread that reads them is created */
+static struct rt_profile applied;
+static cpu_set_t housekeeping_cpus; /* the cores the process may use, but the radar reader's */
+
+static atomic_uint warned_roles; /* one bit per role, so a thread started per stop warns once */
+
+static bool env_int(const char *name, int *value)
+{
+	const char *text = getenv(name);
+	if (text == NULL || *text == '\0')
+		return false;
+
+	char *end;
+	long parsed = strtol(text, &end, 10);
+	if (*end != '\0')
+	{
+		logging_write(LOG_WARN, "Ignoring %s=%s, not a number", name, text);
+		return false;
+	}
+	*value = (int)parsed;
+	return true;
+}
+
+/* Faults the stack in now, mlockall only locks the pages that are already there */
+static void prefault_stack()
+{
+	volatile char stack[RT_PREFAULT_STACK_SIZE];
+	for (size_t i = 0; i < sizeof(stack); i += RT_PAGE_SIZE)
+		stack[i] = 0;
+}
+
+/* Moves the threads started before the profile, e.g. logging's, off the radar reader's core */
+static int8_t pin_existing_threads()
+{
+	DIR *tasks = opendir("/proc/self/task");
+	if (tasks == NULL)
+		return -1;
+
+	pid_t self = (pid_t)syscall(SYS_gettid);
+	int8_t rc = 0;
+	struct dirent *task;
+	while ((task = readdir(tasks)) != NULL)
+	{
+		pid_t tid = (pid_t)strtol(task->d_name, NULL, 10);
+		if (tid <= 0 || tid == self)
+			continue; /* ".", ".." and the caller, which enters its own role */
+		if (sched_setaffinity(tid, sizeof(housekeeping_cpus), &housekeeping_cpus) != 0 &&
+		    errno != ESRCH)
+			rc = -2;
+	}
+	closedir(tasks);
+	return rc;
+}
+
+static int8_t lock_memory()
+{
+	if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+	{
+		logging_write(LOG_WARN, "Real-time profile: mlockall failed (%s)", strerror(errno));
+		return -1;
+	}
+
+#ifdef __GLIBC__
+	/* freed memory stays mapped, so it stays locked and reusing it cannot fault */
+	mallopt(M_TRIM_THRESHOLD, -1);
+	mallopt(M_MMAP_MAX, 0);
+#endif
+	prefault_stack();
+	return 0;
+}
+
+void rt_profile_load(struct rt_profile *profile)
+{
+	memset(profile, 0, sizeof(*profile));
+#ifdef RT_PROFILE
+	profile->enabled = true;
+#endif
+	profile->lock_memory = true;
+	profile->low_latency_serial = true;
+	profile->radar_cpu = RT_PROFILE_RADAR_CPU;
+	profile->priority[RT_THREAD_RADAR] = RT_PRIORITY_RADAR;
+	profile->priority[RT_THREAD_GPS] = RT_PRIORITY_GPS;
+	profile->priority[RT_THREAD_FSM] = RT_PRIORITY_FSM;
+	profile->priority[RT_THREAD_BACKGROUND] = 0;
+
+	int value;
+	if (env_int("SNOW_ANGEL_RT", &value))
+		profile->enabled = value != 0;
+	if (env_int("SNOW_ANGEL_RT_RADAR_CPU", &value))
+		profile->radar_cpu = value;
+}
+
+int rt_profile_apply(const struct rt_profile *profile)
+{
+	if (profile == NULL)
+		return -1;
+	if (!profile->enabled)
+	{
+		logging_write(LOG_INFO, "Real-time profile off");
+		return 0;
+	}
+
+	int failed = 0;
+	if (profile->lock_memory && lock_memory() != 0)
+		failed++;
+
+	applied = *profile;
+	if (sched_getaffinity(0, sizeof(housekeeping_cpus), &housekeeping_cpus) != 0)
+	{
+		logging_write(LOG_WARN, "Real-time profile: sched_getaffinity failed (%s)",
+		              strerror(errno));
+		applied.radar_cpu = -1;
+		failed++;
+	}
+	else if (applied.radar_cpu >= 0)
+	{
+		/* The radar's core has to be online, but not one the process inherited: isolcpus=
+		   takes it out of every process' mask. Some other core has to be left for the rest. */
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		cpu_set_t others = housekeeping_cpus;
+		if (applied.radar_cpu < CPU_SETSIZE)
+			CPU_CLR(applied.radar_cpu, &others);
+		if (applied.radar_cpu >= CPU_SETSIZE || applied.radar_cpu >= online ||
+		    CPU_COUNT(&others) == 0)
+		{
+			logging_write(LOG_WARN, "Real-time profile: core %d is not available, radar reader "
+			              "unpinned", applied.radar_cpu);
+			applied.radar_cpu = -1;
+			failed++;
+		}
+		else
+		{
+			housekeeping_cpus = others;
+			if (pin_existing_threads() != 0)
+			{
+				logging_write(LOG_WARN, "Real-time profile: could not move the running threads "
+				              "off core %d", applied.radar_cpu);
+				failed++;
+			}
+		}
+	}
+
+	if (rt_profile_enter(RT_THREAD_FSM) != 0)
+		failed++;
+
+	logging_write(LOG_INFO, "Real-time profile on: memory %s, radar reader on core %d, "
+	              "SCHED_FIFO radar %d, GPS %d, FSM %d",
+	              profile->lock_memory ? "locked" : "unlocked", applied.radar_cpu,
+	              applied.priority[RT_THREAD_RADAR], applied.priority[RT_THREAD_GPS],
+	              applied.priority[RT_THREAD_FSM]);
+	return -failed;
+}
+
+int rt_profile_enter(enum rt_thread_role role)
+{
+	if ((unsigned)role >= RT_THREAD_ROLES)
+		return -1;
+	if (!applied.enabled)
+		return 0;
+
+	cpu_set_t cpus = housekeeping_cpus;
+	if (role == RT_THREAD_RADAR && applied.radar_cpu >= 0)
+	{
+		CPU_ZERO(&cpus);
+		CPU_SET(applied.radar_cpu, &cpus);
+	}
+	int affinity_rc = sched_setaffinity(0, sizeof(cpus), &cpus) != 0 ? errno : 0;
+
+	struct sched_param param = {0};
+	param.sched_priority = applied.priority[role];
+	int policy = param.sched_priority > 0 ? SCHED_FIFO : SCHED_OTHER;
+	int sched_rc = pthread_setschedparam(pthread_self(), policy, &param);
+
+	if (affinity_rc == 0 && sched_rc == 0)
+		return 0;
+
+	unsigned bit = 1u << role;
+	if ((atomic_fetch_or(&warned_roles, bit) & bit) == 0)
+	{
+		if (affinity_rc != 0)
+			logging_write(LOG_WARN, "Real-time profile: could not set the %s thread's cores (%s)",
+			              ROLE_NAMES[role], strerror(affinity_rc));
+		if (sched_rc != 0)
+			logging_write(LOG_WARN, "Real-time profile: could not set the %s thread's priority "
+			              "to %d (%s)", ROLE_NAMES[role], param.sched_priority,
+			              strerror(sched_rc));
+	}
+	return -1;
+}
+
+int rt_profile_serial_low_latency(int fd)
+{
+	if (!applied.enabled || !applied.low_latency_serial)
+		return 0;
+
+	struct serial_struct serial;
+	if (ioctl(fd, TIOCGSERIAL, &serial) != 0)
+		return -1;
+	serial.flags |= ASYNC_LOW_LATENCY;
+	if (ioctl(fd, TIOCSSERIAL, &serial) != 0)
+		return -2;
+	return 0;
+}
+
+int rt_profile_serial_overruns(int fd, uint32_t *overruns)
+{
+	if (overruns == NULL)
+		return -1;
+
+	struct serial_icounter_struct count;
+	if (ioctl(fd, TIOCGICOUNT, &count) != 0)
+		return -2;
+	*overruns = (uint32_t)(count.overrun + count.buf_overrun);
+	return 0;
+}
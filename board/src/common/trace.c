@@ -0,0 +1,257 @@
+/**
+ *
+ * Name: trace.c
+ * Author: Hubert Dang
+ *
+ * This file implements the latency tracing described in trace.h
+ *
+ * Each recording thread claims one of TRACE_MAX_THREADS single producer rings the first time
+ * it records, and gives it back when it exits. The collector is the only consumer.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "common/trace.h"
+#include "common/logging.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+/* Histogram buckets: values below 8 ns get their own bucket, larger ones get 8 buckets per
+   power of two, so a bucket is at most 1/8th of its value wide. */
+#define TRACE_SUB_BUCKET_BITS 3
+#define TRACE_SUB_BUCKETS (1 << TRACE_SUB_BUCKET_BITS)
+#define TRACE_NUM_BUCKETS ((32 - TRACE_SUB_BUCKET_BITS + 1) * TRACE_SUB_BUCKETS)
+
+enum trace_ring_state
+{
+	TRACE_RING_FREE,
+	TRACE_RING_OWNED,   /* a live thread records into it */
+	TRACE_RING_RETIRED, /* its thread exited, freed once drained */
+};
+
+struct trace_event
+{
+	uint32_t point;
+	uint32_t duration_nsec;
+};
+
+struct trace_ring
+{
+	atomic_int state;
+	atomic_uint head; /* written by the owning thread */
+	atomic_uint tail; /* written by the collector */
+	struct trace_event events[TRACE_RING_SIZE];
+};
+
+struct trace_histogram
+{
+	uint64_t count;
+	uint64_t total_nsec;
+	uint32_t max_nsec;
+	uint32_t buckets[TRACE_NUM_BUCKETS];
+};
+
+static struct trace_ring rings[TRACE_MAX_THREADS];
+static _Thread_local struct trace_ring *thread_ring;
+static pthread_key_t ring_key;
+static pthread_once_t ring_key_once = PTHREAD_ONCE_INIT;
+
+static atomic_ullong dropped[TRACE_NUM_POINTS];
+
+static pthread_mutex_t collect_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct trace_histogram histograms[TRACE_NUM_POINTS]; /* guarded by collect_lock */
+
+static const char *const TRACE_POINT_NAMES[TRACE_NUM_POINTS] = {
+    "radar_serial_read", "radar_parse",    "radar_fft",       "radar_read_frame",
+    "gps_parse",         "gps_read",       "temp_read",       "persist_record",
+    "ice_estimate",      "fsm_gps_fix",    "fsm_stabilized",  "fsm_radar_frame",
+    "fsm_finish_stop",
+};
+
+static void trace_release_ring(void *ring)
+{
+	atomic_store_explicit(&((struct trace_ring *)ring)->state, TRACE_RING_RETIRED,
+	                      memory_order_release);
+}
+
+static void trace_create_ring_key()
+{
+	pthread_key_create(&ring_key, trace_release_ring);
+}
+
+static struct trace_ring *trace_claim_ring()
+{
+	pthread_once(&ring_key_once, trace_create_ring_key);
+
+	for (size_t i = 0; i < TRACE_MAX_THREADS; i++)
+	{
+		int expected = TRACE_RING_FREE;
+		if (atomic_compare_exchange_strong(&rings[i].state, &expected, TRACE_RING_OWNED))
+		{
+			thread_ring = &rings[i];
+			pthread_setspecific(ring_key, thread_ring);
+			return thread_ring;
+		}
+	}
+
+	return NULL; /* raise TRACE_MAX_THREADS */
+}
+
+void trace_record(enum trace_point point, uint64_t duration_nsec)
+{
+	if ((unsigned)point >= TRACE_NUM_POINTS)
+		return;
+
+	struct trace_ring *ring = thread_ring ? thread_ring : trace_claim_ring();
+	if (ring == NULL)
+	{
+		atomic_fetch_add_explicit(&dropped[point], 1, memory_order_relaxed);
+		return;
+	}
+
+	unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	unsigned tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	if (head - tail == TRACE_RING_SIZE)
+	{
+		atomic_fetch_add_explicit(&dropped[point], 1, memory_order_relaxed);
+		return;
+	}
+
+	struct trace_event *event = &ring->events[head & (TRACE_RING_SIZE - 1)];
+	event->point = point;
+	event->duration_nsec = duration_nsec > UINT32_MAX ? UINT32_MAX : (uint32_t)duration_nsec;
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+static unsigned trace_bucket(uint32_t value)
+{
+	if (value < TRACE_SUB_BUCKETS)
+		return value;
+
+	unsigned exponent = 31 - __builtin_clz(value); /* at least TRACE_SUB_BUCKET_BITS */
+	unsigned mantissa = (value >> (exponent - TRACE_SUB_BUCKET_BITS)) & (TRACE_SUB_BUCKETS - 1);
+	return (exponent - TRACE_SUB_BUCKET_BITS + 1) * TRACE_SUB_BUCKETS + mantissa;
+}
+
+/* The largest value that lands in bucket */
+static uint32_t trace_bucket_upper(unsigned bucket)
+{
+	if (bucket < TRACE_SUB_BUCKETS)
+		return bucket;
+
+	unsigned exponent = bucket / TRACE_SUB_BUCKETS + TRACE_SUB_BUCKET_BITS - 1;
+	unsigned mantissa = bucket % TRACE_SUB_BUCKETS;
+	uint64_t width = 1ULL << (exponent - TRACE_SUB_BUCKET_BITS);
+	uint64_t lower = (uint64_t)(TRACE_SUB_BUCKETS + mantissa) * width;
+	uint64_t upper = lower + width - 1;
+	return upper > UINT32_MAX ? UINT32_MAX : (uint32_t)upper;
+}
+
+void trace_collect()
+{
+	pthread_mutex_lock(&collect_lock);
+
+	for (size_t i = 0; i < TRACE_MAX_THREADS; i++)
+	{
+		struct trace_ring *ring = &rings[i];
+		int state = atomic_load_explicit(&ring->state, memory_order_acquire);
+		if (state == TRACE_RING_FREE)
+			continue;
+
+		unsigned head = atomic_load_explicit(&ring->head, memory_order_acquire);
+		unsigned tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+		for (; tail != head; tail++)
+		{
+			const struct trace_event *event = &ring->events[tail & (TRACE_RING_SIZE - 1)];
+			struct trace_histogram *histogram = &histograms[event->point];
+			histogram->count++;
+			histogram->total_nsec += event->duration_nsec;
+			if (event->duration_nsec > histogram->max_nsec)
+				histogram->max_nsec = event->duration_nsec;
+			histogram->buckets[trace_bucket(event->duration_nsec)]++;
+		}
+		atomic_store_explicit(&ring->tail, tail, memory_order_release);
+
+		if (state == TRACE_RING_RETIRED)
+		{
+			/* its thread is gone, nothing else touches the ring until it is claimed again */
+			atomic_store_explicit(&ring->head, 0, memory_order_relaxed);
+			atomic_store_explicit(&ring->tail, 0, memory_order_relaxed);
+			atomic_store_explicit(&ring->state, TRACE_RING_FREE, memory_order_release);
+		}
+	}
+
+	pthread_mutex_unlock(&collect_lock);
+}
+
+static uint32_t trace_percentile(const struct trace_histogram *histogram, unsigned percent)
+{
+	uint64_t rank = (histogram->count * percent + 99) / 100; /* 1 based, rounded up */
+	uint64_t seen = 0;
+	for (unsigned bucket = 0; bucket < TRACE_NUM_BUCKETS; bucket++)
+	{
+		seen += histogram->buckets[bucket];
+		if (seen >= rank)
+		{
+			uint32_t upper = trace_bucket_upper(bucket);
+			return upper < histogram->max_nsec ? upper : histogram->max_nsec;
+		}
+	}
+	return histogram->max_nsec;
+}
+
+int trace_get_stats(enum trace_point point, struct trace_stats *stats)
+{
+	if ((unsigned)point >= TRACE_NUM_POINTS || stats == NULL)
+		return -1;
+
+	pthread_mutex_lock(&collect_lock);
+	const struct trace_histogram *histogram = &histograms[point];
+	stats->count = histogram->count;
+	stats->dropped = atomic_load_explicit(&dropped[point], memory_order_relaxed);
+	stats->max_nsec = histogram->max_nsec;
+	if (histogram->count > 0)
+	{
+		stats->p50_nsec = trace_percentile(histogram, 50);
+		stats->p99_nsec = trace_percentile(histogram, 99);
+		stats->mean_nsec = (uint32_t)(histogram->total_nsec / histogram->count);
+	}
+	else
+	{
+		stats->p50_nsec = 0;
+		stats->p99_nsec = 0;
+		stats->mean_nsec = 0;
+	}
+	pthread_mutex_unlock(&collect_lock);
+	return 0;
+}
+
+void trace_log_summary()
+{
+	trace_collect();
+
+	for (int point = 0; point < TRACE_NUM_POINTS; point++)
+	{
+		struct trace_stats stats;
+		trace_get_stats((enum trace_point)point, &stats);
+		if (stats.count == 0 && stats.dropped == 0)
+			continue;
+
+		logging_write(LOG_INFO,
+		              "Trace %-17s n=%llu p50=%.3f ms p99=%.3f ms max=%.3f ms mean=%.3f ms "
+		              "dropped=%llu",
+		              trace_point_name((enum trace_point)point), (unsigned long long)stats.count,
+		              stats.p50_nsec / 1e6, stats.p99_nsec / 1e6, stats.max_nsec / 1e6,
+		              stats.mean_nsec / 1e6, (unsigned long long)stats.dropped);
+	}
+}
+
+const char *trace_point_name(enum trace_point point)
+{
+	if ((unsigned)point >= TRACE_NUM_POINTS)
+		return "invalid";
+	return TRACE_POINT_NAMES[point];
+}
@@ -0,0 +1,195 @@
+/**
+ *
+ * Name: telemetry.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the functions declared in telemetry.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "comms/telemetry.hpp"
+#include "common/event_loop.h"
+#include "common/rt_profile.h"
+#include <arpa/inet.h>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+TELEMETRY_PUBLISHER::TELEMETRY_PUBLISHER()
+    : sock(-1), destination{}, wake_fd(-1), running(false), published(0), last_sent(0),
+      datagram(0), sent(0), dropped(0), datagrams(0), send_errors(0)
+{
+}
+
+/**
+ * Opens a UDP socket to the ground station and starts the sender thread. Broadcast addresses
+ * work too, for a ground station whose address is not known ahead of time.
+ * @param address IPv4 address of the ground station, e.g. "192.168.4.255"
+ * @param port UDP port the ground station listens on
+ *
+ * @return 0 on success, -X on failure with failure code.
+ */
+int8_t TELEMETRY_PUBLISHER::open(const char *address, uint16_t port)
+{
+	if (is_open())
+		return -1;
+
+	destination.sin_family = AF_INET;
+	destination.sin_port = htons(port);
+	if (address == nullptr || inet_pton(AF_INET, address, &destination.sin_addr) != 1)
+		return -2;
+
+	sock = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if (sock < 0)
+		return -3;
+	int broadcast = 1;
+	setsockopt(sock, SOL_SOCKET, SO_BROADCAST, &broadcast, sizeof(broadcast));
+
+	wake_fd = event_fd_create(false);
+	if (wake_fd < 0)
+	{
+		::close(sock);
+		sock = -1;
+		return -4;
+	}
+
+	running.store(true, std::memory_order_release);
+	sender = std::thread(&TELEMETRY_PUBLISHER::send_loop, this);
+	return 0;
+}
+
+/**
+ * Queues a stop's report for the sender thread and returns right away. If the sender has
+ * fallen TELEMETRY_QUEUE_DEPTH reports behind, the oldest unsent report is overwritten.
+ * Only one thread may publish.
+ * @param report The report, its sequence is filled in here
+ *
+ * @return 0 on success, -X on failure with failure code.
+ */
+int8_t TELEMETRY_PUBLISHER::publish(const telemetry_stop_report_t *report)
+{
+	if (!is_open())
+		return -1;
+	if (report == nullptr)
+		return -2;
+
+	telemetry_stop_report_t queued = *report;
+	queued.sequence = published.load(std::memory_order_relaxed) + 1;
+	reports[queued.sequence % TELEMETRY_QUEUE_DEPTH].store(queued);
+	published.store(queued.sequence, std::memory_order_release);
+	event_fd_signal(wake_fd);
+	return 0;
+}
+
+/**
+ * Takes a snapshot of the downlink's counters, from any thread.
+ */
+void TELEMETRY_PUBLISHER::get_stats(telemetry_stats_t *stats) const
+{
+	stats->published = published.load(std::memory_order_relaxed);
+	stats->sent = sent.load(std::memory_order_relaxed);
+	stats->dropped = dropped.load(std::memory_order_relaxed);
+	stats->datagrams = datagrams.load(std::memory_order_relaxed);
+	stats->send_errors = send_errors.load(std::memory_order_relaxed);
+}
+
+/**
+ * Sends whatever is still queued, then stops the sender thread and closes the socket.
+ */
+void TELEMETRY_PUBLISHER::close()
+{
+	if (!is_open())
+		return;
+
+	running.store(false, std::memory_order_release);
+	event_fd_signal(wake_fd);
+	if (sender.joinable())
+		sender.join();
+
+	::close(wake_fd);
+	::close(sock);
+	wake_fd = -1;
+	sock = -1;
+}
+
+bool TELEMETRY_PUBLISHER::is_open() const
+{
+	return sock >= 0;
+}
+
+TELEMETRY_PUBLISHER::~TELEMETRY_PUBLISHER()
+{
+	close();
+}
+
+/**
+ * Body of the sender thread. Sleeps until something is published and sends it.
+ */
+void TELEMETRY_PUBLISHER::send_loop()
+{
+	rt_profile_enter(RT_THREAD_BACKGROUND); // a late report only costs the ground a delay
+	struct pollfd wake = {wake_fd, POLLIN, 0};
+	while (running.load(std::memory_order_acquire))
+	{
+		if (poll(&wake, 1, -1) < 0)
+			continue; // interrupted
+		event_fd_drain(wake_fd);
+		send_pending();
+	}
+	send_pending(); // published right before close()
+}
+
+/**
+ * Sends every report published since the last call, as few datagrams as it takes. Reports
+ * overwritten before the sender got to them are counted as dropped.
+ */
+void TELEMETRY_PUBLISHER::send_pending()
+{
+	uint32_t newest = published.load(std::memory_order_acquire);
+	if (newest - last_sent > TELEMETRY_QUEUE_DEPTH)
+	{
+		dropped.fetch_add(newest - last_sent - TELEMETRY_QUEUE_DEPTH, std::memory_order_relaxed);
+		last_sent = newest - TELEMETRY_QUEUE_DEPTH;
+	}
+
+	while (last_sent != newest)
+	{
+		telemetry_header_t header = {};
+		telemetry_stop_report_t *batch =
+		    reinterpret_cast<telemetry_stop_report_t *>(buffer + sizeof(header));
+		uint16_t count = 0;
+		for (; last_sent != newest && count < TELEMETRY_MAX_REPORTS_PER_DATAGRAM; last_sent++)
+		{
+			// a slot the publisher lapped while we copied it holds a newer report
+			uint32_t sequence = last_sent + 1;
+			if (reports[sequence % TELEMETRY_QUEUE_DEPTH].load(&batch[count]) &&
+			    batch[count].sequence == sequence)
+				count++;
+			else
+				dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+		if (count == 0)
+			break;
+
+		header.magic = TELEMETRY_MAGIC;
+		header.version = TELEMETRY_VERSION;
+		header.num_reports = count;
+		header.datagram = ++datagram;
+		header.dropped_reports = dropped.load(std::memory_order_relaxed);
+		memcpy(buffer, &header, sizeof(header));
+
+		size_t size = sizeof(header) + count * sizeof(telemetry_stop_report_t);
+		ssize_t written = sendto(sock, buffer, size, 0,
+		                         reinterpret_cast<const struct sockaddr *>(&destination),
+		                         sizeof(destination));
+		if (written == static_cast<ssize_t>(size))
+			sent.fetch_add(count, std::memory_order_relaxed);
+		else
+			send_errors.fetch_add(1, std::memory_order_relaxed);
+		datagrams.fetch_add(1, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,225 @@
+/**
+ *
+ * Name: ice_thickness.cpp
+ * Author: Karran Dhillon
+ *
+ * This file implements the functions declared in ice_thickness.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "dsp/ice_thickness.hpp"
+#include "bsp/ops_fmcw.hpp" // chirp configuration the radar is set up with
+#include <algorithm>
+#include <cmath>
+
+//----------------------------------------------------------------
+// Range axis, identical to OPS241B.range_axis in scripts/ops_serial.py. Spacing between
+// reflections is reported in air, the same as the offline script.
+constexpr double SPEED_OF_LIGHT_M_PER_S = 3e8;
+constexpr double FFT_FULL_SIZE = 2 * FMCW_RADAR_FFT_SIZE; // bins are the upper half only
+constexpr double FFT_BIN_SPACING_HZ = (FMCW_RADAR_FS_KHZ * 1000.0) / FFT_FULL_SIZE;
+constexpr double METERS_PER_HZ = SPEED_OF_LIGHT_M_PER_S / (2 * FMCW_RADAR_SLOPE);
+constexpr double METERS_PER_BIN = FFT_BIN_SPACING_HZ * METERS_PER_HZ;
+
+// Only reflections inside this range gate are considered
+constexpr double RANGE_GATE_MIN_M = 0.1;
+constexpr double RANGE_GATE_MAX_M = 1.0;
+constexpr size_t RANGE_GATE_FIRST_BIN = static_cast<size_t>(RANGE_GATE_MIN_M / METERS_PER_BIN) + 1;
+constexpr size_t RANGE_GATE_END_BIN = static_cast<size_t>(RANGE_GATE_MAX_M / METERS_PER_BIN) + 1;
+static_assert(RANGE_GATE_FIRST_BIN < RANGE_GATE_END_BIN &&
+                  RANGE_GATE_END_BIN <= FMCW_RADAR_FFT_SIZE,
+              "range gate does not fit in the FFT");
+
+// Peak detection parameters, same as the scipy find_peaks() call in scripts/ops_serial.py
+constexpr double MIN_PROMINENCE_FRACTION = 0.003; // of the largest magnitude in the spectrum
+constexpr size_t MIN_PEAK_DISTANCE_BINS = 2;      // about 3.7 cm
+
+constexpr size_t MAX_PEAKS = FMCW_RADAR_FFT_SIZE / 2 + 1; // of any spectrum the radar makes
+
+// The zoomed spectrum of a frame computed on board covers the whole gate
+static_assert(FMCW_RADAR_ZOOM_START_M <= RANGE_GATE_MIN_M &&
+                  FMCW_RADAR_ZOOM_END_M >= RANGE_GATE_MAX_M,
+              "zoom does not cover the range gate");
+
+// Where the range gate falls in a spectrum
+struct range_axis
+{
+	double start_m;        // range of bin 0
+	double meters_per_bin; // range between neighbouring bins
+	size_t first_bin;      // first bin inside the gate
+	size_t end_bin;        // one past the last bin inside the gate
+	size_t min_peak_distance;
+};
+
+constexpr range_axis FFT_AXIS = {0.0, METERS_PER_BIN, RANGE_GATE_FIRST_BIN, RANGE_GATE_END_BIN,
+                                 MIN_PEAK_DISTANCE_BINS};
+
+float ice_thickness_bin_to_range_m(float bin)
+{
+	return static_cast<float>(bin * METERS_PER_BIN);
+}
+
+/**
+ * Computes how far a peak stands out from its neighbourhood, the same way scipy does: the
+ * lowest point on each side before reaching a higher sample (or the edge of the gate), and
+ * the peak's height above the higher of those two.
+ */
+template <typename T>
+static float peak_prominence(const T *bins, size_t peak, const range_axis &axis)
+{
+	float height = static_cast<float>(bins[peak]);
+
+	float left_min = height;
+	for (size_t i = peak; i-- > axis.first_bin;)
+	{
+		if (bins[i] > bins[peak])
+			break;
+		left_min = std::min(left_min, static_cast<float>(bins[i]));
+	}
+
+	float right_min = height;
+	for (size_t i = peak + 1; i < axis.end_bin; i++)
+	{
+		if (bins[i] > bins[peak])
+			break;
+		right_min = std::min(right_min, static_cast<float>(bins[i]));
+	}
+
+	return height - std::max(left_min, right_min);
+}
+
+/**
+ * Refines a peak to sub-bin accuracy by fitting a parabola through it and its neighbours.
+ */
+template <typename T>
+static ice_peak_t refine_peak(const T *bins, size_t peak, float prominence, const range_axis &axis)
+{
+	float a = static_cast<float>(bins[peak - 1]);
+	float b = static_cast<float>(bins[peak]);
+	float c = static_cast<float>(bins[peak + 1]);
+
+	float offset = 0.0f;
+	float denominator = a - 2 * b + c;
+	if (denominator != 0.0f)
+		offset = std::clamp(0.5f * (a - c) / denominator, -0.5f, 0.5f);
+
+	ice_peak_t refined;
+	refined.bin = static_cast<float>(peak) + offset;
+	refined.range_m = static_cast<float>(axis.start_m + refined.bin * axis.meters_per_bin);
+	refined.magnitude = b - 0.25f * (a - c) * offset;
+	refined.prominence = prominence;
+	return refined;
+}
+
+template <typename T>
+static int8_t find_ice_peaks(const T *bins, size_t num_bins, const range_axis &axis,
+                             ice_thickness_estimate_t *estimate)
+{
+	if (estimate == nullptr)
+		return -1;
+	estimate->num_peaks = 0;
+	if (bins == nullptr || num_bins < axis.end_bin + 1 || axis.first_bin + 2 >= axis.end_bin)
+		return -1;
+
+	float max_magnitude = static_cast<float>(*std::max_element(bins, bins + num_bins));
+	float min_prominence = static_cast<float>(MIN_PROMINENCE_FRACTION) * max_magnitude;
+
+	size_t peaks[MAX_PEAKS];
+	float prominences[MAX_PEAKS];
+	size_t num_peaks = 0;
+
+	// Local maxima inside the gate, flat tops count once at their middle sample
+	size_t i = axis.first_bin + 1;
+	while (i + 1 < axis.end_bin)
+	{
+		if (!(bins[i - 1] < bins[i]))
+		{
+			i++;
+			continue;
+		}
+
+		size_t plateau_end = i;
+		while (plateau_end + 2 < axis.end_bin && bins[plateau_end + 1] == bins[i])
+			plateau_end++;
+
+		if (bins[plateau_end + 1] < bins[i])
+		{
+			size_t peak = (i + plateau_end) / 2;
+			float prominence = peak_prominence(bins, peak, axis);
+			if (prominence >= min_prominence && num_peaks < MAX_PEAKS)
+			{
+				// of two peaks that are too close together, keep the taller one
+				if (num_peaks > 0 && peak - peaks[num_peaks - 1] < axis.min_peak_distance)
+				{
+					if (bins[peak] > bins[peaks[num_peaks - 1]])
+					{
+						peaks[num_peaks - 1] = peak;
+						prominences[num_peaks - 1] = prominence;
+					}
+				}
+				else
+				{
+					peaks[num_peaks] = peak;
+					prominences[num_peaks] = prominence;
+					num_peaks++;
+				}
+			}
+		}
+		i = plateau_end + 1;
+	}
+
+	estimate->num_peaks = static_cast<uint8_t>(num_peaks);
+	if (num_peaks < 2)
+		return -2;
+
+	// The two closest reflections are the top and bottom of the ice
+	estimate->surface = refine_peak(bins, peaks[0], prominences[0], axis);
+	estimate->bottom = refine_peak(bins, peaks[1], prominences[1], axis);
+	estimate->thickness_m = estimate->bottom.range_m - estimate->surface.range_m;
+	return 0;
+}
+
+int8_t ice_thickness_estimate(const uint16_t *bins, size_t num_bins,
+                              ice_thickness_estimate_t *estimate)
+{
+	return find_ice_peaks(bins, num_bins, FFT_AXIS, estimate);
+}
+
+int8_t ice_thickness_estimate(const float *bins, size_t num_bins,
+                              ice_thickness_estimate_t *estimate)
+{
+	return find_ice_peaks(bins, num_bins, FFT_AXIS, estimate);
+}
+
+int8_t ice_thickness_estimate_zoom(const uint16_t *bins, size_t num_bins, float start_m,
+                                   float step_m, ice_thickness_estimate_t *estimate)
+{
+	// the zoom has to cover the gate, compared as floats as the plan stores its start that way
+	if (num_bins == 0 || !(step_m > 0.0f) || start_m > static_cast<float>(RANGE_GATE_MIN_M))
+		return -1;
+
+	// peaks are kept as far apart as in the radar's own FFT, which is coarser
+	range_axis axis;
+	axis.start_m = start_m;
+	axis.meters_per_bin = step_m;
+	axis.first_bin =
+	    static_cast<size_t>(std::max(0.0, std::ceil((RANGE_GATE_MIN_M - start_m) / step_m)));
+	axis.end_bin = static_cast<size_t>((RANGE_GATE_MAX_M - start_m) / step_m) + 1;
+	axis.end_bin = std::min(axis.end_bin, num_bins - 1); // refining a peak reads the bin after it
+	axis.min_peak_distance =
+	    static_cast<size_t>(std::ceil(MIN_PEAK_DISTANCE_BINS * METERS_PER_BIN / step_m));
+	return find_ice_peaks(bins, num_bins, axis, estimate);
+}
+
+int8_t ice_thickness_estimate(const fmcw_fft_frame_t *frame, ice_thickness_estimate_t *estimate)
+{
+	if (frame == nullptr)
+		return -1;
+	if (frame->num_zoom_bins > 0)
+		return ice_thickness_estimate_zoom(frame->zoom_bins, frame->num_zoom_bins,
+		                                   frame->zoom_start_m, frame->zoom_step_m, estimate);
+	return ice_thickness_estimate(frame->bins, frame->num_bins, estimate);
+}
@@ -0,0 +1,269 @@
+/**
+ *
+ * Name: radar_fft.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the functions declared in radar_fft.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "dsp/radar_fft.hpp"
+#include "bsp/ops_fmcw.hpp" // chirp configuration the radar is set up with
+#include <array>
+#include <cmath>
+
+//----------------------------------------------------------------
+constexpr double PI = 3.14159265358979323846;
+constexpr double SPEED_OF_LIGHT_M_PER_S = 3e8;
+constexpr double SAMPLE_RATE_HZ = FMCW_RADAR_FS_KHZ * 1000.0;
+constexpr double METERS_PER_HZ = SPEED_OF_LIGHT_M_PER_S / (2 * FMCW_RADAR_SLOPE);
+constexpr size_t PAD_FACTOR = RADAR_FFT_SIZE / RADAR_FFT_CHIRP_SAMPLES;
+
+static_assert(RADAR_FFT_BINS == FMCW_RADAR_FFT_SIZE, "spectrum must match the radar's FFT output");
+static_assert(PAD_FACTOR * RADAR_FFT_CHIRP_SAMPLES == RADAR_FFT_SIZE,
+              "FFT size must be a multiple of the chirp length");
+static_assert(RADAR_ZOOM_CONV_SIZE >= RADAR_FFT_CHIRP_SAMPLES + RADAR_ZOOM_MAX_POINTS - 1,
+              "zoom convolution would wrap around");
+static_assert(RADAR_ZOOM_CONV_SIZE <= RADAR_FFT_SIZE, "zoom convolution needs its own twiddles");
+
+//------------------------------ Compile Time Tables -------------------------------
+/**
+ * std::sin is not constexpr, the Taylor series converges to double precision once the angle
+ * is reduced to [-pi, pi].
+ */
+static constexpr double constexpr_sin(double x)
+{
+	while (x > PI)
+		x -= 2 * PI;
+	while (x < -PI)
+		x += 2 * PI;
+
+	double term = x;
+	double sum = x;
+	for (int n = 1; n < 14; n++)
+	{
+		term *= -x * x / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sum;
+}
+
+static constexpr double constexpr_cos(double x)
+{
+	return constexpr_sin(x + PI / 2);
+}
+
+// W^k = e^(-2 pi j k / RADAR_FFT_SIZE), smaller power of two FFTs use every stride'th entry
+static constexpr std::array<radar_complex_t, RADAR_FFT_SIZE> make_twiddles()
+{
+	std::array<radar_complex_t, RADAR_FFT_SIZE> twiddles{};
+	for (size_t k = 0; k < RADAR_FFT_SIZE; k++)
+	{
+		double angle = -2 * PI * static_cast<double>(k) / RADAR_FFT_SIZE;
+		twiddles[k] = {static_cast<float>(constexpr_cos(angle)),
+		               static_cast<float>(constexpr_sin(angle))};
+	}
+	return twiddles;
+}
+
+template <size_t N> static constexpr std::array<uint16_t, N> make_bit_reversal()
+{
+	static_assert((N & (N - 1)) == 0, "FFT size must be a power of two");
+	size_t bits = 0;
+	while ((static_cast<size_t>(1) << bits) < N)
+		bits++;
+
+	std::array<uint16_t, N> table{};
+	for (size_t i = 0; i < N; i++)
+	{
+		size_t reversed = 0;
+		for (size_t b = 0; b < bits; b++)
+			reversed = (reversed << 1) | ((i >> b) & 1);
+		table[i] = static_cast<uint16_t>(reversed);
+	}
+	return table;
+}
+
+// np.hanning(), symmetric so its ends are zero
+static constexpr std::array<float, RADAR_FFT_CHIRP_SAMPLES> make_hann_window()
+{
+	std::array<float, RADAR_FFT_CHIRP_SAMPLES> window{};
+	for (size_t n = 0; n < RADAR_FFT_CHIRP_SAMPLES; n++)
+		window[n] = static_cast<float>(
+		    0.5 - 0.5 * constexpr_cos(2 * PI * n / (RADAR_FFT_CHIRP_SAMPLES - 1)));
+	return window;
+}
+
+static constexpr std::array<radar_complex_t, RADAR_FFT_SIZE> TWIDDLES = make_twiddles();
+static constexpr std::array<uint16_t, RADAR_FFT_CHIRP_SAMPLES> CHIRP_BIT_REVERSAL =
+    make_bit_reversal<RADAR_FFT_CHIRP_SAMPLES>();
+static constexpr std::array<uint16_t, RADAR_ZOOM_CONV_SIZE> ZOOM_BIT_REVERSAL =
+    make_bit_reversal<RADAR_ZOOM_CONV_SIZE>();
+static constexpr std::array<float, RADAR_FFT_CHIRP_SAMPLES> HANN_WINDOW = make_hann_window();
+
+// the window's coherent gain, dividing by it leaves a tone's magnitude at its amplitude
+static constexpr float HANN_SCALE = 2.0f / (RADAR_FFT_CHIRP_SAMPLES - 1);
+
+//------------------------------ Helper Functions -------------------------------
+static inline radar_complex_t complex_mul(radar_complex_t a, radar_complex_t b)
+{
+	return {a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re};
+}
+
+static inline float complex_abs(radar_complex_t a)
+{
+	return std::sqrt(a.re * a.re + a.im * a.im);
+}
+
+/**
+ * In-place radix-2 decimation in time FFT. The input must already be in bit reversed order.
+ * @param data The samples, transformed in place
+ * @param n The number of samples, a power of two up to RADAR_FFT_SIZE
+ */
+static void fft_in_place(radar_complex_t *data, size_t n)
+{
+	for (size_t len = 2; len <= n; len <<= 1)
+	{
+		size_t half = len / 2;
+		size_t stride = RADAR_FFT_SIZE / len;
+		for (size_t start = 0; start < n; start += len)
+		{
+			for (size_t k = 0; k < half; k++)
+			{
+				radar_complex_t &a = data[start + k];
+				radar_complex_t &b = data[start + k + half];
+				radar_complex_t t = complex_mul(b, TWIDDLES[k * stride]);
+				b = {a.re - t.re, a.im - t.im};
+				a = {a.re + t.re, a.im + t.im};
+			}
+		}
+	}
+}
+
+/**
+ * Forms the complex chirp with the DC offset of each channel removed.
+ */
+static void remove_mean(const float *i, const float *q, radar_complex_t *samples)
+{
+	float mean_i = 0.0f;
+	float mean_q = 0.0f;
+	for (size_t n = 0; n < RADAR_FFT_CHIRP_SAMPLES; n++)
+	{
+		mean_i += i[n];
+		mean_q += q[n];
+	}
+	mean_i /= RADAR_FFT_CHIRP_SAMPLES;
+	mean_q /= RADAR_FFT_CHIRP_SAMPLES;
+
+	for (size_t n = 0; n < RADAR_FFT_CHIRP_SAMPLES; n++)
+		samples[n] = {i[n] - mean_i, q[n] - mean_q};
+}
+
+//------------------------------ Public Functions -------------------------------
+int8_t radar_fft_spectrum(const float *i, const float *q, size_t num_samples, float *magnitude)
+{
+	if (i == nullptr || q == nullptr || magnitude == nullptr ||
+	    num_samples != RADAR_FFT_CHIRP_SAMPLES)
+		return -1;
+
+	radar_complex_t samples[RADAR_FFT_CHIRP_SAMPLES];
+	remove_mean(i, q, samples);
+	for (size_t n = 0; n < RADAR_FFT_CHIRP_SAMPLES; n++)
+		samples[n] = {samples[n].re * HANN_WINDOW[n], samples[n].im * HANN_WINDOW[n]};
+
+	/* Bin 8m + r of the zero-padded FFT is bin m of the chirp length FFT of the samples
+	   turned by W^(nr), so the padding never has to be transformed. */
+	radar_complex_t buf[RADAR_FFT_CHIRP_SAMPLES];
+	for (size_t r = 0; r < PAD_FACTOR; r++)
+	{
+		for (size_t n = 0; n < RADAR_FFT_CHIRP_SAMPLES; n++)
+			buf[CHIRP_BIT_REVERSAL[n]] =
+			    complex_mul(samples[n], TWIDDLES[(n * r) % RADAR_FFT_SIZE]);
+		fft_in_place(buf, RADAR_FFT_CHIRP_SAMPLES);
+
+		for (size_t m = 0; m * PAD_FACTOR + r < RADAR_FFT_BINS; m++)
+			magnitude[m * PAD_FACTOR + r] = complex_abs(buf[m]) * HANN_SCALE;
+	}
+	return 0;
+}
+
+int8_t radar_zoom_plan_init(radar_zoom_plan_t *plan, float start_m, float end_m,
+                            size_t num_points)
+{
+	if (plan == nullptr || num_points < 2 || num_points > RADAR_ZOOM_MAX_POINTS ||
+	    !(start_m >= 0.0f) || !(end_m > start_m))
+		return -1;
+
+	plan->start_m = start_m;
+	plan->step_m = (end_m - start_m) / static_cast<float>(num_points - 1);
+	plan->num_points = static_cast<uint16_t>(num_points);
+
+	// the points are z_k = A W^-k on the unit circle, A at the first range and W one step back
+	double start_rad = 2 * PI * (start_m / METERS_PER_HZ) / SAMPLE_RATE_HZ;
+	double step_rad = 2 * PI * (plan->step_m / METERS_PER_HZ) / SAMPLE_RATE_HZ;
+	auto chirp = [step_rad](double m, double sign) -> radar_complex_t {
+		double angle = std::fmod(sign * 0.5 * step_rad * m * m, 2 * PI);
+		return {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+	};
+
+	for (size_t n = 0; n < RADAR_FFT_CHIRP_SAMPLES; n++)
+	{
+		double angle = std::fmod(-start_rad * static_cast<double>(n), 2 * PI);
+		radar_complex_t a_n = {static_cast<float>(std::cos(angle)),
+		                       static_cast<float>(std::sin(angle))};
+		radar_complex_t w_n = complex_mul(a_n, chirp(static_cast<double>(n), -1.0));
+		plan->premultiply[n] = {w_n.re * HANN_WINDOW[n], w_n.im * HANN_WINDOW[n]};
+	}
+
+	// W^(-m^2 / 2) for m from -(chirp - 1) to points - 1, negative m wrap to the end
+	radar_complex_t filter[RADAR_ZOOM_CONV_SIZE] = {};
+	for (size_t m = 0; m < num_points; m++)
+		filter[m] = chirp(static_cast<double>(m), 1.0);
+	for (size_t m = 1; m < RADAR_FFT_CHIRP_SAMPLES; m++)
+		filter[RADAR_ZOOM_CONV_SIZE - m] = chirp(static_cast<double>(m), 1.0);
+
+	// the inverse FFT's 1 / N is folded into the filter
+	const float scale = 1.0f / RADAR_ZOOM_CONV_SIZE;
+	for (size_t m = 0; m < RADAR_ZOOM_CONV_SIZE; m++)
+		plan->chirp_filter[ZOOM_BIT_REVERSAL[m]] = {filter[m].re * scale, filter[m].im * scale};
+	fft_in_place(plan->chirp_filter, RADAR_ZOOM_CONV_SIZE);
+	return 0;
+}
+
+int8_t radar_zoom_spectrum(const radar_zoom_plan_t *plan, const float *i, const float *q,
+                           size_t num_samples, float *magnitude)
+{
+	if (plan == nullptr || i == nullptr || q == nullptr || magnitude == nullptr ||
+	    num_samples != RADAR_FFT_CHIRP_SAMPLES || plan->num_points == 0)
+		return -1;
+
+	radar_complex_t samples[RADAR_FFT_CHIRP_SAMPLES];
+	remove_mean(i, q, samples);
+
+	radar_complex_t buf[RADAR_ZOOM_CONV_SIZE] = {};
+	for (size_t n = 0; n < RADAR_FFT_CHIRP_SAMPLES; n++)
+		buf[ZOOM_BIT_REVERSAL[n]] = complex_mul(samples[n], plan->premultiply[n]);
+	fft_in_place(buf, RADAR_ZOOM_CONV_SIZE);
+
+	// convolve with the chirp, the inverse FFT is the forward one of the conjugate
+	radar_complex_t product[RADAR_ZOOM_CONV_SIZE];
+	for (size_t m = 0; m < RADAR_ZOOM_CONV_SIZE; m++)
+	{
+		radar_complex_t p = complex_mul(buf[m], plan->chirp_filter[m]);
+		product[ZOOM_BIT_REVERSAL[m]] = {p.re, -p.im};
+	}
+	fft_in_place(product, RADAR_ZOOM_CONV_SIZE);
+
+	// the W^(k^2 / 2) post-multiply and the conjugate do not change the magnitude
+	for (size_t k = 0; k < plan->num_points; k++)
+		magnitude[k] = complex_abs(product[k]) * HANN_SCALE;
+	return 0;
+}
+
+double radar_fft_hz_to_range_m(double hz)
+{
+	return hz * METERS_PER_HZ;
+}
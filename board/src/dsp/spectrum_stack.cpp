@@ -0,0 +1,136 @@
+/**
+ *
+ * Name: spectrum_stack.cpp
+ * Author: Karran Dhillon
+ *
+ * This file implements the functions declared in spectrum_stack.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "dsp/spectrum_stack.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#include <arm_neon.h>
+	#define SPECTRUM_STACK_NEON 1
+#endif
+
+#define SPECTRUM_STACK_LANES 8 // uint16_t lanes in one 128-bit vector
+
+static_assert(FMCW_RADAR_FFT_SIZE % SPECTRUM_STACK_LANES == 0,
+              "FFT size must be a multiple of the vector width");
+
+/**
+ * Element-wise mean of the frames. Sums are kept in 32 bits so up to 65536 frames of full
+ * scale bins cannot overflow.
+ */
+static void stack_mean(const fmcw_fft_frame_t *const *frames, size_t num_frames, float *mean)
+{
+	const float scale = 1.0f / static_cast<float>(num_frames);
+
+#ifdef SPECTRUM_STACK_NEON
+	for (size_t i = 0; i < FMCW_RADAR_FFT_SIZE; i += SPECTRUM_STACK_LANES)
+	{
+		uint32x4_t sum_lo = vdupq_n_u32(0);
+		uint32x4_t sum_hi = vdupq_n_u32(0);
+		for (size_t f = 0; f < num_frames; f++)
+		{
+			uint16x8_t bins = vld1q_u16(frames[f]->bins + i);
+			sum_lo = vaddw_u16(sum_lo, vget_low_u16(bins));
+			sum_hi = vaddw_u16(sum_hi, vget_high_u16(bins));
+		}
+		vst1q_f32(mean + i, vmulq_n_f32(vcvtq_f32_u32(sum_lo), scale));
+		vst1q_f32(mean + i + 4, vmulq_n_f32(vcvtq_f32_u32(sum_hi), scale));
+	}
+#else
+	uint32_t sums[FMCW_RADAR_FFT_SIZE] = {};
+	for (size_t f = 0; f < num_frames; f++)
+	{
+		const uint16_t *bins = frames[f]->bins;
+		for (size_t i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+			sums[i] += bins[i];
+	}
+	for (size_t i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+		mean[i] = static_cast<float>(sums[i]) * scale;
+#endif
+}
+
+/**
+ * Largest value in a spectrum.
+ */
+static float spectrum_max(const float *spectrum)
+{
+#ifdef SPECTRUM_STACK_NEON
+	float32x4_t max = vld1q_f32(spectrum);
+	for (size_t i = 4; i < FMCW_RADAR_FFT_SIZE; i += 4)
+		max = vmaxq_f32(max, vld1q_f32(spectrum + i));
+	float lanes[4];
+	vst1q_f32(lanes, max);
+	return std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#else
+	return *std::max_element(spectrum, spectrum + FMCW_RADAR_FFT_SIZE);
+#endif
+}
+
+/**
+ * Element-wise median of the frames. The per bin column is at most
+ * SPECTRUM_STACK_MAX_FRAMES long, so an insertion sort beats anything fancier.
+ */
+static void stack_median(const fmcw_fft_frame_t *const *frames, size_t num_frames, float *median)
+{
+	uint16_t column[SPECTRUM_STACK_MAX_FRAMES];
+
+	for (size_t i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+	{
+		for (size_t f = 0; f < num_frames; f++)
+		{
+			uint16_t value = frames[f]->bins[i];
+			size_t j = f;
+			for (; j > 0 && column[j - 1] > value; j--)
+				column[j] = column[j - 1];
+			column[j] = value;
+		}
+
+		size_t mid = num_frames / 2;
+		if (num_frames % 2)
+			median[i] = column[mid];
+		else
+			median[i] = 0.5f * (static_cast<float>(column[mid - 1]) + column[mid]);
+	}
+}
+
+int8_t spectrum_stack(const fmcw_fft_frame_t *const *frames, size_t num_frames,
+                      spectrum_stack_result_t *result)
+{
+	if (frames == nullptr || result == nullptr || num_frames == 0 ||
+	    num_frames > SPECTRUM_STACK_MAX_FRAMES)
+		return -1;
+
+	for (size_t f = 0; f < num_frames; f++)
+	{
+		if (frames[f] == nullptr || frames[f]->num_bins != FMCW_RADAR_FFT_SIZE)
+			return -1;
+	}
+
+	result->num_frames = static_cast<uint16_t>(num_frames);
+	stack_mean(frames, num_frames, result->mean);
+	stack_median(frames, num_frames, result->median);
+
+	// Most bins hold no reflection, so the median bin of the mean spectrum is the noise floor
+	float sorted[FMCW_RADAR_FFT_SIZE];
+	std::copy(result->mean, result->mean + FMCW_RADAR_FFT_SIZE, sorted);
+	std::nth_element(sorted, sorted + FMCW_RADAR_FFT_SIZE / 2, sorted + FMCW_RADAR_FFT_SIZE);
+	result->noise_floor = sorted[FMCW_RADAR_FFT_SIZE / 2];
+
+	float peak = spectrum_max(result->mean);
+	if (result->noise_floor > 0.0f && peak > 0.0f)
+		result->peak_snr_db = 20.0f * std::log10(peak / result->noise_floor); // magnitudes
+	else
+		result->peak_snr_db = 0.0f;
+
+	return 0;
+}
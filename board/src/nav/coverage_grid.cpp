@@ -0,0 +1,176 @@
+/**
+ *
+ * Name: coverage_grid.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the functions declared in coverage_grid.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "nav/coverage_grid.hpp"
+#include <cmath>
+
+static_assert((COVERAGE_GRID_CAPACITY & (COVERAGE_GRID_CAPACITY - 1)) == 0,
+              "COVERAGE_GRID_CAPACITY must be a power of two");
+
+static size_t cell_hash(int32_t east_index, int32_t north_index)
+{
+	uint32_t h = static_cast<uint32_t>(east_index) * 0x9E3779B1u ^
+	             static_cast<uint32_t>(north_index) * 0x85EBCA77u;
+	h ^= h >> 16;
+	return h & (COVERAGE_GRID_CAPACITY - 1);
+}
+
+/**
+ * Finds the slot of a cell, or the empty slot it would go in. The table is never full, so
+ * there always is one.
+ */
+static size_t find_slot(const coverage_grid_t *grid, int32_t east_index, int32_t north_index)
+{
+	size_t slot = cell_hash(east_index, north_index);
+	while (grid->cells[slot].num_stops != 0 && (grid->cells[slot].east_index != east_index ||
+	                                            grid->cells[slot].north_index != north_index))
+		slot = (slot + 1) & (COVERAGE_GRID_CAPACITY - 1);
+	return slot;
+}
+
+static const coverage_cell_t *find_cell(const coverage_grid_t *grid, int32_t east_index,
+                                        int32_t north_index)
+{
+	const coverage_cell_t *cell = &grid->cells[find_slot(grid, east_index, north_index)];
+	return cell->num_stops != 0 ? cell : nullptr;
+}
+
+static int32_t cell_index(const coverage_grid_t *grid, double meters)
+{
+	return static_cast<int32_t>(std::floor(meters / grid->cell_size_m));
+}
+
+//----------------------------------------------------------------
+
+void coverage_grid_init(coverage_grid_t *grid, double cell_size_m)
+{
+	*grid = {};
+	grid->cell_size_m = cell_size_m;
+}
+
+const coverage_cell_t *coverage_grid_add_stop(coverage_grid_t *grid, double latitude,
+                                              double longitude, double thickness_m,
+                                              double half_width_m)
+{
+	if (!grid->has_origin)
+	{
+		enu_origin_init(&grid->origin, latitude, longitude);
+		grid->has_origin = true;
+	}
+
+	double east_m, north_m;
+	enu_project(&grid->origin, latitude, longitude, &east_m, &north_m);
+	int32_t east_index = cell_index(grid, east_m);
+	int32_t north_index = cell_index(grid, north_m);
+
+	coverage_cell_t *cell = &grid->cells[find_slot(grid, east_index, north_index)];
+	if (cell->num_stops == 0)
+	{
+		if (grid->num_cells >= COVERAGE_GRID_MAX_CELLS)
+			return nullptr;
+		grid->num_cells++;
+		cell->east_index = east_index;
+		cell->north_index = north_index;
+		cell->best_half_width_m = INFINITY;
+	}
+
+	cell->num_stops++;
+	cell->east_m += (east_m - cell->east_m) / cell->num_stops;
+	cell->north_m += (north_m - cell->north_m) / cell->num_stops;
+	double delta = thickness_m - cell->mean_m;
+	cell->mean_m += delta / cell->num_stops;
+	cell->m2 += delta * (thickness_m - cell->mean_m);
+	cell->best_half_width_m = std::fmin(cell->best_half_width_m, half_width_m);
+	return cell;
+}
+
+const coverage_cell_t *coverage_grid_cell_at(const coverage_grid_t *grid, double latitude,
+                                             double longitude)
+{
+	if (!grid->has_origin)
+		return nullptr;
+
+	double east_m, north_m;
+	enu_project(&grid->origin, latitude, longitude, &east_m, &north_m);
+	return find_cell(grid, cell_index(grid, east_m), cell_index(grid, north_m));
+}
+
+const coverage_cell_t *coverage_grid_nearest(const coverage_grid_t *grid, double latitude,
+                                             double longitude, double max_distance_m,
+                                             double *distance_m)
+{
+	if (!grid->has_origin)
+		return nullptr;
+
+	double east_m, north_m;
+	enu_project(&grid->origin, latitude, longitude, &east_m, &north_m);
+	int32_t east_index = cell_index(grid, east_m);
+	int32_t north_index = cell_index(grid, north_m);
+
+	// a cell's stops can be anywhere in it, so look one cell past max_distance_m
+	int32_t reach = static_cast<int32_t>(std::ceil(max_distance_m / grid->cell_size_m)) + 1;
+	const coverage_cell_t *nearest = nullptr;
+	double nearest_m = max_distance_m;
+	for (int32_t de = -reach; de <= reach; de++)
+	{
+		for (int32_t dn = -reach; dn <= reach; dn++)
+		{
+			const coverage_cell_t *cell = find_cell(grid, east_index + de, north_index + dn);
+			if (cell == nullptr)
+				continue;
+			double d = std::hypot(cell->east_m - east_m, cell->north_m - north_m);
+			if (d <= nearest_m)
+			{
+				nearest = cell;
+				nearest_m = d;
+			}
+		}
+	}
+
+	if (nearest != nullptr)
+		*distance_m = nearest_m;
+	return nearest;
+}
+
+double coverage_cell_uncertainty_m(const coverage_cell_t *cell)
+{
+	if (cell->num_stops < 2)
+		return cell->best_half_width_m;
+
+	double spread_m = std::sqrt(cell->m2 / (cell->num_stops - 1));
+	return std::fmax(spread_m, cell->best_half_width_m);
+}
+
+size_t coverage_grid_most_uncertain(const coverage_grid_t *grid, const coverage_cell_t **cells,
+                                    size_t max_cells)
+{
+	size_t count = 0;
+	for (size_t slot = 0; slot < COVERAGE_GRID_CAPACITY; slot++)
+	{
+		const coverage_cell_t *cell = &grid->cells[slot];
+		if (cell->num_stops == 0)
+			continue;
+
+		// insertion into the sorted list, it only ever holds a handful
+		double uncertainty_m = coverage_cell_uncertainty_m(cell);
+		size_t pos = count < max_cells ? count++ : max_cells;
+		while (pos > 0 && coverage_cell_uncertainty_m(cells[pos - 1]) < uncertainty_m)
+		{
+			if (pos < max_cells)
+				cells[pos] = cells[pos - 1];
+			pos--;
+		}
+		if (pos < max_cells)
+			cells[pos] = cell;
+	}
+	return count;
+}
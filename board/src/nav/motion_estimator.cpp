@@ -0,0 +1,131 @@
+/**
+ *
+ * Name: motion_estimator.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the functions declared in motion_estimator.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "nav/motion_estimator.hpp"
+#include <cmath>
+
+// WGS-84 ellipsoid
+static constexpr double WGS84_A = 6378137.0;
+static constexpr double WGS84_E2 = 6.69437999014e-3;
+
+void enu_origin_init(enu_origin_t *origin, double latitude, double longitude)
+{
+	double lat_rad = latitude * M_PI / 180.0;
+	double sin_lat = std::sin(lat_rad);
+	double w = std::sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat);
+
+	// meridional and prime vertical radii of curvature at the origin
+	double meridian_radius = WGS84_A * (1.0 - WGS84_E2) / (w * w * w);
+	double normal_radius = WGS84_A / w;
+
+	origin->latitude = latitude;
+	origin->longitude = longitude;
+	origin->meters_per_deg_lat = meridian_radius * M_PI / 180.0;
+	origin->meters_per_deg_lon = normal_radius * std::cos(lat_rad) * M_PI / 180.0;
+}
+
+void enu_project(const enu_origin_t *origin, double latitude, double longitude, double *east_m,
+                 double *north_m)
+{
+	*east_m = (longitude - origin->longitude) * origin->meters_per_deg_lon;
+	*north_m = (latitude - origin->latitude) * origin->meters_per_deg_lat;
+}
+
+//----------------------------------------------------------------
+
+void motion_estimator_init(motion_estimator_t *estimator, const motion_estimator_config_t *config)
+{
+	*estimator = {};
+	estimator->config = *config;
+	estimator->state = MOTION_STATE_UNKNOWN;
+	estimator->candidate = MOTION_STATE_UNKNOWN;
+}
+
+double motion_estimator_speed_mps(const motion_estimator_t *estimator)
+{
+	return std::hypot(estimator->east_mps, estimator->north_mps);
+}
+
+/**
+ * Moves the decision to target once the speed has agreed with it for hold_usec.
+ */
+static void motion_estimator_hold(motion_estimator_t *estimator, enum motion_state target,
+                                  uint64_t hold_usec, uint64_t now_usec)
+{
+	if (estimator->candidate != target)
+	{
+		estimator->candidate = target;
+		estimator->candidate_since_usec = now_usec;
+	}
+
+	if (now_usec - estimator->candidate_since_usec >= hold_usec)
+	{
+		estimator->state = target;
+		estimator->candidate = MOTION_STATE_UNKNOWN;
+	}
+}
+
+enum motion_state motion_estimator_update(motion_estimator_t *estimator, double latitude,
+                                          double longitude, uint64_t timestamp_usec)
+{
+	const motion_estimator_config_t &config = estimator->config;
+
+	if (!estimator->has_origin)
+	{
+		enu_origin_init(&estimator->origin, latitude, longitude);
+		estimator->has_origin = true;
+	}
+
+	double east_m, north_m;
+	enu_project(&estimator->origin, latitude, longitude, &east_m, &north_m);
+
+	uint64_t gap_usec = timestamp_usec - estimator->last_fix_usec;
+	if (!estimator->has_fix || timestamp_usec <= estimator->last_fix_usec ||
+	    gap_usec > config.max_gap_usec)
+	{
+		// Restart from this fix, the velocity is unknown until the next one
+		estimator->east_m = east_m;
+		estimator->north_m = north_m;
+		estimator->east_mps = 0;
+		estimator->north_mps = 0;
+		estimator->last_fix_usec = timestamp_usec;
+		estimator->has_fix = true;
+		estimator->candidate = MOTION_STATE_UNKNOWN;
+		return estimator->state;
+	}
+
+	// Predict with constant velocity, then correct with the residual
+	double dt = gap_usec * 1e-6;
+	double predicted_east = estimator->east_m + estimator->east_mps * dt;
+	double predicted_north = estimator->north_m + estimator->north_mps * dt;
+	double residual_east = east_m - predicted_east;
+	double residual_north = north_m - predicted_north;
+
+	estimator->east_m = predicted_east + config.alpha * residual_east;
+	estimator->north_m = predicted_north + config.alpha * residual_north;
+	estimator->east_mps += config.beta / dt * residual_east;
+	estimator->north_mps += config.beta / dt * residual_north;
+	estimator->last_fix_usec = timestamp_usec;
+
+	// Hysteresis: the speed has to clear the far threshold for a while to change state
+	double speed_mps = motion_estimator_speed_mps(estimator);
+	if (estimator->state != MOTION_STATE_STATIONARY && speed_mps < config.stationary_speed_mps)
+		motion_estimator_hold(estimator, MOTION_STATE_STATIONARY, config.stationary_hold_usec,
+		                      timestamp_usec);
+	else if (estimator->state != MOTION_STATE_MOVING && speed_mps > config.moving_speed_mps)
+		motion_estimator_hold(estimator, MOTION_STATE_MOVING, config.moving_hold_usec,
+		                      timestamp_usec);
+	else
+		estimator->candidate = MOTION_STATE_UNKNOWN;
+
+	return estimator->state;
+}
@@ -0,0 +1,105 @@
+/**
+ *
+ * Name: flight_csv.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the functions declared in flight_csv.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "storage/flight_csv.hpp"
+#include <cstdlib>
+#include <cstring>
+
+#define FLIGHT_CSV_MAX_NUMBER 32 // characters of a position or temperature, far more than written
+
+static inline bool is_digit(char ch)
+{
+	return ch >= '0' && ch <= '9';
+}
+
+/**
+ * Checks a timestamp has the shape YYYY-MM-DD HH:MM:SS. The database checks the values.
+ */
+static bool valid_timestamp(const char *text)
+{
+	static const char LAYOUT[] = "0000-00-00 00:00:00";
+	for (size_t i = 0; i < FLIGHT_CSV_TIMESTAMP_SIZE; i++)
+	{
+		if (LAYOUT[i] == '0' ? !is_digit(text[i]) : text[i] != LAYOUT[i])
+			return false;
+	}
+	return true;
+}
+
+/**
+ * Parses the number in front of the next comma and moves p past that comma. The row is not
+ * null terminated, so the field is copied out before strtod() reads it.
+ * @return true on success, false if the field is not a number or no comma follows it.
+ */
+static bool parse_field(const char **p, const char *end, double *value)
+{
+	const char *comma = static_cast<const char *>(memchr(*p, ',', end - *p));
+	size_t len = comma != nullptr ? comma - *p : 0;
+	if (len == 0 || len >= FLIGHT_CSV_MAX_NUMBER || (**p != '-' && **p != '.' && !is_digit(**p)))
+		return false;
+
+	char field[FLIGHT_CSV_MAX_NUMBER];
+	memcpy(field, *p, len);
+	field[len] = '\0';
+	char *field_end;
+	*value = strtod(field, &field_end);
+	if (field_end != field + len)
+		return false;
+	*p = comma + 1;
+	return true;
+}
+
+//----------------------------------------------------------------
+
+int8_t flight_csv_parse_row(const char *line, size_t len, flight_csv_row_t *row)
+{
+	if (line == nullptr || row == nullptr)
+		return -1;
+
+	if (len > 0 && line[len - 1] == '\r')
+		len--;
+	const char *end = line + len;
+
+	if (len < FLIGHT_CSV_TIMESTAMP_SIZE + 1 || line[FLIGHT_CSV_TIMESTAMP_SIZE] != ',' ||
+	    !valid_timestamp(line))
+		return -2;
+	memcpy(row->timestamp, line, FLIGHT_CSV_TIMESTAMP_SIZE);
+	row->timestamp[FLIGHT_CSV_TIMESTAMP_SIZE] = '\0';
+
+	const char *p = line + FLIGHT_CSV_TIMESTAMP_SIZE + 1;
+	double temperature;
+	if (!parse_field(&p, end, &row->latitude) || !parse_field(&p, end, &row->longitude) ||
+	    !parse_field(&p, end, &temperature))
+		return -3;
+	row->temperature = static_cast<float>(temperature);
+
+	// the bins are parsed like the radar's own output
+	int num_bins = fmcw_radar_parse_fft_bins(p, end - p, row->bins, FMCW_RADAR_FFT_SIZE);
+	if (num_bins != FMCW_RADAR_FFT_SIZE)
+		return -4;
+	return 0;
+}
+
+size_t flight_csv_row_start(const char *text, size_t len, size_t offset)
+{
+	if (offset == 0)
+		return 0;
+	if (offset >= len)
+		return len;
+	if (text[offset - 1] == '\n')
+		return offset;
+
+	const void *newline = memchr(text + offset, '\n', len - offset);
+	if (newline == nullptr)
+		return len;
+	return static_cast<const char *>(newline) - text + 1;
+}
@@ -0,0 +1,638 @@
+/**
+ *
+ * Name: flight_log.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the functions declared in flight_log.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "storage/flight_log.hpp"
+#include "common/clock.h"
+#include "common/logging.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------
+// CRC-32 lookup table, built at compile time
+static constexpr std::array<uint32_t, 256> make_crc32_table()
+{
+	std::array<uint32_t, 256> table{};
+	for (uint32_t i = 0; i < 256; i++)
+	{
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; bit++)
+			crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+		table[i] = crc;
+	}
+	return table;
+}
+
+static constexpr std::array<uint32_t, 256> CRC32_TABLE = make_crc32_table();
+
+uint32_t flight_log_crc32(const void *data, size_t len)
+{
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	uint32_t crc = 0xFFFFFFFFu;
+	for (size_t i = 0; i < len; i++)
+		crc = CRC32_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFFu;
+}
+
+//----------------------------------------------------------------
+
+bool flight_log_header_valid(const flight_log_header_t *header)
+{
+	bool packed = (header->flags & FLIGHT_LOG_PACKED) != 0;
+	return memcmp(header->magic, FLIGHT_LOG_MAGIC, sizeof(header->magic)) == 0 &&
+	       header->version == FLIGHT_LOG_VERSION &&
+	       header->header_size == sizeof(flight_log_header_t) &&
+	       header->record_size == (packed ? 0 : sizeof(flight_log_record_t)) &&
+	       (header->flags & ~FLIGHT_LOG_PACKED) == 0 && header->num_bins == FMCW_RADAR_FFT_SIZE &&
+	       header->num_zoom_bins == FMCW_RADAR_ZOOM_SIZE;
+}
+
+bool flight_log_record_valid(const flight_log_record_t *record)
+{
+	return record->crc == flight_log_crc32(record, offsetof(flight_log_record_t, crc));
+}
+
+static size_t flight_log_packed_size(size_t payload_size)
+{
+	size_t size = sizeof(flight_log_packed_record_t) + payload_size + sizeof(uint32_t);
+	return (size + FLIGHT_LOG_PACKED_ALIGN - 1) / FLIGHT_LOG_PACKED_ALIGN * FLIGHT_LOG_PACKED_ALIGN;
+}
+
+size_t flight_log_packed_record_size(const uint8_t *data, size_t len, uint64_t offset)
+{
+	flight_log_packed_record_t record;
+	if (len < sizeof(record))
+		return 0;
+	memcpy(&record, data, sizeof(record)); // data may not be aligned
+
+	if (record.sync != FLIGHT_LOG_PACKED_SYNC || record.offset != offset ||
+	    record.num_bins > FMCW_RADAR_FFT_SIZE || record.num_zoom_bins > FMCW_RADAR_ZOOM_SIZE ||
+	    record.payload_size > FLIGHT_LOG_PACKED_MAX_PAYLOAD)
+		return 0;
+
+	size_t size = flight_log_packed_size(record.payload_size);
+	if (size > len)
+		return 0;
+
+	size_t crc_offset = sizeof(record) + record.payload_size;
+	uint32_t crc;
+	memcpy(&crc, &data[crc_offset], sizeof(crc));
+	return crc == flight_log_crc32(data, crc_offset) ? size : 0;
+}
+
+void flight_log_make_record(double latitude, double longitude, double temperature,
+                            const fmcw_fft_frame_t *frame, flight_log_record_t *record)
+{
+	memset(record, 0, sizeof(*record));
+	record->timestamp_usec = frame->timestamp_usec;
+	record->latitude = latitude;
+	record->longitude = longitude;
+	record->temperature = static_cast<float>(temperature);
+	record->sequence = frame->sequence;
+	record->num_bins = frame->num_bins;
+	memcpy(record->bins, frame->bins, sizeof(record->bins));
+	record->num_zoom_bins = std::min<uint16_t>(frame->num_zoom_bins, FMCW_RADAR_ZOOM_SIZE);
+	if (record->num_zoom_bins > 0)
+	{
+		record->zoom_start_m = frame->zoom_start_m;
+		record->zoom_step_m = frame->zoom_step_m;
+		memcpy(record->zoom_bins, frame->zoom_bins,
+		       record->num_zoom_bins * sizeof(record->zoom_bins[0]));
+	}
+}
+
+//----------------------------------------------------------------
+
+FLIGHT_LOG_WRITER::FLIGHT_LOG_WRITER()
+    : fd(-1), writer(nullptr), map_size(0), ring_header(nullptr), ring_records(nullptr),
+      ring_bytes(nullptr), packed(false), have_reference(false), reference_num_bins(0),
+      since_keyframe(0), write_offset(0), record_count(0)
+{
+}
+
+FLIGHT_LOG_WRITER::~FLIGHT_LOG_WRITER()
+{
+	close();
+}
+
+static void flight_log_init_header(flight_log_header_t *header, uint32_t ring_capacity,
+                                   uint32_t flags)
+{
+	memset(header, 0, sizeof(*header));
+	memcpy(header->magic, FLIGHT_LOG_MAGIC, sizeof(header->magic));
+	header->version = FLIGHT_LOG_VERSION;
+	header->header_size = sizeof(flight_log_header_t);
+	header->record_size = (flags & FLIGHT_LOG_PACKED) ? 0 : sizeof(flight_log_record_t);
+	header->num_bins = FMCW_RADAR_FFT_SIZE;
+	header->num_zoom_bins = FMCW_RADAR_ZOOM_SIZE;
+	header->created_usec = clock_realtime_usec();
+	header->ring_capacity = ring_capacity;
+	header->flags = flags;
+}
+
+static off_t flight_log_ring_file_size(uint32_t ring_capacity, uint32_t flags)
+{
+	off_t record_size = (flags & FLIGHT_LOG_PACKED) ? 1 : (off_t)sizeof(flight_log_record_t);
+	return (off_t)sizeof(flight_log_header_t) + (off_t)ring_capacity * record_size;
+}
+
+/**
+ * Opens a flight log, creating it if needed.
+ *
+ * An append log (ring_capacity 0) grows by one record per append. A record cut short by a
+ * crash is dropped so the records that follow stay aligned.
+ *
+ * A ring log is preallocated and mapped when it is created, so appending is a memcpy and the
+ * file never grows. Once full the oldest records are overwritten.
+ *
+ * Either kind can be packed (FLIGHT_LOG_PACKED), which stores the bins compressed against the
+ * previous record. A ring log's capacity is then in bytes, a multiple of 8.
+ * @param path The path of the flight log
+ * @param ring_capacity The number of records (bytes if packed) a new ring log holds, 0 for an
+ *                      append log
+ * @param flags FLIGHT_LOG_PACKED or 0, an existing log has to match
+ *
+ * @return 0 on success, -X on failure with failure code
+ */
+int8_t FLIGHT_LOG_WRITER::open(const char *path, uint32_t ring_capacity, uint32_t flags)
+{
+	int8_t rc;
+
+	flags &= FLIGHT_LOG_PACKED;
+	packed = flags != 0;
+	have_reference = false; // the first record after opening is always a keyframe
+	since_keyframe = 0;
+	write_offset = 0;
+	record_count = 0;
+
+	if (packed && ring_capacity > 0 &&
+	    (ring_capacity % FLIGHT_LOG_PACKED_ALIGN != 0 ||
+	     ring_capacity < FLIGHT_LOG_PACKED_MAX_SIZE))
+	{
+		logging_write(LOG_ERROR, "flight_log: a packed ring of %u bytes cannot hold records",
+		              ring_capacity);
+		return -9;
+	}
+
+	fd = ::open(path, O_RDWR | O_CREAT, 0644);
+	if (fd < 0)
+	{
+		logging_write(LOG_ERROR, "flight_log: failed to open %s: %s", path, strerror(errno));
+		return -1;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+	{
+		close();
+		return -2;
+	}
+
+	if (ring_capacity > 0)
+		return open_ring(path, ring_capacity, flags, st.st_size);
+
+	if (st.st_size == 0)
+	{
+		flight_log_header_t header;
+		flight_log_init_header(&header, 0, flags);
+
+		if (write(fd, &header, sizeof(header)) != (ssize_t)sizeof(header))
+		{
+			close();
+			return -3;
+		}
+		return start_writer();
+	}
+
+	flight_log_header_t header;
+	if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+	    !flight_log_header_valid(&header) || header.ring_capacity != 0 || header.flags != flags)
+	{
+		logging_write(LOG_ERROR, "flight_log: %s is not a version %d %sappend flight log", path,
+		              FLIGHT_LOG_VERSION, packed ? "packed " : "");
+		close();
+		return -4;
+	}
+
+	if (packed)
+	{
+		if ((rc = recover_packed(st.st_size)) != 0)
+			return rc;
+		if (lseek(fd, 0, SEEK_END) < 0)
+		{
+			close();
+			return -6;
+		}
+		return start_writer();
+	}
+
+	off_t records_size = st.st_size - (off_t)sizeof(header);
+	off_t partial = records_size % (off_t)sizeof(flight_log_record_t);
+	if (partial != 0)
+	{
+		logging_write(LOG_WARN, "flight_log: dropping %ld bytes of a truncated record",
+		              (long)partial);
+		if (ftruncate(fd, st.st_size - partial) != 0)
+		{
+			close();
+			return -5;
+		}
+	}
+
+	if (lseek(fd, 0, SEEK_END) < 0)
+	{
+		close();
+		return -6;
+	}
+	return start_writer();
+}
+
+/**
+ * Preallocates and maps a ring log. An existing ring log keeps its capacity and write cursor.
+ *
+ * @return 0 on success, -X on failure with failure code
+ */
+int8_t FLIGHT_LOG_WRITER::open_ring(const char *path, uint32_t ring_capacity, uint32_t flags,
+                                    off_t file_size)
+{
+	bool created = file_size == 0;
+	if (created)
+	{
+		// Reserve every block now so the filesystem does no allocation during the flight
+		int err = posix_fallocate(fd, 0, flight_log_ring_file_size(ring_capacity, flags));
+		if (err != 0)
+		{
+			logging_write(LOG_ERROR, "flight_log: failed to preallocate %s: %s", path,
+			              strerror(err));
+			close();
+			return -3;
+		}
+		file_size = flight_log_ring_file_size(ring_capacity, flags);
+	}
+	else
+	{
+		flight_log_header_t header;
+		if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+		    !flight_log_header_valid(&header) || header.ring_capacity == 0 ||
+		    header.flags != flags ||
+		    file_size != flight_log_ring_file_size(header.ring_capacity, flags))
+		{
+			logging_write(LOG_ERROR, "flight_log: %s is not a version %d %sring flight log", path,
+			              FLIGHT_LOG_VERSION, packed ? "packed " : "");
+			close();
+			return -4;
+		}
+	}
+
+	// MAP_POPULATE faults every page in now instead of on the first write to each one
+	void *map = mmap(nullptr, (size_t)file_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+	                 fd, 0);
+	if (map == MAP_FAILED)
+	{
+		logging_write(LOG_ERROR, "flight_log: failed to map %s: %s", path, strerror(errno));
+		close();
+		return -8;
+	}
+
+	map_size = (size_t)file_size;
+	ring_header = static_cast<flight_log_header_t *>(map);
+	if (packed)
+		ring_bytes = reinterpret_cast<uint8_t *>(ring_header + 1);
+	else
+		ring_records = reinterpret_cast<flight_log_record_t *>(ring_header + 1);
+
+	if (created)
+		flight_log_init_header(ring_header, ring_capacity, flags);
+	else if (packed)
+		recover_packed_ring();
+	else
+		recover_ring();
+	return 0;
+}
+
+/**
+ * The write cursor is bumped after the record is copied in, so a crash in between leaves an
+ * intact record just past the cursor. Take back any such records.
+ */
+void FLIGHT_LOG_WRITER::recover_ring()
+{
+	uint64_t capacity = ring_header->ring_capacity;
+	uint64_t recovered = 0;
+
+	while (recovered < capacity)
+	{
+		uint64_t next = ring_header->write_count;
+		const flight_log_record_t *slot = &ring_records[next % capacity];
+		if (!flight_log_record_valid(slot))
+			break;
+
+		// Once the ring has wrapped the slot holds an older record from the previous lap
+		if (next > 0 && slot->timestamp_usec < ring_records[(next - 1) % capacity].timestamp_usec)
+			break;
+
+		ring_header->write_count++;
+		recovered++;
+	}
+
+	if (recovered > 0)
+		logging_write(LOG_WARN, "flight_log: recovered %llu records past the write cursor",
+		              (unsigned long long)recovered);
+}
+
+/**
+ * Same as recover_ring() for a packed ring log. A record past the cursor is only new if it was
+ * written at the cursor, older ones were written a lap earlier.
+ */
+void FLIGHT_LOG_WRITER::recover_packed_ring()
+{
+	uint64_t capacity = ring_header->ring_capacity;
+	uint64_t recovered = 0;
+
+	for (;;)
+	{
+		uint64_t pos = ring_header->write_offset % capacity;
+		size_t size = flight_log_packed_record_size(&ring_bytes[pos], (size_t)(capacity - pos),
+		                                            ring_header->write_offset);
+		if (size == 0)
+			break;
+
+		ring_header->write_offset += size;
+		ring_header->write_count++;
+		recovered++;
+	}
+
+	if (recovered > 0)
+		logging_write(LOG_WARN, "flight_log: recovered %llu records past the write cursor",
+		              (unsigned long long)recovered);
+}
+
+/**
+ * Finds the end of the last intact record in a packed append log and drops whatever follows
+ * it, e.g. a record cut short by a crash. Reads through the whole log once.
+ *
+ * @return 0 on success, -X on failure with failure code
+ */
+int8_t FLIGHT_LOG_WRITER::recover_packed(off_t file_size)
+{
+	off_t pos = (off_t)sizeof(flight_log_header_t);
+	while (pos < file_size)
+	{
+		ssize_t len = pread(fd, packed_record, sizeof(packed_record), pos);
+		if (len <= 0)
+			break;
+
+		size_t size = flight_log_packed_record_size(packed_record, (size_t)len, write_offset);
+		if (size == 0)
+			break;
+		pos += (off_t)size;
+		write_offset += size;
+		record_count++;
+	}
+
+	if (pos < file_size)
+	{
+		logging_write(LOG_WARN, "flight_log: dropping %ld bytes after the last intact record",
+		              (long)(file_size - pos));
+		if (ftruncate(fd, pos) != 0)
+		{
+			close();
+			return -5;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Hands the file over to a background writer thread.
+ *
+ * @return 0 on success, -X on failure with failure code
+ */
+int8_t FLIGHT_LOG_WRITER::start_writer()
+{
+	struct async_writer_config config = {};
+	config.buffer_size = FLIGHT_LOG_BUFFER_SIZE;
+	config.flush_interval_ms = FLIGHT_LOG_FLUSH_INTERVAL_MS;
+	config.fsync_interval_ms = FLIGHT_LOG_FSYNC_INTERVAL_MS;
+
+	writer = async_writer_create(fd, &config);
+	if (writer == nullptr)
+	{
+		close();
+		return -7;
+	}
+	return 0;
+}
+
+/**
+ * Seals a record with its CRC and appends it to the flight log.
+ * @param record The record to append
+ *
+ * @return 0 on success, -X on failure with failure code
+ */
+int8_t FLIGHT_LOG_WRITER::append(flight_log_record_t *record)
+{
+	if (packed)
+		return append_packed(record);
+
+	record->crc = flight_log_crc32(record, offsetof(flight_log_record_t, crc));
+
+	if (ring_header != nullptr)
+	{
+		uint64_t slot = ring_header->write_count % ring_header->ring_capacity;
+		memcpy(&ring_records[slot], record, sizeof(*record));
+		ring_header->write_count++; // only after the record is complete, see recover_ring()
+		return 0;
+	}
+
+	if (writer == nullptr)
+		return -1;
+	if (async_writer_write(writer, record, sizeof(*record)) != 0)
+		return -2; // buffer full, storage is not keeping up
+	return 0;
+}
+
+/**
+ * Encodes a record into packed_record, against the last record unless a keyframe is due or
+ * the keyframe comes out smaller. The zoom bins follow, encoded on their own. Its offset and
+ * CRC are filled in by seal().
+ * @param record The record to encode
+ * @param index The number of records written to the log before it
+ *
+ * @return The size of the packed record including its padding.
+ */
+size_t FLIGHT_LOG_WRITER::pack(const flight_log_record_t *record, uint64_t index)
+{
+	uint16_t num_bins = std::min<uint16_t>(record->num_bins, FMCW_RADAR_FFT_SIZE);
+	uint16_t num_zoom_bins = std::min<uint16_t>(record->num_zoom_bins, FMCW_RADAR_ZOOM_SIZE);
+	uint8_t *payload = &packed_record[sizeof(flight_log_packed_record_t)];
+	constexpr size_t PAYLOAD_CAPACITY = SPECTRUM_CODEC_MAX_SIZE(FMCW_RADAR_FFT_SIZE);
+	constexpr size_t ZOOM_CAPACITY = SPECTRUM_CODEC_MAX_SIZE(FMCW_RADAR_ZOOM_SIZE);
+
+	flight_log_packed_record_t header = {};
+	header.sync = FLIGHT_LOG_PACKED_SYNC;
+	header.flags = FLIGHT_LOG_RECORD_KEYFRAME;
+	header.timestamp_usec = record->timestamp_usec;
+	header.latitude = record->latitude;
+	header.longitude = record->longitude;
+	header.temperature = record->temperature;
+	header.sequence = record->sequence;
+	header.num_bins = num_bins;
+	header.num_zoom_bins = num_zoom_bins;
+	header.index = static_cast<uint32_t>(index);
+	header.zoom_start_m = record->zoom_start_m;
+	header.zoom_step_m = record->zoom_step_m;
+
+	// never fails, the payload has room for the largest encoding
+	int size = spectrum_encode(record->bins, nullptr, num_bins, payload, PAYLOAD_CAPACITY);
+	if (have_reference && reference_num_bins == num_bins &&
+	    since_keyframe < FLIGHT_LOG_KEYFRAME_INTERVAL)
+	{
+		uint8_t delta[PAYLOAD_CAPACITY];
+		int delta_size = spectrum_encode(record->bins, reference, num_bins, delta, sizeof(delta));
+		if (delta_size < size)
+		{
+			memcpy(payload, delta, (size_t)delta_size);
+			size = delta_size;
+			header.flags = 0;
+		}
+	}
+	size += spectrum_encode(record->zoom_bins, nullptr, num_zoom_bins, &payload[size],
+	                        ZOOM_CAPACITY);
+	header.payload_size = static_cast<uint16_t>(size);
+	memcpy(packed_record, &header, sizeof(header));
+
+	since_keyframe = (header.flags & FLIGHT_LOG_RECORD_KEYFRAME) ? 1 : since_keyframe + 1;
+	memcpy(reference, record->bins, num_bins * sizeof(reference[0]));
+	reference_num_bins = num_bins;
+	have_reference = true;
+	return flight_log_packed_size((size_t)size);
+}
+
+/**
+ * Stamps the packed record with where it goes and seals it with its CRC and padding.
+ */
+void FLIGHT_LOG_WRITER::seal(size_t size, uint64_t offset)
+{
+	flight_log_packed_record_t *header =
+	    reinterpret_cast<flight_log_packed_record_t *>(packed_record);
+	header->offset = offset;
+
+	size_t crc_offset = sizeof(*header) + header->payload_size;
+	uint32_t crc = flight_log_crc32(packed_record, crc_offset);
+	memcpy(&packed_record[crc_offset], &crc, sizeof(crc));
+	memset(&packed_record[crc_offset + sizeof(crc)], 0, size - crc_offset - sizeof(crc));
+}
+
+/**
+ * Appends a record to a packed log.
+ * @param record The record to append
+ *
+ * @return 0 on success, -X on failure with failure code
+ */
+int8_t FLIGHT_LOG_WRITER::append_packed(const flight_log_record_t *record)
+{
+	if (ring_header != nullptr)
+	{
+		uint64_t capacity = ring_header->ring_capacity;
+		size_t size = pack(record, ring_header->write_count);
+		uint64_t pos = ring_header->write_offset % capacity;
+		if (pos + size > capacity)
+		{
+			// the cursor moves past the zeroed end before the record goes in, so a crash
+			// in between leaves the record right at the cursor for recover_packed_ring()
+			memset(&ring_bytes[pos], 0, (size_t)(capacity - pos));
+			ring_header->write_offset += capacity - pos;
+			pos = 0;
+		}
+		seal(size, ring_header->write_offset);
+		memcpy(&ring_bytes[pos], packed_record, size);
+		ring_header->write_offset += size;
+		ring_header->write_count++;
+		return 0;
+	}
+
+	if (writer == nullptr)
+		return -1;
+
+	size_t size = pack(record, record_count);
+	seal(size, write_offset);
+	if (async_writer_write(writer, packed_record, size) != 0)
+	{
+		have_reference = false; // the next record cannot refer to one that was dropped
+		return -2;
+	}
+	write_offset += size;
+	record_count++;
+	return 0;
+}
+
+/**
+ * Asks for every record appended so far to be written and fsynced, without waiting for it.
+ */
+void FLIGHT_LOG_WRITER::sync()
+{
+	if (writer != nullptr)
+		async_writer_sync(writer);
+	else if (ring_header != nullptr)
+		sync_file_range(fd, 0, 0, SYNC_FILE_RANGE_WRITE); // start writeback of dirty pages
+}
+
+/**
+ * Writes out every queued record and closes the file.
+ */
+void FLIGHT_LOG_WRITER::close()
+{
+	if (writer != nullptr)
+	{
+		struct async_writer_stats stats;
+		async_writer_get_stats(writer, &stats);
+		async_writer_destroy(writer); // also closes fd
+		writer = nullptr;
+		fd = -1;
+
+		if (packed && (stats.bytes_dropped > 0 || stats.write_errors > 0))
+		{
+			logging_write(LOG_WARN, "flight_log: dropped %llu bytes of records, %u write errors",
+			              (unsigned long long)stats.bytes_dropped, stats.write_errors);
+		}
+		else if (stats.bytes_dropped > 0 || stats.write_errors > 0)
+		{
+			logging_write(LOG_WARN, "flight_log: dropped %llu records, %u write errors",
+			              (unsigned long long)(stats.bytes_dropped / sizeof(flight_log_record_t)),
+			              stats.write_errors);
+		}
+	}
+	else if (fd >= 0)
+	{
+		if (ring_header != nullptr)
+		{
+			msync(ring_header, map_size, MS_SYNC);
+			munmap(ring_header, map_size);
+			ring_header = nullptr;
+			ring_records = nullptr;
+			ring_bytes = nullptr;
+			map_size = 0;
+		}
+		::close(fd);
+		fd = -1;
+	}
+}
+
+bool FLIGHT_LOG_WRITER::is_open() const
+{
+	return writer != nullptr || ring_header != nullptr;
+}
@@ -0,0 +1,128 @@
+/**
+ *
+ * Name: spectrum_codec.cpp
+ * Author: Hubert Dang
+ *
+ * This file implements the functions declared in spectrum_codec.hpp
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "storage/spectrum_codec.hpp"
+#include <algorithm>
+#include <cstring>
+
+// Maps 0, -1, 1, -2, 2... to 0, 1, 2, 3, 4...
+static inline uint32_t zigzag(int32_t delta)
+{
+	return (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t value)
+{
+	return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+static inline size_t block_bytes(size_t count, unsigned width)
+{
+	return (count * width + 7) / 8;
+}
+
+int spectrum_encode(const uint16_t *bins, const uint16_t *reference, size_t num_bins, uint8_t *out,
+                    size_t out_size)
+{
+	if (bins == nullptr || out == nullptr)
+		return -1;
+
+	size_t pos = 0;
+	int32_t previous = 0; // keyframes start from 0
+	for (size_t start = 0; start < num_bins; start += SPECTRUM_CODEC_BLOCK_BINS)
+	{
+		size_t count = std::min<size_t>(SPECTRUM_CODEC_BLOCK_BINS, num_bins - start);
+		uint32_t deltas[SPECTRUM_CODEC_BLOCK_BINS];
+		uint32_t all = 0;
+		for (size_t k = 0; k < count; k++)
+		{
+			int32_t value = bins[start + k];
+			int32_t base = reference != nullptr ? reference[start + k] : previous;
+			deltas[k] = zigzag(value - base);
+			all |= deltas[k];
+			previous = value;
+		}
+
+		unsigned width = all == 0 ? 0 : 32 - __builtin_clz(all);
+		if (pos + 1 + block_bytes(count, width) > out_size)
+			return -2;
+
+		out[pos++] = static_cast<uint8_t>(width);
+		uint64_t acc = 0;
+		unsigned bits = 0;
+		for (size_t k = 0; k < count; k++)
+		{
+			acc |= static_cast<uint64_t>(deltas[k]) << bits;
+			bits += width;
+			while (bits >= 8)
+			{
+				out[pos++] = static_cast<uint8_t>(acc);
+				acc >>= 8;
+				bits -= 8;
+			}
+		}
+		if (bits > 0)
+			out[pos++] = static_cast<uint8_t>(acc);
+	}
+	return static_cast<int>(pos);
+}
+
+int spectrum_decode(const uint8_t *data, size_t len, const uint16_t *reference, size_t num_bins,
+                    uint16_t *bins)
+{
+	if (data == nullptr || bins == nullptr)
+		return -1;
+
+	size_t pos = 0;
+	int32_t previous = 0;
+	for (size_t start = 0; start < num_bins; start += SPECTRUM_CODEC_BLOCK_BINS)
+	{
+		size_t count = std::min<size_t>(SPECTRUM_CODEC_BLOCK_BINS, num_bins - start);
+		if (pos >= len)
+			return -2;
+		unsigned width = data[pos++];
+		if (width > SPECTRUM_CODEC_MAX_WIDTH || pos + block_bytes(count, width) > len)
+			return -2;
+
+		// most blocks between two frames of the same stop barely change, if at all
+		if (width == 0 && reference != nullptr)
+		{
+			memcpy(&bins[start], &reference[start], count * sizeof(bins[0]));
+			continue;
+		}
+
+		const uint8_t *block = &data[pos];
+		pos += block_bytes(count, width);
+		uint32_t mask = (1u << width) - 1;
+		uint64_t acc = 0;
+		unsigned bits = 0;
+		for (size_t k = 0; k < count; k++)
+		{
+			while (bits < width)
+			{
+				acc |= static_cast<uint64_t>(*block++) << bits;
+				bits += 8;
+			}
+			int32_t delta = unzigzag(static_cast<uint32_t>(acc) & mask);
+			acc >>= width;
+			bits -= width;
+
+			int32_t base = reference != nullptr ? reference[start + k] : previous;
+			int32_t value = base + delta;
+			if (value < 0 || value > UINT16_MAX)
+				return -2;
+			bins[start + k] = static_cast<uint16_t>(value);
+			previous = value;
+		}
+	}
+	return static_cast<int>(pos);
+}
@@ -0,0 +1,347 @@
+/**
+ * Name: ingest.cpp
+ * Author: Hubert Dang
+ *
+ * Post-flight ingest for the webapp. Turns a flight CSV (see storage/flight_csv.hpp) into
+ * PostgreSQL COPY text files for raw_measurements and cleaned_measurements, with the board's
+ * own bin parser and thickness estimator.
+ *
+ * The file is mapped into memory and split into chunks at row boundaries, and a pool of
+ * threads takes chunks off a shared counter: first to count the rows of each chunk, so every
+ * row gets its raw_id before anything is parsed, then to parse, estimate and format them. The
+ * chunks' output is written in file order, so the COPY files are the same for any number of
+ * threads.
+ *
+ * raw_id is first_raw_id plus the row's line number, counted from 0, so malformed rows leave
+ * gaps. A cleaned measurement is written for each row whose spectrum has an ice estimate.
+ *
+ *     raw_measurements.copy:     raw_id, flight_id, timestamp, coordinates, temperature, fft
+ *     cleaned_measurements.copy: flight_id, raw_id, timestamp, coordinates, thickness,
+ *                                quality_score
+ *
+ * coordinates is a point (longitude, latitude), thickness is in cm and quality_score is the
+ * share of the weaker reflection's peak that stands out of the spectrum around it, 0 to 1.
+ * A JSON summary goes to stdout and malformed rows are reported on stderr.
+ *
+ * Usage: ./snow_angel_ingest flight.csv flight_id first_raw_id output_dir [threads]
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include "common/clock.h"
+#include "dsp/ice_thickness.hpp"
+#include "storage/flight_csv.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#define INGEST_MIN_CHUNK_BYTES (64u << 10)
+#define INGEST_MAX_CHUNK_BYTES (4u << 20)
+#define INGEST_CHUNKS_PER_THREAD 4 // so a slow chunk does not hold up the others
+#define INGEST_MAX_REPORTED_ROWS 10
+
+#define RAW_COPY_FILE "raw_measurements.copy"
+#define CLEANED_COPY_FILE "cleaned_measurements.copy"
+
+struct chunk
+{
+	size_t begin; // byte range in the file, from the start of a row
+	size_t end;
+	uint64_t num_lines;
+	uint64_t first_line; // line number of the chunk's first row
+
+	uint64_t num_raw;
+	uint64_t num_cleaned;
+	uint64_t num_bad;
+	std::string raw_copy;
+	std::string cleaned_copy;
+};
+
+struct ingest_job
+{
+	const char *text;
+	size_t len;
+	uint64_t flight_id;
+	uint64_t first_raw_id;
+	std::vector<chunk> chunks;
+	std::atomic<size_t> next_chunk;
+	std::atomic<unsigned> num_reported;
+};
+
+//----------------------------------------------------------------
+
+/* Runs work on every chunk, spread over num_threads threads. */
+template <typename FN>
+static void for_each_chunk(ingest_job *job, unsigned num_threads, FN work)
+{
+	job->next_chunk.store(0);
+	auto worker = [job, &work]
+	{
+		size_t i;
+		while ((i = job->next_chunk.fetch_add(1)) < job->chunks.size())
+			work(&job->chunks[i]);
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned t = 1; t < num_threads; t++)
+		threads.emplace_back(worker);
+	worker();
+	for (std::thread &thread : threads)
+		thread.join();
+}
+
+static void count_lines(const ingest_job *job, chunk *c)
+{
+	const char *p = job->text + c->begin;
+	const char *end = job->text + c->end;
+	c->num_lines = 0;
+	while (p < end)
+	{
+		const char *newline = static_cast<const char *>(memchr(p, '\n', end - p));
+		c->num_lines++;
+		p = newline != nullptr ? newline + 1 : end;
+	}
+}
+
+static void append_uint(std::string *out, uint64_t value)
+{
+	char digits[20];
+	std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+	out->append(digits, result.ptr - digits);
+}
+
+static void append_format(std::string *out, const char *format, double value)
+{
+	char text[32];
+	int len = snprintf(text, sizeof(text), format, value);
+	out->append(text, len);
+}
+
+/* Appends the columns both tables share: timestamp, coordinates */
+static void append_when_where(std::string *out, const flight_csv_row_t *row)
+{
+	out->append(row->timestamp, FLIGHT_CSV_TIMESTAMP_SIZE);
+	out->append("\t(");
+	append_format(out, "%.6f", row->longitude);
+	out->push_back(',');
+	append_format(out, "%.6f", row->latitude);
+	out->append(")\t");
+}
+
+static void ingest_row(const ingest_job *job, chunk *c, const flight_csv_row_t *row,
+                       uint64_t raw_id)
+{
+	std::string *raw = &c->raw_copy;
+	append_uint(raw, raw_id);
+	raw->push_back('\t');
+	append_uint(raw, job->flight_id);
+	raw->push_back('\t');
+	append_when_where(raw, row);
+	append_format(raw, "%.2f", row->temperature);
+	raw->append("\t{");
+	for (size_t i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+	{
+		if (i > 0)
+			raw->push_back(',');
+		append_uint(raw, row->bins[i]);
+	}
+	raw->append("}\n");
+	c->num_raw++;
+
+	ice_thickness_estimate_t estimate;
+	if (ice_thickness_estimate(row->bins, FMCW_RADAR_FFT_SIZE, &estimate) != 0)
+		return;
+
+	// how far the weaker reflection stands out of the spectrum around it
+	float quality = 0.0f;
+	if (estimate.surface.magnitude > 0.0f && estimate.bottom.magnitude > 0.0f)
+		quality = std::min(estimate.surface.prominence / estimate.surface.magnitude,
+		                   estimate.bottom.prominence / estimate.bottom.magnitude);
+	quality = std::clamp(quality, 0.0f, 1.0f);
+
+	std::string *cleaned = &c->cleaned_copy;
+	append_uint(cleaned, job->flight_id);
+	cleaned->push_back('\t');
+	append_uint(cleaned, raw_id);
+	cleaned->push_back('\t');
+	append_when_where(cleaned, row);
+	append_format(cleaned, "%.2f", estimate.thickness_m * 100.0f);
+	cleaned->push_back('\t');
+	append_format(cleaned, "%.3f", quality);
+	cleaned->push_back('\n');
+	c->num_cleaned++;
+}
+
+static void ingest_chunk(ingest_job *job, chunk *c)
+{
+	// formatted rows are about the size of the CSV's
+	c->raw_copy.reserve(c->end - c->begin + (c->end - c->begin) / 8);
+	c->cleaned_copy.reserve(c->num_lines * 64);
+
+	flight_csv_row_t row;
+	const char *p = job->text + c->begin;
+	const char *end = job->text + c->end;
+	for (uint64_t line = c->first_line; p < end; line++)
+	{
+		const char *newline = static_cast<const char *>(memchr(p, '\n', end - p));
+		const char *line_end = newline != nullptr ? newline : end;
+		size_t len = line_end - p;
+
+		if (len > 0 && !(len == 1 && *p == '\r')) // blank lines are skipped quietly
+		{
+			int8_t rc = flight_csv_parse_row(p, len, &row);
+			if (rc == 0)
+			{
+				ingest_row(job, c, &row, job->first_raw_id + line);
+			}
+			else
+			{
+				c->num_bad++;
+				if (job->num_reported.fetch_add(1) < INGEST_MAX_REPORTED_ROWS)
+					fprintf(stderr, "[WARN] line %" PRIu64 " skipped, rc %d\n", line + 1, rc);
+			}
+		}
+		p = newline != nullptr ? newline + 1 : end;
+	}
+}
+
+static int8_t write_all(int fd, const std::string &data)
+{
+	const char *p = data.data();
+	size_t left = data.size();
+	while (left > 0)
+	{
+		ssize_t n = write(fd, p, left);
+		if (n < 0)
+			return -1;
+		p += n;
+		left -= n;
+	}
+	return 0;
+}
+
+static int open_output(const char *dir, const char *name)
+{
+	std::string path = std::string(dir) + "/" + name;
+	int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		fprintf(stderr, "[ERROR] Failed to create %s: %s\n", path.c_str(), strerror(errno));
+	return fd;
+}
+
+static bool parse_uint(const char *text, uint64_t *value)
+{
+	const char *end = text + strlen(text);
+	std::from_chars_result result = std::from_chars(text, end, *value);
+	return result.ec == std::errc() && result.ptr == end && end != text;
+}
+
+//----------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+	uint64_t flight_id, first_raw_id, num_threads = std::thread::hardware_concurrency();
+	if ((argc != 5 && argc != 6) || !parse_uint(argv[2], &flight_id) ||
+	    !parse_uint(argv[3], &first_raw_id) || (argc == 6 && !parse_uint(argv[5], &num_threads)))
+	{
+		fprintf(stderr, "Usage: %s flight.csv flight_id first_raw_id output_dir [threads]\n",
+		        argv[0]);
+		return 1;
+	}
+	num_threads = std::clamp<uint64_t>(num_threads, 1, 256);
+	uint64_t start_nsec = clock_monotonic_nsec();
+
+	int fd = open(argv[1], O_RDONLY);
+	struct stat st;
+	if (fd < 0 || fstat(fd, &st) != 0)
+	{
+		fprintf(stderr, "[ERROR] Failed to open %s: %s\n", argv[1], strerror(errno));
+		return 1;
+	}
+
+	ingest_job job;
+	job.len = static_cast<size_t>(st.st_size);
+	job.text = "";
+	job.flight_id = flight_id;
+	job.first_raw_id = first_raw_id;
+	job.num_reported.store(0);
+	if (job.len > 0)
+	{
+		void *map = mmap(nullptr, job.len, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map == MAP_FAILED)
+		{
+			fprintf(stderr, "[ERROR] Failed to map %s: %s\n", argv[1], strerror(errno));
+			return 1;
+		}
+		madvise(map, job.len, MADV_WILLNEED);
+		job.text = static_cast<const char *>(map);
+	}
+	close(fd); // the mapping keeps the file
+
+	// split at row boundaries, a chunk grows past chunk_bytes to end its last row
+	size_t chunk_bytes = job.len / (num_threads * INGEST_CHUNKS_PER_THREAD);
+	chunk_bytes = std::clamp<size_t>(chunk_bytes, INGEST_MIN_CHUNK_BYTES, INGEST_MAX_CHUNK_BYTES);
+	for (size_t begin = 0; begin < job.len;)
+	{
+		size_t end = flight_csv_row_start(job.text, job.len, begin + chunk_bytes);
+		job.chunks.push_back({});
+		job.chunks.back().begin = begin;
+		job.chunks.back().end = end;
+		begin = end;
+	}
+
+	for_each_chunk(&job, num_threads, [&job](chunk *c) { count_lines(&job, c); });
+	uint64_t num_lines = 0;
+	for (chunk &c : job.chunks)
+	{
+		c.first_line = num_lines;
+		num_lines += c.num_lines;
+	}
+	for_each_chunk(&job, num_threads, [&job](chunk *c) { ingest_chunk(&job, c); });
+
+	int raw_fd = open_output(argv[4], RAW_COPY_FILE);
+	int cleaned_fd = open_output(argv[4], CLEANED_COPY_FILE);
+	if (raw_fd < 0 || cleaned_fd < 0)
+		return 1;
+
+	uint64_t num_raw = 0, num_cleaned = 0, num_bad = 0;
+	for (chunk &c : job.chunks)
+	{
+		if (write_all(raw_fd, c.raw_copy) != 0 || write_all(cleaned_fd, c.cleaned_copy) != 0)
+		{
+			fprintf(stderr, "[ERROR] Failed to write the COPY files: %s\n", strerror(errno));
+			return 1;
+		}
+		num_raw += c.num_raw;
+		num_cleaned += c.num_cleaned;
+		num_bad += c.num_bad;
+		std::string().swap(c.raw_copy); // done with it
+		std::string().swap(c.cleaned_copy);
+	}
+	if (close(raw_fd) != 0 || close(cleaned_fd) != 0)
+	{
+		fprintf(stderr, "[ERROR] Failed to write the COPY files: %s\n", strerror(errno));
+		return 1;
+	}
+
+	printf("{\"raw_rows\": %" PRIu64 ", \"cleaned_rows\": %" PRIu64 ", \"bad_rows\": %" PRIu64
+	       ", \"next_raw_id\": %" PRIu64 ", \"threads\": %" PRIu64 ", \"chunks\": %zu"
+	       ", \"elapsed_ms\": %.1f}\n",
+	       num_raw, num_cleaned, num_bad, first_raw_id + num_lines, num_threads,
+	       job.chunks.size(), (clock_monotonic_nsec() - start_nsec) / 1e6);
+	return 0;
+}
@@ -12,6 +12,7 @@
 #include <cassert>
 #include <cstdio>
 #include <cstdint>
+#include <unistd.h>
 #include "bsp/temperature_sensor.hpp"
 
 int main()
@@ -30,6 +31,28 @@ int main()
     assert(read_result == 0);
     assert(temperature_data.temperature > -40.0f && temperature_data.temperature < 125.0f); // Assuming valid range for TMP117
 
+    // Test reads within one conversion cycle return the same sample
+    temp_sensor_data_t repeat_data;
+    assert(sensor->temperature_sensor_read(&repeat_data) == 0);
+    assert(repeat_data.timestamp_usec == temperature_data.timestamp_usec);
+    assert(repeat_data.temperature == temperature_data.temperature);
+
+    // Test the next conversion cycle gives a new sample
+    usleep(260000);
+    assert(sensor->temperature_sensor_read(&repeat_data) == 0);
+    assert(repeat_data.timestamp_usec >= temperature_data.timestamp_usec + 250000);
+
+    // Test batch reads take one sample per conversion, and only finished ones without waiting
+    temp_sensor_data_t samples[3];
+    assert(sensor->temperature_sensor_try_read_samples(samples, 3) == 0);
+    assert(sensor->temperature_sensor_read_samples(samples, 3) == 3);
+    assert(samples[0].timestamp_usec >= repeat_data.timestamp_usec + 250000);
+    assert(samples[2].timestamp_usec >= samples[1].timestamp_usec + 250000);
+    assert(sensor->temperature_sensor_try_read_samples(samples, 3) == 0);
+    usleep(260000);
+    assert(sensor->temperature_sensor_try_read_samples(samples, 3) == 1);
+    assert(sensor->temperature_sensor_read_samples(nullptr, 3) < 0);
+
     printf("All tests passed successfully.\n");
     return 0;
 }
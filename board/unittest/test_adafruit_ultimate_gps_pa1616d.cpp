@@ -0,0 +1,70 @@
+/**
+ * Name: test_adafruit_ultimate_gps_pa1616d.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the adafruit_ultimate_gps_pa1616d.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <unistd.h>
+#include "bsp/gps.hpp"
+
+int main(void)
+{
+    // Test instance creation
+    GPS *gps = instantiate_gps();
+    assert(gps != nullptr);
+
+    // Test initialization, the simulated module sends 10 fixes a second
+    assert(gps->gps_init() == 0);
+    usleep(450000);
+
+    // Test a batch read returns every fix so far, oldest first
+    gps_data_t fixes[32];
+    int num_fixes = gps->gps_read_fixes(fixes, 32);
+    assert(num_fixes >= 3);
+    for (int i = 1; i < num_fixes; i++)
+    {
+        assert(fixes[i].sequence == fixes[i - 1].sequence + 1);
+        assert(fixes[i].timestamp_usec > fixes[i - 1].timestamp_usec);
+    }
+
+    // Test the latest fix is the newest of the batch, and nothing is returned twice
+    gps_data_t latest;
+    assert(gps->gps_read(&latest) == 0);
+    assert(latest.sequence >= fixes[num_fixes - 1].sequence);
+    uint32_t last_sequence = fixes[num_fixes - 1].sequence;
+    num_fixes = gps->gps_read_fixes(fixes, 32);
+    assert(num_fixes >= 0);
+    if (num_fixes > 0)
+        assert(fixes[0].sequence == last_sequence + 1);
+
+    // Test a small batch leaves the rest for the next call
+    usleep(350000);
+    last_sequence = num_fixes > 0 ? fixes[num_fixes - 1].sequence : last_sequence;
+    assert(gps->gps_read_fixes(fixes, 1) == 1);
+    assert(fixes[0].sequence == last_sequence + 1);
+    assert(gps->gps_read_fixes(fixes, 1) == 1);
+    assert(fixes[0].sequence == last_sequence + 2);
+    last_sequence = fixes[0].sequence;
+
+    // Test a reader that falls far behind skips the oldest fixes
+    usleep(2500000);
+    num_fixes = gps->gps_read_fixes(fixes, 32);
+    assert(num_fixes > 1 && num_fixes < 20);
+    assert(fixes[0].sequence > last_sequence + 1);
+    for (int i = 1; i < num_fixes; i++)
+        assert(fixes[i].sequence == fixes[i - 1].sequence + 1);
+
+    // Test bad arguments
+    assert(gps->gps_read_fixes(nullptr, 32) < 0);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
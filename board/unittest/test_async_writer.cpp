@@ -0,0 +1,83 @@
+/**
+ * Name: test_async_writer.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the async_writer.c background writer
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "common/async_writer.h"
+
+static const char *TEST_FILE = "./test_async_writer.bin";
+
+static off_t file_size(const char *path)
+{
+    struct stat st;
+    if (stat(path, &st) != 0)
+        return -1;
+    return st.st_size;
+}
+
+int main(void)
+{
+    unlink(TEST_FILE);
+
+    struct async_writer_config config = {};
+    config.buffer_size = 1024;
+    config.flush_interval_ms = 10;
+    config.fsync_interval_ms = 50;
+
+    // Test bad arguments
+    assert(async_writer_create(-1, &config) == NULL);
+
+    // Test bytes arrive in order after destroy
+    int fd = open(TEST_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    assert(fd >= 0);
+    struct async_writer *writer = async_writer_create(fd, &config);
+    assert(writer != NULL);
+
+    char chunk[100];
+    for (int i = 0; i < 5; i++)
+    {
+        memset(chunk, 'a' + i, sizeof(chunk));
+        assert(async_writer_write(writer, chunk, sizeof(chunk)) == 0);
+    }
+
+    // Test the flush interval writes without being asked
+    for (int i = 0; i < 100 && file_size(TEST_FILE) != 500; i++)
+        usleep(10000);
+    assert(file_size(TEST_FILE) == 500);
+
+    // Test a write larger than the buffer is dropped and counted
+    char big[2048] = {};
+    assert(async_writer_write(writer, big, sizeof(big)) < 0);
+
+    async_writer_sync(writer);
+    struct async_writer_stats stats;
+    async_writer_get_stats(writer, &stats);
+    assert(stats.bytes_dropped == sizeof(big));
+    async_writer_destroy(writer);
+
+    FILE *file = fopen(TEST_FILE, "rb");
+    assert(file != NULL);
+    char contents[600];
+    assert(fread(contents, 1, sizeof(contents), file) == 500);
+    fclose(file);
+    for (int i = 0; i < 5; i++)
+        for (int j = 0; j < 100; j++)
+            assert(contents[i * 100 + j] == 'a' + i);
+
+    unlink(TEST_FILE);
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * Name: test_coverage_grid.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the coverage_grid.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include "nav/coverage_grid.hpp"
+
+#define ORIGIN_LAT 45.3848
+#define ORIGIN_LON -75.7047
+#define CELL_SIZE_M 5.0
+
+static coverage_grid_t grid;
+static enu_origin_t origin;
+
+// Latitude and longitude of a point east_m and north_m from the origin
+static void offset(double east_m, double north_m, double *lat, double *lon)
+{
+    *lat = ORIGIN_LAT + north_m / origin.meters_per_deg_lat;
+    *lon = ORIGIN_LON + east_m / origin.meters_per_deg_lon;
+}
+
+static const coverage_cell_t *add(double east_m, double north_m, double thickness_m,
+                                  double half_width_m)
+{
+    double lat, lon;
+    offset(east_m, north_m, &lat, &lon);
+    return coverage_grid_add_stop(&grid, lat, lon, thickness_m, half_width_m);
+}
+
+static const coverage_cell_t *at(double east_m, double north_m)
+{
+    double lat, lon;
+    offset(east_m, north_m, &lat, &lon);
+    return coverage_grid_cell_at(&grid, lat, lon);
+}
+
+int main(void)
+{
+    enu_origin_init(&origin, ORIGIN_LAT, ORIGIN_LON);
+    coverage_grid_init(&grid, CELL_SIZE_M);
+
+    // Test an empty grid has nothing to report
+    const coverage_cell_t *cells[4];
+    double distance_m;
+    assert(at(0, 0) == nullptr);
+    assert(coverage_grid_nearest(&grid, ORIGIN_LAT, ORIGIN_LON, 100, &distance_m) == nullptr);
+    assert(coverage_grid_most_uncertain(&grid, cells, 4) == 0);
+
+    // Test stops in one cell are accumulated, the first stop is the grid's origin
+    const coverage_cell_t *cell = add(0, 0, 0.30, 0.003);
+    assert(cell != nullptr && cell->num_stops == 1);
+    assert(std::fabs(coverage_cell_uncertainty_m(cell) - 0.003) < 1e-12);
+    assert(add(3, 2, 0.31, 0.004) == cell);
+    assert(cell->num_stops == 2);
+    assert(std::fabs(cell->mean_m - 0.305) < 1e-9);
+    assert(std::fabs(cell->east_m - 1.5) < 0.01 && std::fabs(cell->north_m - 1.0) < 0.01);
+    assert(std::fabs(coverage_cell_uncertainty_m(cell) - 0.01 / std::sqrt(2.0)) < 1e-6);
+    assert(grid.num_cells == 1);
+
+    // Test lookups find the cell anywhere inside it, and only inside it
+    assert(at(0.1, 0.1) == cell && at(4.9, 4.9) == cell);
+    assert(at(5.1, 1) == nullptr && at(1, 5.1) == nullptr);
+    assert(at(-0.1, 1) == nullptr); // cells left of the origin have negative indices
+
+    // Test neighbours get cells of their own
+    const coverage_cell_t *west = add(-1, 1, 0.40, 0.002);
+    assert(west != nullptr && west != cell && west->east_index == -1);
+    assert(at(-0.1, 1) == west);
+    assert(grid.num_cells == 2);
+
+    // Test the nearest cell is the one whose stops are closest
+    double lat, lon;
+    offset(21.5, 1, &lat, &lon);
+    assert(coverage_grid_nearest(&grid, lat, lon, 30, &distance_m) == cell);
+    assert(std::fabs(distance_m - 20.0) < 0.01);
+    assert(coverage_grid_nearest(&grid, lat, lon, 15, &distance_m) == nullptr);
+    offset(-6, 1, &lat, &lon); // west's only stop is at (-1, 1)
+    assert(coverage_grid_nearest(&grid, lat, lon, 30, &distance_m) == west);
+    assert(std::fabs(distance_m - 5.0) < 0.01);
+
+    // Test the most uncertain cells come first, a single estimate counts as unknown
+    const coverage_cell_t *unknown = add(50, 50, 0.20, INFINITY);
+    const coverage_cell_t *spread = add(-50, 0, 0.10, 0.001);
+    assert(add(-50, 1, 0.20, 0.001) == spread);
+    assert(coverage_grid_most_uncertain(&grid, cells, 4) == 4);
+    assert(cells[0] == unknown && cells[1] == spread && cells[2] == cell && cells[3] == west);
+    assert(coverage_grid_most_uncertain(&grid, cells, 2) == 2);
+    assert(cells[0] == unknown && cells[1] == spread);
+
+    // Test a full grid refuses new cells but keeps updating the ones it has
+    size_t added = 0;
+    for (int i = 0; add(1000 + 10.0 * (i % 64), 1000 + 10.0 * (i / 64), 0.3, 0.003); i++)
+        added++;
+    assert(grid.num_cells == COVERAGE_GRID_MAX_CELLS);
+    assert(added == COVERAGE_GRID_MAX_CELLS - 4);
+    assert(add(1, 1, 0.30, 0.003) == cell && cell->num_stops == 3);
+    assert(at(1000, 1000) != nullptr && at(-500, -500) == nullptr);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
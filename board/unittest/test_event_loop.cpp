@@ -0,0 +1,139 @@
+/**
+ * Name: test_event_loop.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the event_loop.c epoll loop
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <unistd.h>
+#include "common/clock.h"
+#include "common/event_loop.h"
+
+struct counter
+{
+    int calls;
+    int fd;
+    struct event_loop *loop;
+};
+
+static void count_call(void *ctx)
+{
+    ((struct counter *)ctx)->calls++;
+}
+
+static void drain_one(void *ctx)
+{
+    struct counter *counter = (struct counter *)ctx;
+    counter->calls++;
+    assert(event_fd_drain(counter->fd) == 1);
+}
+
+static void remove_self(void *ctx)
+{
+    struct counter *counter = (struct counter *)ctx;
+    counter->calls++;
+    event_loop_remove_fd(counter->loop, counter->fd);
+}
+
+static void stop_loop(void *ctx)
+{
+    struct counter *counter = (struct counter *)ctx;
+    counter->calls++;
+    if (counter->calls == 3)
+        event_loop_stop(counter->loop);
+}
+
+int main(void)
+{
+    struct event_loop *loop = event_loop_create();
+    assert(loop != NULL);
+
+    // Test bad arguments
+    assert(event_loop_add_fd(loop, -1, count_call, NULL) < 0);
+    assert(event_loop_add_fd(loop, 0, NULL, NULL) < 0);
+
+    // Test nothing is dispatched when nothing is ready
+    assert(event_loop_run_once(loop, 0) == 0);
+
+    // Test a one-shot timer fires once, after its delay
+    struct counter oneshot = {};
+    int timer = event_loop_add_timer(loop, count_call, &oneshot);
+    assert(timer >= 0);
+    assert(event_loop_arm_timer(loop, timer, 20000, 0) == 0);
+    uint64_t start_usec = clock_monotonic_usec();
+    assert(event_loop_run_once(loop, 1000) == 1);
+    assert(clock_monotonic_usec() - start_usec >= 19000);
+    assert(oneshot.calls == 1);
+    assert(event_loop_run_once(loop, 50) == 0);
+
+    // Test a disarmed timer does not fire
+    assert(event_loop_arm_timer(loop, timer, 10000, 0) == 0);
+    assert(event_loop_arm_timer(loop, timer, 0, 0) == 0);
+    assert(event_loop_run_once(loop, 30) == 0);
+    assert(oneshot.calls == 1);
+    event_loop_remove_timer(loop, timer);
+
+    // Test a periodic timer keeps firing until the loop is stopped
+    struct counter periodic = {};
+    periodic.loop = loop;
+    timer = event_loop_add_timer(loop, stop_loop, &periodic);
+    assert(event_loop_arm_timer(loop, timer, 5000, 5000) == 0);
+    assert(event_loop_run(loop) == 0);
+    assert(periodic.calls == 3);
+    event_loop_remove_timer(loop, timer);
+
+    // Test a semaphore eventfd wakes the loop once per signal
+    struct counter semaphore = {};
+    semaphore.fd = event_fd_create(true);
+    assert(semaphore.fd >= 0);
+    assert(event_loop_add_fd(loop, semaphore.fd, drain_one, &semaphore) == 0);
+    for (int i = 0; i < 3; i++)
+        event_fd_signal(semaphore.fd);
+    for (int i = 0; i < 3; i++)
+        assert(event_loop_run_once(loop, 100) == 1);
+    assert(semaphore.calls == 3);
+    assert(event_loop_run_once(loop, 0) == 0);
+    event_loop_remove_fd(loop, semaphore.fd);
+
+    // Test a plain eventfd is drained by one read
+    int notify = event_fd_create(false);
+    event_fd_signal(notify);
+    event_fd_signal(notify);
+    assert(event_fd_drain(notify) == 2);
+    assert(event_fd_drain(notify) == 0);
+    close(notify);
+
+    // Test a source removed by a callback is not dispatched again
+    struct counter removed = {};
+    removed.loop = loop;
+    removed.fd = semaphore.fd;
+    assert(event_loop_add_fd(loop, semaphore.fd, remove_self, &removed) == 0);
+    event_fd_signal(semaphore.fd);
+    assert(event_loop_run_once(loop, 100) == 1);
+    assert(event_loop_run_once(loop, 20) == 0);
+    assert(removed.calls == 1);
+    close(semaphore.fd);
+
+    // Test the loop refuses more sources than it has slots for
+    int fds[EVENT_LOOP_MAX_SOURCES + 1];
+    int added = 0;
+    for (int i = 0; i <= EVENT_LOOP_MAX_SOURCES; i++)
+    {
+        fds[i] = event_fd_create(false);
+        if (event_loop_add_fd(loop, fds[i], count_call, NULL) == 0)
+            added++;
+    }
+    assert(added == EVENT_LOOP_MAX_SOURCES);
+    for (int i = 0; i <= EVENT_LOOP_MAX_SOURCES; i++)
+        close(fds[i]);
+
+    event_loop_destroy(loop);
+    printf("All tests passed successfully.\n");
+    return 0;
+}
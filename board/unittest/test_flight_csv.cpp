@@ -0,0 +1,84 @@
+/**
+ * Name: test_flight_csv.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the flight_csv.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "storage/flight_csv.hpp"
+
+// A row with num_bins bins, bin i is i * 7 % 1000
+static std::string make_row(const char *prefix, size_t num_bins)
+{
+    std::string row = prefix;
+    for (size_t i = 0; i < num_bins; i++)
+        row += "," + std::to_string(i * 7 % 1000);
+    return row;
+}
+
+static int8_t parse(const std::string &line, flight_csv_row_t *row)
+{
+    return flight_csv_parse_row(line.data(), line.size(), row);
+}
+
+int main(void)
+{
+    const char *PREFIX = "2025-11-20 14:05:09,45.384980,-75.704700,-12.24";
+    flight_csv_row_t row;
+
+    // Test a row as flight_log_to_csv.py writes it
+    std::string line = make_row(PREFIX, FMCW_RADAR_FFT_SIZE);
+    assert(parse(line, &row) == 0);
+    assert(strcmp(row.timestamp, "2025-11-20 14:05:09") == 0);
+    assert(std::fabs(row.latitude - 45.38498) < 1e-9);
+    assert(std::fabs(row.longitude + 75.7047) < 1e-9);
+    assert(std::fabs(row.temperature + 12.24f) < 1e-5f);
+    for (size_t i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+        assert(row.bins[i] == i * 7 % 1000);
+
+    // Test Windows line endings
+    assert(parse(line + "\r", &row) == 0);
+
+    // Test invalid arguments and malformed rows
+    assert(flight_csv_parse_row(nullptr, 10, &row) == -1);
+    assert(flight_csv_parse_row(line.data(), line.size(), nullptr) == -1);
+    assert(parse("", &row) == -2);
+    assert(parse(make_row("2025-11-20T14:05:09,45.38,-75.70,-12.2", 512), &row) == -2);
+    assert(parse(make_row("2025-11-2 14:05:09,45.38,-75.70,-12.2", 512), &row) == -2);
+    assert(parse(make_row("2025-11-20 14:05:09,north,-75.70,-12.2", 512), &row) == -3);
+    assert(parse(make_row("2025-11-20 14:05:09,45.38,-75.70x,-12.2", 512), &row) == -3);
+    assert(parse(make_row("2025-11-20 14:05:09, 45.38,-75.70,-12.2", 512), &row) == -3);
+    assert(parse(make_row("2025-11-20 14:05:09,45.38,,-12.2", 512), &row) == -3);
+    assert(parse(make_row("2025-11-20 14:05:09,45.3800000000000000000000000000001,-75.70,-12.2",
+                          512), &row) == -3); // longer than any number written
+    assert(parse(make_row("2025-11-20 14:05:09,45.38,-75.70", 512), &row) == -4);
+    assert(parse("2025-11-20 14:05:09,45.38,-75.70", &row) == -3); // no bins at all
+    assert(parse(make_row(PREFIX, FMCW_RADAR_FFT_SIZE - 1), &row) == -4);
+    assert(parse(make_row(PREFIX, FMCW_RADAR_FFT_SIZE + 1), &row) == -4);
+    assert(parse(line + ",", &row) == -4);
+
+    // Test splitting text at row boundaries
+    const char *text = "row one\nrow two\n\nrow four";
+    size_t len = strlen(text);
+    assert(flight_csv_row_start(text, len, 0) == 0);
+    assert(flight_csv_row_start(text, len, 3) == 8);
+    assert(flight_csv_row_start(text, len, 8) == 8);
+    assert(flight_csv_row_start(text, len, 9) == 16);
+    assert(flight_csv_row_start(text, len, 16) == 16); // an empty row
+    assert(flight_csv_row_start(text, len, 17) == 17);
+    assert(flight_csv_row_start(text, len, 18) == len); // inside the last row
+    assert(flight_csv_row_start(text, len, len + 5) == len);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
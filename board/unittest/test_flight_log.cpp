@@ -0,0 +1,354 @@
+/**
+ * Name: test_flight_log.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the flight_log.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "storage/flight_log.hpp"
+
+#define TEST_LOG_PATH "./test_flight_log.bin"
+
+static off_t file_size(const char *path)
+{
+    struct stat st;
+    assert(stat(path, &st) == 0);
+    return st.st_size;
+}
+
+static int count_valid_records(const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    assert(fd >= 0);
+
+    flight_log_header_t header;
+    assert(read(fd, &header, sizeof(header)) == (ssize_t)sizeof(header));
+    assert(flight_log_header_valid(&header));
+
+    int valid = 0;
+    flight_log_record_t record;
+    while (read(fd, &record, sizeof(record)) == (ssize_t)sizeof(record))
+    {
+        if (flight_log_record_valid(&record))
+            valid++;
+    }
+    close(fd);
+    return valid;
+}
+
+static std::vector<uint8_t> read_file(const char *path)
+{
+    std::vector<uint8_t> data(file_size(path));
+    int fd = open(path, O_RDONLY);
+    assert(fd >= 0 && read(fd, data.data(), data.size()) == (ssize_t)data.size());
+    close(fd);
+    return data;
+}
+
+struct packed_walk
+{
+    int records;           // intact records
+    int keyframes;
+    uint32_t last_sequence;
+    uint64_t last_offset;
+    bool bins_match; // every decoded record has the bins and zoom bins set_frame() gives it
+};
+
+// Bins of the frame with a sequence number, a slow ripple so frames differ a little
+static uint16_t frame_bin(uint32_t sequence, int bin)
+{
+    return (uint16_t)(1000 + (bin * 37) % 400 + (bin + sequence) % 5);
+}
+
+// Odd frames were computed on board and have a zoomed spectrum as well
+static uint16_t frame_zoom_bins(uint32_t sequence)
+{
+    return sequence % 2 ? FMCW_RADAR_ZOOM_SIZE : 0;
+}
+
+static void set_frame(fmcw_fft_frame_t *frame, uint32_t sequence)
+{
+    frame->timestamp_usec = 1764000000000000ULL + sequence;
+    frame->sequence = sequence;
+    for (int i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+        frame->bins[i] = frame_bin(sequence, i);
+    frame->num_zoom_bins = frame_zoom_bins(sequence);
+    frame->zoom_start_m = 0.25f;
+    frame->zoom_step_m = 0.002f;
+    for (int i = 0; i < FMCW_RADAR_ZOOM_SIZE; i++)
+        frame->zoom_bins[i] = frame_bin(sequence, i) + 7;
+}
+
+// Reads the intact packed records written between two offsets and decodes their bins, like
+// scripts/flight_log_to_csv.py does. A capacity of 0 reads an append log.
+static packed_walk walk_packed(const uint8_t *records, size_t len, uint64_t capacity,
+                               uint64_t offset, uint64_t end_offset)
+{
+    packed_walk walk = {0, 0, 0, 0, true};
+    uint16_t bins[FMCW_RADAR_FFT_SIZE], reference[FMCW_RADAR_FFT_SIZE];
+    uint16_t zoom_bins[FMCW_RADAR_ZOOM_SIZE];
+    bool have_reference = false;
+    uint32_t last_index = 0;
+
+    while (offset < end_offset)
+    {
+        size_t pos = capacity ? offset % capacity : offset;
+        size_t size = flight_log_packed_record_size(&records[pos], len - pos, offset);
+        if (size == 0)
+        {
+            offset += FLIGHT_LOG_PACKED_ALIGN;
+            continue;
+        }
+        walk.last_offset = offset;
+        offset += size;
+
+        flight_log_packed_record_t record;
+        memcpy(&record, &records[pos], sizeof(record));
+        bool keyframe = (record.flags & FLIGHT_LOG_RECORD_KEYFRAME) != 0;
+        walk.records++;
+        walk.keyframes += keyframe;
+        walk.last_sequence = record.sequence;
+        if (!keyframe && !(have_reference && record.index == last_index + 1))
+        {
+            have_reference = false; // encoded against a record that was overwritten
+            continue;
+        }
+
+        const uint8_t *payload = &records[pos + sizeof(record)];
+        int bins_size = spectrum_decode(payload, record.payload_size,
+                                        keyframe ? nullptr : reference, record.num_bins, bins);
+        assert(bins_size > 0);
+        assert(spectrum_decode(&payload[bins_size], record.payload_size - bins_size, nullptr,
+                               record.num_zoom_bins, zoom_bins) == record.payload_size - bins_size);
+        for (int i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+            walk.bins_match = walk.bins_match && bins[i] == frame_bin(record.sequence, i);
+        bool zoom_match = record.num_zoom_bins == frame_zoom_bins(record.sequence);
+        for (int i = 0; i < record.num_zoom_bins; i++)
+            zoom_match = zoom_match && zoom_bins[i] == frame_bin(record.sequence, i) + 7;
+        if (record.num_zoom_bins > 0)
+            zoom_match = zoom_match && record.zoom_start_m == 0.25f && record.zoom_step_m == 0.002f;
+        walk.bins_match = walk.bins_match && zoom_match;
+        memcpy(reference, bins, sizeof(reference));
+        have_reference = true;
+        last_index = record.index;
+    }
+    return walk;
+}
+
+static void append_frames(FLIGHT_LOG_WRITER *writer, uint32_t first, uint32_t count)
+{
+    fmcw_fft_frame_t frame = {};
+    frame.num_bins = FMCW_RADAR_FFT_SIZE;
+    for (uint32_t n = first; n < first + count; n++)
+    {
+        set_frame(&frame, n);
+        flight_log_record_t record;
+        flight_log_make_record(45.3848, -75.7047, -12.4, &frame, &record);
+        assert(writer->append(&record) == 0);
+    }
+}
+
+static void test_packed_logs()
+{
+    FLIGHT_LOG_WRITER writer;
+    const size_t header_size = sizeof(flight_log_header_t);
+
+    // Test a packed append log keeps every frame, a keyframe every interval
+    unlink(TEST_LOG_PATH);
+    assert(writer.open(TEST_LOG_PATH, 0, FLIGHT_LOG_PACKED) == 0);
+    append_frames(&writer, 0, 45);
+    writer.close();
+    std::vector<uint8_t> data = read_file(TEST_LOG_PATH);
+    flight_log_header_t header;
+    memcpy(&header, data.data(), sizeof(header));
+    assert(flight_log_header_valid(&header));
+    assert(header.flags == FLIGHT_LOG_PACKED && header.record_size == 0);
+    assert(data.size() * 3 < header_size + 45 * sizeof(flight_log_record_t));
+    packed_walk walk = walk_packed(&data[header_size], data.size() - header_size, 0, 0,
+                                   data.size() - header_size);
+    assert(walk.records == 45 && walk.keyframes == 3 && walk.last_sequence == 44);
+    assert(walk.bins_match);
+
+    // Test a record cut short is dropped on reopening, and the next record is a keyframe
+    assert(truncate(TEST_LOG_PATH, (off_t)data.size() - 10) == 0);
+    assert(writer.open(TEST_LOG_PATH, 0, FLIGHT_LOG_PACKED) == 0);
+    append_frames(&writer, 45, 1);
+    writer.close();
+    data = read_file(TEST_LOG_PATH);
+    walk = walk_packed(&data[header_size], data.size() - header_size, 0, 0,
+                       data.size() - header_size);
+    assert(walk.records == 45 && walk.keyframes == 4 && walk.last_sequence == 45);
+    assert(walk.bins_match);
+
+    // Test packed and unpacked logs refuse each other
+    assert(writer.open(TEST_LOG_PATH) < 0);
+    assert(writer.open(TEST_LOG_PATH, 4096, FLIGHT_LOG_PACKED) < 0);
+    unlink(TEST_LOG_PATH);
+    assert(writer.open(TEST_LOG_PATH) == 0);
+    writer.close();
+    assert(writer.open(TEST_LOG_PATH, 0, FLIGHT_LOG_PACKED) < 0);
+    unlink(TEST_LOG_PATH);
+
+    // Test a packed ring has to hold at least the largest record
+    assert(writer.open(TEST_LOG_PATH, 1000, FLIGHT_LOG_PACKED) < 0);
+
+    // Test a packed ring wraps in place and keeps the newest records decodable
+    const uint32_t capacity = 8 * FLIGHT_LOG_PACKED_MAX_SIZE;
+    assert(writer.open(TEST_LOG_PATH, capacity, FLIGHT_LOG_PACKED) == 0);
+    assert(file_size(TEST_LOG_PATH) == (off_t)(header_size + capacity));
+    append_frames(&writer, 0, 200);
+    writer.close();
+    assert(file_size(TEST_LOG_PATH) == (off_t)(header_size + capacity));
+    data = read_file(TEST_LOG_PATH);
+    memcpy(&header, data.data(), sizeof(header));
+    assert(header.write_count == 200 && header.write_offset > 2 * capacity);
+    walk = walk_packed(&data[header_size], capacity, capacity, header.write_offset - capacity,
+                       header.write_offset);
+    assert(walk.records > 8 && walk.last_sequence == 199 && walk.bins_match);
+
+    // Test a record written just before a crash, without the cursor update, is recovered
+    uint64_t cursor = header.write_offset;
+    header.write_offset = walk.last_offset;
+    header.write_count--;
+    int fd = open(TEST_LOG_PATH, O_WRONLY);
+    assert(pwrite(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header));
+    close(fd);
+    assert(writer.open(TEST_LOG_PATH, capacity, FLIGHT_LOG_PACKED) == 0);
+    writer.close();
+    data = read_file(TEST_LOG_PATH);
+    memcpy(&header, data.data(), sizeof(header));
+    assert(header.write_offset == cursor && header.write_count == 200);
+
+    unlink(TEST_LOG_PATH);
+}
+
+int main(void)
+{
+    // Test the CRC matches zlib.crc32
+    assert(flight_log_crc32("123456789", 9) == 0xCBF43926u);
+
+    unlink(TEST_LOG_PATH);
+
+    fmcw_fft_frame_t frame = {};
+    frame.timestamp_usec = 1764000000000000ULL;
+    frame.num_bins = FMCW_RADAR_FFT_SIZE;
+    for (int i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+        frame.bins[i] = (uint16_t)(i * 3);
+
+    // Test records are appended after a header
+    FLIGHT_LOG_WRITER writer;
+    assert(writer.open(TEST_LOG_PATH) == 0);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        flight_log_record_t record;
+        frame.sequence = i;
+        flight_log_make_record(45.3848, -75.7047, -12.4, &frame, &record);
+        assert(record.bins[10] == 30 && record.num_zoom_bins == 0);
+        assert(writer.append(&record) == 0);
+    }
+    writer.close();
+    assert(file_size(TEST_LOG_PATH) ==
+           (off_t)(sizeof(flight_log_header_t) + 3 * sizeof(flight_log_record_t)));
+    assert(count_valid_records(TEST_LOG_PATH) == 3);
+
+    // Test a frame's zoomed spectrum is kept with its bins
+    fmcw_fft_frame_t zoom_frame = {};
+    set_frame(&zoom_frame, 1);
+    flight_log_record_t zoom_record;
+    flight_log_make_record(45.3848, -75.7047, -12.4, &zoom_frame, &zoom_record);
+    assert(zoom_record.num_zoom_bins == FMCW_RADAR_ZOOM_SIZE && zoom_record.zoom_step_m == 0.002f);
+    assert(zoom_record.zoom_bins[9] == frame_bin(1, 9) + 7);
+
+    // Test a corrupted record fails its CRC
+    int fd = open(TEST_LOG_PATH, O_WRONLY);
+    uint16_t garbage = 0xBEEF;
+    off_t bin_offset = sizeof(flight_log_header_t) + sizeof(flight_log_record_t) +
+                       offsetof(flight_log_record_t, bins);
+    assert(pwrite(fd, &garbage, sizeof(garbage), bin_offset) == (ssize_t)sizeof(garbage));
+
+    // Test a truncated record is dropped when the log is reopened
+    assert(ftruncate(fd, file_size(TEST_LOG_PATH) - 100) == 0);
+    close(fd);
+    assert(writer.open(TEST_LOG_PATH) == 0);
+    assert(file_size(TEST_LOG_PATH) ==
+           (off_t)(sizeof(flight_log_header_t) + 2 * sizeof(flight_log_record_t)));
+
+    flight_log_record_t record;
+    flight_log_make_record(45.3848, -75.7047, -12.4, &frame, &record);
+    assert(writer.append(&record) == 0);
+    writer.close();
+    assert(count_valid_records(TEST_LOG_PATH) == 2);
+
+    // Test a file that is not a flight log is refused
+    fd = open(TEST_LOG_PATH, O_WRONLY | O_TRUNC);
+    assert(write(fd, "timestamp,lat,lon\n", 18) == 18);
+    close(fd);
+    assert(writer.open(TEST_LOG_PATH) < 0);
+
+    // Test a ring log is preallocated and does not grow
+    unlink(TEST_LOG_PATH);
+    assert(writer.open(TEST_LOG_PATH, 4) == 0);
+    off_t ring_size = sizeof(flight_log_header_t) + 4 * sizeof(flight_log_record_t);
+    assert(file_size(TEST_LOG_PATH) == ring_size);
+
+    // Test the ring wraps and keeps the newest records
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        frame.timestamp_usec = 1764000000000000ULL + i;
+        frame.sequence = i;
+        flight_log_make_record(45.3848, -75.7047, -12.4, &frame, &record);
+        assert(writer.append(&record) == 0);
+    }
+    writer.close();
+    assert(file_size(TEST_LOG_PATH) == ring_size);
+    assert(count_valid_records(TEST_LOG_PATH) == 4);
+
+    flight_log_header_t header;
+    fd = open(TEST_LOG_PATH, O_RDWR);
+    assert(pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header));
+    assert(header.ring_capacity == 4 && header.write_count == 6);
+    assert(pread(fd, &record, sizeof(record), sizeof(header) + sizeof(record)) ==
+           (ssize_t)sizeof(record));
+    assert(record.sequence == 5);
+
+    // Test a record written just before a crash, without the cursor update, is recovered
+    frame.timestamp_usec = 1764000000000000ULL + 6;
+    frame.sequence = 6;
+    flight_log_make_record(45.3848, -75.7047, -12.4, &frame, &record);
+    record.crc = flight_log_crc32(&record, offsetof(flight_log_record_t, crc));
+    assert(pwrite(fd, &record, sizeof(record), sizeof(header) + 2 * sizeof(record)) ==
+           (ssize_t)sizeof(record));
+    close(fd);
+
+    assert(writer.open(TEST_LOG_PATH, 4) == 0);
+    writer.close();
+    fd = open(TEST_LOG_PATH, O_RDONLY);
+    assert(pread(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header));
+    assert(header.write_count == 7);
+    close(fd);
+
+    // Test append and ring logs refuse each other
+    assert(writer.open(TEST_LOG_PATH) < 0);
+    unlink(TEST_LOG_PATH);
+    assert(writer.open(TEST_LOG_PATH) == 0);
+    writer.close();
+    assert(writer.open(TEST_LOG_PATH, 4) < 0);
+
+    test_packed_logs();
+
+    unlink(TEST_LOG_PATH);
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * Name: test_flight_replay.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the flight replay the simulation drivers read from
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include "bsp/flight_replay.hpp"
+#include "bsp/serial_line_reader.hpp"
+#include "common/clock.h"
+
+static void write_file(const char *path, const std::string &contents)
+{
+    FILE *f = fopen(path, "w");
+    assert(f != NULL);
+    fwrite(contents.data(), 1, contents.size(), f);
+    fclose(f);
+}
+
+static std::string next_line(SERIAL_LINE_READER *reader, int timeout_ms = 1000)
+{
+    std::string_view line;
+    if (reader->read_line(&line, timeout_ms) != 0)
+        return "";
+    return std::string(line);
+}
+
+int main(void)
+{
+    char path[] = "/tmp/test_flight_replay_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    FLIGHT_REPLAY *replay = FLIGHT_REPLAY::get_instance();
+    double celcius;
+
+    // Test bad arguments
+    assert(replay->start(0) < 0); // not open
+    assert(replay->open("/nonexistent/replay") < 0);
+    assert(replay->open(path) < 0); // empty
+
+    // Test every event type goes where it belongs, in order, and bad lines are skipped
+    write_file(path, "# comment\n"
+                     "0 G $GNRMC,first\n"
+                     "\n"
+                     "0 R {\"FFT\":[1.0,2.0]}\r\n"
+                     "10 T -12.5\n"
+                     "bogus line\n"
+                     "20 X unknown\n"
+                     "30 G $GNGGA,second\n"
+                     "40 R {\"FFT\":[3.0,4.0]}"); // no trailing newline
+    assert(replay->open(path) == 0);
+    assert(replay->open(path) < 0); // already open
+    assert(!replay->temperature(&celcius));
+    assert(replay->start(0) == 0);
+    assert(replay->start(0) < 0); // already started
+
+    SERIAL_LINE_READER radar, gps;
+    radar.attach(replay->radar_fd());
+    gps.attach(replay->gps_fd());
+    assert(next_line(&gps) == "$GNRMC,first");
+    assert(next_line(&gps) == "$GNGGA,second");
+    assert(next_line(&radar) == "{\"FFT\":[1.0,2.0]}");
+    assert(next_line(&radar) == "{\"FFT\":[3.0,4.0]}");
+
+    for (int i = 0; i < 100 && !replay->finished(); i++)
+        usleep(10000);
+    assert(replay->finished());
+    assert(replay->temperature(&celcius) && celcius == -12.5);
+
+    flight_replay_stats_t stats;
+    replay->get_stats(&stats);
+    assert(stats.radar_lines == 2 && stats.radar_lines_dropped == 0);
+    assert(stats.gps_sentences == 2 && stats.temperature_samples == 1);
+    assert(stats.bad_lines == 2);
+
+    // Test pacing follows the recorded times, scaled by the speed
+    replay->close();
+    write_file(path, "0 G $GNGGA,now\n"
+                     "400000 G $GNGGA,later\n");
+    assert(replay->open(path) == 0);
+    gps.attach(replay->gps_fd());
+    uint64_t start_usec = clock_monotonic_usec();
+    assert(replay->start(2.0) == 0);
+    assert(next_line(&gps) == "$GNGGA,now");
+    assert(clock_monotonic_usec() - start_usec < 100000);
+    assert(next_line(&gps) == "$GNGGA,later");
+    uint64_t elapsed_usec = clock_monotonic_usec() - start_usec;
+    assert(elapsed_usec >= 200000 && elapsed_usec < 350000);
+
+    // Test radar lines nobody reads are dropped in real time instead of stalling the replay
+    replay->close();
+    std::string flight;
+    std::string fft_line = "{\"FFT\":[" + std::string(3000, '1') + "]}";
+    for (int i = 0; i < 100; i++)
+        flight += std::to_string(i) + " R " + fft_line + "\n";
+    flight += "100 G $GNGGA,after\n";
+    write_file(path, flight);
+    assert(replay->open(path) == 0);
+    gps.attach(replay->gps_fd());
+    assert(replay->start(1.0) == 0);
+    assert(next_line(&gps) == "$GNGGA,after");
+    replay->get_stats(&stats);
+    assert(stats.radar_lines > 0 && stats.radar_lines_dropped > 0);
+    assert(stats.radar_lines + stats.radar_lines_dropped == 100);
+
+    // Test discarding drops what is buffered
+    replay->discard_radar();
+    radar.attach(replay->radar_fd());
+    assert(next_line(&radar, 100) == "");
+
+    replay->close();
+    assert(!replay->is_open());
+    unlink(path);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
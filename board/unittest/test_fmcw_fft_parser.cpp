@@ -0,0 +1,86 @@
+/**
+ * Name: test_fmcw_fft_parser.cpp
+ * Author: Karran Dhillon
+ *
+ * Unit test file for the fmcw_fft_parser.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "bsp/fmcw_radar_sensor.hpp"
+
+#define RADAR_SIM_PATH "../sim/radar_ice_fft_data.sim"
+
+static int parse(const char *text, uint16_t *bins, size_t max_bins)
+{
+    return fmcw_radar_parse_fft_bins(text, strlen(text), bins, max_bins);
+}
+
+int main(void)
+{
+    uint16_t bins[FMCW_RADAR_FFT_SIZE] = {};
+
+    // Test integers, fractions and rounding
+    assert(parse("0.0,61.0,263.4,263.5,42432", bins, FMCW_RADAR_FFT_SIZE) == 5);
+    assert(bins[0] == 0);
+    assert(bins[1] == 61);
+    assert(bins[2] == 263);
+    assert(bins[3] == 264);
+    assert(bins[4] == 42432);
+
+    // Test whitespace (pretty printed JSON) is tolerated
+    assert(parse(" 1.0,\n  2.0 , 3.0\n", bins, FMCW_RADAR_FFT_SIZE) == 3);
+    assert(bins[0] == 1 && bins[1] == 2 && bins[2] == 3);
+
+    // Test out of range values clamp instead of wrapping
+    assert(parse("-4.0,99999999.0", bins, FMCW_RADAR_FFT_SIZE) == 2);
+    assert(bins[0] == 0);
+    assert(bins[1] == UINT16_MAX);
+
+    // Test malformed input is rejected
+    assert(parse("1.0,,2.0", bins, FMCW_RADAR_FFT_SIZE) < 0);
+    assert(parse("1.0,2.0,", bins, FMCW_RADAR_FFT_SIZE) < 0);
+    assert(parse("1.0,abc", bins, FMCW_RADAR_FFT_SIZE) < 0);
+    assert(parse("1.0,2.0,3.0", bins, 2) < 0);
+    assert(parse("", bins, FMCW_RADAR_FFT_SIZE) == 0);
+
+    // Test the FFT array is found in the radar's JSON lines
+    std::string_view fft;
+    assert(fmcw_radar_extract_fft("{\"FFT\":[1.0,2.0]}", &fft) == 0 && fft == "1.0,2.0");
+    assert(fmcw_radar_extract_fft("noise{\"FFT\":[]}", &fft) == 0 && fft.empty());
+    assert(fmcw_radar_extract_fft("{\"FFT\":[1.0,2.0", &fft) < 0); // cut off
+    assert(fmcw_radar_extract_fft("{\"ADC\":[1.0]}", &fft) < 0);
+
+    // Test ADC samples keep their sign and fraction, and each channel is told apart
+    float samples[4];
+    std::string_view adc;
+    assert(fmcw_radar_parse_adc_samples("2048,-12, 3.25", 14, samples, 4) == 3);
+    assert(samples[0] == 2048.0f && samples[1] == -12.0f && samples[2] == 3.25f);
+    assert(fmcw_radar_parse_adc_samples("1,2,", 4, samples, 4) < 0);
+    assert(fmcw_radar_parse_adc_samples("1,2,3", 5, samples, 2) < 0);
+    assert(fmcw_radar_extract_adc("{\"I\":[1,2]}", 'I', &adc) == 0 && adc == "1,2");
+    assert(fmcw_radar_extract_adc("{\"Q\":[3]}", 'Q', &adc) == 0 && adc == "3");
+    assert(fmcw_radar_extract_adc("{\"Q\":[3]}", 'I', &adc) < 0);
+    assert(fmcw_radar_extract_adc("{\"FFT\":[3]}", 'X', &adc) < 0);
+
+    // Test a full frame recorded from the radar
+    std::ifstream sim_file(RADAR_SIM_PATH);
+    assert(sim_file.is_open());
+    std::string line;
+    assert(std::getline(sim_file, line));
+    assert(fmcw_radar_parse_fft_bins(line.data(), line.size(), bins, FMCW_RADAR_FFT_SIZE) ==
+           FMCW_RADAR_FFT_SIZE);
+    assert(bins[3] == 32);
+    assert(bins[FMCW_RADAR_FFT_SIZE - 1] == 7);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
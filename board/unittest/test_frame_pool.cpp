@@ -0,0 +1,128 @@
+/**
+ * Name: test_frame_pool.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the FRAME_POOL class
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include "common/frame_pool.hpp"
+#include "common/spsc_queue.hpp"
+
+struct test_frame
+{
+    uint32_t sequence;
+    uint32_t payload[64];
+};
+
+typedef FRAME_POOL<test_frame, 70> test_pool_t; // more than one word of free slots
+typedef test_pool_t::HANDLE test_handle_t;
+
+static test_pool_t pool;
+
+int main(void)
+{
+    // Test every slot can be taken once, then the pool runs dry
+    static test_handle_t handles[70];
+    assert(pool.available() == 70);
+    for (int i = 0; i < 70; i++)
+    {
+        handles[i] = pool.acquire();
+        assert(handles[i]);
+        assert(handles[i].use_count() == 1);
+        handles[i]->sequence = i;
+    }
+    assert(pool.available() == 0);
+    assert(!pool.acquire());
+    for (int i = 0; i < 70; i++)
+        for (int j = i + 1; j < 70; j++)
+            assert(handles[i].get() != handles[j].get());
+
+    // Test a slot is only freed once its last handle lets go
+    test_frame *shared = handles[5].get();
+    test_handle_t copy = handles[5];
+    assert(copy.get() == shared && copy.use_count() == 2);
+    handles[5].reset();
+    assert(!handles[5] && handles[5].get() == nullptr && handles[5].use_count() == 0);
+    assert(pool.available() == 0);
+    assert(copy->sequence == 5);
+    copy.reset();
+    assert(pool.available() == 1);
+    handles[5] = pool.acquire();
+    assert(handles[5].get() == shared);
+
+    // Test moves hand over the reference, assignment drops the old one
+    test_handle_t moved = std::move(handles[6]);
+    assert(!handles[6] && moved.use_count() == 1 && moved->sequence == 6);
+    moved = handles[7];
+    assert(pool.available() == 1 && moved.use_count() == 2);
+    moved = test_handle_t();
+    assert(handles[7].use_count() == 1);
+    for (test_handle_t &handle : handles)
+        handle.reset();
+    assert(pool.available() == 70);
+
+    // Test a queue of handles moves them through and gives them up when cleared
+    static SPSC_QUEUE<test_handle_t, 8> queue;
+    test_handle_t queued = pool.acquire();
+    assert(queue.push(std::move(queued)) && !queued);
+    assert(queue.push(pool.acquire()));
+    assert(pool.available() == 68);
+    assert(queue.pop(&queued) && queued.use_count() == 1);
+    queued.reset();
+    assert(pool.available() == 69);
+    queue.clear();
+    assert(pool.available() == 70);
+
+    // Test slots go round between a producer and a consumer that holds on to a few
+    const uint32_t NUM_FRAMES = 20000;
+    std::thread producer([&]() {
+        for (uint32_t sequence = 0; sequence < NUM_FRAMES;)
+        {
+            test_handle_t frame = pool.acquire();
+            if (!frame)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            frame->sequence = sequence;
+            for (uint32_t &word : frame->payload)
+                word = sequence;
+            while (!queue.push(std::move(frame)))
+                std::this_thread::yield();
+            sequence++;
+        }
+    });
+
+    static test_handle_t held[16];
+    for (uint32_t sequence = 0; sequence < NUM_FRAMES;)
+    {
+        test_handle_t frame;
+        if (!queue.pop(&frame))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        assert(frame->sequence == sequence);
+        for (uint32_t word : frame->payload)
+            assert(word == sequence);
+        held[sequence % 16] = std::move(frame);
+        sequence++;
+    }
+    producer.join();
+    assert(pool.available() == 70 - 16);
+    for (test_handle_t &handle : held)
+        handle.reset();
+    assert(pool.available() == 70);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * Name: test_gps_position_hint.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the gps_position_hint.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include "bsp/gps_position_hint.hpp"
+
+#define HOUR_USEC (3600ULL * 1000000)
+#define NOV_20_2025_1500_UTC_USEC (1763650800ULL * 1000000)
+
+int main(void)
+{
+    gps_position_hint_t hint = {45.3848, -75.7047, NOV_20_2025_1500_UTC_USEC};
+    uint64_t now = hint.utc_usec;
+
+    // Test the start mode follows the age of the hint
+    assert(gps_position_hint_start_mode(nullptr, now) == GPS_START_COLD);
+    assert(gps_position_hint_start_mode(&hint, now) == GPS_START_HOT);
+    assert(gps_position_hint_start_mode(&hint, now + 3 * HOUR_USEC) == GPS_START_HOT);
+    assert(gps_position_hint_start_mode(&hint, now + 5 * HOUR_USEC) == GPS_START_WARM);
+    assert(gps_position_hint_start_mode(&hint, now + 24 * 40 * HOUR_USEC) == GPS_START_COLD);
+
+    // Test a clock behind the hint is not trusted
+    assert(gps_position_hint_start_mode(&hint, now - HOUR_USEC) == GPS_START_COLD);
+
+    // Test the aiding command carries the position and the current UTC time
+    char body[96];
+    int len = gps_position_hint_format_aiding(&hint, now + 90 * 1000000ULL, body, sizeof(body));
+    assert(len > 0 && (size_t)len == strlen(body));
+    assert(strcmp(body, "PMTK741,45.384800,-75.704700,0,2025,11,20,15,01,30") == 0);
+    assert(gps_position_hint_format_aiding(&hint, now, body, 10) < 0);
+
+    // Test the hint survives a save and load
+    char dir[] = "/tmp/test_gps_position_hint_XXXXXX";
+    assert(mkdtemp(dir) != NULL);
+    char path[64];
+    snprintf(path, sizeof(path), "%s/hint", dir);
+
+    gps_position_hint_t loaded;
+    assert(gps_position_hint_load(path, &loaded) == -1); // nothing saved yet
+    assert(gps_position_hint_save(path, &hint) == 0);
+    assert(gps_position_hint_load(path, &loaded) == 0);
+    assert(loaded.utc_usec == hint.utc_usec);
+    assert(loaded.latitude > 45.38479 && loaded.latitude < 45.38481);
+    assert(loaded.longitude > -75.70471 && loaded.longitude < -75.70469);
+
+    // Test a corrupt hint is rejected
+    FILE *f = fopen(path, "w");
+    fputs("SAUVHINT 1 145.0 -75.0 1763650800000000\n", f);
+    fclose(f);
+    assert(gps_position_hint_load(path, &loaded) == -2);
+    f = fopen(path, "w");
+    fputs("garbage\n", f);
+    fclose(f);
+    assert(gps_position_hint_load(path, &loaded) == -2);
+
+    unlink(path);
+    rmdir(dir);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * Name: test_ice_thickness.cpp
+ * Author: Karran Dhillon
+ *
+ * Unit test file for the ice_thickness.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include "bsp/fmcw_radar_sensor.hpp"
+#include "dsp/ice_thickness.hpp"
+
+// Adds a gaussian shaped reflection centered on a fractional bin
+static void add_peak(float *bins, float center, float height)
+{
+    for (int i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+    {
+        float d = (i - center) / 1.5f;
+        bins[i] += height * std::exp(-0.5f * d * d);
+    }
+}
+
+int main(void)
+{
+    ice_thickness_estimate_t estimate;
+    float spectrum[FMCW_RADAR_FFT_SIZE];
+
+    // Test bin to range conversion: 78.125 Hz per bin, 990 MHz over 1.6 ms
+    assert(std::fabs(ice_thickness_bin_to_range_m(0.0f)) < 1e-6f);
+    assert(std::fabs(ice_thickness_bin_to_range_m(1.0f) - 0.018939f) < 1e-5f);
+
+    // Test the two closest reflections are found and refined between bins
+    for (int i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+        spectrum[i] = 20.0f;
+    add_peak(spectrum, 2.0f, 5000.0f);   // antenna leakage, outside the range gate
+    add_peak(spectrum, 20.3f, 3000.0f);  // ice surface
+    add_peak(spectrum, 30.6f, 800.0f);   // ice bottom
+    add_peak(spectrum, 40.0f, 1500.0f);  // multipath, should be ignored
+    assert(ice_thickness_estimate(spectrum, FMCW_RADAR_FFT_SIZE, &estimate) == 0);
+    assert(estimate.num_peaks == 3);
+    assert(std::fabs(estimate.surface.bin - 20.3f) < 0.1f);
+    assert(std::fabs(estimate.bottom.bin - 30.6f) < 0.1f);
+    float expected_m = ice_thickness_bin_to_range_m(30.6f) - ice_thickness_bin_to_range_m(20.3f);
+    assert(std::fabs(estimate.thickness_m - expected_m) < 0.002f);
+
+    // Test the integer overload agrees
+    uint16_t bins[FMCW_RADAR_FFT_SIZE];
+    for (int i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+        bins[i] = (uint16_t)std::lround(spectrum[i]);
+    ice_thickness_estimate_t integer_estimate;
+    assert(ice_thickness_estimate(bins, FMCW_RADAR_FFT_SIZE, &integer_estimate) == 0);
+    assert(std::fabs(integer_estimate.thickness_m - estimate.thickness_m) < 0.002f);
+
+    // Test a single reflection is not enough
+    for (int i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+        spectrum[i] = 20.0f;
+    add_peak(spectrum, 20.0f, 3000.0f);
+    assert(ice_thickness_estimate(spectrum, FMCW_RADAR_FFT_SIZE, &estimate) == -2);
+    assert(estimate.num_peaks == 1);
+
+    // Test a zoomed spectrum is read on its own range axis, peaks a fraction of a bin apart
+    const float start_m = 0.1f, step_m = 0.9f / (FMCW_RADAR_ZOOM_SIZE - 1);
+    fmcw_fft_frame_t frame = {};
+    for (int i = 0; i < FMCW_RADAR_ZOOM_SIZE; i++)
+    {
+        float range_m = start_m + i * step_m;
+        float surface = (range_m - 0.5031f) / 0.008f, bottom = (range_m - 0.6047f) / 0.008f;
+        float magnitude = 10.0f + 600.0f * std::exp(-0.5f * surface * surface) +
+                          250.0f * std::exp(-0.5f * bottom * bottom);
+        frame.zoom_bins[i] = (uint16_t)std::lround(magnitude);
+    }
+    frame.num_bins = FMCW_RADAR_FFT_SIZE;
+    frame.num_zoom_bins = FMCW_RADAR_ZOOM_SIZE;
+    frame.zoom_start_m = start_m;
+    frame.zoom_step_m = step_m;
+    assert(ice_thickness_estimate(&frame, &estimate) == 0);
+    assert(estimate.num_peaks == 2);
+    assert(std::fabs(estimate.surface.range_m - 0.5031f) < 0.001f);
+    assert(std::fabs(estimate.thickness_m - 0.1016f) < 0.001f);
+    assert(ice_thickness_estimate_zoom(frame.zoom_bins, FMCW_RADAR_ZOOM_SIZE, 0.2f, step_m,
+                                       &estimate) == -1); // does not cover the gate
+
+    // Test invalid arguments
+    assert(ice_thickness_estimate(spectrum, 10, &estimate) == -1);
+    assert(ice_thickness_estimate((const float *)nullptr, FMCW_RADAR_FFT_SIZE, &estimate) == -1);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
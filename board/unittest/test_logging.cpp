@@ -0,0 +1,125 @@
+/**
+ * Name: test_logging.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the logging.c deferred formatting logger
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#define LOG_INFO_ENABLE 0 // logging_write(LOG_INFO, ...) compiles out of this file
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include "common/logging.h"
+
+static std::string read_log()
+{
+    FILE *f = fopen("./snow_angel_uav.log", "r");
+    assert(f != NULL);
+    std::string contents;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        contents.append(buf, n);
+    fclose(f);
+    return contents;
+}
+
+// Waits for the writer thread, which flushes every 100 ms
+static std::string synced_log()
+{
+    logging_sync();
+    usleep(300000);
+    return read_log();
+}
+
+static bool log_has(const std::string &log, const char *message)
+{
+    return log.find(std::string("]: ") + message + "\n") != std::string::npos;
+}
+
+static void spam(int thread, int count)
+{
+    for (int i = 0; i < count; i++)
+        logging_write(LOG_WARN, "thread %d message %d", thread, i);
+}
+
+int main(void)
+{
+    // Keep the test's log away from the board's log in the build directory
+    char dir[] = "/tmp/test_logging_XXXXXX";
+    assert(mkdtemp(dir) != NULL);
+    assert(chdir(dir) == 0);
+
+    // Test messages before init are ignored
+    logging_write(LOG_ERROR, "before init %d", 1);
+
+    assert(logging_init() == 0);
+
+    // Test the queued arguments are formatted like printf would
+    char *heap_string = strdup("copied");
+    logging_write(LOG_WARN, "int %d uint %u hex %04X neg %ld size %zu", -42, 7u, 0xBEEFu, -5L,
+                  (size_t)123);
+    logging_write(LOG_WARN, "float %.2f %8.3f exp %e pct 50%%", 3.14159, -2.5, 1e-6);
+    logging_write(LOG_ERROR, "str [%s] [%-8s] [%.3s] [%*d] char %c", heap_string, "left",
+                  "truncate", 5, 42, 'x');
+    logging_write(LOG_ERROR, "wide %llu %hhd %hu", 18446744073709551615ULL, (signed char)-3,
+                  (unsigned short)65535);
+    free(heap_string); // strings are copied when queued, not when formatted
+
+    // Test the compile time level filter
+    logging_write(LOG_INFO, "filtered at compile time");
+    logging_emit(LOG_INFO, "emitted directly %d", 9);
+
+    std::string log = synced_log();
+    assert(log.find("before init") == std::string::npos);
+    assert(log_has(log, "int -42 uint 7 hex BEEF neg -5 size 123"));
+    assert(log_has(log, "float 3.14   -2.500 exp 1.000000e-06 pct 50%"));
+    assert(log_has(log, "str [copied] [left    ] [tru] [   42] char x"));
+    assert(log_has(log, "wide 18446744073709551615 -3 65535"));
+    assert(log.find("filtered at compile time") == std::string::npos);
+    assert(log_has(log, "emitted directly 9"));
+    assert(log.find("][WARN]: int -42") != std::string::npos);
+    assert(log.find("][ERROR]: str") != std::string::npos);
+
+    // Test a string too long for the queue is cut off instead of overflowing
+    std::string long_string(1000, 'a');
+    logging_write(LOG_WARN, "long %s tail %d", long_string.c_str(), 1);
+    log = synced_log();
+    size_t start = log.find("]: long aaa");
+    assert(start != std::string::npos);
+    size_t end = log.find('\n', start);
+    assert(end - start < 512 && log.compare(end - 3, 3, "...") == 0);
+
+    // Test concurrent producers lose nothing that is not reported as dropped
+    std::thread producers[4];
+    for (int t = 0; t < 4; t++)
+        producers[t] = std::thread(spam, t, 1000);
+    for (auto &producer : producers)
+        producer.join();
+    log = synced_log();
+
+    int found = 0, dropped = 0;
+    for (size_t pos = 0; (pos = log.find("]: thread ", pos)) != std::string::npos; pos++)
+        found++;
+    for (size_t pos = 0; (pos = log.find("dropped ", pos)) != std::string::npos; pos++)
+        dropped += atoi(log.c_str() + pos + 8);
+    assert(found + dropped == 4000);
+    assert(log_has(log, "thread 3 message 0") || dropped > 0);
+
+    logging_cleanup();
+    unlink("./snow_angel_uav.log");
+    chdir("/");
+    rmdir(dir);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * Name: test_motion_estimator.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the motion_estimator.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include "nav/motion_estimator.hpp"
+
+#define ORIGIN_LAT 45.3848
+#define ORIGIN_LON -75.7047
+#define FIX_PERIOD_USEC 100000
+
+// Deterministic noise in [-amplitude, amplitude]
+static double noise(uint32_t *seed, double amplitude)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return ((*seed >> 8) / (double)(1u << 24) * 2.0 - 1.0) * amplitude;
+}
+
+int main(void)
+{
+    // Test the projection against known distances near the origin
+    enu_origin_t origin;
+    enu_origin_init(&origin, ORIGIN_LAT, ORIGIN_LON);
+    double east, north;
+    enu_project(&origin, ORIGIN_LAT + 0.001, ORIGIN_LON, &east, &north);
+    assert(std::fabs(east) < 1e-9 && std::fabs(north - 111.1) < 0.2);
+    enu_project(&origin, ORIGIN_LAT, ORIGIN_LON + 0.001, &east, &north);
+    assert(std::fabs(east - 78.3) < 0.2 && std::fabs(north) < 1e-9);
+
+    motion_estimator_config_t config = {};
+    config.alpha = 0.4;
+    config.beta = 0.05;
+    config.stationary_speed_mps = 0.7;
+    config.moving_speed_mps = 1.5;
+    config.stationary_hold_usec = 500000;
+    config.moving_hold_usec = 300000;
+    config.max_gap_usec = 1000000;
+
+    motion_estimator_t estimator;
+    motion_estimator_init(&estimator, &config);
+
+    const double m_per_deg_lat = origin.meters_per_deg_lat;
+    const double m_per_deg_lon = origin.meters_per_deg_lon;
+    uint32_t seed = 1;
+
+    // A fix north_m north of the origin with 0.5 m of noise on each axis
+    auto feed = [&](double north_m, uint64_t t) {
+        double lat = ORIGIN_LAT + (north_m + noise(&seed, 0.5)) / m_per_deg_lat;
+        double lon = ORIGIN_LON + noise(&seed, 0.5) / m_per_deg_lon;
+        return motion_estimator_update(&estimator, lat, lon, t);
+    };
+    uint64_t t = 1000000;
+    enum motion_state state = MOTION_STATE_UNKNOWN;
+
+    // Test flying north at 5 m/s is detected as moving
+    double north_m = 0;
+    int fixes = 0;
+    for (; fixes < 50 && state != MOTION_STATE_MOVING; fixes++, t += FIX_PERIOD_USEC)
+    {
+        north_m += 0.5;
+        state = feed(north_m, t);
+    }
+    assert(state == MOTION_STATE_MOVING);
+    assert(fixes <= 15); // within 1.5 s of taking off
+    for (int i = 0; i < 20; i++, t += FIX_PERIOD_USEC)
+    {
+        north_m += 0.5;
+        state = feed(north_m, t);
+    }
+    assert(std::fabs(motion_estimator_speed_mps(&estimator) - 5.0) < 1.0);
+
+    // Test hovering in place is detected as stationary, and stays so
+    for (fixes = 0; fixes < 50 && state != MOTION_STATE_STATIONARY; fixes++, t += FIX_PERIOD_USEC)
+    {
+        state = feed(north_m, t);
+    }
+    assert(state == MOTION_STATE_STATIONARY);
+    assert(fixes <= 25);
+    for (int i = 0; i < 300; i++, t += FIX_PERIOD_USEC)
+    {
+        state = feed(north_m, t);
+        assert(state == MOTION_STATE_STATIONARY);
+    }
+
+    // Test a long gap restarts the filter instead of turning the jump into speed
+    t += 10000000;
+    state = motion_estimator_update(&estimator, ORIGIN_LAT + (north_m + 50) / m_per_deg_lat,
+                                    ORIGIN_LON, t);
+    assert(state == MOTION_STATE_STATIONARY && motion_estimator_speed_mps(&estimator) == 0);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * Name: test_nmea_parser.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the nmea_parser.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include "bsp/nmea_parser.hpp"
+
+int main(void)
+{
+    nmea_fields_t fields;
+    nmea_fix_t fix = {};
+    int32_t value;
+
+    // Test tokenizing keeps empty fields and checks the checksum
+    assert(nmea_tokenize("$GNVTG,87.25,T,,M,1.94,N,3.60,K,D*17", &fields) == 0);
+    assert(fields.count == 10);
+    assert(fields.field[0] == "GNVTG" && fields.field[3].empty() && fields.field[9] == "D");
+    assert(nmea_tokenize("$GNVTG,87.25,T,,M,1.94,N,3.60,K,D*18", &fields) == -2);
+    assert(nmea_tokenize("$GNVTG,87.25,T,,M,1.94,N,3.60,K,D", &fields) == -1);
+    assert(nmea_tokenize("GNVTG,87.25*17", &fields) == -1);
+    assert(nmea_tokenize("$GNVTG,87.25,T,,M,1.9", &fields) == -1); // cut off mid line
+
+    // Test fixed point numbers
+    assert(nmea_parse_fixed("0.89", 2, &value) && value == 89);
+    assert(nmea_parse_fixed("97.123", 1, &value) && value == 971);
+    assert(nmea_parse_fixed("-34.2", 3, &value) && value == -34200);
+    assert(nmea_parse_fixed("14", 0, &value) && value == 14);
+    assert(!nmea_parse_fixed("", 0, &value));
+    assert(!nmea_parse_fixed("1.2x", 2, &value));
+    assert(!nmea_parse_fixed("99999999999", 0, &value));
+
+    // Test coordinates in every hemisphere
+    assert(nmea_parse_coordinate("4515.9532", "N", &value) && value == 452658866);
+    assert(nmea_parse_coordinate("07543.7486", "W", &value) && value == -757291433);
+    assert(nmea_parse_coordinate("3351.0000", "S", &value) && value == -338500000);
+    assert(nmea_parse_coordinate("15112.0000", "E", &value) && value == 1512000000);
+    assert(!nmea_parse_coordinate("4560.0000", "N", &value)); // 60 minutes
+    assert(!nmea_parse_coordinate("4515.9532", "X", &value));
+    assert(!nmea_parse_coordinate("", "", &value));
+
+    // Test one epoch of sentences accumulates into a full fix
+    assert(nmea_parse_sentence(
+               "$GNRMC,012422.000,A,4515.9532,N,07543.7486,W,1.94,87.25,241125,,,D*55", &fix) ==
+           NMEA_SENTENCE_RMC);
+    assert(fix.speed_mm_s == 998 && fix.course_cdeg == 8725);
+    assert(nmea_parse_sentence("$GNVTG,87.25,T,,M,1.94,N,3.60,K,D*17", &fix) ==
+           NMEA_SENTENCE_VTG);
+    assert(fix.speed_mm_s == 1000);
+    assert(nmea_parse_sentence(
+               "$GNGGA,012422.000,4515.9532,N,07543.7486,W,2,14,0.89,97.1,M,-34.2,M,,*77", &fix) ==
+           NMEA_SENTENCE_GGA);
+    assert(fix.latitude_e7 == 452658866 && fix.longitude_e7 == -757291433);
+    assert(fix.fix_quality == 2 && fix.num_satellites == 14 && fix.hdop_x100 == 89);
+    assert(nmea_parse_sentence("$GNGSA,A,3,10,12,25,32,,,,,,,,,1.21,0.89,0.82*11", &fix) ==
+           NMEA_SENTENCE_GSA);
+    assert(fix.fix_mode == 3);
+
+    // Test losing the fix keeps the last position but clears the quality
+    assert(nmea_parse_sentence("$GNGGA,012423.000,,,,,0,00,99.99,,,,,,*4E", &fix) ==
+           NMEA_SENTENCE_GGA);
+    assert(fix.fix_quality == 0 && fix.latitude_e7 == 452658866);
+
+    // Test other talkers and sentences we do not use
+    assert(nmea_parse_sentence(
+               "$GPGGA,000000.000,3351.0000,S,15112.0000,E,1,08,1.00,10.0,M,0.0,M,,*7B", &fix) ==
+           NMEA_SENTENCE_GGA);
+    assert(fix.latitude_e7 == -338500000 && fix.fix_quality == 1);
+    assert(nmea_parse_sentence("$PMTK001,314,3*36", &fix) == NMEA_SENTENCE_UNKNOWN);
+
+    // Test a corrupted sentence leaves the fix alone
+    nmea_fix_t before = fix;
+    assert(nmea_parse_sentence(
+               "$GPGGA,000000.000,3351.0000,S,15112.0000,E,1,08,1.00,10.0,M,0.0,M,,*7C", &fix) < 0);
+    assert(fix.latitude_e7 == before.latitude_e7 && fix.fix_quality == before.fix_quality);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -45,6 +45,22 @@ int main(void)
     int count = commas + 1;
     assert(count == 512); // Ensure we have 512 samples
 
+    // Test batch reads, on demand and from the stream
+    static fmcw_fft_frame_t frames[4];
+    assert(radar->fmcw_radar_sensor_try_read_fft_frames(frames, 4) == 0); // not streaming
+    assert(radar->fmcw_radar_sensor_read_fft_frames(frames, 2) == 2);
+    assert(frames[1].sequence > frames[0].sequence);
+    assert(radar->fmcw_radar_sensor_read_fft_frames(nullptr, 2) < 0);
+
+    assert(radar->fmcw_radar_sensor_start_streaming() == 0);
+    assert(radar->fmcw_radar_sensor_read_fft_frames(frames, 1) == 1); // waits for a frame
+    usleep(300000); // a few more frames queue up
+    int queued = radar->fmcw_radar_sensor_try_read_fft_frames(frames, 4);
+    assert(queued > 1);
+    for (int i = 1; i < queued; i++)
+        assert(frames[i].sequence > frames[i - 1].sequence);
+    assert(radar->fmcw_radar_sensor_stop_streaming() == 0);
+
     int8_t stop_result = radar->fmcw_radar_sensor_stop_tx_signal();
     assert(stop_result == 0);
 
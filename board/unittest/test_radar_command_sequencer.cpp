@@ -0,0 +1,238 @@
+/**
+ * Name: test_radar_command_sequencer.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the radar command sequencer. A thread on the other end of two pipes
+ * stands in for the OPS-243C.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "bsp/ops_fmcw.hpp"
+#include "bsp/radar_command_sequencer.hpp"
+#include "common/clock.h"
+
+enum fake_reply
+{
+    REPLY_ACK,
+    REPLY_ACK_AFTER_STREAM, // an FFT line gets in before the reply
+    REPLY_ERROR,
+    REPLY_OTHER, // a late reply to an earlier command
+    REPLY_NOTHING,
+};
+
+// Reads commands like the sensor does and answers them from a script, acking once it runs out
+struct fake_sensor
+{
+    int command_fd;
+    int reply_fd;
+    std::vector<fake_reply> script;
+    std::vector<std::string> received;
+    std::atomic<bool> json_mode{true}; // plain text replies echo no command until OJ
+    std::thread thread;
+
+    void run()
+    {
+        std::string pending;
+        char buf[256];
+        ssize_t len;
+        while ((len = read(command_fd, buf, sizeof(buf))) > 0)
+        {
+            pending.append(buf, len);
+            size_t end;
+            while ((end = pending.find("\r\n")) != std::string::npos)
+            {
+                std::string command = pending.substr(0, end);
+                pending.erase(0, end + 2);
+                fake_reply reply = REPLY_ACK;
+                if (received.size() < script.size())
+                    reply = script[received.size()];
+                received.push_back(command);
+                answer(command, reply);
+                if (command == FMCW_CMD_JSON_MODE)
+                    json_mode = true;
+            }
+        }
+    }
+
+    void answer(const std::string &command, fake_reply reply)
+    {
+        std::string out;
+        if (!json_mode && reply != REPLY_NOTHING)
+        {
+            out = "Command: " + command + "\r\n";
+            assert(write(reply_fd, out.data(), out.size()) == (ssize_t)out.size());
+            return;
+        }
+        if (reply == REPLY_ACK_AFTER_STREAM)
+            out += "{\"FFT\":[1.0,2.0,3.0]}\r\n";
+        if (reply == REPLY_ACK || reply == REPLY_ACK_AFTER_STREAM)
+            out += "{\"Command\":\"" + command + "\"}\r\n";
+        else if (reply == REPLY_ERROR)
+            out += "{\"Error\":\"" + command + "\"}\r\n";
+        else if (reply == REPLY_OTHER)
+            out += "{\"Command\":\"??\"}\r\n";
+        if (!out.empty())
+            assert(write(reply_fd, out.data(), out.size()) == (ssize_t)out.size());
+    }
+};
+
+static void assert_config(RADAR_COMMAND_SEQUENCER *sequencer, radar_setting fft, radar_setting adc,
+                          radar_setting led, radar_setting awake)
+{
+    radar_config_t config;
+    sequencer->get_config(&config);
+    assert(config.fft_output == fft && config.adc_output == adc);
+    assert(config.led == led && config.awake == awake);
+}
+
+int main(void)
+{
+    const char *commands[RADAR_CMD_MAX_BATCH];
+
+    // Test replies are told apart from streamed data and errors, and only ack what they echo
+    assert(radar_reply_classify("{\"Command\":\"OJ\"}", "OJ") == 1);
+    assert(radar_reply_classify("{\"Command\":\"OJ\"}", "Ol") == -2);
+    assert(radar_reply_classify("{\"Command\":\"oF\"}", "of") == -2);
+    assert(radar_reply_classify("{\"Command\":\"xOJ\"}", "OJ") == -2);
+    assert(radar_reply_classify("OPS243-C", "oF") == -2);
+    assert(radar_reply_classify("{\"FFT\":[1.0,2.0]}", "oF") == 0);
+    assert(radar_reply_classify("", "OJ") == 0);
+    assert(radar_reply_classify("{\"Error\":\"Invalid command\"}", "OJ") == -1);
+    assert(radar_reply_classify("Command: OJ", "OJ") == 1); // not in JSON mode yet
+    assert(radar_reply_classify("Command: oF", "oF") == -2);
+    assert(radar_reply_classify("Invalid command", "OJ") == -1);
+
+    // Test going from an unknown configuration sends every requested setting, waking up first
+    // and hibernating last
+    radar_config_t unknown = {RADAR_SETTING_UNKNOWN, RADAR_SETTING_UNKNOWN, RADAR_SETTING_UNKNOWN,
+                              RADAR_SETTING_UNKNOWN};
+    radar_config_t transmitting = {RADAR_SETTING_ON, RADAR_SETTING_UNKNOWN, RADAR_SETTING_ON,
+                                   RADAR_SETTING_ON};
+    radar_config_t hibernating = {RADAR_SETTING_OFF, RADAR_SETTING_OFF, RADAR_SETTING_OFF,
+                                  RADAR_SETTING_OFF};
+    size_t num = radar_config_commands(&unknown, &transmitting, commands, RADAR_CMD_MAX_BATCH);
+    assert(num == 3);
+    assert(strcmp(commands[0], FMCW_CMD_WAKEUP) == 0);
+    assert(strcmp(commands[1], FMCW_CMD_TURN_ON_FFT) == 0);
+    assert(strcmp(commands[2], FMCW_CMD_LED_ON) == 0);
+    num = radar_config_commands(&unknown, &hibernating, commands, RADAR_CMD_MAX_BATCH);
+    assert(num == 4);
+    assert(strcmp(commands[0], FMCW_CMD_TURN_OFF_FFT) == 0);
+    assert(strcmp(commands[3], FMCW_CMD_HIBERNATE) == 0);
+
+    // Test only the changes are sent and the list is capped
+    radar_config_t led_off = transmitting;
+    led_off.led = RADAR_SETTING_OFF;
+    num = radar_config_commands(&transmitting, &led_off, commands, RADAR_CMD_MAX_BATCH);
+    assert(num == 1 && strcmp(commands[0], FMCW_CMD_LED_OFF) == 0);
+    assert(radar_config_commands(&transmitting, &transmitting, commands, 16) == 0);
+    assert(radar_config_commands(&unknown, &hibernating, commands, 2) == 2);
+
+    // Test acknowledged commands update the configuration and others do not touch it
+    radar_config_t config = unknown;
+    radar_config_apply(&config, FMCW_CMD_TURN_ON_ADC);
+    radar_config_apply(&config, FMCW_CMD_HIBERNATE);
+    radar_config_apply(&config, FMCW_CMD_JSON_MODE);
+    assert(config.adc_output == RADAR_SETTING_ON && config.awake == RADAR_SETTING_OFF);
+    assert(config.fft_output == RADAR_SETTING_UNKNOWN && config.led == RADAR_SETTING_UNKNOWN);
+
+    int command_pipe[2], reply_pipe[2];
+    assert(pipe(command_pipe) == 0 && pipe(reply_pipe) == 0);
+    fake_sensor sensor;
+    sensor.command_fd = command_pipe[0];
+    sensor.reply_fd = reply_pipe[1];
+    sensor.thread = std::thread(&fake_sensor::run, &sensor);
+
+    SERIAL_LINE_READER reader;
+    reader.attach(reply_pipe[0]);
+    RADAR_COMMAND_SEQUENCER sequencer;
+    const char *const batch[] = {FMCW_CMD_JSON_MODE, FMCW_CMD_TURN_OFF_FFT, FMCW_CMD_LED_OFF};
+    assert(sequencer.run(batch, 3) == -1); // not attached
+    sequencer.attach(command_pipe[1], &reader);
+
+    // Test a batch is acknowledged in order, skipping streamed data, without waiting out
+    // any timeouts
+    sensor.script = {REPLY_ACK, REPLY_ACK_AFTER_STREAM, REPLY_ACK};
+    uint64_t start_usec = clock_monotonic_usec();
+    assert(sequencer.run(batch, 3) == 0);
+    assert(clock_monotonic_usec() - start_usec < RADAR_CMD_ACK_TIMEOUT_MS * 1000ULL);
+    assert(sensor.received.size() == 3 && sensor.received[1] == FMCW_CMD_TURN_OFF_FFT);
+    assert_config(&sequencer, RADAR_SETTING_OFF, RADAR_SETTING_UNKNOWN, RADAR_SETTING_OFF,
+                  RADAR_SETTING_UNKNOWN);
+
+    // Test a missing ack resends the unacknowledged command
+    sensor.received.clear();
+    sensor.script = {REPLY_ACK, REPLY_ACK, REPLY_NOTHING};
+    assert(sequencer.run(batch, 3) == 0);
+    assert(sensor.received.size() == 4 && sensor.received[3] == FMCW_CMD_LED_OFF);
+
+    // Test an error resends the rejected command and the ones after it
+    sensor.received.clear();
+    sensor.script = {REPLY_ACK, REPLY_ERROR};
+    assert(sequencer.run(batch, 3) == 0);
+    assert(sensor.received.size() == 5);
+    assert(sensor.received[3] == FMCW_CMD_TURN_OFF_FFT && sensor.received[4] == FMCW_CMD_LED_OFF);
+
+    // Test a reply to another command is not taken for an ack and the command is resent
+    sensor.received.clear();
+    sensor.script = {REPLY_OTHER};
+    assert(sequencer.run(batch, 3) == 0);
+    assert(sensor.received.size() == 6 && sensor.received[3] == FMCW_CMD_JSON_MODE);
+
+    radar_sequencer_stats_t stats;
+    sequencer.get_stats(&stats);
+    assert(stats.commands_acked == 12 && stats.retries == 3);
+    assert(stats.nacks == 1 && stats.mismatches == 1);
+
+    // Test only the settings that change are sent
+    sensor.received.clear();
+    sensor.script = {};
+    assert(sequencer.configure(&transmitting) == 0);
+    assert(sensor.received.size() == 3 && sensor.received[0] == FMCW_CMD_WAKEUP);
+    sensor.received.clear();
+    assert(sequencer.configure(&transmitting) == 0);
+    assert(sensor.received.empty());
+    assert(sequencer.configure(&hibernating) == 0);
+    assert(sensor.received.size() == 4 && sensor.received[3] == FMCW_CMD_HIBERNATE);
+    assert_config(&sequencer, RADAR_SETTING_OFF, RADAR_SETTING_OFF, RADAR_SETTING_OFF,
+                  RADAR_SETTING_OFF);
+
+    // Test a sensor that never answers fails after the retries and forgets the settings
+    sensor.received.clear();
+    sensor.script = std::vector<fake_reply>(16, REPLY_NOTHING);
+    assert(sequencer.configure(&transmitting) == -3);
+    assert(sensor.received.size() == 3 * (RADAR_CMD_MAX_RETRIES + 1));
+    assert_config(&sequencer, RADAR_SETTING_UNKNOWN, RADAR_SETTING_OFF, RADAR_SETTING_UNKNOWN,
+                  RADAR_SETTING_UNKNOWN);
+
+    // Test a sensor that powers up in plain text mode acks nothing until it is in JSON mode
+    const char *const quiet[] = {FMCW_CMD_DISABLE_STREAM, FMCW_CMD_TURN_OFF_FFT};
+    const char *const json[] = {FMCW_CMD_JSON_MODE};
+    sensor.script = {};
+    sensor.json_mode = false;
+    assert(sequencer.run(quiet, 2) == -3);
+    sensor.received.clear();
+    assert(sequencer.run(json, 1) == 0);
+    assert(sequencer.run(quiet, 2) == 0);
+    assert(sensor.received.size() == 3 && sensor.received[2] == FMCW_CMD_TURN_OFF_FFT);
+
+    close(command_pipe[1]); // the fake sensor sees end of file
+    sensor.thread.join();
+    close(command_pipe[0]);
+    close(reply_pipe[0]);
+    close(reply_pipe[1]);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
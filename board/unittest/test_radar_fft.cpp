@@ -0,0 +1,139 @@
+/**
+ * Name: test_radar_fft.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the on-board radar FFT and zoom transform, checked against a direct DFT
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include "bsp/ops_fmcw.hpp"
+#include "dsp/radar_fft.hpp"
+
+#define N RADAR_FFT_CHIRP_SAMPLES
+
+static const double PI = 3.14159265358979323846;
+static const double SAMPLE_RATE_HZ = FMCW_RADAR_FS_KHZ * 1000.0;
+
+// I/Q of reflections at the given ranges, on top of the ADC's mid-scale offset
+static void make_chirp(const double *ranges_m, const double *amplitudes, int num, float *i,
+                       float *q)
+{
+    for (int n = 0; n < N; n++)
+    {
+        double re = 2048.0, im = 2000.0;
+        for (int r = 0; r < num; r++)
+        {
+            double hz = ranges_m[r] / radar_fft_hz_to_range_m(1.0);
+            double phase = 2 * PI * hz * n / SAMPLE_RATE_HZ + r;
+            re += amplitudes[r] * cos(phase);
+            im += amplitudes[r] * sin(phase);
+        }
+        i[n] = (float)re;
+        q[n] = (float)im;
+    }
+}
+
+// |DTFT| of the mean removed, Hann windowed chirp at hz, scaled like radar_fft_spectrum()
+static double direct_dft(const float *i, const float *q, double hz)
+{
+    double mean_i = 0, mean_q = 0;
+    for (int n = 0; n < N; n++)
+    {
+        mean_i += i[n] / N;
+        mean_q += q[n] / N;
+    }
+
+    double re = 0, im = 0, window_sum = 0;
+    for (int n = 0; n < N; n++)
+    {
+        double w = 0.5 - 0.5 * cos(2 * PI * n / (N - 1));
+        double angle = -2 * PI * hz * n / SAMPLE_RATE_HZ;
+        double x_re = (i[n] - mean_i) * w, x_im = (q[n] - mean_q) * w;
+        re += x_re * cos(angle) - x_im * sin(angle);
+        im += x_re * sin(angle) + x_im * cos(angle);
+        window_sum += w;
+    }
+    return sqrt(re * re + im * im) / window_sum;
+}
+
+static size_t argmax(const float *values, size_t num)
+{
+    size_t best = 0;
+    for (size_t k = 1; k < num; k++)
+        if (values[k] > values[best])
+            best = k;
+    return best;
+}
+
+int main(void)
+{
+    float i[N] = {0}, q[N] = {0};
+    static float spectrum[RADAR_FFT_BINS];
+    static float zoom[RADAR_ZOOM_MAX_POINTS];
+    static radar_zoom_plan_t plan;
+
+    // Test bad arguments
+    assert(radar_fft_spectrum(nullptr, q, N, spectrum) < 0);
+    assert(radar_fft_spectrum(i, q, N - 1, spectrum) < 0);
+    assert(radar_zoom_plan_init(&plan, 0.5f, 0.4f, 64) < 0);
+    assert(radar_zoom_plan_init(&plan, 0.1f, 1.0f, 1) < 0);
+    assert(radar_zoom_plan_init(&plan, 0.1f, 1.0f, RADAR_ZOOM_MAX_POINTS + 1) < 0);
+
+    // Test the spectrum matches the zero-padded DFT bin for bin
+    double ranges_m[] = {0.52, 0.61};
+    double amplitudes[] = {400.0, 150.0};
+    make_chirp(ranges_m, amplitudes, 2, i, q);
+    assert(radar_fft_spectrum(i, q, N, spectrum) == 0);
+    double max_error = 0;
+    for (size_t k = 0; k < RADAR_FFT_BINS; k++)
+    {
+        double expected = direct_dft(i, q, k * SAMPLE_RATE_HZ / RADAR_FFT_SIZE);
+        max_error = fmax(max_error, fabs(spectrum[k] - expected));
+    }
+    assert(max_error < 0.05);
+
+    // Test the DC offset is removed
+    make_chirp(ranges_m, amplitudes, 0, i, q);
+    assert(radar_fft_spectrum(i, q, N, spectrum) == 0);
+    assert(spectrum[argmax(spectrum, RADAR_FFT_BINS)] < 1e-3f);
+
+    // Test a single tone's peak is at its range with its amplitude
+    make_chirp(ranges_m, amplitudes, 1, i, q);
+    assert(radar_fft_spectrum(i, q, N, spectrum) == 0);
+    double bin_m = radar_fft_hz_to_range_m(SAMPLE_RATE_HZ / RADAR_FFT_SIZE);
+    size_t peak = argmax(spectrum, RADAR_FFT_BINS);
+    assert(fabs(peak * bin_m - ranges_m[0]) <= bin_m / 2);
+
+    // Test the zoom matches the DFT at its ranges and finds the peak to a fraction of a bin
+    assert(radar_zoom_plan_init(&plan, 0.1f, 1.0f, RADAR_ZOOM_MAX_POINTS) == 0);
+    assert(plan.num_points == RADAR_ZOOM_MAX_POINTS);
+    assert(fabs(plan.step_m * (RADAR_ZOOM_MAX_POINTS - 1) - 0.9) < 1e-5);
+    assert(radar_zoom_spectrum(&plan, i, q, N, zoom) == 0);
+    max_error = 0;
+    for (size_t k = 0; k < plan.num_points; k++)
+    {
+        double range_m = plan.start_m + k * plan.step_m;
+        double expected = direct_dft(i, q, range_m / radar_fft_hz_to_range_m(1.0));
+        max_error = fmax(max_error, fabs(zoom[k] - expected));
+    }
+    assert(max_error < 0.05);
+    size_t zoom_peak = argmax(zoom, plan.num_points);
+    assert(fabs(plan.start_m + zoom_peak * plan.step_m - ranges_m[0]) <= plan.step_m);
+    assert(plan.step_m < bin_m / 4);
+    assert(fabs(zoom[zoom_peak] - amplitudes[0]) < 0.01 * amplitudes[0]);
+
+    // Test the zoom matches the spectrum where their points coincide
+    assert(radar_zoom_plan_init(&plan, 10 * bin_m, 40 * bin_m, 31) == 0);
+    assert(radar_zoom_spectrum(&plan, i, q, N, zoom) == 0);
+    for (size_t k = 0; k < 31; k++)
+        assert(fabs(zoom[k] - spectrum[10 + k]) < 0.05);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
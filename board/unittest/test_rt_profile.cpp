@@ -0,0 +1,107 @@
+/**
+ * Name: test_rt_profile.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the rt_profile.c functions. Only checks what works without privileges,
+ * SCHED_FIFO and mlockall may be refused and are allowed to fail.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <sched.h>
+#include <thread>
+#include <unistd.h>
+#include "common/rt_profile.h"
+
+int main(void)
+{
+    // Test the environment overrides the build's defaults
+    rt_profile profile;
+    setenv("SNOW_ANGEL_RT", "1", 1);
+    setenv("SNOW_ANGEL_RT_RADAR_CPU", "-1", 1);
+    rt_profile_load(&profile);
+    assert(profile.enabled && profile.radar_cpu == -1);
+    assert(profile.priority[RT_THREAD_RADAR] > profile.priority[RT_THREAD_GPS]);
+    assert(profile.priority[RT_THREAD_GPS] > profile.priority[RT_THREAD_FSM]);
+    assert(profile.priority[RT_THREAD_BACKGROUND] == 0);
+    setenv("SNOW_ANGEL_RT", "0", 1);
+    setenv("SNOW_ANGEL_RT_RADAR_CPU", "2", 1);
+    rt_profile_load(&profile);
+    assert(!profile.enabled && profile.radar_cpu == 2);
+    setenv("SNOW_ANGEL_RT_RADAR_CPU", "two", 1); // ignored
+    rt_profile_load(&profile);
+    assert(profile.radar_cpu == RT_PROFILE_RADAR_CPU);
+
+    // Test nothing happens before a profile is applied, or when it is off
+    int pipe_fds[2];
+    assert(pipe(pipe_fds) == 0);
+    assert(rt_profile_enter(RT_THREAD_RADAR) == 0);
+    assert(rt_profile_enter(RT_THREAD_ROLES) < 0);
+    assert(rt_profile_serial_low_latency(pipe_fds[0]) == 0);
+    assert(rt_profile_apply(nullptr) < 0);
+    assert(rt_profile_apply(&profile) == 0);
+
+    // Test serial port calls fail cleanly on something that is not a serial port
+    uint32_t overruns = 7;
+    assert(rt_profile_serial_overruns(pipe_fds[0], &overruns) < 0 && overruns == 7);
+    assert(rt_profile_serial_overruns(pipe_fds[0], nullptr) < 0);
+
+    // Test the radar reader gets its core and the other threads the rest. Without privileges
+    // only the priorities fail, so only the cores are checked.
+    cpu_set_t cpus;
+    assert(sched_getaffinity(0, sizeof(cpus), &cpus) == 0);
+    if (CPU_COUNT(&cpus) >= 2)
+    {
+        int radar_cpu = -1;
+        for (int i = CPU_SETSIZE - 1; radar_cpu < 0; i--)
+            radar_cpu = CPU_ISSET(i, &cpus) ? i : -1;
+
+        // a thread already running, like logging's, is moved off the radar's core too
+        std::atomic<bool> profile_applied{false};
+        std::thread earlier([radar_cpu, &profile_applied] {
+            while (!profile_applied)
+                std::this_thread::yield();
+            cpu_set_t earlier_cpus;
+            assert(sched_getaffinity(0, sizeof(earlier_cpus), &earlier_cpus) == 0);
+            assert(!CPU_ISSET(radar_cpu, &earlier_cpus));
+        });
+
+        profile.enabled = true;
+        profile.lock_memory = false;
+        profile.radar_cpu = radar_cpu;
+        rt_profile_apply(&profile);
+        assert(sched_getaffinity(0, sizeof(cpus), &cpus) == 0);
+        assert(!CPU_ISSET(radar_cpu, &cpus));
+        profile_applied = true;
+        earlier.join();
+
+        std::thread radar([radar_cpu] {
+            rt_profile_enter(RT_THREAD_RADAR);
+            cpu_set_t radar_cpus;
+            assert(sched_getaffinity(0, sizeof(radar_cpus), &radar_cpus) == 0);
+            assert(CPU_COUNT(&radar_cpus) == 1 && CPU_ISSET(radar_cpu, &radar_cpus));
+        });
+        radar.join();
+
+        std::thread background([radar_cpu] {
+            assert(rt_profile_enter(RT_THREAD_BACKGROUND) == 0); // lowering always works
+            cpu_set_t background_cpus;
+            assert(sched_getaffinity(0, sizeof(background_cpus), &background_cpus) == 0);
+            assert(!CPU_ISSET(radar_cpu, &background_cpus));
+            assert(sched_getscheduler(0) == SCHED_OTHER);
+        });
+        background.join();
+    }
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,56 @@
+/**
+ * Name: test_sample_history.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the SAMPLE_HISTORY template
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include "common/sample_history.hpp"
+
+int main(void)
+{
+    SAMPLE_HISTORY<int, 4> history;
+    int value = -1;
+    uint64_t skew = 0;
+
+    // Test an empty history has nothing to join with
+    assert(history.size() == 0);
+    assert(!history.nearest(1000, &value));
+    assert(value == -1);
+
+    // Test a single sample is the nearest to any time
+    history.push(1000, 1);
+    assert(history.nearest(0, &value, &skew) && value == 1 && skew == 1000);
+    assert(history.nearest(5000, &value, &skew) && value == 1 && skew == 4000);
+
+    // Test the nearest sample is picked on either side of the target
+    history.push(2000, 2);
+    history.push(3000, 3);
+    assert(history.nearest(1400, &value, &skew) && value == 1 && skew == 400);
+    assert(history.nearest(1600, &value, &skew) && value == 2 && skew == 400);
+    assert(history.nearest(3000, &value, &skew) && value == 3 && skew == 0);
+    assert(history.nearest(9000, &value) && value == 3);
+
+    // Test the oldest samples are overwritten once full
+    history.push(4000, 4);
+    history.push(5000, 5);
+    history.push(6000, 6);
+    assert(history.size() == 4);
+    assert(history.nearest(0, &value, &skew) && value == 3 && skew == 3000);
+    assert(history.nearest(4900, &value) && value == 5);
+
+    // Test clear empties the history
+    history.clear();
+    assert(history.size() == 0);
+    assert(!history.nearest(5000, &value));
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
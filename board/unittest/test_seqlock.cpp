@@ -0,0 +1,64 @@
+/**
+ * Name: test_seqlock.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the seqlock.hpp template
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include "common/seqlock.hpp"
+
+typedef struct sample
+{
+    double latitude;
+    double longitude;
+    uint32_t sequence; // odd size on purpose, the last word is partly padding
+} sample_t;
+
+int main(void)
+{
+    SEQLOCK<sample_t> lock;
+    sample_t value = {};
+
+    // Test nothing is published initially
+    assert(!lock.load(&value));
+
+    // Test a stored value reads back
+    lock.store(sample_t{45.0, -75.0, 1});
+    assert(lock.load(&value));
+    assert(value.latitude == 45.0 && value.longitude == -75.0 && value.sequence == 1);
+
+    // Test readers never see a torn value while the writer is busy
+    lock.store(sample_t{1.0, -1.0, 1});
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (uint32_t i = 2; i < 200000; i++)
+            lock.store(sample_t{(double)i, -(double)i, i});
+        done.store(true);
+    });
+
+    uint32_t last = 0;
+    while (!done.load())
+    {
+        assert(lock.load(&value));
+        assert(value.latitude == (double)value.sequence);
+        assert(value.longitude == -(double)value.sequence);
+        assert(value.sequence >= last); // never goes back in time
+        last = value.sequence;
+        std::this_thread::yield();
+    }
+    writer.join();
+
+    assert(lock.load(&value) && value.sequence == 199999);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * Name: test_serial_line_reader.cpp
+ * Author: Karran Dhillon
+ *
+ * Unit test file for the serial_line_reader.cpp functions. A pipe stands in for the tty.
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include "bsp/serial_line_reader.hpp"
+
+static void write_str(int fd, const char *str)
+{
+    ssize_t len = (ssize_t)strlen(str);
+    assert(write(fd, str, len) == len);
+}
+
+int main(void)
+{
+    int fds[2];
+    assert(pipe(fds) == 0);
+
+    SERIAL_LINE_READER reader;
+    reader.attach(fds[0]);
+    std::string_view line;
+
+    // Test several lines delivered in one chunk, with mixed line endings
+    write_str(fds[1], "{\"Units\":\"m\"}\r\n\r\nfirst\nsecond\r");
+    assert(reader.read_line(&line, 100) == 0);
+    assert(line == "{\"Units\":\"m\"}");
+    assert(reader.read_line(&line, 100) == 0);
+    assert(line == "first");
+    assert(reader.read_line(&line, 100) == 0);
+    assert(line == "second");
+
+    // Test a line split across several reads
+    write_str(fds[1], "{\"FFT\":[1.0,");
+    assert(reader.read_line(&line, 10) == -1); // incomplete line times out
+    write_str(fds[1], "2.0]}\n");
+    assert(reader.read_line(&line, 100) == 0);
+    assert(line == "{\"FFT\":[1.0,2.0]}");
+
+    // Test lines keep coming out intact once the buffer has to wrap around
+    std::string long_line(3000, '7');
+    for (int i = 0; i < 10; i++)
+    {
+        write_str(fds[1], (long_line + "\r\n").c_str());
+        assert(reader.read_line(&line, 100) == 0);
+        assert(line == long_line);
+    }
+
+    // Test discard drops a partial line
+    write_str(fds[1], "stale");
+    assert(reader.read_line(&line, 10) == -1);
+    reader.discard();
+    write_str(fds[1], "fresh\n");
+    assert(reader.read_line(&line, 100) == 0);
+    assert(line == "fresh");
+
+    // Test a closed device is reported as an error
+    close(fds[1]);
+    assert(reader.read_line(&line, 100) == -2);
+
+    close(fds[0]);
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * Name: test_spectrum_codec.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the spectrum_codec.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "bsp/fmcw_radar_sensor.hpp"
+#include "storage/spectrum_codec.hpp"
+
+#define RADAR_SIM_PATH "../sim/radar_ice_fft_data.sim"
+#define N FMCW_RADAR_FFT_SIZE
+
+static uint8_t encoded[SPECTRUM_CODEC_MAX_SIZE(N)];
+
+// Encodes and decodes bins, returns the encoded size
+static int round_trip(const uint16_t *bins, const uint16_t *reference, size_t num_bins)
+{
+    uint16_t decoded[N];
+    int size = spectrum_encode(bins, reference, num_bins, encoded, sizeof(encoded));
+    assert(size > 0);
+    assert(spectrum_decode(encoded, size, reference, num_bins, decoded) == size);
+    assert(memcmp(decoded, bins, num_bins * sizeof(bins[0])) == 0);
+    return size;
+}
+
+int main(void)
+{
+    uint16_t frame[N], next[N], decoded[N];
+
+    // Test a recorded frame, on its own and against a noisy copy of itself
+    std::ifstream sim_file(RADAR_SIM_PATH);
+    assert(sim_file.is_open());
+    std::string line;
+    assert(std::getline(sim_file, line));
+    assert(fmcw_radar_parse_fft_bins(line.data(), line.size(), frame, N) == N);
+    srand(1);
+    for (int i = 0; i < N; i++)
+        next[i] = (uint16_t)(frame[i] + frame[i] / 50 * (rand() % 3 - 1));
+    int keyframe_size = round_trip(next, nullptr, N);
+    int delta_size = round_trip(next, frame, N);
+    assert(keyframe_size < (int)sizeof(frame));
+    assert(delta_size < keyframe_size);
+    assert(delta_size * 3 < (int)sizeof(frame)); // correlated frames compress at least 3:1
+
+    // Test identical frames take a byte per block
+    assert(round_trip(frame, frame, N) == N / SPECTRUM_CODEC_BLOCK_BINS);
+
+    // Test the extremes, every bin a full swing from its reference
+    for (int i = 0; i < N; i++)
+    {
+        frame[i] = (i % 2) ? UINT16_MAX : 0;
+        next[i] = (i % 2) ? 0 : UINT16_MAX;
+    }
+    assert(round_trip(next, frame, N) == SPECTRUM_CODEC_MAX_SIZE(N));
+    assert(round_trip(next, nullptr, N) == SPECTRUM_CODEC_MAX_SIZE(N));
+
+    // Test a partial last block
+    assert(round_trip(next, frame, 21) > 0);
+
+    // Test an output that is too small and bad arguments
+    assert(spectrum_encode(next, frame, N, encoded, 100) == -2);
+    assert(spectrum_encode(nullptr, frame, N, encoded, sizeof(encoded)) == -1);
+    assert(spectrum_decode(nullptr, 10, frame, N, decoded) == -1);
+
+    // Test corrupt encodings are refused
+    int size = spectrum_encode(next, frame, N, encoded, sizeof(encoded));
+    assert(spectrum_decode(encoded, size - 1, frame, N, decoded) == -2); // cut short
+    encoded[0] = SPECTRUM_CODEC_MAX_WIDTH + 1;
+    assert(spectrum_decode(encoded, size, frame, N, decoded) == -2);
+    uint8_t below_zero[] = {2, 0x01}; // one block of -1 against a zero reference
+    uint16_t zeros[4] = {};
+    assert(spectrum_decode(below_zero, sizeof(below_zero), zeros, 4, decoded) == -2);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,64 @@
+/**
+ * Name: test_spectrum_stack.cpp
+ * Author: Karran Dhillon
+ *
+ * Unit test file for the spectrum_stack.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include "bsp/fmcw_radar_sensor.hpp"
+#include "dsp/spectrum_stack.hpp"
+
+#define NUM_FRAMES 5
+
+int main(void)
+{
+    static fmcw_fft_frame_t frames[NUM_FRAMES];
+    const fmcw_fft_frame_t *frame_ptrs[NUM_FRAMES];
+    static spectrum_stack_result_t result;
+
+    // Frame f holds (f + 1) * 10 in every bin, except one noisy frame and one strong bin
+    for (int f = 0; f < NUM_FRAMES; f++)
+    {
+        frames[f].num_bins = FMCW_RADAR_FFT_SIZE;
+        for (int i = 0; i < FMCW_RADAR_FFT_SIZE; i++)
+            frames[f].bins[i] = (uint16_t)((f + 1) * 10);
+        frames[f].bins[100] = 1000;
+        frame_ptrs[f] = &frames[f];
+    }
+    frames[2].bins[7] = 65535; // a glitch should drag the mean but not the median
+
+    assert(spectrum_stack(frame_ptrs, NUM_FRAMES, &result) == 0);
+    assert(result.num_frames == NUM_FRAMES);
+
+    // Test mean and median
+    assert(std::fabs(result.mean[0] - 30.0f) < 1e-3f);
+    assert(std::fabs(result.median[0] - 30.0f) < 1e-3f);
+    assert(std::fabs(result.mean[100] - 1000.0f) < 1e-3f);
+    assert(std::fabs(result.mean[7] - (10 + 20 + 65535 + 40 + 50) / 5.0f) < 1e-2f);
+    assert(std::fabs(result.median[7] - 40.0f) < 1e-3f);
+
+    // Test noise floor and SNR
+    assert(std::fabs(result.noise_floor - 30.0f) < 1e-3f);
+    float expected_snr_db = 20.0f * std::log10(result.mean[7] / 30.0f);
+    assert(std::fabs(result.peak_snr_db - expected_snr_db) < 1e-2f);
+
+    // Test an even number of frames averages the two middle values
+    assert(spectrum_stack(frame_ptrs, 4, &result) == 0);
+    assert(std::fabs(result.median[0] - 25.0f) < 1e-3f);
+
+    // Test invalid arguments
+    assert(spectrum_stack(frame_ptrs, 0, &result) == -1);
+    frames[1].num_bins = 10;
+    assert(spectrum_stack(frame_ptrs, NUM_FRAMES, &result) == -1);
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * Name: test_spsc_queue.cpp
+ * Author: Karran Dhillon
+ *
+ * Unit test file for the spsc_queue.hpp template
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include "common/spsc_queue.hpp"
+
+int main(void)
+{
+    SPSC_QUEUE<uint32_t, 4> queue;
+    uint32_t item = 0;
+
+    // Test empty and full conditions
+    assert(!queue.pop(&item));
+    for (uint32_t i = 0; i < 4; i++)
+        assert(queue.push(i));
+    assert(!queue.push(4));
+    assert(queue.size() == 4);
+
+    // Test FIFO order
+    assert(queue.pop(&item) && item == 0);
+    assert(queue.push(4));
+    for (uint32_t i = 1; i <= 4; i++)
+        assert(queue.pop(&item) && item == i);
+    assert(queue.size() == 0);
+
+    // Test popping in bulk, across the wrap and with less room than is queued
+    uint32_t items[4] = {};
+    assert(queue.pop_many(items, 4) == 0);
+    for (uint32_t i = 6; i < 9; i++)
+        assert(queue.push(i));
+    assert(queue.pop_many(items, 2) == 2 && items[0] == 6 && items[1] == 7);
+    assert(queue.push(9) && queue.push(10));
+    assert(queue.pop_many(items, 4) == 3 && items[0] == 8 && items[1] == 9 && items[2] == 10);
+    assert(queue.size() == 0);
+
+    // Test clear
+    assert(queue.push(5));
+    queue.clear();
+    assert(!queue.pop(&item));
+
+    // Test a producer thread and consumer thread see every item in order
+    constexpr uint32_t NUM_ITEMS = 100000;
+    SPSC_QUEUE<uint32_t, 64> shared_queue;
+    std::thread producer([&shared_queue]() {
+        for (uint32_t i = 0; i < NUM_ITEMS; i++)
+        {
+            while (!shared_queue.push(i))
+                std::this_thread::yield();
+        }
+    });
+
+    for (uint32_t expected = 0; expected < NUM_ITEMS;)
+    {
+        if (shared_queue.pop(&item))
+        {
+            assert(item == expected);
+            expected++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
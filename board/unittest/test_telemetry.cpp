@@ -0,0 +1,135 @@
+/**
+ * Name: test_telemetry.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the telemetry.cpp functions
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "comms/telemetry.hpp"
+
+static uint8_t datagram[TELEMETRY_MAX_DATAGRAM_SIZE];
+
+// A ground station on the loopback interface, returns its socket and port
+static int open_listener(uint16_t *port)
+{
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    assert(sock >= 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    assert(bind(sock, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+    socklen_t len = sizeof(addr);
+    assert(getsockname(sock, (struct sockaddr *)&addr, &len) == 0);
+    *port = ntohs(addr.sin_port);
+
+    struct timeval timeout = {2, 0};
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return sock;
+}
+
+// Receives one datagram, checks its header and returns its reports
+static int receive(int sock, telemetry_header_t *header, telemetry_stop_report_t **reports)
+{
+    ssize_t len = recv(sock, datagram, sizeof(datagram), 0);
+    if (len < 0)
+        return -1;
+    assert((size_t)len >= sizeof(*header));
+    memcpy(header, datagram, sizeof(*header));
+    assert(header->magic == TELEMETRY_MAGIC);
+    assert(header->version == TELEMETRY_VERSION);
+    assert(header->num_reports >= 1 && header->num_reports <= TELEMETRY_MAX_REPORTS_PER_DATAGRAM);
+    assert((size_t)len == sizeof(*header) + header->num_reports * sizeof(telemetry_stop_report_t));
+    *reports = (telemetry_stop_report_t *)(datagram + sizeof(*header));
+    return header->num_reports;
+}
+
+int main(void)
+{
+    uint16_t port;
+    int listener = open_listener(&port);
+
+    // Test bad addresses and publishing before open
+    TELEMETRY_PUBLISHER telemetry;
+    telemetry_stop_report_t report = {};
+    assert(telemetry.publish(&report) < 0);
+    assert(telemetry.open("not an address", port) < 0);
+    assert(!telemetry.is_open());
+
+    // Test a report arrives whole, numbered from 1
+    assert(telemetry.open("127.0.0.1", port) == 0);
+    assert(telemetry.open("127.0.0.1", port) < 0); // already open
+    report.flags = TELEMETRY_STOP_CONVERGED | TELEMETRY_STOP_HAS_ESTIMATE;
+    report.num_reads = 7;
+    report.num_estimates = 6;
+    report.timestamp_usec = 1763650800000000ULL;
+    report.latitude = 45.3848;
+    report.longitude = -75.7047;
+    report.temperature = -12.4f;
+    report.thickness_m = 0.35f;
+    report.half_width_m = 0.004f;
+    report.snr_db = 21.5f;
+    report.stacked_thickness_m = 0.352f;
+    assert(telemetry.publish(&report) == 0);
+    assert(telemetry.publish(nullptr) < 0);
+
+    telemetry_header_t header;
+    telemetry_stop_report_t *reports;
+    assert(receive(listener, &header, &reports) == 1);
+    assert(header.datagram == 1 && header.dropped_reports == 0);
+    report.sequence = 1;
+    assert(memcmp(&reports[0], &report, sizeof(report)) == 0);
+
+    // Test a burst is batched into datagrams, the oldest reports dropped when it overflows
+    // the queue, and every report either sent or counted as dropped
+    const uint32_t BURST = 200;
+    for (uint32_t i = 0; i < BURST; i++)
+    {
+        report.num_reads = (uint16_t)i;
+        assert(telemetry.publish(&report) == 0);
+    }
+    telemetry.close(); // sends whatever is still queued
+
+    uint32_t received = 0, last_sequence = 1, last_datagram = 1, num_datagrams = 1;
+    int count;
+    while ((count = receive(listener, &header, &reports)) > 0)
+    {
+        assert(header.datagram == last_datagram + 1);
+        last_datagram = header.datagram;
+        num_datagrams++;
+        for (int i = 0; i < count; i++)
+        {
+            assert(reports[i].sequence > last_sequence); // oldest first, never twice
+            assert(reports[i].num_reads == reports[i].sequence - 2);
+            last_sequence = reports[i].sequence;
+        }
+        received += count;
+        if (last_sequence == BURST + 1)
+            break;
+    }
+    assert(last_sequence == BURST + 1); // the newest report always goes out
+
+    telemetry_stats_t stats;
+    telemetry.get_stats(&stats);
+    assert(stats.published == BURST + 1);
+    assert(stats.sent == received + 1);
+    assert(stats.sent + stats.dropped == stats.published);
+    assert(stats.datagrams == num_datagrams);
+    assert(stats.send_errors == 0);
+    assert(header.dropped_reports == stats.dropped);
+
+    close(listener);
+    printf("All tests passed successfully.\n");
+    return 0;
+}
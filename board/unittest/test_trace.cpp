@@ -0,0 +1,90 @@
+/**
+ * Name: test_trace.cpp
+ * Author: Hubert Dang
+ *
+ * Unit test file for the trace.c latency tracing
+ *
+ * Date: November 2025
+ *
+ * Copyright 2025 SnowAngel-UAV
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include <unistd.h>
+#include "common/trace.h"
+
+static void record_many(enum trace_point point, int count, uint32_t duration_nsec)
+{
+    for (int i = 0; i < count; i++)
+        trace_record(point, duration_nsec);
+}
+
+int main(void)
+{
+    struct trace_stats stats;
+
+    // Test bad arguments
+    assert(trace_get_stats(TRACE_NUM_POINTS, &stats) < 0);
+    assert(trace_get_stats(TRACE_GPS_READ, NULL) < 0);
+
+    // Test nothing is reported before anything is recorded
+    assert(trace_get_stats(TRACE_GPS_READ, &stats) == 0);
+    assert(stats.count == 0 && stats.p50_nsec == 0 && stats.max_nsec == 0);
+
+    // Test percentiles are within 1/8th of the recorded values
+    record_many(TRACE_GPS_READ, 98, 1000);
+    record_many(TRACE_GPS_READ, 1, 50000);
+    record_many(TRACE_GPS_READ, 1, 2000000);
+    trace_collect();
+    assert(trace_get_stats(TRACE_GPS_READ, &stats) == 0);
+    assert(stats.count == 100 && stats.dropped == 0);
+    assert(stats.p50_nsec >= 1000 && stats.p50_nsec <= 1125);
+    assert(stats.p99_nsec >= 50000 && stats.p99_nsec <= 56250);
+    assert(stats.max_nsec == 2000000);
+    assert(stats.mean_nsec == (98 * 1000 + 50000 + 2000000) / 100);
+
+    // Test small and saturated durations
+    trace_record(TRACE_PERSIST_RECORD, 3);
+    trace_record(TRACE_PERSIST_RECORD, 10ULL * 1000000000ULL);
+    trace_collect();
+    assert(trace_get_stats(TRACE_PERSIST_RECORD, &stats) == 0);
+    assert(stats.p50_nsec == 3 && stats.max_nsec == UINT32_MAX);
+
+    // Test events recorded by other threads are collected, and exited threads' rings are
+    // reused so more threads than TRACE_MAX_THREADS can record over time
+    for (int round = 0; round < 3; round++)
+    {
+        std::thread workers[TRACE_MAX_THREADS - 1];
+        for (auto &worker : workers)
+            worker = std::thread(record_many, TRACE_RADAR_PARSE, 100, 20000);
+        for (auto &worker : workers)
+            worker.join();
+        trace_collect();
+    }
+    assert(trace_get_stats(TRACE_RADAR_PARSE, &stats) == 0);
+    assert(stats.count == 3 * (TRACE_MAX_THREADS - 1) * 100 && stats.dropped == 0);
+    assert(stats.p50_nsec >= 20000 && stats.p50_nsec <= 22500);
+
+    // Test a full ring drops and counts events instead of blocking
+    record_many(TRACE_ICE_ESTIMATE, TRACE_RING_SIZE + 10, 500);
+    trace_collect();
+    assert(trace_get_stats(TRACE_ICE_ESTIMATE, &stats) == 0);
+    assert(stats.count == TRACE_RING_SIZE && stats.dropped == 10);
+
+    // Test the scoped timer records the time spent in its scope
+    {
+        TRACE_SCOPE(TRACE_FSM_FINISH_STOP);
+        usleep(2000);
+    }
+    trace_collect();
+    assert(trace_get_stats(TRACE_FSM_FINISH_STOP, &stats) == 0);
+    assert(stats.count == 1 && stats.max_nsec >= 2000000);
+
+    assert(trace_point_name(TRACE_GPS_READ)[0] != '\0');
+
+    printf("All tests passed successfully.\n");
+    return 0;
+}
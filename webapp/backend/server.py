@@ -1,18 +1,25 @@
 from fastapi import FastAPI, HTTPException, UploadFile, File, Form
 from pydantic import BaseModel
 from typing import Optional
-import psycopg2
+import json
 import os
+import shutil
+import subprocess
+import tempfile
+import psycopg2
 
 # --- Database connection ---
-try:
-    conn = psycopg2.connect(
+def connect_db():
+    return psycopg2.connect(
         host=os.getenv("DB_HOST", "localhost"),
         port=os.getenv("DB_PORT", 5432),
         database=os.getenv("DB_NAME", "db"),
         user=os.getenv("DB_USER", "temp"),
         password=os.getenv("DB_PASS", "pass")
     )
+
+try:
+    conn = connect_db()
     conn.autocommit = True
 except Exception as e:
     raise RuntimeError(f"Failed to connect to database: {e}")
@@ -25,15 +32,69 @@ class Flight(BaseModel):
     location: str
     notes: Optional[str] = None
 
-# --- Helper function placeholder ---
-def process_uploaded_measurements(file: UploadFile, flight_id: int):
+# --- Measurement ingest ---
+# board/tools/ingest, built with -DBUILD_TOOLS=ON. It parses the flight CSV on every core and
+# writes COPY files for the two measurement tables.
+INGEST_BIN = os.getenv("INGEST_BIN", "snow_angel_ingest")
+
+RAW_COPY = ("COPY raw_measurements (raw_id, flight_id, timestamp, coordinates, temperature, fft) "
+            "FROM STDIN")
+CLEANED_COPY = ("COPY cleaned_measurements (flight_id, raw_id, timestamp, coordinates, thickness, "
+                "quality_score) FROM STDIN")
+
+
+def add_flight_with_measurements(date: str, location: Optional[str], notes: Optional[str],
+                                  file: UploadFile):
     """
-    Placeholder function to handle file parsing and DB insertion.
-    - Parse the uploaded file
-    - Insert rows into raw_measurements and cleaned_measurements
+    Creates a flight, parses the uploaded flight CSV with the native ingest tool and bulk loads
+    its output into raw_measurements and cleaned_measurements, all in one transaction on a
+    connection of its own, so a failed upload leaves no flight behind. Returns the flight's id
+    and the tool's summary.
     """
-    # TODO: Implement parsing + insertion logic here
-    pass
+    with tempfile.TemporaryDirectory() as tmp:
+        csv_path = os.path.join(tmp, "flight.csv")
+        with open(csv_path, "wb") as out:
+            shutil.copyfileobj(file.file, out)
+
+        upload_conn = connect_db()
+        cur = upload_conn.cursor()
+        try:
+            cur.execute(
+                "INSERT INTO flights (date, location, notes) VALUES (%s, %s, %s) "
+                "RETURNING flight_id;",
+                (date, location, notes)
+            )
+            flight_id = cur.fetchone()[0]
+
+            # the tool numbers the raw rows, so other uploads wait until these are loaded
+            cur.execute("LOCK TABLE raw_measurements IN SHARE ROW EXCLUSIVE MODE;")
+            cur.execute("SELECT COALESCE(MAX(raw_id), 0) + 1 FROM raw_measurements;")
+            first_raw_id = cur.fetchone()[0]
+
+            result = subprocess.run(
+                [INGEST_BIN, csv_path, str(flight_id), str(first_raw_id), tmp],
+                capture_output=True, text=True
+            )
+            if result.returncode != 0:
+                raise HTTPException(status_code=422, detail=result.stderr.strip())
+            summary = json.loads(result.stdout)
+
+            with open(os.path.join(tmp, "raw_measurements.copy")) as f:
+                cur.copy_expert(RAW_COPY, f)
+            with open(os.path.join(tmp, "cleaned_measurements.copy")) as f:
+                cur.copy_expert(CLEANED_COPY, f)
+            cur.execute(
+                "SELECT setval(pg_get_serial_sequence('raw_measurements', 'raw_id'), %s, false);",
+                (summary["next_raw_id"],)
+            )
+            upload_conn.commit()
+        except Exception:
+            upload_conn.rollback()
+            raise
+        finally:
+            cur.close()
+            upload_conn.close()
+    return flight_id, summary
 
 
 # --- Routes ---
@@ -50,27 +111,21 @@ def get_flights():
     return [{"flight_id": r[0], "date": str(r[1]), "location": r[2], "notes": r[3]} for r in rows]
 
 @app.post("/flights")
-async def add_flight(
+def add_flight(
     date: str = Form(...),
     location: str = Form(...),
     notes: Optional[str] = Form(None),
     file: UploadFile = File(...)
 ):
     """
-    Creates a new flight and processes the uploaded measurement file.
+    Creates a new flight and processes the uploaded measurement file. A plain def, so the
+    ingest runs in FastAPI's threadpool instead of blocking the event loop.
     """
-    cur = conn.cursor()
-    cur.execute(
-        "INSERT INTO flights (date, location, notes) VALUES (%s, %s, %s) RETURNING flight_id;",
-        (date, location, notes)
-    )
-    flight_id = cur.fetchone()[0]
-    cur.close()
-
-    # Placeholder for parsing & inserting measurement data
-    process_uploaded_measurements(file, flight_id)
+    flight_id, summary = add_flight_with_measurements(date, location, notes, file)
 
-    return {"flight_id": flight_id, "status": "added", "file_received": file.filename}
+    return {"flight_id": flight_id, "status": "added", "file_received": file.filename,
+            "raw_rows": summary["raw_rows"], "cleaned_rows": summary["cleaned_rows"],
+            "bad_rows": summary["bad_rows"]}
 
 
 @app.get("/cleaned/{flight_id}")